@@ -113,6 +113,7 @@ typedef enum {
     // ACL
     MM_ENV_AUTO_USE_UC_MEMORY = 10000,
     MM_ENV_SHAREGROUP_PRECONFIG = 10001,
+    MM_ENV_TDT_HOST_MEM_POOL_LIMIT = 10002,
     // HCCL
     MM_ENV_HCCL_RDMA_PCIE_DIRECT_POST_NOSTRICT = 11000,
     MM_ENV_HCCL_EXEC_TIMEOUT = 11001,
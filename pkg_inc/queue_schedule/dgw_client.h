@@ -67,6 +67,8 @@ enum class GroupPolicy : int32_t {
     HASH = 0,
     BROADCAST = 1,
     DYNAMIC = 2,
+    CONSISTENT_HASH = 3,
+    LEAST_DEPTH = 4,
 };
 
 // Query mode
@@ -34,6 +34,16 @@ RTS_API RT_DEPRECATED_MESSAGE(RT_RUNTIME_DEPRECATED_MESSAGE) rtError_t
     rtsProfTrace(void* userdata, int32_t length, rtStream_t stream);
 
 RT_RUNTIME_DEPRECATED_DECLS_END
+
+/**
+ * @ingroup rts_profiling
+ * @brief Turn on or off the latency histograms of the runtime hot paths.
+ * Turning on starts a new statistics window, the p50/p99/p999 summary is exported periodically to the log or to
+ * the file given by env ASCEND_RT_LATENCY_STAT_PATH, and once more when turned off.
+ * @param [in] enable 1: on, 0: off.
+ * @return RT_ERROR_NONE for ok.
+ */
+RTS_API rtError_t rtsSetLatencyStat(uint32_t enable);
 #if defined(__cplusplus)
 }
 #endif
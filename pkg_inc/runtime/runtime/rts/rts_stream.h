@@ -35,15 +35,37 @@ typedef enum {
     RT_STREAM_ATTR_USER_CUSTOM_TAG = 3,
     RT_STREAM_ATTR_CACHE_OP_INFO = 4,
     RT_STREAM_ATTR_PRIORITY = 5,
-    RT_STREAM_ATTR_MAX = 6,
+    RT_STREAM_ATTR_SUBMIT_BATCH = 6, // 批量下发kernel任务，攒够submitBatchSize个、等待超过50us或遇到同步/非kernel任务时统一敲doorbell
+    RT_STREAM_ATTR_SYNC_WAIT_MODE = 7, // 流同步时host线程的等待方式，取值见rtStreamSyncWaitMode
+    RT_STREAM_ATTR_SYNC_WAIT_STAT = 8, // 只读，流同步等待的统计，见rtStreamSyncWaitStat_t
+    RT_STREAM_ATTR_MAX = 9,
 } rtStreamAttr;
 
+#define RT_STREAM_SUBMIT_BATCH_SIZE_MAX (256U)
+
+typedef enum {
+    RT_STREAM_SYNC_WAIT_ADAPTIVE = 0,    // 默认，根据流上任务的历史耗时在自旋和休眠之间切换
+    RT_STREAM_SYNC_WAIT_LOW_LATENCY = 1, // 一直自旋，唤醒时延最低
+    RT_STREAM_SYNC_WAIT_LOW_CPU = 2,     // 尽量休眠，CPU占用最低
+    RT_STREAM_SYNC_WAIT_MAX,
+} rtStreamSyncWaitMode;
+
+typedef struct {
+    uint32_t spinNum;            // 自旋等待的次数
+    uint32_t parkNum;            // 休眠等待的次数
+    uint32_t notifiedNum;        // 休眠中被任务完成提前唤醒的次数
+    uint32_t wakeupLatencyMaxUs; // 从唤醒到等待线程恢复运行的最大时延，单位us
+} rtStreamSyncWaitStat_t;
+
 typedef union {
     uint64_t failureMode;
     uint32_t overflowSwitch;
     uint32_t userCustomTag;
     uint32_t cacheOpInfoSwitch;
     uint32_t streamPriority;
+    uint32_t submitBatchSize; // 0或1: 逐个下发; [2, RT_STREAM_SUBMIT_BATCH_SIZE_MAX]: 批量下发的最大任务数
+    uint32_t syncWaitMode;    // rtStreamSyncWaitMode
+    rtStreamSyncWaitStat_t syncWaitStat; // 只读，超过UINT32_MAX的计数按UINT32_MAX返回
     uint32_t rsv[4];
 } rtStreamAttrValue_t;
 
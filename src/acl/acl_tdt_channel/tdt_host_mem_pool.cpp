@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include "tdt_host_mem_pool.h"
+#include <cstdlib>
+#include <iterator>
+
+#include "log_inner.h"
+#include "runtime/mem.h"
+
+namespace {
+constexpr size_t TDT_HOST_MEM_POOL_LIMIT_UNIT = 1024UL * 1024UL;
+constexpr size_t TDT_HOST_MEM_POOL_CLASS_PER_POW2 = 4UL;
+
+size_t GetPoolLimitSize()
+{
+    const char_t* limitEnv = nullptr;
+    MM_SYS_GET_ENV(MM_ENV_TDT_HOST_MEM_POOL_LIMIT, limitEnv);
+    if ((limitEnv == nullptr) || (limitEnv[0] == '\0')) {
+        return acl::TDT_HOST_MEM_POOL_DEFAULT_LIMIT;
+    }
+    char_t* end = nullptr;
+    const unsigned long long limitMb = strtoull(limitEnv, &end, 10);
+    if ((end == nullptr) || (*end != '\0') || (limitEnv[0] == '-') ||
+        (limitMb > (SIZE_MAX / TDT_HOST_MEM_POOL_LIMIT_UNIT))) {
+        ACL_LOG_WARN(
+            "invalid TDT_HOST_MEM_POOL_LIMIT [%s], use default limit %zu bytes", limitEnv,
+            acl::TDT_HOST_MEM_POOL_DEFAULT_LIMIT);
+        return acl::TDT_HOST_MEM_POOL_DEFAULT_LIMIT;
+    }
+    return static_cast<size_t>(limitMb) * TDT_HOST_MEM_POOL_LIMIT_UNIT;
+}
+} // namespace
+
+namespace acl {
+std::shared_ptr<TdtHostMemPool> TdtHostMemPool::Create()
+{
+    const size_t limitSize = GetPoolLimitSize();
+    std::shared_ptr<TdtHostMemPool> pool(new (std::nothrow) TdtHostMemPool(limitSize));
+    ACL_CHECK_MALLOC_RESULT_REPORT_RET(pool.get(), sizeof(TdtHostMemPool), "new", nullptr);
+    ACL_LOG_INFO("create tdt host mem pool, limit size is %zu", limitSize);
+    return pool;
+}
+
+size_t TdtHostMemPool::GetSizeClass(const size_t size)
+{
+    if (size <= TDT_HOST_MEM_POOL_MIN_CLASS) {
+        return TDT_HOST_MEM_POOL_MIN_CLASS;
+    }
+    if (size <= TDT_HOST_MEM_POOL_POW2_CLASS_MAX) {
+        size_t sizeClass = TDT_HOST_MEM_POOL_MIN_CLASS;
+        while (sizeClass < size) {
+            sizeClass <<= 1U;
+        }
+        return sizeClass;
+    }
+    // large buffers are rounded to a quarter of their power of 2, so at most 25% is wasted
+    size_t pow2 = TDT_HOST_MEM_POOL_POW2_CLASS_MAX;
+    while (pow2 <= (size / 2UL)) {
+        pow2 <<= 1U;
+    }
+    const size_t step = pow2 / TDT_HOST_MEM_POOL_CLASS_PER_POW2;
+    if (size > (SIZE_MAX - step)) {
+        return size;
+    }
+    return (size + step - 1UL) / step * step;
+}
+
+TdtHostMemPool::TdtHostMemPool(const size_t limitSize) : limitSize_(limitSize) {}
+
+TdtHostMemPool::~TdtHostMemPool()
+{
+    ACL_LOG_INFO(
+        "destroy tdt host mem pool, hit %lu, miss %lu, trim %lu, cached size %zu, in use size %zu", hitCount_,
+        missCount_, trimCount_, cachedSize_, inUseSize_);
+    for (const IdleBuf& idleBuf : lruList_) {
+        (void)rtFreeHost(idleBuf.ptr);
+    }
+    lruList_.clear();
+    idleMap_.clear();
+}
+
+aclError TdtHostMemPool::Acquire(const size_t size, std::shared_ptr<void>& buf, size_t& bufSize)
+{
+    const size_t sizeClass = GetSizeClass(size);
+    void* ptr = nullptr;
+    if (!TakeIdle(sizeClass, ptr, bufSize)) {
+        if ((rtMallocHost(&ptr, sizeClass, acl::ACL_MODE_ID_U16) != RT_ERROR_NONE) || (ptr == nullptr)) {
+            // the cached buffers may be what keeps the pinned memory exhausted, give them back and retry once
+            ACL_LOG_INFO("mallochost size %zu failed, trim tdt host mem pool and retry", sizeClass);
+            Trim(0UL);
+            ptr = nullptr;
+            ACL_REQUIRES_RTS_OK_WARN_NOT_SUPPORT(rtMallocHost(&ptr, sizeClass, acl::ACL_MODE_ID_U16), rtMallocHost);
+            ACL_CHECK_MALLOC_RESULT(ptr);
+        }
+        bufSize = sizeClass;
+        const std::lock_guard<std::mutex> lk(mutex_);
+        inUseSize_ += bufSize;
+    }
+    const std::weak_ptr<TdtHostMemPool> weakPool = shared_from_this();
+    const size_t releaseSize = bufSize;
+    buf.reset(ptr, [weakPool, releaseSize](void* p) { ReleaseToPool(weakPool, p, releaseSize); });
+    ACL_LOG_DEBUG("acquire tdt host mem, need size %zu, buf size %zu", size, bufSize);
+    return ACL_SUCCESS;
+}
+
+void TdtHostMemPool::Trim(const size_t targetSize)
+{
+    IdleList freeList;
+    {
+        const std::lock_guard<std::mutex> lk(mutex_);
+        TrimLocked(targetSize, freeList);
+    }
+    for (const IdleBuf& idleBuf : freeList) {
+        (void)rtFreeHost(idleBuf.ptr);
+    }
+}
+
+void TdtHostMemPool::GetStat(TdtHostMemPoolStat& stat)
+{
+    const std::lock_guard<std::mutex> lk(mutex_);
+    stat.hitCount = hitCount_;
+    stat.missCount = missCount_;
+    stat.trimCount = trimCount_;
+    stat.cachedSize = cachedSize_;
+    stat.inUseSize = inUseSize_;
+}
+
+void TdtHostMemPool::ReleaseToPool(const std::weak_ptr<TdtHostMemPool>& pool, void* const ptr, const size_t size)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    const std::shared_ptr<TdtHostMemPool> owner = pool.lock();
+    if (owner == nullptr) {
+        (void)rtFreeHost(ptr);
+        return;
+    }
+    owner->GiveBack(ptr, size);
+}
+
+bool TdtHostMemPool::TakeIdle(const size_t sizeClass, void*& ptr, size_t& bufSize)
+{
+    const std::lock_guard<std::mutex> lk(mutex_);
+    // a cached buffer up to twice the size class is good enough, larger ones are left for larger requests
+    const auto iter = idleMap_.lower_bound(sizeClass);
+    if ((iter == idleMap_.end()) || ((iter->first / 2UL) > sizeClass)) {
+        ++missCount_;
+        return false;
+    }
+    ptr = iter->second->ptr;
+    bufSize = iter->first;
+    (void)lruList_.erase(iter->second);
+    (void)idleMap_.erase(iter);
+    cachedSize_ -= bufSize;
+    inUseSize_ += bufSize;
+    ++hitCount_;
+    return true;
+}
+
+void TdtHostMemPool::GiveBack(void* const ptr, const size_t size)
+{
+    IdleList freeList;
+    {
+        const std::lock_guard<std::mutex> lk(mutex_);
+        inUseSize_ -= size;
+        if (size <= limitSize_) {
+            lruList_.push_front({ptr, size});
+            (void)idleMap_.emplace(size, lruList_.begin());
+            cachedSize_ += size;
+            TrimLocked(limitSize_, freeList);
+        } else {
+            ++trimCount_;
+            freeList.push_back({ptr, size});
+        }
+    }
+    for (const IdleBuf& idleBuf : freeList) {
+        (void)rtFreeHost(idleBuf.ptr);
+    }
+}
+
+void TdtHostMemPool::TrimLocked(const size_t targetSize, IdleList& freeList)
+{
+    while ((cachedSize_ > targetSize) && (!lruList_.empty())) {
+        const IdleList::iterator oldest = std::prev(lruList_.end());
+        auto range = idleMap_.equal_range(oldest->size);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (iter->second == oldest) {
+                (void)idleMap_.erase(iter);
+                break;
+            }
+        }
+        cachedSize_ -= oldest->size;
+        ++trimCount_;
+        freeList.splice(freeList.end(), lruList_, oldest);
+    }
+}
+} // namespace acl
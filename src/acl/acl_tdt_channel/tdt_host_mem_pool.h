@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef ACL_TDT_HOST_MEM_POOL_H
+#define ACL_TDT_HOST_MEM_POOL_H
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "acl/acl_base.h"
+
+namespace acl {
+constexpr size_t TDT_HOST_MEM_POOL_MIN_CLASS = 4UL * 1024UL;
+constexpr size_t TDT_HOST_MEM_POOL_POW2_CLASS_MAX = 1024UL * 1024UL;
+constexpr size_t TDT_HOST_MEM_POOL_DEFAULT_LIMIT = 256UL * 1024UL * 1024UL;
+
+struct TdtHostMemPoolStat {
+    uint64_t hitCount;
+    uint64_t missCount;
+    uint64_t trimCount;
+    size_t cachedSize;
+    size_t inUseSize;
+};
+
+// Pinned host buffers of one channel, cached by size class after use.
+// Idle buffers are kept in LRU order and the least recently released ones are freed once the idle total exceeds
+// the limit, which is TDT_HOST_MEM_POOL_LIMIT (MB) or TDT_HOST_MEM_POOL_DEFAULT_LIMIT, 0 disables the cache.
+class TdtHostMemPool : public std::enable_shared_from_this<TdtHostMemPool> {
+public:
+    static std::shared_ptr<TdtHostMemPool> Create();
+    static size_t GetSizeClass(const size_t size);
+
+    explicit TdtHostMemPool(const size_t limitSize);
+    ~TdtHostMemPool();
+    TdtHostMemPool(const TdtHostMemPool&) = delete;
+    TdtHostMemPool& operator=(const TdtHostMemPool&) = delete;
+
+    // buf goes back to the pool when its last reference is dropped, or is freed if the pool is already gone
+    aclError Acquire(const size_t size, std::shared_ptr<void>& buf, size_t& bufSize);
+    void Trim(const size_t targetSize);
+    void GetStat(TdtHostMemPoolStat& stat);
+
+private:
+    struct IdleBuf {
+        void* ptr;
+        size_t size;
+    };
+    using IdleList = std::list<IdleBuf>;
+
+    static void ReleaseToPool(const std::weak_ptr<TdtHostMemPool>& pool, void* const ptr, const size_t size);
+    bool TakeIdle(const size_t sizeClass, void*& ptr, size_t& bufSize);
+    void GiveBack(void* const ptr, const size_t size);
+    void TrimLocked(const size_t targetSize, IdleList& freeList);
+
+    std::mutex mutex_;
+    IdleList lruList_; // front is the most recently released
+    std::multimap<size_t, IdleList::iterator> idleMap_;
+    size_t limitSize_;
+    size_t cachedSize_ = 0UL;
+    size_t inUseSize_ = 0UL;
+    uint64_t hitCount_ = 0UL;
+    uint64_t missCount_ = 0UL;
+    uint64_t trimCount_ = 0UL;
+};
+} // namespace acl
+#endif // ACL_TDT_HOST_MEM_POOL_H
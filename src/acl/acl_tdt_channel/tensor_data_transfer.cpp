@@ -110,41 +110,49 @@ void* GetFunction(const std::string& func_name)
 namespace acl {
 bool GetTensorShape(const std::string& dimsStr, std::vector<int64_t>& dims)
 {
-    // change "[32,224,224,3]" => "32,224,224,3"
-    // tensor_shape.size() - 2 is the second to last
+    // parse "[32, 224,224,3]" in place, the first and the last character are the brackets
     if (dimsStr.size() < 2) {
         ACL_LOG_INNER_ERROR("[Check][dimsStr]Invalid shape string: %s", dimsStr.c_str());
         return false;
     }
-
-    std::string str = dimsStr.substr(1, dimsStr.size() - 2);
-    if (!str.empty()) {
-        std::string::size_type index = 0;
-        while ((index = str.find(' ', index)) != std::string::npos) {
-            (void)str.erase(index, 1);
-        }
+    const char* cur = dimsStr.data() + 1;
+    const char* const end = dimsStr.data() + dimsStr.size() - 1;
+    while ((cur != end) && (*cur == ' ')) {
+        ++cur;
     }
-    std::string split = ",";
-    std::string::size_type pos2 = str.find(split);
-    std::string::size_type pos1 = 0;
-    while (pos2 != std::string::npos) {
-        try {
-            dims.push_back(std::stoll(str.substr(pos1, pos2 - pos1)));
-        } catch (...) {
-            ACL_LOG_INNER_ERROR("[Check][Shape]Invalid shape string: %s", dimsStr.c_str());
-            return false;
+    while (cur != end) {
+        bool negative = false;
+        if ((*cur == '-') || (*cur == '+')) {
+            negative = (*cur == '-');
+            ++cur;
+        }
+        const char* const digitStart = cur;
+        uint64_t value = 0U;
+        const uint64_t limit = negative ? (static_cast<uint64_t>(INT64_MAX) + 1U) : static_cast<uint64_t>(INT64_MAX);
+        while ((cur != end) && (*cur >= '0') && (*cur <= '9')) {
+            const uint64_t digit = static_cast<uint64_t>(*cur - '0');
+            if (value > (limit - digit) / 10U) {
+                ACL_LOG_INNER_ERROR("[Check][Shape]Dim out of range, shape string: %s", dimsStr.c_str());
+                return false;
+            }
+            value = value * 10U + digit;
+            ++cur;
         }
-        // string::size_type can store the length of any string object
-        pos1 = pos2 + split.size();
-        pos2 = str.find(split, pos1);
-    }
-    if (pos1 != str.length()) {
-        try {
-            dims.push_back(std::stoll(str.substr(pos1)));
-        } catch (...) {
+        const bool noDigit = (cur == digitStart);
+        while ((cur != end) && (*cur == ' ')) {
+            ++cur;
+        }
+        if (noDigit || ((cur != end) && (*cur != ','))) {
             ACL_LOG_INNER_ERROR("[Check][Shape]Invalid shape string: %s", dimsStr.c_str());
             return false;
         }
+        dims.push_back(negative ? static_cast<int64_t>(0U - value) : static_cast<int64_t>(value));
+        if (cur != end) {
+            ++cur;
+            while ((cur != end) && (*cur == ' ')) {
+                ++cur;
+            }
+        }
     }
     return true;
 }
@@ -485,26 +493,25 @@ void GetTensorDimsString(const int64_t* dims, size_t dimNum, std::string& dimsSt
 }
 
 aclError SaveCtrlSharedPtrToVec(
-    const datasetMemType memType, rtMemQueueBuffInfo& qItem, const std::shared_ptr<uint8_t>& ctrlSharedPtr,
-    std::vector<std::shared_ptr<uint8_t>>& ctrlSharedPtrVec)
+    const datasetMemType memType, const size_t ctrlTotalSize, const std::shared_ptr<uint8_t>& ctrlSharedPtr,
+    std::vector<std::shared_ptr<uint8_t>>& ctrlSharedPtrVec, uint8_t*& ctrlBase)
 {
-    void* ctrlPtr = ctrlSharedPtr.get();
     if (memType == MEM_DEVICE) {
-        uint8_t* devPtr = nullptr;
-        std::shared_ptr<uint8_t> ctrlSharedDevPtr;
-        ctrlSharedDevPtr.reset(devPtr, [](void* p) {
+        // all ctrl headers of the dataset are copied to device by one malloc and one memcpy
+        void* devPtr = nullptr;
+        ACL_REQUIRES_RTS_OK_WARN_NOT_SUPPORT(
+            rtMalloc(&devPtr, ctrlTotalSize, RT_MEMORY_DEFAULT, acl::ACL_MODE_ID_U16), rtMalloc);
+        std::shared_ptr<uint8_t> ctrlSharedDevPtr(static_cast<uint8_t*>(devPtr), [](uint8_t* p) {
             if (p != nullptr) {
                 (void)rtFree(p);
             }
         });
         ACL_REQUIRES_RTS_OK_WARN_NOT_SUPPORT(
-            rtMalloc(reinterpret_cast<void**>(&devPtr), qItem.len, RT_MEMORY_DEFAULT, acl::ACL_MODE_ID_U16), rtMalloc);
-        ACL_REQUIRES_RTS_OK_WARN_NOT_SUPPORT(
-            rtMemcpy(devPtr, qItem.len, ctrlPtr, qItem.len, RT_MEMCPY_HOST_TO_DEVICE), rtMemcpy);
-        qItem.addr = devPtr;
+            rtMemcpy(devPtr, ctrlTotalSize, ctrlSharedPtr.get(), ctrlTotalSize, RT_MEMCPY_HOST_TO_DEVICE), rtMemcpy);
+        ctrlBase = static_cast<uint8_t*>(devPtr);
         ctrlSharedPtrVec.push_back(ctrlSharedDevPtr);
     } else {
-        qItem.addr = ctrlPtr;
+        ctrlBase = ctrlSharedPtr.get();
         ctrlSharedPtrVec.push_back(ctrlSharedPtr);
     }
     return ACL_SUCCESS;
@@ -515,6 +522,7 @@ aclError UnpackageRecvDataInfo(uint8_t* outputHostAddr, size_t size, std::vector
     ItemInfo* head = reinterpret_cast<ItemInfo*>(outputHostAddr);
     uint32_t cnt = head->cnt;
     ACL_LOG_INFO("get tensor cnt is %u", cnt);
+    itemVec.reserve(itemVec.size() + cnt);
     size_t offset = 0;
     for (uint32_t i = 0; i < cnt; ++i) {
         if (offset + sizeof(ItemInfo) > size) {
@@ -531,15 +539,20 @@ aclError UnpackageRecvDataInfo(uint8_t* outputHostAddr, size_t size, std::vector
             static_cast<uint32_t>(tmp->sliceNum), static_cast<uint32_t>(tmp->sliceId), tmp->dataLen);
         offset += sizeof(ItemInfo);
 
-        for (uint32_t j = 0; j < tmp->dimNum; ++j) {
-            if (offset + sizeof(int64_t) > size) {
-                ACL_LOG_ERROR("offset is %zu, size is %zu", offset, size);
+        // dims follow the packed header and are not 8 bytes aligned, copy them out in one go
+        const size_t dimsSize = static_cast<size_t>(tmp->dimNum) * sizeof(int64_t);
+        if ((dimsSize > size) || (offset + dimsSize > size)) {
+            ACL_LOG_ERROR("offset is %zu, dim num is %u, size is %zu", offset, tmp->dimNum, size);
+            return ACL_ERROR_FAILURE;
+        }
+        if (dimsSize > 0U) {
+            item.dims.resize(tmp->dimNum);
+            const auto memcpyRet = memcpy_s(item.dims.data(), dimsSize, outputHostAddr + offset, dimsSize);
+            if (memcpyRet != EN_OK) {
+                ACL_LOG_INNER_ERROR("[Call][MemCpy]call memcpy failed, result=%d, size=%zu", memcpyRet, dimsSize);
                 return ACL_ERROR_FAILURE;
             }
-            int64_t dimTmp = *(reinterpret_cast<int64_t*>(outputHostAddr + offset));
-            item.dims.push_back(dimTmp);
-            ACL_LOG_INFO("current dims[%u] is %ld", j, dimTmp);
-            offset += sizeof(int64_t);
+            offset += dimsSize;
         }
 
         if (offset + tmp->dataLen > size) {
@@ -553,68 +566,99 @@ aclError UnpackageRecvDataInfo(uint8_t* outputHostAddr, size_t size, std::vector
             ACL_LOG_INFO("data length is 0");
         }
         ACL_LOG_INFO("after %u tensor, offset is %zu", i + 1, offset);
-        itemVec.push_back(item);
+        itemVec.push_back(std::move(item));
     }
     return ACL_SUCCESS;
 }
 
 aclError TensorDataitemSerialize(
-    std::vector<acl::aclTdtDataItemInfo>& itemVec, const datasetMemType memType,
+    std::vector<acl::aclTdtDataItemInfo>& itemVec, const datasetMemType memType, TdtHostMemPool* const hostMemPool,
     std::vector<rtMemQueueBuffInfo>& qBufVec, std::vector<std::shared_ptr<uint8_t>>& ctrlSharedPtrVec)
 {
-    uint32_t currentCnt = 0;
+    // the ctrl header of every item is written in place into one buffer, each one is enqueued as a slice of it
+    std::vector<size_t> alignedSizeVec(itemVec.size());
+    size_t ctrlTotalSize = 0U;
     size_t lastDataSize = 0U;
     for (size_t i = 0; i < itemVec.size(); ++i) {
-        itemVec[i].ctrlInfo.curCnt = currentCnt;
-        itemVec[i].ctrlInfo.cnt = itemVec.size();
         const size_t ctrlSize = sizeof(ItemInfo) + itemVec[i].dims.size() * sizeof(int64_t);
         // 64n + lastDataSize + 64n - lastDataSize
-        const size_t alignedSize = Get64AlignedSize(ctrlSize + lastDataSize) - lastDataSize;
+        alignedSizeVec[i] = Get64AlignedSize(ctrlSize + lastDataSize) - lastDataSize;
+        ctrlTotalSize += alignedSizeVec[i];
+        // current total size is (64n + lastDataSize)
+        lastDataSize = itemVec[i].ctrlInfo.dataLen;
+    }
+    if (ctrlTotalSize == 0U) {
+        return ACL_SUCCESS;
+    }
+    std::shared_ptr<uint8_t> ctrlSharedPtr;
+    if (hostMemPool != nullptr) {
+        std::shared_ptr<void> poolBuf;
+        size_t poolBufSize = 0U;
+        ACL_REQUIRES_OK(hostMemPool->Acquire(ctrlTotalSize, poolBuf, poolBufSize));
+        ctrlSharedPtr = std::static_pointer_cast<uint8_t>(poolBuf);
+    } else {
+        ctrlSharedPtr.reset(new (std::nothrow) uint8_t[ctrlTotalSize], std::default_delete<uint8_t[]>());
+        ACL_CHECK_MALLOC_RESULT_REPORT_RET(ctrlSharedPtr.get(), ctrlTotalSize, "new", ACL_ERROR_BAD_ALLOC);
+    }
+    uint8_t* const ctrlPtr = ctrlSharedPtr.get();
+
+    size_t ctrlOffset = 0U;
+    for (size_t i = 0; i < itemVec.size(); ++i) {
+        const size_t alignedSize = alignedSizeVec[i];
+        itemVec[i].ctrlInfo.curCnt = static_cast<uint32_t>(i);
+        itemVec[i].ctrlInfo.cnt = itemVec.size();
         itemVec[i].ctrlInfo.dynamicBitSize = alignedSize - sizeof(ItemInfo);
-        std::shared_ptr<uint8_t> ctrlSharedPtr(
-            new (std::nothrow) uint8_t[alignedSize], std::default_delete<uint8_t[]>());
-        ACL_CHECK_MALLOC_RESULT_REPORT_RET(ctrlSharedPtr.get(), alignedSize, "new", ACL_ERROR_BAD_ALLOC);
-        void* ctrlPtr = ctrlSharedPtr.get();
         ACL_LOG_DEBUG(
-            "TensorDataitemSerialize alignedSize is %zu, ctrlSize is %zu, dynamicBitSize is %u, i is %zu,"
-            " lastDataSize is %zu, shape size is %zu",
-            alignedSize, ctrlSize, itemVec[i].ctrlInfo.dynamicBitSize, i, lastDataSize, itemVec[i].dims.size());
-        auto memcpyRet = memcpy_s(ctrlPtr, alignedSize, &itemVec[i].ctrlInfo, sizeof(ItemInfo));
+            "TensorDataitemSerialize alignedSize is %zu, ctrlOffset is %zu, dynamicBitSize is %u, i is %zu,"
+            " shape size is %zu",
+            alignedSize, ctrlOffset, itemVec[i].ctrlInfo.dynamicBitSize, i, itemVec[i].dims.size());
+        auto memcpyRet = memcpy_s(ctrlPtr + ctrlOffset, alignedSize, &itemVec[i].ctrlInfo, sizeof(ItemInfo));
         if (memcpyRet != EN_OK) {
             ACL_LOG_INNER_ERROR(
                 "[Call][MemCpy]call memcpy failed, result=%d, srcLen=%zu, dstLen=%zu", memcpyRet, sizeof(ItemInfo),
                 alignedSize);
+            return ACL_ERROR_FAILURE;
         }
-        size_t offset = sizeof(ItemInfo);
-        for (size_t j = 0; j < itemVec[i].dims.size(); ++j) {
+        const size_t dimsSize = itemVec[i].dims.size() * sizeof(int64_t);
+        if (dimsSize > 0U) {
             memcpyRet = memcpy_s(
-                reinterpret_cast<uint8_t*>(ctrlPtr) + offset, alignedSize - offset, &itemVec[i].dims[j],
-                sizeof(int64_t));
+                ctrlPtr + ctrlOffset + sizeof(ItemInfo), alignedSize - sizeof(ItemInfo), itemVec[i].dims.data(),
+                dimsSize);
             if (memcpyRet != EN_OK) {
                 ACL_LOG_INNER_ERROR(
-                    "[Call][MemCpy]call memcpy failed, result=%d, srcLen=%zu, dstLen=%zu", memcpyRet, sizeof(int64_t),
-                    alignedSize - offset);
+                    "[Call][MemCpy]call memcpy failed, result=%d, srcLen=%zu, dstLen=%zu", memcpyRet, dimsSize,
+                    alignedSize - sizeof(ItemInfo));
+                return ACL_ERROR_FAILURE;
             }
-            offset += sizeof(int64_t);
         }
-        rtMemQueueBuffInfo qItem = {};
-        qItem.len = alignedSize;
-        ACL_REQUIRES_OK(SaveCtrlSharedPtrToVec(memType, qItem, ctrlSharedPtr, ctrlSharedPtrVec));
-        qBufVec.push_back(qItem);
+        ctrlOffset += alignedSize;
+    }
 
+    uint8_t* ctrlBase = nullptr;
+    ACL_REQUIRES_OK(SaveCtrlSharedPtrToVec(memType, ctrlTotalSize, ctrlSharedPtr, ctrlSharedPtrVec, ctrlBase));
+    qBufVec.reserve(qBufVec.size() + (itemVec.size() * 2U));
+    ctrlOffset = 0U;
+    for (size_t i = 0; i < itemVec.size(); ++i) {
+        rtMemQueueBuffInfo qItem = {ctrlBase + ctrlOffset, alignedSizeVec[i]};
+        qBufVec.push_back(qItem);
+        ctrlOffset += alignedSizeVec[i];
         if (itemVec[i].ctrlInfo.dataLen > 0U) {
             rtMemQueueBuffInfo tmpQItem = {itemVec[i].dataPtr.get(), itemVec[i].ctrlInfo.dataLen};
             qBufVec.push_back(tmpQItem);
         } else {
             ACL_LOG_DEBUG("no need to insert data buf");
         }
-        // current total size is (64n + lastDataSize)
-        lastDataSize = itemVec[i].ctrlInfo.dataLen;
-        ++currentCnt;
     }
     return ACL_SUCCESS;
 }
 
+aclError TensorDataitemSerialize(
+    std::vector<acl::aclTdtDataItemInfo>& itemVec, const datasetMemType memType,
+    std::vector<rtMemQueueBuffInfo>& qBufVec, std::vector<std::shared_ptr<uint8_t>>& ctrlSharedPtrVec)
+{
+    return TensorDataitemSerialize(itemVec, memType, nullptr, qBufVec, ctrlSharedPtrVec);
+}
+
 aclError acltdtSendTensorV2(const acltdtChannelHandle* handle, const acltdtDataset* dataset, int32_t timeout)
 {
     ACL_REQUIRES_NOT_NULL_WITH_INPUT_REPORT(handle);
@@ -629,7 +673,8 @@ aclError acltdtSendTensorV2(const acltdtChannelHandle* handle, const acltdtDatas
     }
     std::vector<std::shared_ptr<uint8_t>> ctrlSharedPtrVec;
     std::vector<rtMemQueueBuffInfo> queueBufInfoVec;
-    ret = acl::TensorDataitemSerialize(itemVec, dataset->memType, queueBufInfoVec, ctrlSharedPtrVec);
+    ret = acl::TensorDataitemSerialize(
+        itemVec, dataset->memType, handle->hostMemPool_.get(), queueBufInfoVec, ctrlSharedPtrVec);
     if (ret != ACL_SUCCESS) {
         ACL_LOG_INNER_ERROR(
             "[Serialize][Dataset]Failed to TensorDataitemSerialize, device is %u, name is %s.", handle->devId,
@@ -687,11 +732,26 @@ static size_t GetMallocSize(const size_t bufLen)
     return bufLen;
 }
 
+static aclError AcquireHostMemFromPool(TdtHostMemPool& hostMemPool, acltdtDataset* dataset, size_t bufLen)
+{
+    // give the smaller buffer back to the pool before taking a larger one
+    dataset->sharedMem_.reset();
+    dataset->sharedMemSize_ = 0U;
+    std::shared_ptr<void> poolBuf;
+    size_t poolBufSize = 0U;
+    ACL_REQUIRES_OK(hostMemPool.Acquire(bufLen, poolBuf, poolBufSize));
+    dataset->sharedMem_ = poolBuf;
+    dataset->sharedMemSize_ = poolBufSize;
+    return ACL_SUCCESS;
+}
+
 aclError GetOrMallocHostMem(const acltdtChannelHandle* handle, acltdtDataset* dataset, size_t bufLen, void*& hostPtr)
 {
     ACL_LOG_INFO("current need size is %zu, current mem size is %zu", bufLen, dataset->sharedMemSize_);
     ACL_REQUIRES_OK(EnsureCurrentThreadHasContext(handle));
-    if (bufLen > dataset->sharedMemSize_) {
+    if ((bufLen > dataset->sharedMemSize_) && (handle->hostMemPool_ != nullptr)) {
+        ACL_REQUIRES_OK(AcquireHostMemFromPool(*handle->hostMemPool_, dataset, bufLen));
+    } else if (bufLen > dataset->sharedMemSize_) {
         const size_t mallocSize = GetMallocSize(bufLen);
         ACL_LOG_INFO("need mallochost size %zu, bufLen is %zu", mallocSize, bufLen);
         void* outHostAddr = nullptr;
@@ -1091,6 +1151,8 @@ acltdtChannelHandle* acltdtCreateChannelWithCapacity(uint32_t deviceId, const ch
         ACL_DELETE_AND_SET_NULL(handle);
         return nullptr;
     }
+    // without the pool send and receive fall back to allocating host memory every time
+    handle->hostMemPool_ = acl::TdtHostMemPool::Create();
     ACL_LOG_INFO(
         "acltdtCreateChannelWithCapacity devId is %u, name is %s, real name is %s, qid is %u", deviceId,
         handle->name.c_str(), name, handle->qid);
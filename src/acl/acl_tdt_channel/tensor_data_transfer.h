@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "acl/acl_tdt.h"
+#include "tdt_host_mem_pool.h"
 
 enum datasetMemType { MEM_UNKNOWN = 0, MEM_HOST, MEM_DEVICE };
 
@@ -92,6 +93,8 @@ struct acltdtChannelHandle {
     uint32_t qid;
     bool isTdtProcess;
     std::shared_ptr<void> ctx_;
+    // pinned host buffers reused by acltdtSendTensor and acltdtReceiveTensor in queue process
+    std::shared_ptr<acl::TdtHostMemPool> hostMemPool_;
 };
 
 namespace acl {
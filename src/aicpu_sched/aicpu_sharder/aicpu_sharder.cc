@@ -12,6 +12,7 @@
 
 #include <atomic>
 #include <semaphore.h>
+#include <sched.h>
 #include <unistd.h>
 #ifndef _AOSCORE_
 #include <error.h>
@@ -25,6 +26,191 @@
 
 namespace aicpu {
 constexpr uint32_t GET_EVENT_LIMITED_NUM = 1000U;
+constexpr uint32_t PARALLEL_FOR_MAX_SLOT_NUM = 32U;
+constexpr uint32_t PARALLEL_FOR_SPIN_NUM = 64U;
+constexpr uint32_t RANGE_END_SHIFT = 32U;
+constexpr uint64_t RANGE_BEGIN_MASK = 0xFFFFFFFFULL;
+constexpr uint32_t PARALLEL_FOR_TICKET_NUM = 1024U;
+constexpr uint32_t TICKET_OWNER_SHIFT = 32U;
+constexpr uint64_t TICKET_OPEN_FLAG = 0x80000000ULL;
+constexpr uint64_t TICKET_ACTIVE_MASK = 0x7FFFFFFFULL;
+
+namespace {
+// Block range [begin, end) of one participant, begin in low 32 bits and end in high 32 bits.
+// The owner pops blocks from the front, others steal half of the remaining blocks from the back.
+struct alignas(64) ParallelForSlot {
+    std::atomic<uint64_t> range{0U};
+};
+
+struct ParallelForJob {
+    ParallelForJob(
+        const SharderWork& jobWork, const int64_t jobTotal, const int64_t jobBlockSize, const uint32_t jobParallelId,
+        const uint32_t jobSlotNum, const int64_t helperNum)
+        : work(jobWork),
+          total(jobTotal),
+          blockSize(jobBlockSize),
+          parallelId(jobParallelId),
+          slotNum(jobSlotNum),
+          unstartedHelperNum(helperNum)
+    {}
+
+    const SharderWork& work;
+    const int64_t total;
+    const int64_t blockSize;
+    const uint32_t parallelId;
+    const uint32_t slotNum;
+    std::atomic<uint32_t> nextSlot{1U}; // slot 0 belongs to the calling thread
+    std::atomic<uint32_t> doneBlockNum{0U};
+    std::atomic<int64_t> unstartedHelperNum;
+    ParallelForSlot slots[PARALLEL_FOR_MAX_SLOT_NUM];
+};
+
+// Helpers reach the job on the caller's stack only through a ticket, state holds the owner parallelId in the
+// high 32 bits, an open flag and the number of helpers inside the job. The caller closes the ticket and waits
+// for helpers inside before return, so a helper the scheduler still runs after a failed submit leaves at once.
+struct alignas(64) ParallelForTicket {
+    std::atomic<uint64_t> state{0U};
+    std::atomic<ParallelForJob*> job{nullptr};
+};
+
+ParallelForTicket g_parallelForTickets[PARALLEL_FOR_TICKET_NUM];
+
+inline uint64_t PackRange(const uint32_t begin, const uint32_t end)
+{
+    return (static_cast<uint64_t>(end) << RANGE_END_SHIFT) | static_cast<uint64_t>(begin);
+}
+
+inline uint32_t RangeBegin(const uint64_t range) { return static_cast<uint32_t>(range & RANGE_BEGIN_MASK); }
+
+inline uint32_t RangeEnd(const uint64_t range) { return static_cast<uint32_t>(range >> RANGE_END_SHIFT); }
+
+bool PopFrontBlock(ParallelForSlot& slot, uint32_t& block)
+{
+    uint64_t range = slot.range.load(std::memory_order_acquire);
+    while (RangeBegin(range) < RangeEnd(range)) {
+        if (slot.range.compare_exchange_weak(
+                range, PackRange(RangeBegin(range) + 1U, RangeEnd(range)), std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            block = RangeBegin(range);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StealBackBlocks(ParallelForSlot& victim, uint32_t& begin, uint32_t& end)
+{
+    uint64_t range = victim.range.load(std::memory_order_acquire);
+    while (RangeBegin(range) < RangeEnd(range)) {
+        const uint32_t stealNum = (RangeEnd(range) - RangeBegin(range) + 1U) / 2U;
+        const uint32_t newEnd = RangeEnd(range) - stealNum;
+        if (victim.range.compare_exchange_weak(
+                range, PackRange(RangeBegin(range), newEnd), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            begin = newEnd;
+            end = RangeEnd(range);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RunParallelForBlock(ParallelForJob& job, const uint32_t block)
+{
+    const int64_t start = static_cast<int64_t>(block) * job.blockSize;
+    const int64_t limit = std::min(start + job.blockSize, job.total);
+    // In order to ensure that user's work function exception does not affect multithread services,
+    // exception capture is needed. Exception type is not cared here, and error log is printed.
+    try {
+        job.work(start, limit);
+    } catch (std::exception& e) {
+        AICPUE_LOGE(
+            "Exception occurred in work func. parallelId=%u, taskIndex=%u, exception=%s", job.parallelId, block,
+            e.what());
+    }
+    (void)job.doneBlockNum.fetch_add(1U, std::memory_order_relaxed);
+}
+
+void RunParallelForSlot(ParallelForJob& job, const uint32_t slotIdx)
+{
+    ParallelForSlot& own = job.slots[slotIdx];
+    uint32_t block = 0U;
+    bool stolen = true;
+    while (stolen) {
+        while (PopFrontBlock(own, block)) {
+            RunParallelForBlock(job, block);
+        }
+        // own slot is empty, nobody else writes it, so stolen blocks are published there for others to steal
+        stolen = false;
+        for (uint32_t i = 1U; (i < job.slotNum) && (!stolen); ++i) {
+            uint32_t begin = 0U;
+            uint32_t end = 0U;
+            if (StealBackBlocks(job.slots[(slotIdx + i) % job.slotNum], begin, end)) {
+                own.range.store(PackRange(begin + 1U, end), std::memory_order_release);
+                RunParallelForBlock(job, begin);
+                stolen = true;
+            }
+        }
+    }
+}
+
+void RunParallelForHelper(ParallelForTicket& ticket, const uint32_t parallelId)
+{
+    uint64_t state = ticket.state.load(std::memory_order_acquire);
+    do {
+        if (((state & TICKET_OPEN_FLAG) == 0U) || ((state >> TICKET_OWNER_SHIFT) != parallelId)) {
+            AICPUE_LOGI("Parallel for has finished, skip helper. parallelId=%u", parallelId);
+            return;
+        }
+    } while (!ticket.state.compare_exchange_weak(
+        state, state + 1U, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    ParallelForJob& job = *ticket.job.load(std::memory_order_relaxed);
+    (void)job.unstartedHelperNum.fetch_sub(1, std::memory_order_relaxed);
+    const uint32_t slotIdx = job.nextSlot.fetch_add(1U, std::memory_order_relaxed);
+    AICPUE_LOGI("Start call work func. parallelId=%u, slotIdx=%u", job.parallelId, slotIdx);
+    if (slotIdx < job.slotNum) {
+        RunParallelForSlot(job, slotIdx);
+    }
+    AICPUE_LOGI("End call work func. parallelId=%u, slotIdx=%u", job.parallelId, slotIdx);
+    (void)ticket.state.fetch_sub(1U, std::memory_order_release);
+}
+
+void WaitParallelForTicketIdle(const ParallelForTicket& ticket, const uint64_t busyMask)
+{
+    uint32_t spinCnt = 0U;
+    while ((ticket.state.load(std::memory_order_acquire) & busyMask) != 0U) {
+        if (++spinCnt >= PARALLEL_FOR_SPIN_NUM) {
+            spinCnt = 0U;
+            (void)sched_yield();
+        }
+    }
+}
+
+ParallelForTicket& OpenParallelForTicket(ParallelForJob& job)
+{
+    ParallelForTicket& ticket = g_parallelForTickets[job.parallelId % PARALLEL_FOR_TICKET_NUM];
+    // the slot is busy only if another parallel for with the same slot is still running
+    uint64_t state = ticket.state.load(std::memory_order_acquire);
+    do {
+        if ((state & (TICKET_OPEN_FLAG | TICKET_ACTIVE_MASK)) != 0U) {
+            WaitParallelForTicketIdle(ticket, TICKET_OPEN_FLAG | TICKET_ACTIVE_MASK);
+            state = ticket.state.load(std::memory_order_acquire);
+            continue;
+        }
+        ticket.job.store(&job, std::memory_order_relaxed);
+    } while (!ticket.state.compare_exchange_weak(
+        state, (static_cast<uint64_t>(job.parallelId) << TICKET_OWNER_SHIFT) | TICKET_OPEN_FLAG,
+        std::memory_order_acq_rel, std::memory_order_acquire));
+    return ticket;
+}
+
+// no helper enters the job after close, helpers inside may still run stolen blocks and are waited for
+void CloseParallelForTicket(ParallelForTicket& ticket)
+{
+    (void)ticket.state.fetch_and(~TICKET_OPEN_FLAG, std::memory_order_acq_rel);
+    WaitParallelForTicketIdle(ticket, TICKET_ACTIVE_MASK);
+}
+} // namespace
 
 SharderNonBlock::SharderNonBlock()
     : cpuCoreNum_(0U),
@@ -127,71 +313,42 @@ void SharderNonBlock::ExecuteParallelFor(
     const int64_t total, const int64_t shardNum, const int64_t blockSize, const SharderWork& work,
     const uint32_t parallelId)
 {
+    // every participant owns a slot, so the helper number is limited by cpu core number and slot number
+    const uint32_t slotNum = static_cast<uint32_t>(
+        std::min({shardNum, static_cast<int64_t>(cpuCoreNum_), static_cast<int64_t>(PARALLEL_FOR_MAX_SLOT_NUM)}));
+    const int64_t helperNum = static_cast<int64_t>(slotNum) - 1;
     AICPUE_LOGI(
-        "Op parallel process start. parallelId=%u, shardNum=%ld, blockSize=%ld", parallelId, shardNum, blockSize);
-
-    std::atomic<int64_t> cpuNumCounter(shardNum);
-    sem_t aicpuSem;
-    const int32_t semInitRet = sem_init(&aicpuSem, 0, 0U);
-    if (semInitRet == -1) {
-        AICPUE_LOGE("sem_init error with message: %s", strerror(errno));
-        work(0, total);
-        return;
+        "Op parallel process start. parallelId=%u, shardNum=%ld, blockSize=%ld, helperNum=%ld", parallelId, shardNum,
+        blockSize, helperNum);
+
+    ParallelForJob job(work, total, blockSize, parallelId, slotNum, helperNum);
+    const uint32_t blockNum = static_cast<uint32_t>(shardNum);
+    for (uint32_t i = 0U; i < slotNum; ++i) {
+        const uint32_t begin = static_cast<uint32_t>((static_cast<uint64_t>(blockNum) * i) / slotNum);
+        const uint32_t end = static_cast<uint32_t>((static_cast<uint64_t>(blockNum) * (i + 1U)) / slotNum);
+        job.slots[i].range.store(PackRange(begin, end), std::memory_order_relaxed);
     }
 
-    uint32_t taskIndex = 0U;
+    // helpers only carry the ticket pointer and parallelId, which fit in Closure without allocation
+    ParallelForTicket* const ticket = &OpenParallelForTicket(job);
     std::queue<aicpu::Closure> taskQueue;
-    for (int64_t start = 0; start < total; start += blockSize) {
-        const auto limit = std::min(start + blockSize, total);
-        const Closure aicpuClosure = [&aicpuSem, &work, &cpuNumCounter, start, limit, parallelId, shardNum,
-                                      taskIndex]() {
-            cpuNumCounter--;
-            // In order to ensure that user's work function exception does not affect multithread services,
-            // exception capture is needed. Exception type is not cared here, and error log is printed.
-            AICPUE_LOGI(
-                "Start call work func. parallelId=%u, shardNum=%ld, taskIndex=%u", parallelId, shardNum, taskIndex);
-            try {
-                work(start, limit);
-            } catch (std::exception& e) {
-                AICPUE_LOGE(
-                    "Exception occurred in work func. parallelId=%u, shardNum=%ld, taskIndex=%u, "
-                    "exception=%s",
-                    parallelId, shardNum, taskIndex, e.what());
-            }
-
-            const int32_t semPostRet = sem_post(&aicpuSem);
-            if (semPostRet == -1) {
-                AICPUE_LOGE("sem_post error with message: %s", strerror(errno));
-            }
-            AICPUE_LOGI(
-                "End call work func. parallelId=%u, shardNum=%ld, taskIndex=%u", parallelId, shardNum, taskIndex);
-        };
-
-        taskQueue.push(aicpuClosure);
-        ++taskIndex;
+    for (int64_t i = 0; i < helperNum; ++i) {
+        taskQueue.push([ticket, parallelId]() { RunParallelForHelper(*ticket, parallelId); });
     }
-
-    const uint32_t ret = splitKernelScheduler_(parallelId, shardNum, taskQueue);
+    const uint32_t ret = splitKernelScheduler_(parallelId, helperNum, taskQueue);
     if (ret != 0U) {
-        AICPUE_LOGE("Submit split kernel task failed, ret=%u, parallelId=%u", ret, parallelId);
-        (void)sem_destroy(&aicpuSem);
-        return;
+        // some helpers may have been submitted before the failure, they are not waited for unless they start
+        AICPUE_LOGE("Submit split kernel task failed, do it by self. ret=%u, parallelId=%u", ret, parallelId);
+        job.unstartedHelperNum.store(0, std::memory_order_relaxed);
     }
 
-    DoTaskItself(parallelId, cpuNumCounter, shardNum);
-
-    for (int64_t i = 0; i < shardNum; ++i) {
-        const int32_t semWaitRet = sem_wait(&aicpuSem);
-        if (semWaitRet == -1) {
-            AICPUE_LOGE("sem_wait error with message: %s", strerror(errno));
-        }
-    }
-    const int32_t semDesRet = sem_destroy(&aicpuSem);
-    if (semDesRet == -1) {
-        AICPUE_LOGE("sem_destroy error with message: %s", strerror(errno));
-    }
+    RunParallelForSlot(job, 0U);
+    DoTaskItself(parallelId, job.unstartedHelperNum, helperNum);
+    CloseParallelForTicket(*ticket);
 
-    AICPUE_LOGI("Op parallel process finished. parallelId=%u", parallelId);
+    AICPUE_LOGI(
+        "Op parallel process finished. parallelId=%u, doneBlockNum=%u", parallelId,
+        job.doneBlockNum.load(std::memory_order_relaxed));
 
     return;
 }
@@ -99,7 +99,8 @@ private:
     inline int64_t CeilMultiple(const int64_t x, const int64_t base) const;
 
     /**
-     * Shards the "total" unit of work refer "perUintSize"
+     * Shards the "total" unit of work refer "perUintSize", blocks are spread over per-thread ranges,
+     * idle threads steal half of others' remaining blocks, the caller joins by spinning on helper counter
      * @param total Total unit of work
      * @param shardNum parralle number
      * @param blockSize Minimum shard unit
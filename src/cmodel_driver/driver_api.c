@@ -11,6 +11,7 @@
 #include "driver_queue.h"
 #include "driver_mem.h"
 #include "driver_impl.h"
+#include "driver_sim.h"
 #define RUN_MODE_ONLINE (1)
 #define HANDLE_VALUE (2)
 #define PAGE_SIZE_4K (0x1000)
@@ -241,6 +242,9 @@ drvError_t halSqMemGet(uint32_t devId, struct halSqMemGetInput* in, struct halSq
             break;
         case DRV_NORMAL_TYPE:
             deviceId = DEVICE_HANDLE_TO_ID(devId);
+            if (drvSimIsEnabled() == DRV_TRUE) {
+                return drvSimSqMemGet(deviceId, in, out);
+            }
             COND_RETURN_CMODEL(deviceId >= MAX_DEV_NUM, DRV_ERROR_INVALID_VALUE, "invalid device %u", deviceId);
 
             queue = &(g_drvQosQueue[deviceId][qos]);
@@ -275,7 +279,9 @@ drvError_t halSqMsgSend(uint32_t devId, struct halSqMsgInfo* info)
             UNUSED(devId);
             break;
         case DRV_NORMAL_TYPE:
-            UNUSED(info);
+            if (drvSimIsEnabled() == DRV_TRUE) {
+                return drvSimSqMsgSend(devId, info);
+            }
             int32_t deviceId = (int32_t)devId;
             int8_t qos = 0;
             int32_t qid;
@@ -310,7 +316,7 @@ drvError_t halSqMsgSend(uint32_t devId, struct halSqMsgInfo* info)
 
 void drvDfxShowReport(uint32_t devId)
 {
-    UNUSED(devId);
+    drvSimShowStat(devId);
     return;
 }
 
@@ -515,7 +521,9 @@ drvError_t halSqCqFree(uint32_t devId, struct halSqCqFreeInfo* info)
             ret = __drvIdFree((int32_t)(info->sqId), devId, (int32_t)DRV_RES_SQCQ);
             break;
         case DRV_NORMAL_TYPE:
-            UNUSED(devId);
+            if (drvSimIsEnabled() == DRV_TRUE) {
+                drvSimSqFree(devId, info->sqId);
+            }
             break;
         default:
             DRVSTUB_LOG("[ERROR] invalid type:%u", (uint32_t)info->type);
@@ -538,9 +546,10 @@ drvError_t halCqReportIrqWait(uint32_t devId, struct halReportInfoInput* in, str
             UNUSED(devId);
             break;
         case DRV_NORMAL_TYPE:
-            UNUSED(devId);
-            UNUSED(in);
             UNUSED(out);
+            if (drvSimIsEnabled() == DRV_TRUE) {
+                ret = drvSimCqReportWait(devId, in->timeout);
+            }
             break;
         default:
             DRVSTUB_LOG("[ERROR] invalid type:%u", (uint32_t)in->type);
@@ -570,6 +579,9 @@ drvError_t halCqReportGet(uint32_t devId, struct halReportGetInput* in, struct h
             out->reportPtr = (void*)&g_ModelCqReport;
             break;
         case DRV_NORMAL_TYPE:
+            if (drvSimIsEnabled() == DRV_TRUE) {
+                return drvSimCqReportGet(devId, out);
+            }
 
             out->count = 1;
             deviceId = devId;
@@ -601,7 +613,9 @@ drvError_t halReportRelease(uint32_t devId, struct halReportReleaseInfo* info)
             UNUSED(devId);
             break;
         case DRV_NORMAL_TYPE:
-            UNUSED(devId);
+            if (drvSimIsEnabled() == DRV_TRUE) {
+                ret = drvSimReportRelease(devId, info->count);
+            }
             break;
         default:
             DRVSTUB_LOG("[ERROR] invalid type:%u", (uint32_t)info->type);
@@ -21,6 +21,7 @@
 #include "driver_queue.h"
 #include "driver_mem.h"
 #include "driver_impl.h"
+#include "driver_sim.h"
 
 #include "mmpa/mmpa_api.h"
 
@@ -142,6 +143,7 @@ drvError_t drvDriverStubInit(void)
         (void)drvSqCqIDListInit();
         (void)drvQueueInit();
         (void)drvMemMgmtInit();
+        (void)drvSimInit();
 #ifndef __DRV_CFG_DEV_PLATFORM_ESL__
         // interface for decoupling,because tsch depends on runtime while st
         tsRegDrvReportIrqTriger(drvReportIrqTrigger);
@@ -169,6 +171,7 @@ drvError_t drvDriverStubInit(void)
 drvError_t drvDriverStubExit(void)
 {
     if (drvInitCheck(0) == CMODEL_DRI_STARTED) {
+        drvSimExit();
         stop_task_scheduler();
         stopModel();
     }
@@ -0,0 +1,483 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "driver_sim.h"
+
+#define DRV_SIM_NS_PER_US (1000ULL)
+#define DRV_SIM_NS_PER_MS (1000000ULL)
+#define DRV_SIM_NS_PER_SEC (1000000000ULL)
+#define DRV_SIM_MAX_CMD_COUNT (DRV_SIM_SQ_DEPTH / 2U)
+/* offset of streamID, taskID and taskInfoFlag in the 64 byte ts command */
+#define DRV_SIM_SQE_STREAM_ID_OFFSET (0U)
+#define DRV_SIM_SQE_TASK_ID_OFFSET (2U)
+#define DRV_SIM_SQE_INFO_FLAG_OFFSET (13U)
+#define DRV_SIM_SQE_NO_SEND_CQ (0x1U)
+#define DRV_SIM_STREAM_ID_LOW_BITS (10U)
+#define DRV_SIM_STREAM_ID_LOW_MASK (0x3FFU)
+#define DRV_SIM_LN2 (0.69314718055994531)
+#define DRV_SIM_DOUBLE_EXP_SHIFT (52U)
+#define DRV_SIM_DOUBLE_EXP_MASK (0x7FFULL)
+#define DRV_SIM_DOUBLE_EXP_BIAS (1023)
+
+typedef struct tagDrvSimConfig {
+    drvSimLatencyDist_t dist;
+    uint64_t latencyNs;
+    uint64_t jitterNs;
+    uint32_t cqBatch;
+} drvSimConfig_t;
+
+static drvBool_t g_drvSimEnable = DRV_FALSE;
+static drvSimConfig_t g_drvSimCfg;
+static drvSimDevice_t g_drvSimDevice[MAX_DEV_NUM];
+
+static uint64_t drvSimNowNs(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * DRV_SIM_NS_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+static void drvSimNsToTimespec(uint64_t ns, struct timespec* ts)
+{
+    ts->tv_sec = (time_t)(ns / DRV_SIM_NS_PER_SEC);
+    ts->tv_nsec = (long)(ns % DRV_SIM_NS_PER_SEC);
+}
+
+static uint64_t drvSimGetEnvU64(const char* name, uint64_t defaultValue)
+{
+    const char* value = getenv(name);
+    if ((value == NULL) || (value[0] == '\0')) {
+        return defaultValue;
+    }
+    char* end = NULL;
+    const unsigned long long result = strtoull(value, &end, 10);
+    COND_RETURN_CMODEL((end == NULL) || (*end != '\0'), defaultValue, "invalid %s=%s, use %llu", name, value,
+        (unsigned long long)defaultValue);
+    return (uint64_t)result;
+}
+
+static void drvSimLoadConfig(void)
+{
+    const char* dist = getenv("CMODEL_DRV_SIM_LATENCY_DIST");
+    g_drvSimCfg.dist = DRV_SIM_LATENCY_FIXED;
+    if (dist != NULL) {
+        if (strcmp(dist, "uniform") == 0) {
+            g_drvSimCfg.dist = DRV_SIM_LATENCY_UNIFORM;
+        } else if (strcmp(dist, "exp") == 0) {
+            g_drvSimCfg.dist = DRV_SIM_LATENCY_EXP;
+        }
+    }
+    g_drvSimCfg.latencyNs =
+        drvSimGetEnvU64("CMODEL_DRV_SIM_LATENCY_US", DRV_SIM_DEFAULT_LATENCY_US) * DRV_SIM_NS_PER_US;
+    g_drvSimCfg.jitterNs = drvSimGetEnvU64("CMODEL_DRV_SIM_JITTER_US", 0ULL) * DRV_SIM_NS_PER_US;
+    g_drvSimCfg.cqBatch = (uint32_t)drvSimGetEnvU64("CMODEL_DRV_SIM_CQ_BATCH", DRV_SIM_DEFAULT_CQ_BATCH);
+    if ((g_drvSimCfg.cqBatch == 0U) || (g_drvSimCfg.cqBatch > DRV_SIM_CQ_DEPTH)) {
+        g_drvSimCfg.cqBatch = DRV_SIM_DEFAULT_CQ_BATCH;
+    }
+}
+
+/* natural log of a positive normal x, precise enough for sampling and does not need libm */
+static double drvSimLn(double x)
+{
+    uint64_t bits;
+    (void)memcpy_s(&bits, sizeof(bits), &x, sizeof(x));
+    const int32_t e = (int32_t)((bits >> DRV_SIM_DOUBLE_EXP_SHIFT) & DRV_SIM_DOUBLE_EXP_MASK) - DRV_SIM_DOUBLE_EXP_BIAS;
+    bits = (bits & ~(DRV_SIM_DOUBLE_EXP_MASK << DRV_SIM_DOUBLE_EXP_SHIFT)) |
+           ((uint64_t)DRV_SIM_DOUBLE_EXP_BIAS << DRV_SIM_DOUBLE_EXP_SHIFT);
+    double m;
+    (void)memcpy_s(&m, sizeof(m), &bits, sizeof(bits));
+    /* m is in [1, 2), ln(m) = 2 * atanh(t) with t in [0, 1/3) */
+    const double t = (m - 1.0) / (m + 1.0);
+    const double t2 = t * t;
+    const double lnM = 2.0 * t * (1.0 + t2 * (1.0 / 3.0 + t2 * (1.0 / 5.0 + t2 * (1.0 / 7.0 + t2 * (1.0 / 9.0)))));
+    return ((double)e * DRV_SIM_LN2) + lnM;
+}
+
+/* called with dev->mutex held */
+static uint64_t drvSimSampleLatency(drvSimDevice_t* dev)
+{
+    const uint64_t mean = g_drvSimCfg.latencyNs;
+    const uint64_t jitter = g_drvSimCfg.jitterNs;
+    /* u is in (0, 1) */
+    const double u = ((double)rand_r(&dev->seed) + 1.0) / ((double)RAND_MAX + 2.0);
+    uint64_t low;
+
+    switch (g_drvSimCfg.dist) {
+        case DRV_SIM_LATENCY_UNIFORM:
+            low = (mean > jitter) ? (mean - jitter) : 0ULL;
+            return low + (uint64_t)(u * (double)(mean + jitter - low));
+        case DRV_SIM_LATENCY_EXP:
+            /* jitter is the minimum latency, the tail above it is exponential */
+            low = (mean > jitter) ? jitter : mean;
+            return low + (uint64_t)(-drvSimLn(u) * (double)(mean - low));
+        default:
+            return mean;
+    }
+}
+
+/* called with dev->mutex held */
+static void drvSimFlushReport(drvSimDevice_t* dev)
+{
+    drvSimCq_t* cq = &dev->cq;
+    if (cq->pendingTail == cq->tail) {
+        return;
+    }
+    cq->tail = cq->pendingTail;
+    dev->stat.batchCount++;
+    (void)pthread_cond_broadcast(&dev->cqCond);
+}
+
+/* called with dev->mutex held */
+static drvError_t drvSimPostReport(drvSimDevice_t* dev, uint32_t sqId, const drvSimSq_t* sq, uint32_t slot)
+{
+    drvSimCq_t* cq = &dev->cq;
+    const uint8_t* sqe = sq->cmd[slot].dummy;
+    if ((sqe[DRV_SIM_SQE_INFO_FLAG_OFFSET] & DRV_SIM_SQE_NO_SEND_CQ) != 0U) {
+        return DRV_ERROR_NONE;
+    }
+    if ((cq->pendingTail - cq->head) >= DRV_SIM_CQ_DEPTH) {
+        dev->stat.cqFullCount++;
+        return DRV_ERROR_INNER_ERR;
+    }
+
+    uint16_t streamId;
+    uint16_t taskId;
+    (void)memcpy_s(&streamId, sizeof(streamId), &sqe[DRV_SIM_SQE_STREAM_ID_OFFSET], sizeof(streamId));
+    (void)memcpy_s(&taskId, sizeof(taskId), &sqe[DRV_SIM_SQE_TASK_ID_OFFSET], sizeof(taskId));
+
+    drvSimReport_t* report = &cq->report[cq->pendingTail % DRV_SIM_CQ_DEPTH];
+    (void)memset_s(report, sizeof(drvSimReport_t), 0, sizeof(drvSimReport_t));
+    report->SOP = 1U;
+    report->EOP = 1U;
+    report->streamId = (uint16_t)(streamId & DRV_SIM_STREAM_ID_LOW_MASK);
+    report->streamIdEx = (uint16_t)((streamId >> DRV_SIM_STREAM_ID_LOW_BITS) & 0x1U);
+    report->taskId = taskId;
+    report->sqId = (uint16_t)sqId;
+    report->sqHead = (uint16_t)((sq->head + 1U) % DRV_SIM_SQ_DEPTH);
+    cq->pendingTail++;
+    dev->stat.cqeCount++;
+    if ((cq->pendingTail - cq->tail) >= g_drvSimCfg.cqBatch) {
+        drvSimFlushReport(dev);
+    }
+    return DRV_ERROR_NONE;
+}
+
+/*
+ * complete every sqe due before nowNs, in order within each sq.
+ * return DRV_TRUE if the device has to stop because the cq is full.
+ * called with dev->mutex held
+ */
+static drvBool_t drvSimComplete(drvSimDevice_t* dev, uint64_t nowNs, uint64_t* nextDueNs)
+{
+    drvBool_t cqFull = DRV_FALSE;
+    uint32_t sqId;
+
+    for (sqId = 0U; (sqId < MAX_SQCQ_NUM) && (cqFull == DRV_FALSE); sqId++) {
+        drvSimSq_t* sq = dev->sq[sqId];
+        if (sq == NULL) {
+            continue;
+        }
+        while (sq->head != sq->sendTail) {
+            const uint32_t slot = sq->head % DRV_SIM_SQ_DEPTH;
+            if (sq->isPad[slot] == 0U) {
+                if (sq->dueNs[slot] > nowNs) {
+                    *nextDueNs = (sq->dueNs[slot] < *nextDueNs) ? sq->dueNs[slot] : *nextDueNs;
+                    break;
+                }
+                if (drvSimPostReport(dev, sqId, sq, slot) != DRV_ERROR_NONE) {
+                    cqFull = DRV_TRUE;
+                    break;
+                }
+                dev->stat.sqeCount++;
+            }
+            sq->head++;
+        }
+    }
+    drvSimFlushReport(dev);
+    return cqFull;
+}
+
+static void* drvSimDeviceRun(void* arg)
+{
+    drvSimDevice_t* dev = (drvSimDevice_t*)arg;
+    struct timespec ts;
+
+    (void)pthread_mutex_lock(&dev->mutex);
+    while (dev->runFlag != 0) {
+        uint64_t nextDueNs = UINT64_MAX;
+        const drvBool_t cqFull = drvSimComplete(dev, drvSimNowNs(), &nextDueNs);
+        if ((cqFull == DRV_TRUE) || (nextDueNs == UINT64_MAX)) {
+            /* woken up by halSqMsgSend or halReportRelease */
+            (void)pthread_cond_wait(&dev->sqCond, &dev->mutex);
+        } else {
+            drvSimNsToTimespec(nextDueNs, &ts);
+            (void)pthread_cond_timedwait(&dev->sqCond, &dev->mutex, &ts);
+        }
+    }
+    (void)pthread_mutex_unlock(&dev->mutex);
+    return NULL;
+}
+
+static void drvSimDeviceDestroy(drvSimDevice_t* dev)
+{
+    (void)pthread_cond_destroy(&dev->sqCond);
+    (void)pthread_cond_destroy(&dev->cqCond);
+    (void)pthread_mutex_destroy(&dev->mutex);
+}
+
+static drvError_t drvSimDeviceInit(drvSimDevice_t* dev, uint32_t devId)
+{
+    pthread_condattr_t attr;
+
+    errno_t ret = memset_s(dev, sizeof(drvSimDevice_t), 0, sizeof(drvSimDevice_t));
+    COND_RETURN_CMODEL(ret != EOK, DRV_ERROR_INVALID_VALUE, "memset_s failed");
+
+    (void)pthread_mutex_init(&dev->mutex, NULL);
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&dev->sqCond, &attr);
+    (void)pthread_cond_init(&dev->cqCond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+    dev->seed = devId + 1U;
+    dev->runFlag = 1;
+
+    const int result = pthread_create(&dev->thread, NULL, drvSimDeviceRun, dev);
+    if (result != 0) {
+        drvSimDeviceDestroy(dev);
+        DRVSTUB_LOG("create sim device thread failed, result=%d", result);
+        return DRV_ERROR_INNER_ERR;
+    }
+    return DRV_ERROR_NONE;
+}
+
+/* stop the device thread and release the sqs of a device initialized by drvSimDeviceInit */
+static void drvSimDeviceExit(drvSimDevice_t* dev)
+{
+    uint32_t sqId;
+
+    (void)pthread_mutex_lock(&dev->mutex);
+    dev->runFlag = 0;
+    (void)pthread_cond_broadcast(&dev->sqCond);
+    (void)pthread_cond_broadcast(&dev->cqCond);
+    (void)pthread_mutex_unlock(&dev->mutex);
+    (void)pthread_join(dev->thread, NULL);
+
+    for (sqId = 0U; sqId < MAX_SQCQ_NUM; sqId++) {
+        free(dev->sq[sqId]);
+        dev->sq[sqId] = NULL;
+    }
+    drvSimDeviceDestroy(dev);
+}
+
+drvError_t drvSimInit(void)
+{
+    const char* enable = getenv("CMODEL_DRV_SIM_DEVICE");
+    if ((enable == NULL) || (strcmp(enable, "1") != 0)) {
+        return DRV_ERROR_NONE;
+    }
+
+    drvSimLoadConfig();
+    uint32_t i;
+    for (i = 0U; i < MAX_DEV_NUM; i++) {
+        const drvError_t ret = drvSimDeviceInit(&g_drvSimDevice[i], i);
+        if (ret != DRV_ERROR_NONE) {
+            DRVSTUB_LOG("sim device %u init failed", i);
+            /* stop the devices already started */
+            while (i > 0U) {
+                i--;
+                drvSimDeviceExit(&g_drvSimDevice[i]);
+            }
+            return ret;
+        }
+    }
+    g_drvSimEnable = DRV_TRUE;
+    DRVSTUB_LOG("sim device enabled, dist=%d, latency=%lluns, jitter=%lluns, cq batch=%u", (int32_t)g_drvSimCfg.dist,
+        (unsigned long long)g_drvSimCfg.latencyNs, (unsigned long long)g_drvSimCfg.jitterNs, g_drvSimCfg.cqBatch);
+    return DRV_ERROR_NONE;
+}
+
+void drvSimExit(void)
+{
+    if (g_drvSimEnable == DRV_FALSE) {
+        return;
+    }
+
+    uint32_t i;
+    for (i = 0U; i < MAX_DEV_NUM; i++) {
+        drvSimDeviceExit(&g_drvSimDevice[i]);
+        drvSimShowStat(i);
+    }
+    g_drvSimEnable = DRV_FALSE;
+}
+
+drvBool_t drvSimIsEnabled(void) { return g_drvSimEnable; }
+
+drvError_t drvSimSqMemGet(uint32_t devId, const struct halSqMemGetInput* in, struct halSqMemGetOutput* out)
+{
+    COND_RETURN_CMODEL(devId >= MAX_DEV_NUM, DRV_ERROR_INVALID_VALUE, "invalid device %u", devId);
+    COND_RETURN_CMODEL(in->sqId >= MAX_SQCQ_NUM, DRV_ERROR_INVALID_VALUE, "invalid sq %u", in->sqId);
+    COND_RETURN_CMODEL((in->cmdCount == 0U) || (in->cmdCount > DRV_SIM_MAX_CMD_COUNT), DRV_ERROR_INVALID_VALUE,
+        "invalid cmdCount %u", in->cmdCount);
+
+    drvSimDevice_t* dev = &g_drvSimDevice[devId];
+    const uint32_t cmdCount = in->cmdCount;
+    uint32_t i;
+
+    (void)pthread_mutex_lock(&dev->mutex);
+    drvSimSq_t* sq = dev->sq[in->sqId];
+    if (sq == NULL) {
+        sq = (drvSimSq_t*)calloc(1U, sizeof(drvSimSq_t));
+        if (sq == NULL) {
+            (void)pthread_mutex_unlock(&dev->mutex);
+            DRVSTUB_LOG("alloc sim sq %u failed", in->sqId);
+            return DRV_ERROR_OUT_OF_MEMORY;
+        }
+        dev->sq[in->sqId] = sq;
+    }
+
+    /* the slots returned must be contiguous, skip the end of the ring if they do not fit */
+    const uint32_t pos = sq->allocTail % DRV_SIM_SQ_DEPTH;
+    const uint32_t padCount = ((DRV_SIM_SQ_DEPTH - pos) < cmdCount) ? (DRV_SIM_SQ_DEPTH - pos) : 0U;
+    if (((sq->allocTail - sq->head) + padCount + cmdCount) > DRV_SIM_SQ_DEPTH) {
+        (void)pthread_mutex_unlock(&dev->mutex);
+        return DRV_ERROR_INNER_ERR;
+    }
+    for (i = 0U; i < padCount; i++) {
+        sq->isPad[(sq->allocTail + i) % DRV_SIM_SQ_DEPTH] = 1U;
+    }
+    sq->allocTail += padCount;
+    for (i = 0U; i < cmdCount; i++) {
+        sq->isPad[(sq->allocTail + i) % DRV_SIM_SQ_DEPTH] = 0U;
+    }
+    out->cmdPtr = (void*)&sq->cmd[sq->allocTail % DRV_SIM_SQ_DEPTH];
+    out->pos = sq->allocTail % DRV_SIM_SQ_DEPTH;
+    out->cmdCount = cmdCount;
+    sq->allocTail += cmdCount;
+    (void)pthread_mutex_unlock(&dev->mutex);
+    return DRV_ERROR_NONE;
+}
+
+drvError_t drvSimSqMsgSend(uint32_t devId, const struct halSqMsgInfo* info)
+{
+    COND_RETURN_CMODEL(devId >= MAX_DEV_NUM, DRV_ERROR_INVALID_VALUE, "invalid device %u", devId);
+    COND_RETURN_CMODEL(info->sqId >= MAX_SQCQ_NUM, DRV_ERROR_INVALID_VALUE, "invalid sq %u", info->sqId);
+
+    drvSimDevice_t* dev = &g_drvSimDevice[devId];
+    uint32_t remain = info->cmdCount;
+
+    (void)pthread_mutex_lock(&dev->mutex);
+    drvSimSq_t* sq = dev->sq[info->sqId];
+    if (sq == NULL) {
+        (void)pthread_mutex_unlock(&dev->mutex);
+        DRVSTUB_LOG("sim sq %u has no cmd", info->sqId);
+        return DRV_ERROR_INVALID_VALUE;
+    }
+    /* the device runs the sqes of one sq one after another */
+    const uint64_t nowNs = drvSimNowNs();
+    while ((remain > 0U) && (sq->sendTail != sq->allocTail)) {
+        const uint32_t slot = sq->sendTail % DRV_SIM_SQ_DEPTH;
+        if (sq->isPad[slot] == 0U) {
+            const uint64_t startNs = (sq->lastDueNs > nowNs) ? sq->lastDueNs : nowNs;
+            sq->dueNs[slot] = startNs + drvSimSampleLatency(dev);
+            sq->lastDueNs = sq->dueNs[slot];
+            remain--;
+        }
+        sq->sendTail++;
+    }
+    (void)pthread_cond_signal(&dev->sqCond);
+    (void)pthread_mutex_unlock(&dev->mutex);
+    return DRV_ERROR_NONE;
+}
+
+void drvSimSqFree(uint32_t devId, uint32_t sqId)
+{
+    if ((devId >= MAX_DEV_NUM) || (sqId >= MAX_SQCQ_NUM)) {
+        return;
+    }
+    drvSimDevice_t* dev = &g_drvSimDevice[devId];
+    (void)pthread_mutex_lock(&dev->mutex);
+    free(dev->sq[sqId]);
+    dev->sq[sqId] = NULL;
+    (void)pthread_mutex_unlock(&dev->mutex);
+}
+
+drvError_t drvSimCqReportWait(uint32_t devId, int32_t timeout)
+{
+    COND_RETURN_CMODEL(devId >= MAX_DEV_NUM, DRV_ERROR_INVALID_VALUE, "invalid device %u", devId);
+
+    drvSimDevice_t* dev = &g_drvSimDevice[devId];
+    struct timespec ts;
+    drvError_t ret = DRV_ERROR_NONE;
+
+    /* timeout is in ms, negative means wait forever */
+    if (timeout >= 0) {
+        drvSimNsToTimespec(drvSimNowNs() + ((uint64_t)timeout * DRV_SIM_NS_PER_MS), &ts);
+    }
+    (void)pthread_mutex_lock(&dev->mutex);
+    while ((dev->cq.head == dev->cq.tail) && (dev->runFlag != 0)) {
+        if (timeout < 0) {
+            (void)pthread_cond_wait(&dev->cqCond, &dev->mutex);
+        } else if (pthread_cond_timedwait(&dev->cqCond, &dev->mutex, &ts) == ETIMEDOUT) {
+            break;
+        }
+    }
+    if (dev->cq.head == dev->cq.tail) {
+        ret = DRV_ERROR_WAIT_TIMEOUT;
+    }
+    (void)pthread_mutex_unlock(&dev->mutex);
+    return ret;
+}
+
+drvError_t drvSimCqReportGet(uint32_t devId, struct halReportGetOutput* out)
+{
+    COND_RETURN_CMODEL(devId >= MAX_DEV_NUM, DRV_ERROR_INVALID_VALUE, "invalid device %u", devId);
+
+    drvSimDevice_t* dev = &g_drvSimDevice[devId];
+    (void)pthread_mutex_lock(&dev->mutex);
+    const uint32_t pos = dev->cq.head % DRV_SIM_CQ_DEPTH;
+    uint32_t count = dev->cq.tail - dev->cq.head;
+    /* reports returned at a time are contiguous, the rest is returned by the next call */
+    if (count > (DRV_SIM_CQ_DEPTH - pos)) {
+        count = DRV_SIM_CQ_DEPTH - pos;
+    }
+    out->count = count;
+    out->reportPtr = (count > 0U) ? (void*)&dev->cq.report[pos] : NULL;
+    (void)pthread_mutex_unlock(&dev->mutex);
+    return DRV_ERROR_NONE;
+}
+
+drvError_t drvSimReportRelease(uint32_t devId, uint32_t count)
+{
+    COND_RETURN_CMODEL(devId >= MAX_DEV_NUM, DRV_ERROR_INVALID_VALUE, "invalid device %u", devId);
+
+    drvSimDevice_t* dev = &g_drvSimDevice[devId];
+    (void)pthread_mutex_lock(&dev->mutex);
+    const uint32_t avail = dev->cq.tail - dev->cq.head;
+    dev->cq.head += (count < avail) ? count : avail;
+    /* the device may be waiting for cq space */
+    (void)pthread_cond_signal(&dev->sqCond);
+    (void)pthread_mutex_unlock(&dev->mutex);
+    return DRV_ERROR_NONE;
+}
+
+void drvSimShowStat(uint32_t devId)
+{
+    if ((g_drvSimEnable == DRV_FALSE) || (devId >= MAX_DEV_NUM)) {
+        return;
+    }
+    const drvSimStat_t* stat = &g_drvSimDevice[devId].stat;
+    DRVSTUB_LOG("sim device %u: sqe=%llu, cqe=%llu, cq batch=%llu, cq full=%llu", devId,
+        (unsigned long long)stat->sqeCount, (unsigned long long)stat->cqeCount, (unsigned long long)stat->batchCount,
+        (unsigned long long)stat->cqFullCount);
+}
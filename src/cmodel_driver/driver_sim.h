@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#ifndef DRIVER_SIM_H
+#define DRIVER_SIM_H
+
+#include <pthread.h>
+#include "driver_queue.h"
+#include "driver_impl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * @ingroup driver-stub
+ * @brief simulated device, enabled by env CMODEL_DRV_SIM_DEVICE=1.
+ * A device thread consumes the SQEs of every SQ in order, completes each one after a latency sampled from
+ * CMODEL_DRV_SIM_LATENCY_DIST (fixed/uniform/exp) with mean CMODEL_DRV_SIM_LATENCY_US and jitter
+ * CMODEL_DRV_SIM_JITTER_US, and publishes the CQEs in batches of up to CMODEL_DRV_SIM_CQ_BATCH.
+ */
+#define DRV_SIM_SQ_DEPTH (1024U)
+#define DRV_SIM_CQ_DEPTH (1024U)
+#define DRV_SIM_DEFAULT_LATENCY_US (10U)
+#define DRV_SIM_DEFAULT_CQ_BATCH (32U)
+
+typedef enum tagDrvSimLatencyDist {
+    DRV_SIM_LATENCY_FIXED = 0,
+    DRV_SIM_LATENCY_UNIFORM = 1,
+    DRV_SIM_LATENCY_EXP = 2,
+} drvSimLatencyDist_t;
+
+/*
+ * @ingroup driver-stub
+ * @brief report of the simulated device, same layout as the ts task report of runtime.
+ */
+typedef struct tagDrvSimReport {
+    uint16_t SOP : 1;
+    uint16_t MOP : 1;
+    uint16_t EOP : 1;
+    uint16_t packageType : 3;
+    uint16_t streamId : 10;
+    uint16_t taskId;
+    uint32_t payLoad;
+    uint16_t sqId : 9;
+    uint16_t reserved : 6;
+    uint16_t phase : 1;
+    uint16_t sqHead : 14;
+    uint16_t streamIdEx : 1;
+    uint16_t faultStreamIdEx : 1;
+} drvSimReport_t;
+
+/*
+ * @ingroup driver-stub
+ * @brief sq ring of the simulated device.
+ * allocTail is moved by halSqMemGet, sendTail by halSqMsgSend and head by the device thread.
+ */
+typedef struct tagDrvSimSq {
+    drvCommandStruct_t cmd[DRV_SIM_SQ_DEPTH];
+    uint64_t dueNs[DRV_SIM_SQ_DEPTH];
+    uint8_t isPad[DRV_SIM_SQ_DEPTH];
+    uint32_t head;
+    uint32_t sendTail;
+    uint32_t allocTail;
+    uint64_t lastDueNs;
+} drvSimSq_t;
+
+/*
+ * @ingroup driver-stub
+ * @brief cq ring of the simulated device.
+ * reports between tail and pendingTail are written but not visible to halCqReportGet until the batch is posted.
+ */
+typedef struct tagDrvSimCq {
+    drvSimReport_t report[DRV_SIM_CQ_DEPTH];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t pendingTail;
+} drvSimCq_t;
+
+typedef struct tagDrvSimStat {
+    uint64_t sqeCount;
+    uint64_t cqeCount;
+    uint64_t batchCount;
+    uint64_t cqFullCount;
+} drvSimStat_t;
+
+typedef struct tagDrvSimDevice {
+    drvSimSq_t* sq[MAX_SQCQ_NUM];
+    drvSimCq_t cq;
+    drvSimStat_t stat;
+    pthread_mutex_t mutex;
+    pthread_cond_t sqCond;
+    pthread_cond_t cqCond;
+    pthread_t thread;
+    uint32_t seed;
+    volatile int32_t runFlag;
+} drvSimDevice_t;
+
+drvError_t drvSimInit(void);
+void drvSimExit(void);
+drvBool_t drvSimIsEnabled(void);
+drvError_t drvSimSqMemGet(uint32_t devId, const struct halSqMemGetInput* in, struct halSqMemGetOutput* out);
+drvError_t drvSimSqMsgSend(uint32_t devId, const struct halSqMsgInfo* info);
+void drvSimSqFree(uint32_t devId, uint32_t sqId);
+drvError_t drvSimCqReportWait(uint32_t devId, int32_t timeout);
+drvError_t drvSimCqReportGet(uint32_t devId, struct halReportGetOutput* out);
+drvError_t drvSimReportRelease(uint32_t devId, uint32_t count);
+void drvSimShowStat(uint32_t devId);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DRIVER_SIM_H */
@@ -13,7 +13,8 @@ LOCAL_PATH := $(call my-dir)
 libnpu_drv_common_src_files := driver_api.c \
                                driver_impl.c \
                                driver_mem.c \
-                               driver_queue.c
+                               driver_queue.c \
+                               driver_sim.c
 
 MODEL_VERSION := MODEL_V100
 ifeq ($(chip_id),hi1910p)
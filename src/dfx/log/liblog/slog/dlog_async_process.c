@@ -14,6 +14,7 @@
 #include "log_time.h"
 #include "dlog_unified_timer_api.h"
 #include "unified_timer_error_code.h"
+#include "dlog_deferred.h"
 
 #ifndef UNIFIED_TIMER_NAME_DUPLICATE
 #define UNIFIED_TIMER_NAME_DUPLICATE UNIFILED_TIMER_NAME_DUPLICATE
@@ -31,6 +32,9 @@ extern "C" {
 #define LOG_MAX_COVERED_LOSS_NUM                10000UL
 #define LOG_SYNC_PERIOD                         1 // unified_timer minimum period: 100ms
 #define LOG_BUF_NUM                             4U
+#define DLOG_THREAD_BUF_SIZE                    (128U * 1024U)
+#define DLOG_THREAD_BUF_SYNC_SIZE               (DLOG_THREAD_BUF_SIZE / 2U) // add sync task when half full
+#define DLOG_THREAD_BUF_ALIGN                   8U
 
 #define LOG_MONITOR_TIME_OUT_PRINT(cost, threshold, format, ...)  \
     NO_ACT_WARN_LOG((cost) / LogGetCpuFrequency() * TICK_TO_US >= (threshold), \
@@ -54,12 +58,39 @@ extern "C" {
 #define DLOG_SYNC_TIMER_NAME                    "slog_sync_task_timer"
 #endif
 
+/*
+ * Every writing thread owns a single producer single consumer buffer, the send task is the only consumer.
+ * Records of all thread buffers are merged by cpu cycle into dlogBuf, so the format sent to slogd is unchanged.
+ * Thread buffers are recycled after thread exit and are kept until process exit.
+ */
+typedef struct DlogThreadRecord {
+    uint32_t size;      // record size with padding, 0 means the rest of buffer is skipped
+    uint16_t msgLength;
+    uint16_t moduleId;
+    uint8_t logType;
+    uint8_t logLevel;
+    uint8_t deferred;   // 1: message is encoded by DlogDeferredEncodeLog, head and content are built by send task
+    uint8_t resv[5];
+    uint64_t cycle;     // write time, used to merge records of all threads
+} DlogThreadRecord;
+
+typedef struct DlogThreadBuf {
+    struct DlogThreadBuf *next;
+    uint32_t inUse;     // owned by a living thread
+    uint64_t writePos;  // only updated by owner thread
+    uint64_t readPos;   // only updated by send task
+    uint64_t dropCount; // records dropped by owner thread because buffer is full
+    uint64_t dropRead;  // dropCount already accounted by send task
+    char data[DLOG_THREAD_BUF_SIZE];
+} DlogThreadBuf;
+
 typedef struct DlogBufferMgr {
     RingBufferStat *dlogBuf[LOG_BUF_NUM];
     uint64_t lossCount; // covered log loss count
     uint64_t lastPrintTime; // record log loss print time
     uint32_t writeBufIndex; // current buffer index to write
     uint32_t sendBufIndex; // current buffer index to send
+    DlogThreadBuf *threadBufList; // all thread buffers, only prepended
 } DlogBufferMgr;
 
 typedef struct DlogLevelCtrlMgr {
@@ -78,8 +109,13 @@ typedef struct DlogNsycMgr {
     int32_t himemFd; // high memory fd
 } DlogNsycMgr;
 
-STATIC DlogNsycMgr g_dlogAsyncMgr = {false, false, {{NULL, NULL, NULL, NULL}, 0, 0, 0, 0}, PTHREAD_MUTEX_INITIALIZER,
-    {false, DLOG_DEBUG, 0, {0, 0}}, -1};
+STATIC DlogNsycMgr g_dlogAsyncMgr = {false, false, {{NULL, NULL, NULL, NULL}, 0, 0, 0, 0, NULL},
+    PTHREAD_MUTEX_INITIALIZER, {false, DLOG_DEBUG, 0, {0, 0}}, -1};
+STATIC __thread DlogThreadBuf *g_dlogThreadBuf = NULL;
+STATIC pthread_key_t g_dlogThreadBufKey;
+STATIC pthread_once_t g_dlogThreadBufKeyOnce = PTHREAD_ONCE_INIT;
+
+STATIC bool DlogDrainThreadBuf(bool stopOnSwitch);
 
 /**
  * @brief       : init mutex, set robust
@@ -119,6 +155,12 @@ STATIC void DlogUnLock(void)
  */
 STATIC void DlogChildUnLock(void)
 {
+    // other threads do not exist in child process, their buffers can be taken by new threads
+    for (DlogThreadBuf *buf = g_dlogAsyncMgr.bufMgr.threadBufList; buf != NULL; buf = buf->next) {
+        if (buf != g_dlogThreadBuf) {
+            __atomic_store_n(&buf->inUse, 0U, __ATOMIC_RELEASE);
+        }
+    }
     int32_t ret = pthread_mutex_unlock(&g_dlogAsyncMgr.mutex);
     if (ret != SYS_OK) {
         (void)pthread_mutex_destroy(&g_dlogAsyncMgr.mutex);
@@ -318,12 +360,8 @@ static bool DlogCheckWriteBufModify(uint32_t writeBufIndex)
     return ret;
 }
 
-static void DlogUnifiedTimerCb(void)
+static void DlogSendBuf(void)
 {
-    DlogMonitorTimerDelay();
-    if (!DlogIamServiceIsValid()) {
-        return;
-    }
     // if write buffer is not empty and service is ready, exchange buffer and send data
     uint32_t writeBufIndex = g_dlogAsyncMgr.bufMgr.writeBufIndex;
     LOG_MONITOR_TIME_OUT(DlogSyncAllSendBuf(&g_dlogAsyncMgr.bufMgr.sendBufIndex, writeBufIndex), LOG_SEND_COST_MAX_TIME,
@@ -337,6 +375,27 @@ static void DlogUnifiedTimerCb(void)
             "%s send newest buffer", DLOG_TIMER_NAME);
         g_dlogAsyncMgr.bufMgr.sendBufIndex = (writeBufIndex + 1U) % LOG_BUF_NUM;
     }
+}
+
+static void DlogUnifiedTimerCb(void)
+{
+    DlogMonitorTimerDelay();
+    if (!DlogIamServiceIsValid()) {
+        return;
+    }
+    if (DlogDeferredEnabled()) {
+        DlogDeferredCheckUnload();
+    }
+    // merge thread buffers into write buffer, send whenever a write buffer is filled up
+    uint32_t round = 0;
+    bool isBufSwitch = false;
+    do {
+        DlogLock();
+        LOG_MONITOR_TIME_OUT(isBufSwitch = DlogDrainThreadBuf(true), LOG_SEND_COST_MAX_TIME,
+            "%s merge thread buffer", DLOG_TIMER_NAME);
+        DlogUnLock();
+        DlogSendBuf();
+    } while (isBufSwitch && (++round < LOG_BUF_NUM));
     return;
 }
 
@@ -411,6 +470,9 @@ STATIC void DlogSyncNotify(void)
     int32_t retry = 0;
     const uint32_t retryWaitTime = 50U;
     bool isExit = false;
+    DlogLock();
+    (void)DlogDrainThreadBuf(false);
+    DlogUnLock();
     // if sendBufIndex != writeBufIndex, means there are some send buf is wait to send, wait until send done
     if (g_dlogAsyncMgr.bufMgr.sendBufIndex != g_dlogAsyncMgr.bufMgr.writeBufIndex) {
         DlogAddSyncTask();
@@ -469,6 +531,8 @@ void DlogUpdateFlierLevelStatus(void)
         return;
     }
     DlogLock();
+    // logs written before level changed are kept with the old level filter
+    (void)DlogDrainThreadBuf(false);
     uint32_t curIdx = g_dlogAsyncMgr.bufMgr.writeBufIndex;
     if (LogBufCheckEmpty(g_dlogAsyncMgr.bufMgr.dlogBuf[curIdx])) { // if current buf is empty, not switch write index
         DlogFilterStatus(g_dlogAsyncMgr.bufMgr.dlogBuf[curIdx]);
@@ -492,21 +556,21 @@ void DlogUpdateFlierLevelStatus(void)
     DlogUnLock();
 }
 
-STATIC void DlogInitHead(LogHead *head, const LogMsg *logMsg)
+STATIC void DlogInitHead(LogHead *head, const DlogThreadRecord *record)
 {
     (void)memset_s(head, sizeof(LogHead), 0, sizeof(LogHead));
     head->magic = HEAD_MAGIC;
     head->version = HEAD_VERSION;
     head->aosType = (uint8_t)DlogGetAosType(); // AOS_GEA/AOS_SEA
     head->processType = (uint8_t)DlogGetProcessType();  // APPLICATION/SYSTEM
-    head->logType = (uint8_t)logMsg->type;     // debug/run/security
-    head->logLevel = (uint8_t)logMsg->level;   // debug/info/warning/error/event
+    head->logType = record->logType;           // debug/run/security
+    head->logLevel = record->logLevel;         // debug/info/warning/error/event
     head->hostPid = DlogGetHostPid();
     head->devicePid = (uint32_t)DlogGetCurrPid();
     head->deviceId = (uint16_t)DlogGetAttrDeviceId();
-    head->moduleId = (uint16_t)logMsg->moduleId;
+    head->moduleId = record->moduleId;
     head->allLength = 0;
-    head->msgLength = (uint16_t)logMsg->msgLength;
+    head->msgLength = record->msgLength;
     head->tagSwitch = 0; // 0:without tag; 1:with tag
     head->saveMode = 0;
 }
@@ -552,10 +616,222 @@ STATIC RingBufferStat *DlogGetWriteBuf(bool *isBufSwitch, uint32_t msgLen)
 }
 
 /**
- * @brief        : write log to buffer
- * @param [in]   : logMsg      log messages
+ * @brief        : write one merged record to current write buffer, must be called with lock
+ * @return       : true if write buffer is switched
  */
-void DlogWriteToBuf(const LogMsg *logMsg)
+STATIC bool DlogWriteRecordToBuf(const DlogThreadRecord *record)
+{
+    LogHead head;
+    DlogInitHead(&head, record);
+    const char *msg = (const char *)(record + 1);
+    char text[MSG_LENGTH];
+    if (record->deferred != 0U) {
+        // format deferred log now, the same head and content as DlogWriteInner builds for eager log
+        LogMsgArg msgArg = { 0 };
+        msgArg.moduleId = record->moduleId;
+        msgArg.level = (int32_t)record->logLevel;
+        msgArg.selfPid = (int32_t)head.devicePid;
+        head.msgLength = (uint16_t)DlogDeferredDecodeLog(msg, record->msgLength, &msgArg, text, (uint32_t)sizeof(text));
+        ONE_ACT_NO_LOG(head.msgLength == 0U, return false);
+        msg = text;
+    }
+    bool isBufSwitch = false;
+    RingBufferStat *bufMgr = DlogGetWriteBuf(&isBufSwitch, head.msgLength);
+    ONE_ACT_NO_LOG(bufMgr == NULL, return false);
+
+    uint64_t coverCount = 0;
+    int32_t res = LogBufWrite(bufMgr->ringBufferCtrl, msg, &head, &coverCount);
+    if (res < 0) {
+        SELF_LOG_ERROR("DlogWriteToBuf fail res %d", res);
+    } else {
+        if (coverCount > 0) {
+            g_dlogAsyncMgr.bufMgr.lossCount += coverCount;
+            DlogPrintLogLoss();
+        }
+    }
+    return isBufSwitch;
+}
+
+/**
+ * @brief        : get the oldest record of thread buffer, skip the padding at the end of buffer
+ * @return       : NULL if thread buffer is empty
+ */
+STATIC const DlogThreadRecord *DlogThreadBufPeek(DlogThreadBuf *buf)
+{
+    const uint64_t writePos = __atomic_load_n(&buf->writePos, __ATOMIC_ACQUIRE);
+    while (buf->readPos != writePos) {
+        const uint32_t offset = (uint32_t)(buf->readPos % DLOG_THREAD_BUF_SIZE);
+        const DlogThreadRecord *record = (const DlogThreadRecord *)(buf->data + offset);
+        if (record->size != 0) {
+            return record;
+        }
+        __atomic_store_n(&buf->readPos, buf->readPos + (DLOG_THREAD_BUF_SIZE - offset), __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+/**
+ * @brief        : account records dropped by writing threads since last merge, must be called with lock
+ */
+STATIC void DlogCountThreadBufDrop(void)
+{
+    uint64_t dropNum = 0;
+    DlogThreadBuf *buf = __atomic_load_n(&g_dlogAsyncMgr.bufMgr.threadBufList, __ATOMIC_ACQUIRE);
+    for (; buf != NULL; buf = buf->next) {
+        const uint64_t dropCount = __atomic_load_n(&buf->dropCount, __ATOMIC_RELAXED);
+        dropNum += dropCount - buf->dropRead;
+        buf->dropRead = dropCount;
+    }
+    if (dropNum > 0) {
+        // thread buffer full means write buffers can not keep up, the same as buffer covered
+        g_dlogAsyncMgr.bufMgr.lossCount += dropNum;
+        LogCtrlIncLogic();
+        DlogPrintLogLoss();
+    }
+}
+
+/**
+ * @brief        : merge records of all thread buffers into write buffer by cpu cycle, must be called with lock
+ * @param [in]   : stopOnSwitch    stop merging when write buffer is switched, let the full buffer be sent first
+ * @return       : true if stopped on write buffer switch
+ */
+STATIC bool DlogDrainThreadBuf(bool stopOnSwitch)
+{
+    DlogCountThreadBufDrop();
+    DlogThreadBuf *list = __atomic_load_n(&g_dlogAsyncMgr.bufMgr.threadBufList, __ATOMIC_ACQUIRE);
+    while (true) {
+        DlogThreadBuf *minBuf = NULL;
+        const DlogThreadRecord *minRecord = NULL;
+        for (DlogThreadBuf *buf = list; buf != NULL; buf = buf->next) {
+            const DlogThreadRecord *record = DlogThreadBufPeek(buf);
+            if ((record != NULL) && ((minRecord == NULL) || (record->cycle < minRecord->cycle))) {
+                minBuf = buf;
+                minRecord = record;
+            }
+        }
+        if (minRecord == NULL) {
+            return false;
+        }
+        bool isBufSwitch = DlogWriteRecordToBuf(minRecord);
+        __atomic_store_n(&minBuf->readPos, minBuf->readPos + minRecord->size, __ATOMIC_RELEASE);
+        if (isBufSwitch && stopOnSwitch) {
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief        : count records left in thread buffers as loss and discard them, must be called with lock
+ */
+STATIC void DlogDiscardThreadBuf(void)
+{
+    DlogThreadBuf *buf = __atomic_load_n(&g_dlogAsyncMgr.bufMgr.threadBufList, __ATOMIC_ACQUIRE);
+    for (; buf != NULL; buf = buf->next) {
+        const DlogThreadRecord *record = DlogThreadBufPeek(buf);
+        while (record != NULL) {
+            g_dlogAsyncMgr.bufMgr.lossCount++;
+            __atomic_store_n(&buf->readPos, buf->readPos + record->size, __ATOMIC_RELEASE);
+            record = DlogThreadBufPeek(buf);
+        }
+    }
+}
+
+STATIC void DlogThreadBufRelease(void *arg)
+{
+    DlogThreadBuf *buf = (DlogThreadBuf *)arg;
+    if (buf != NULL) {
+        // called on the exiting thread, a later log of it during tls teardown takes a buffer again and re-arms the key
+        if (g_dlogThreadBuf == buf) {
+            g_dlogThreadBuf = NULL;
+        }
+        // records left are still merged by send task, buffer is reused by the next new thread
+        __atomic_store_n(&buf->inUse, 0U, __ATOMIC_RELEASE);
+    }
+}
+
+STATIC void DlogThreadBufKeyInit(void)
+{
+    int32_t ret = pthread_key_create(&g_dlogThreadBufKey, DlogThreadBufRelease);
+    NO_ACT_WARN_LOG(ret != 0, "can not create thread buffer key, ret=%d.", ret);
+}
+
+/**
+ * @brief        : get buffer of current thread, take a released one first, or malloc a new one
+ * @return       : NULL if malloc failed
+ */
+STATIC DlogThreadBuf *DlogGetThreadBuf(void)
+{
+    if (g_dlogThreadBuf != NULL) {
+        return g_dlogThreadBuf;
+    }
+    (void)pthread_once(&g_dlogThreadBufKeyOnce, DlogThreadBufKeyInit);
+    DlogThreadBuf *buf = __atomic_load_n(&g_dlogAsyncMgr.bufMgr.threadBufList, __ATOMIC_ACQUIRE);
+    for (; buf != NULL; buf = buf->next) {
+        if ((__atomic_load_n(&buf->inUse, __ATOMIC_RELAXED) == 0U) &&
+            __sync_bool_compare_and_swap(&buf->inUse, 0U, 1U)) {
+            break;
+        }
+    }
+    if (buf == NULL) {
+        // malloc but not memset data, memory is not actually occupied until used
+        buf = (DlogThreadBuf *)malloc(sizeof(DlogThreadBuf));
+        if (buf == NULL) {
+            SELF_LOG_ERROR("malloc for thread log buffer failed, strerr = %s.", strerror(ToolGetErrorCode()));
+            return NULL;
+        }
+        (void)memset_s(buf, offsetof(DlogThreadBuf, data), 0, offsetof(DlogThreadBuf, data));
+        buf->inUse = 1U;
+        DlogThreadBuf *head = __atomic_load_n(&g_dlogAsyncMgr.bufMgr.threadBufList, __ATOMIC_RELAXED);
+        do {
+            buf->next = head;
+        } while (!__atomic_compare_exchange_n(&g_dlogAsyncMgr.bufMgr.threadBufList, &head, buf, true,
+            __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+    (void)pthread_setspecific(g_dlogThreadBufKey, buf);
+    g_dlogThreadBuf = buf;
+    return buf;
+}
+
+/**
+ * @brief        : write one record to thread buffer, only called by owner thread
+ * @return       : LOG_SUCCESS success; LOG_FAILURE buffer is full, record is dropped
+ */
+STATIC LogStatus DlogThreadBufWrite(DlogThreadBuf *buf, const LogMsg *logMsg, bool deferred, bool *needSync)
+{
+    const uint32_t msgLen = logMsg->msgLength;
+    const uint32_t size = (uint32_t)(sizeof(DlogThreadRecord) + msgLen + DLOG_THREAD_BUF_ALIGN - 1U) &
+        ~(DLOG_THREAD_BUF_ALIGN - 1U);
+    uint64_t writePos = buf->writePos;
+    const uint64_t readPos = __atomic_load_n(&buf->readPos, __ATOMIC_ACQUIRE);
+    uint32_t offset = (uint32_t)(writePos % DLOG_THREAD_BUF_SIZE);
+    const uint32_t tailSize = DLOG_THREAD_BUF_SIZE - offset;
+    const uint32_t skipSize = (tailSize < size) ? tailSize : 0U;
+    if ((writePos + skipSize + size - readPos) > DLOG_THREAD_BUF_SIZE) {
+        __atomic_store_n(&buf->dropCount, buf->dropCount + 1U, __ATOMIC_RELAXED);
+        *needSync = true;
+        return LOG_FAILURE;
+    }
+    if (skipSize != 0U) {
+        ((DlogThreadRecord *)(buf->data + offset))->size = 0;
+        writePos += skipSize;
+        offset = 0;
+    }
+    DlogThreadRecord *record = (DlogThreadRecord *)(buf->data + offset);
+    record->size = size;
+    record->msgLength = (uint16_t)msgLen;
+    record->moduleId = (uint16_t)logMsg->moduleId;
+    record->logType = (uint8_t)logMsg->type;
+    record->logLevel = (uint8_t)logMsg->level;
+    record->deferred = deferred ? 1U : 0U;
+    record->cycle = LogGetCpuCycleCounter();
+    (void)memcpy_s((char *)(record + 1), DLOG_THREAD_BUF_SIZE - offset - sizeof(DlogThreadRecord),
+        logMsg->msg, msgLen);
+    __atomic_store_n(&buf->writePos, writePos + size, __ATOMIC_RELEASE);
+    *needSync = (writePos + size - readPos) >= DLOG_THREAD_BUF_SYNC_SIZE;
+    return LOG_SUCCESS;
+}
+
+STATIC void DlogWriteToThreadBuf(const LogMsg *logMsg, bool deferred)
 {
     if (!g_dlogAsyncMgr.initFlag) {
         return;
@@ -564,38 +840,41 @@ void DlogWriteToBuf(const LogMsg *logMsg)
         SELF_LOG_ERROR("log messaegs is null, pid = %d", ToolGetPid());
         return;
     }
-    DlogLock();
-    bool isBufSwitch = false;
-    RingBufferStat *bufMgr = DlogGetWriteBuf(&isBufSwitch, logMsg->msgLength);
-    TWO_ACT_NO_LOG(bufMgr == NULL, DlogUnLock(), return);
-
     if (g_dlogAsyncMgr.levelCtrl.ctrlSwitch && (logMsg->type == DEBUG_LOG)
         && (logMsg->level < g_dlogAsyncMgr.levelCtrl.ctrlLevel)) {
-        g_dlogAsyncMgr.levelCtrl.lossCount++;
-        DlogUnLock();
+        (void)__sync_fetch_and_add(&g_dlogAsyncMgr.levelCtrl.lossCount, 1U);
         return;
     }
+    DlogThreadBuf *buf = DlogGetThreadBuf();
+    ONE_ACT_NO_LOG(buf == NULL, return);
 
-    LogHead head = { 0 };
-    DlogInitHead(&head, logMsg);
-    uint64_t coverCount = 0;
-    int32_t res = LogBufWrite(bufMgr->ringBufferCtrl, logMsg->msg, &head, &coverCount);
-    if (res < 0) {
-        SELF_LOG_ERROR("DlogWriteToBuf fail res %d", res);
-    } else {
-        if (coverCount > 0) {
-            g_dlogAsyncMgr.bufMgr.lossCount += coverCount;
-            DlogPrintLogLoss();
-        }
-    }
-    DlogUnLock();
+    bool needSync = false;
+    (void)DlogThreadBufWrite(buf, logMsg, deferred, &needSync);
     // if sync task add failed, retry next time
-    if (isBufSwitch) {
+    if (needSync) {
         DlogAddSyncTask();
     }
     return;
 }
 
+/**
+ * @brief        : write log to buffer of current thread, no lock is taken
+ * @param [in]   : logMsg      log messages
+ */
+void DlogWriteToBuf(const LogMsg *logMsg)
+{
+    DlogWriteToThreadBuf(logMsg, false);
+}
+
+/**
+ * @brief        : write log encoded by DlogDeferredEncodeLog, head and content are formatted by send task
+ * @param [in]   : logMsg      log messages, msg holds the encoded log
+ */
+void DlogWriteDeferredToBuf(const LogMsg *logMsg)
+{
+    DlogWriteToThreadBuf(logMsg, true);
+}
+
 STATIC void DlogStopSendTask(void)
 {
     if (g_dlogAsyncMgr.initFlag && (DlogCheckCurrPid())) {
@@ -713,6 +992,8 @@ void DlogAsyncExit(void)
 {
     DlogStopSendTask();
     DlogLock();
+    DlogCountThreadBufDrop();
+    DlogDiscardThreadBuf();
     CountLogLoss();
     // log loss selflog print
     SELF_LOG_INFO("pid=%d, pid_name=%s quit, log covered loss num is %lu, log level control loss num is %lu.",
@@ -20,6 +20,7 @@ extern "C" {
 #endif // __cplusplus
 
 void DlogWriteToBuf(const LogMsg *logMsg);
+void DlogWriteDeferredToBuf(const LogMsg *logMsg);
 void DlogFlushBuf(void);
 void DlogUpdateFlierLevelStatus(void);
 
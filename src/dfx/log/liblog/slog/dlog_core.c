@@ -9,6 +9,7 @@
  */
 
 #include "dlog_core.h"
+#include <sched.h>
 #include "securec.h"
 #include "log_platform.h"
 #include "log_common.h"
@@ -30,6 +31,7 @@ STATIC DlogCallback g_dlogCallback = { 0 };
 STATIC bool g_dlogIsInited = false;
 STATIC ToolMutex g_slogMutex = TOOL_MUTEX_INITIALIZER;
 STATIC bool g_hasRegistered = false;
+STATIC uint32_t g_dlogWritingNum = 0U; // writers running the write callback without g_slogMutex
 
 /**
  * @brief       : check dlog init or not
@@ -89,6 +91,8 @@ STATIC void DlogAtForkChild(void)
     if (g_dlogCallback.funcAtFork != NULL) {
         g_dlogCallback.funcAtFork(ATFORK_CHILD);
     }
+    // writers of other threads do not exist in child process
+    __atomic_store_n(&g_dlogWritingNum, 0U, __ATOMIC_SEQ_CST);
     SlogUnlock();
 }
 
@@ -273,6 +277,16 @@ void DlogRefreshCache(void)
     }
 }
 
+/**
+ * @brief       : wait for writers still running the old write callback, caller may release it after return
+ */
+STATIC void DlogWaitWriters(void)
+{
+    while (__atomic_load_n(&g_dlogWritingNum, __ATOMIC_SEQ_CST) != 0U) {
+        (void)sched_yield();
+    }
+}
+
 /**
  * @brief RegisterCallback: register DlogCallback
  * @param [in]callback: function pointer
@@ -283,10 +297,10 @@ int RegisterCallback(const ArgPtr callback, const CallbackType funcType)
     SlogLock();
     switch (funcType) {
         case LOG_WRITE:
-            g_dlogCallback.funcWrite = (DlogWriteCallback)callback;
-            if (g_dlogCallback.funcWrite != NULL) {
+            if (callback != NULL) {
                 g_hasRegistered = true;
             }
+            __atomic_store_n(&g_dlogCallback.funcWrite, (DlogWriteCallback)callback, __ATOMIC_SEQ_CST);
             break;
         case LOG_FLUSH:
             ToolMemBarrier();
@@ -302,6 +316,9 @@ int RegisterCallback(const ArgPtr callback, const CallbackType funcType)
             break;
     }
     SlogUnlock();
+    if (funcType == LOG_WRITE) {
+        DlogWaitWriters();
+    }
     return SUCCESS;
 }
 
@@ -386,6 +403,37 @@ STATIC void DlogWriteToSocket(LogMsg *logMsg, const LogMsgArg *msgArg)
     }
 }
 
+/**
+ * @brief       : write to plog without g_slogMutex, the write callback serializes its own buffer.
+ *                Used in steady state only, init, fork and socket connect still go through g_slogMutex.
+ * @param [in]  : logMsg        struct of log message
+ * @return      : true log is handled; false caller takes the locked path
+ */
+STATIC bool DlogTryWriteToPlog(LogMsg *logMsg)
+{
+    if (!DlogIsInited() || !DlogCheckCurrPid()) {
+        return false;
+    }
+    // published before the callback is loaded, RegisterCallback waits it out after replacing the callback
+    (void)__atomic_add_fetch(&g_dlogWritingNum, 1U, __ATOMIC_SEQ_CST);
+    DlogWriteCallback funcWrite = __atomic_load_n(&g_dlogCallback.funcWrite, __ATOMIC_SEQ_CST);
+    if (funcWrite == NULL) {
+        (void)__atomic_sub_fetch(&g_dlogWritingNum, 1U, __ATOMIC_RELEASE);
+        return false;
+    }
+    DlogSetMessageNl(logMsg);
+    int32_t ret = funcWrite(logMsg->logContent, logMsg->contentLength, logMsg->type);
+    (void)__atomic_sub_fetch(&g_dlogWritingNum, 1U, __ATOMIC_RELEASE);
+#ifdef CONSOLE_WRITE
+    if (ret != 0) {
+        DlogWriteToConsole(logMsg);
+    }
+#else
+    (void)ret;
+#endif
+    return true;
+}
+
 /**
 * @brief DlogWriteInner: write log to log socket or stdout
 * @param [in]msgArg: LogMsgArg struct pointer
@@ -411,6 +459,10 @@ int32_t DlogWriteInner(LogMsgArg *msgArg, const char *fmt, va_list v)
         return LOG_SUCCESS;
     }
 
+    if (DlogTryWriteToPlog(&logMsg)) {
+        return LOG_SUCCESS;
+    }
+
     // lock, To prevent the leaked of file handle.(socket)
     SlogLock();
 
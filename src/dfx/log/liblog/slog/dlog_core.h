@@ -20,6 +20,7 @@ void DlogInit(void);
 int32_t DlogWriteInner(LogMsgArg *msgArg, const char *fmt, va_list v);
 void DlogRefreshCache(void);
 int32_t DlogCheckLogLevel(int32_t logLevel);
+int32_t DlogConstructBaseMsg(char *msg, uint32_t msgLen, const LogMsgArg *msgArg);
 
 #ifdef __cplusplus
 }
@@ -19,6 +19,7 @@
 #include "dlog_core.h"
 #include "log_time.h"
 #include "alog_to_slog.h"
+#include "dlog_deferred.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -102,7 +103,7 @@ STATIC void ParseLogMsg(LogMsg *logMsg, LogMsgArg *msgArg)
  * @param [in]  : msgArg        log info, include information to construct
  * @return      : SYS_OK success; SYS_ERROR failure
  */
-STATIC int32_t ConstructBaseMsg(char *msg, uint32_t msgLen, const LogMsgArg *msgArg)
+int32_t DlogConstructBaseMsg(char *msg, uint32_t msgLen, const LogMsgArg *msgArg)
 {
     int32_t err;
     if (msgArg->moduleId < (uint32_t)INVALID_MODULE_ID) {
@@ -146,7 +147,7 @@ STATIC int32_t ConstructLogMsg(LogMsg *logMsg, const LogMsgArg *msgArg, const ch
 {
     ONE_ACT_NO_LOG(logMsg == NULL, return SYS_ERROR);
     ONE_ACT_NO_LOG(fmt == NULL, return SYS_ERROR);
-    int32_t err = ConstructBaseMsg(logMsg->msg, MSG_LENGTH, msgArg);
+    int32_t err = DlogConstructBaseMsg(logMsg->msg, MSG_LENGTH, msgArg);
     if (err != SYS_OK) {
         SELF_LOG_ERROR("construct base log msg failed.");
         return SYS_ERROR;
@@ -201,6 +202,23 @@ STATIC void DlogWriteToStdout(LogMsg *logMsg)
     (void)ToolWrite(fd, (void *)logMsg->logContent, logMsg->contentLength);
 }
 
+/**
+ * @brief       : write log with time and content captured raw, head and content are formatted later by send task
+ * @return      : LOG_SUCCESS written; LOG_FAILURE format not supported, log must be written by DlogWriteInner
+ */
+STATIC int32_t DlogWriteDeferred(LogMsgArg *msgArg, const char *fmt, va_list v)
+{
+    // msg is not cleared, only the encoded length is copied to thread buffer
+    LogMsg logMsg;
+    logMsg.logContent = NULL;
+    logMsg.contentLength = 0;
+    ParseLogMsg(&logMsg, msgArg);
+    int32_t ret = DlogDeferredEncodeLog(logMsg.msg, MSG_LENGTH, fmt, v, &logMsg.msgLength);
+    ONE_ACT_NO_LOG(ret != LOG_SUCCESS, return LOG_FAILURE);
+    DlogWriteDeferredToBuf(&logMsg);
+    return LOG_SUCCESS;
+}
+
 /**
 * @brief DlogWriteInner: write log to log socket or stdout
 * @param [in]msgArg: LogMsgArg struct pointer
@@ -211,11 +229,16 @@ int32_t DlogWriteInner(LogMsgArg *msgArg, const char *fmt, va_list v)
 {
     ONE_ACT_NO_LOG(!CheckLogLevelInner(msgArg), return LOG_FAILURE);
 
+    CheckPid();
+    // log with key value keeps the eager path, deferred head only holds module, level, pid and time
+    if ((fmt != NULL) && (msgArg->typeMask != STDOUT_LOG_MASK) && (msgArg->kvArg.kvNum == 0) &&
+        DlogDeferredEnabled() && (DlogWriteDeferred(msgArg, fmt, v) == LOG_SUCCESS)) {
+        return LOG_SUCCESS;
+    }
     DlogGetTime(msgArg->timestamp, TIMESTAMP_LEN);
     msgArg->selfPid = DlogGetCurrPid();
     DlogGetUserAttr(&msgArg->attr);
 
-    CheckPid();
     LogMsg logMsg = {DEBUG_LOG, 0, 0, 0, NULL, 0, ""};
     ParseLogMsg(&logMsg, msgArg);
     int32_t result = ConstructLogMsg(&logMsg, msgArg, fmt, v);
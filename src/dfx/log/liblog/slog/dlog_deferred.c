@@ -0,0 +1,609 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "dlog_deferred.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <link.h>
+#include <sys/types.h>
+#include "securec.h"
+#include "log_print.h"
+#include "log_error_code.h"
+#include "log_types.h"
+#include "dlog_core.h"
+#include "dlog_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#define DLOG_DEFERRED_ENV_NAME          "ASCEND_LOG_DEFERRED_FORMAT"
+#define DLOG_DEFERRED_NULL_STR          0xFFFFU
+#define DLOG_DEFERRED_ARG_SIZE          8U
+#define DLOG_DEFERRED_LEN_SIZE          2U
+#define DLOG_DEFERRED_SPEC_LEN          48U
+#define DLOG_DEFERRED_FLAG_NUM          8U
+#define DLOG_DEFERRED_ID_SIZE           2U
+#define DLOG_DEFERRED_FMT_BITS          12U
+#define DLOG_DEFERRED_FMT_NUM           (1U << DLOG_DEFERRED_FMT_BITS) // max number of different formats
+#define DLOG_DEFERRED_FMT_PROBE         16U
+#define DLOG_DEFERRED_HASH_FACTOR       0x9E3779B97F4A7C15ULL
+#define DLOG_DEFERRED_CACHE_BITS        6U
+#define DLOG_DEFERRED_CACHE_NUM         (1U << DLOG_DEFERRED_CACHE_BITS) // formats cached by each thread
+
+typedef enum {
+    LEN_MOD_NONE = 0,
+    LEN_MOD_HH,
+    LEN_MOD_H,
+    LEN_MOD_L,
+    LEN_MOD_LL,
+    LEN_MOD_J,
+    LEN_MOD_Z,
+    LEN_MOD_T,
+    LEN_MOD_BIG_L
+} DeferredLenMod;
+
+typedef struct {
+    uint32_t len;       // spec length, from '%' to conversion
+    char flags[DLOG_DEFERRED_FLAG_NUM + 1U];
+    bool widthStar;
+    bool precStar;
+    int32_t width;      // -1 means not set
+    int32_t prec;       // -1 means not set
+    DeferredLenMod lenMod;
+    char conv;
+} DeferredSpec;
+
+typedef struct {
+    int64_t sec;
+    int64_t nsec;
+} DeferredTime;
+
+/*
+ * addr is published after fmt, an entry with fmt but without addr is being registered by another thread.
+ * Entries are never removed, fmt is a copy so it stays valid after the caller is unloaded.
+ */
+typedef struct {
+    const char *addr;   // format address of caller
+    char *fmt;          // copy of format
+} DeferredFmt;
+
+STATIC DeferredFmt g_deferredFmt[DLOG_DEFERRED_FMT_NUM];
+
+/*
+ * Format ids resolved by this thread, a hit skips the probe and the strcmp against the copy.
+ * The cache is dropped when g_deferredFmtGen changes, the generation follows the number of unloaded libraries,
+ * so an address reused by a library loaded after dlclose is checked against the table again.
+ */
+typedef struct {
+    const char *addr;
+    int32_t id;
+} DeferredFmtCache;
+
+STATIC uint64_t g_deferredFmtGen = 0;
+STATIC uint64_t g_deferredUnloadNum = 0;
+STATIC __thread DeferredFmtCache g_deferredFmtCache[DLOG_DEFERRED_CACHE_NUM];
+STATIC __thread uint64_t g_deferredFmtCacheGen = 0;
+
+bool DlogDeferredEnabled(void)
+{
+    static int32_t deferredFlag = -1;
+    if (deferredFlag == -1) {
+        const char *envValue = getenv(DLOG_DEFERRED_ENV_NAME);
+        deferredFlag = ((envValue != NULL) && (strcmp(envValue, "1") == 0)) ? 1 : 0;
+        if (deferredFlag == 1) {
+            SELF_LOG_INFO("deferred log format enabled by environment variable '%s'.", DLOG_DEFERRED_ENV_NAME);
+        }
+    }
+    return (deferredFlag == 1) ? true : false;
+}
+
+STATIC char *DlogCopyFmt(const char *fmt)
+{
+    const size_t len = strlen(fmt);
+    char *copy = (char *)malloc(len + 1U);
+    ONE_ACT_NO_LOG(copy == NULL, return NULL);
+    (void)memcpy_s(copy, len + 1U, fmt, len + 1U);
+    return copy;
+}
+
+STATIC int32_t DlogGetUnloadNum(struct dl_phdr_info *info, size_t size, void *data)
+{
+    (void)size;
+    *(uint64_t *)data = (uint64_t)info->dlpi_subs;
+    return 1; // counter is the same for all objects, stop after the first one
+}
+
+/**
+ * @brief       : drop format ids cached by threads when a library has been unloaded since last check,
+ *                called by the send task so that writers only read the generation
+ */
+void DlogDeferredCheckUnload(void)
+{
+    uint64_t unloadNum = 0;
+    (void)dl_iterate_phdr(DlogGetUnloadNum, &unloadNum);
+    if (unloadNum != g_deferredUnloadNum) {
+        g_deferredUnloadNum = unloadNum;
+        (void)__atomic_add_fetch(&g_deferredFmtGen, 1U, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief       : look up format in the process wide table, register it when the address is seen for the first time
+ * @param [in]  : fmt           log content format
+ * @param [in]  : hash          hash of format address
+ * @return      : id of format; -1 table is full or address is reused by another format
+ */
+STATIC int32_t DlogLookupFmtId(const char *fmt, uint32_t hash)
+{
+    for (uint32_t i = 0; i < DLOG_DEFERRED_FMT_PROBE; i++) {
+        const uint32_t id = (hash + i) & (DLOG_DEFERRED_FMT_NUM - 1U);
+        DeferredFmt *entry = &g_deferredFmt[id];
+        const char *addr = __atomic_load_n(&entry->addr, __ATOMIC_ACQUIRE);
+        if (addr == fmt) {
+            // a library loaded after dlclose may put another format at the same address
+            return (strcmp(entry->fmt, fmt) == 0) ? (int32_t)id : -1;
+        }
+        if ((addr != NULL) || (__atomic_load_n(&entry->fmt, __ATOMIC_ACQUIRE) != NULL)) {
+            continue;
+        }
+        char *copy = DlogCopyFmt(fmt);
+        ONE_ACT_NO_LOG(copy == NULL, return -1);
+        char *expect = NULL;
+        if (!__atomic_compare_exchange_n(&entry->fmt, &expect, copy, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            free(copy);
+            continue;
+        }
+        __atomic_store_n(&entry->addr, fmt, __ATOMIC_RELEASE);
+        return (int32_t)id;
+    }
+    return -1;
+}
+
+/**
+ * @brief       : get id of format, ids resolved by the calling thread are taken from its cache
+ * @param [in]  : fmt           log content format
+ * @return      : id of format; -1 format can not be registered
+ */
+STATIC int32_t DlogGetFmtId(const char *fmt)
+{
+    const uint64_t hash = ((uint64_t)(uintptr_t)fmt * DLOG_DEFERRED_HASH_FACTOR) >> (64U - DLOG_DEFERRED_FMT_BITS);
+    const uint64_t gen = __atomic_load_n(&g_deferredFmtGen, __ATOMIC_ACQUIRE);
+    if (gen != g_deferredFmtCacheGen) {
+        (void)memset_s(g_deferredFmtCache, sizeof(g_deferredFmtCache), 0, sizeof(g_deferredFmtCache));
+        g_deferredFmtCacheGen = gen;
+    }
+    DeferredFmtCache *cache = &g_deferredFmtCache[hash & (DLOG_DEFERRED_CACHE_NUM - 1U)];
+    if (cache->addr == fmt) {
+        return cache->id;
+    }
+    const int32_t id = DlogLookupFmtId(fmt, (uint32_t)hash);
+    if (id >= 0) {
+        cache->addr = fmt;
+        cache->id = id;
+    }
+    return id;
+}
+
+STATIC int32_t DlogParseNumber(const char *str, uint32_t *idx)
+{
+    int32_t num = 0;
+    while ((str[*idx] >= '0') && (str[*idx] <= '9')) {
+        if (num < (INT32_MAX / 10)) { // 10: decimal
+            num = num * 10 + (str[*idx] - '0'); // 10: decimal
+        }
+        (*idx)++;
+    }
+    return num;
+}
+
+STATIC DeferredLenMod DlogParseLenMod(const char *str, uint32_t *idx)
+{
+    switch (str[*idx]) {
+        case 'h':
+            (*idx)++;
+            if (str[*idx] == 'h') {
+                (*idx)++;
+                return LEN_MOD_HH;
+            }
+            return LEN_MOD_H;
+        case 'l':
+            (*idx)++;
+            if (str[*idx] == 'l') {
+                (*idx)++;
+                return LEN_MOD_LL;
+            }
+            return LEN_MOD_L;
+        case 'q':
+            (*idx)++;
+            return LEN_MOD_LL;
+        case 'j':
+            (*idx)++;
+            return LEN_MOD_J;
+        case 'z':
+            (*idx)++;
+            return LEN_MOD_Z;
+        case 't':
+            (*idx)++;
+            return LEN_MOD_T;
+        case 'L':
+            (*idx)++;
+            return LEN_MOD_BIG_L;
+        default:
+            return LEN_MOD_NONE;
+    }
+}
+
+/**
+ * @brief       : parse one conversion specification
+ * @param [in]  : str       point to '%'
+ * @param [out] : spec      parsed specification
+ * @return      : true supported; false not supported, log must be formatted by caller
+ */
+STATIC bool DlogParseSpec(const char *str, DeferredSpec *spec)
+{
+    (void)memset_s(spec, sizeof(DeferredSpec), 0, sizeof(DeferredSpec));
+    uint32_t idx = 1U;
+    uint32_t flagNum = 0;
+    while ((str[idx] == '-') || (str[idx] == '+') || (str[idx] == ' ') || (str[idx] == '#') || (str[idx] == '0')) {
+        ONE_ACT_NO_LOG(flagNum >= DLOG_DEFERRED_FLAG_NUM, return false);
+        spec->flags[flagNum++] = str[idx++];
+    }
+    spec->width = -1;
+    if (str[idx] == '*') {
+        spec->widthStar = true;
+        idx++;
+    } else if ((str[idx] >= '0') && (str[idx] <= '9')) {
+        spec->width = DlogParseNumber(str, &idx);
+    }
+    spec->prec = -1;
+    if (str[idx] == '.') {
+        idx++;
+        if (str[idx] == '*') {
+            spec->precStar = true;
+            idx++;
+        } else {
+            spec->prec = DlogParseNumber(str, &idx);
+        }
+    }
+    spec->lenMod = DlogParseLenMod(str, &idx);
+    spec->conv = str[idx];
+    spec->len = idx + 1U;
+    switch (spec->conv) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            return spec->lenMod != LEN_MOD_BIG_L;
+        case 'c': case 's':
+            return spec->lenMod == LEN_MOD_NONE; // wide char is not supported
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return spec->lenMod != LEN_MOD_BIG_L; // long double is not supported
+        case 'p':
+            return true;
+        default:
+            return false; // %n and unknown conversions
+    }
+}
+
+STATIC bool DlogPutArg(char *buf, uint32_t bufLen, uint32_t *pos, const void *arg)
+{
+    ONE_ACT_NO_LOG(*pos + DLOG_DEFERRED_ARG_SIZE > bufLen, return false);
+    (void)memcpy_s(buf + *pos, bufLen - *pos, arg, DLOG_DEFERRED_ARG_SIZE);
+    *pos += DLOG_DEFERRED_ARG_SIZE;
+    return true;
+}
+
+STATIC int64_t DlogGetSignedArg(DeferredLenMod lenMod, va_list *v)
+{
+    switch (lenMod) {
+        case LEN_MOD_HH:
+            return (int64_t)(signed char)va_arg(*v, int);
+        case LEN_MOD_H:
+            return (int64_t)(short)va_arg(*v, int);
+        case LEN_MOD_L:
+            return (int64_t)va_arg(*v, long);
+        case LEN_MOD_LL:
+            return (int64_t)va_arg(*v, long long);
+        case LEN_MOD_J:
+            return (int64_t)va_arg(*v, intmax_t);
+        case LEN_MOD_Z:
+            return (int64_t)va_arg(*v, ssize_t);
+        case LEN_MOD_T:
+            return (int64_t)va_arg(*v, ptrdiff_t);
+        default:
+            return (int64_t)va_arg(*v, int);
+    }
+}
+
+STATIC uint64_t DlogGetUnsignedArg(DeferredLenMod lenMod, va_list *v)
+{
+    switch (lenMod) {
+        case LEN_MOD_HH:
+            return (uint64_t)(unsigned char)va_arg(*v, unsigned int);
+        case LEN_MOD_H:
+            return (uint64_t)(unsigned short)va_arg(*v, unsigned int);
+        case LEN_MOD_L:
+            return (uint64_t)va_arg(*v, unsigned long);
+        case LEN_MOD_LL:
+            return (uint64_t)va_arg(*v, unsigned long long);
+        case LEN_MOD_J:
+            return (uint64_t)va_arg(*v, uintmax_t);
+        case LEN_MOD_Z:
+            return (uint64_t)va_arg(*v, size_t);
+        case LEN_MOD_T:
+            return (uint64_t)va_arg(*v, ptrdiff_t);
+        default:
+            return (uint64_t)va_arg(*v, unsigned int);
+    }
+}
+
+STATIC bool DlogPutStrArg(char *buf, uint32_t bufLen, uint32_t *pos, const char *str, int32_t prec)
+{
+    ONE_ACT_NO_LOG(*pos + DLOG_DEFERRED_LEN_SIZE > bufLen, return false);
+    uint16_t len = (uint16_t)DLOG_DEFERRED_NULL_STR;
+    if (str != NULL) {
+        // string is copied now, caller may release it as soon as the log call returns
+        size_t maxLen = bufLen - *pos - DLOG_DEFERRED_LEN_SIZE;
+        if ((prec >= 0) && ((size_t)prec < maxLen)) {
+            maxLen = (size_t)prec;
+        }
+        len = (uint16_t)strnlen(str, maxLen);
+    }
+    (void)memcpy_s(buf + *pos, bufLen - *pos, &len, DLOG_DEFERRED_LEN_SIZE);
+    *pos += DLOG_DEFERRED_LEN_SIZE;
+    if (len != (uint16_t)DLOG_DEFERRED_NULL_STR) {
+        (void)memcpy_s(buf + *pos, bufLen - *pos, str, len);
+        *pos += len;
+    }
+    return true;
+}
+
+STATIC bool DlogEncodeArg(char *buf, uint32_t bufLen, uint32_t *pos, DeferredSpec *spec, va_list *v)
+{
+    if (spec->widthStar) {
+        int64_t width = (int64_t)va_arg(*v, int);
+        ONE_ACT_NO_LOG(!DlogPutArg(buf, bufLen, pos, &width), return false);
+    }
+    if (spec->precStar) {
+        int64_t prec = (int64_t)va_arg(*v, int);
+        spec->prec = (prec >= 0) ? (int32_t)prec : -1;
+        ONE_ACT_NO_LOG(!DlogPutArg(buf, bufLen, pos, &prec), return false);
+    }
+    switch (spec->conv) {
+        case 'd': case 'i': {
+            int64_t value = DlogGetSignedArg(spec->lenMod, v);
+            return DlogPutArg(buf, bufLen, pos, &value);
+        }
+        case 'u': case 'o': case 'x': case 'X': {
+            uint64_t value = DlogGetUnsignedArg(spec->lenMod, v);
+            return DlogPutArg(buf, bufLen, pos, &value);
+        }
+        case 'c': {
+            int64_t value = (int64_t)va_arg(*v, int);
+            return DlogPutArg(buf, bufLen, pos, &value);
+        }
+        case 'p': {
+            uint64_t value = (uint64_t)(uintptr_t)va_arg(*v, void *);
+            return DlogPutArg(buf, bufLen, pos, &value);
+        }
+        case 's':
+            return DlogPutStrArg(buf, bufLen, pos, va_arg(*v, const char *), spec->prec);
+        default: {
+            double value = va_arg(*v, double);
+            return DlogPutArg(buf, bufLen, pos, &value);
+        }
+    }
+}
+
+/**
+ * @brief       : capture format id and arguments without formatting
+ * @param [out] : buf           encoded data
+ * @param [in]  : bufLen        max length of encoded data
+ * @param [in]  : fmt           log content format
+ * @param [in]  : v             variable list, copied and left untouched for fallback
+ * @param [out] : encodeLen     length of encoded data
+ * @return      : LOG_SUCCESS success; LOG_FAILURE format not supported or too long, caller formats it directly
+ */
+int32_t DlogDeferredEncode(char *buf, uint32_t bufLen, const char *fmt, va_list v, uint32_t *encodeLen)
+{
+    ONE_ACT_NO_LOG((buf == NULL) || (fmt == NULL) || (encodeLen == NULL), return LOG_FAILURE);
+    ONE_ACT_NO_LOG(bufLen < DLOG_DEFERRED_ID_SIZE, return LOG_FAILURE);
+    const int32_t fmtId = DlogGetFmtId(fmt);
+    ONE_ACT_NO_LOG(fmtId < 0, return LOG_FAILURE);
+    uint16_t id = (uint16_t)fmtId;
+    (void)memcpy_s(buf, bufLen, &id, DLOG_DEFERRED_ID_SIZE);
+    uint32_t pos = DLOG_DEFERRED_ID_SIZE;
+
+    va_list args;
+    va_copy(args, v);
+    bool ret = true;
+    const char *cur = strchr(fmt, '%');
+    while (ret && (cur != NULL)) {
+        if (cur[1] == '%') {
+            cur = strchr(cur + 2, '%'); // 2: skip "%%"
+            continue;
+        }
+        DeferredSpec spec;
+        ret = DlogParseSpec(cur, &spec) && DlogEncodeArg(buf, bufLen, &pos, &spec, &args);
+        cur = strchr(cur + spec.len, '%');
+    }
+    va_end(args);
+    ONE_ACT_NO_LOG(!ret, return LOG_FAILURE);
+    *encodeLen = pos;
+    return LOG_SUCCESS;
+}
+
+STATIC bool DlogGetArg(const char *data, uint32_t dataLen, uint32_t *pos, void *arg)
+{
+    ONE_ACT_NO_LOG(*pos + DLOG_DEFERRED_ARG_SIZE > dataLen, return false);
+    (void)memcpy_s(arg, DLOG_DEFERRED_ARG_SIZE, data + *pos, DLOG_DEFERRED_ARG_SIZE);
+    *pos += DLOG_DEFERRED_ARG_SIZE;
+    return true;
+}
+
+/**
+ * @brief       : rebuild the specification with captured width and precision, integers are printed as 64 bits
+ */
+STATIC bool DlogBuildSpec(const DeferredSpec *spec, int64_t width, int64_t prec, char *out, uint32_t outLen)
+{
+    const char *lenStr = "";
+    if ((spec->conv == 'd') || (spec->conv == 'i') || (spec->conv == 'u') || (spec->conv == 'o') ||
+        (spec->conv == 'x') || (spec->conv == 'X')) {
+        lenStr = "ll";
+    }
+    // negative width from '*' means left adjust, zero width is printed as nothing by "%.0lld"
+    const bool hasWidth = spec->widthStar || (spec->width >= 0);
+    const char *leftFlag = (hasWidth && (width < 0)) ? "-" : "";
+    const int64_t absWidth = !hasWidth ? 0 : ((width < 0) ? -width : width);
+    int32_t err;
+    if (prec >= 0) {
+        err = snprintf_s(out, outLen, (size_t)outLen - 1U, "%%%s%s%.0lld.%lld%s%c", spec->flags, leftFlag,
+            (long long)absWidth, (long long)prec, lenStr, spec->conv);
+    } else {
+        err = snprintf_s(out, outLen, (size_t)outLen - 1U, "%%%s%s%.0lld%s%c", spec->flags, leftFlag,
+            (long long)absWidth, lenStr, spec->conv);
+    }
+    return err != -1;
+}
+
+STATIC int32_t DlogDecodeArg(const char *data, uint32_t dataLen, uint32_t *pos, const DeferredSpec *spec,
+    char *text, uint32_t textLen)
+{
+    int64_t width = spec->width;
+    int64_t prec = spec->prec;
+    ONE_ACT_NO_LOG(spec->widthStar && !DlogGetArg(data, dataLen, pos, &width), return -1);
+    ONE_ACT_NO_LOG(spec->precStar && !DlogGetArg(data, dataLen, pos, &prec), return -1);
+    char specStr[DLOG_DEFERRED_SPEC_LEN] = { 0 };
+    ONE_ACT_NO_LOG(!DlogBuildSpec(spec, width, prec, specStr, DLOG_DEFERRED_SPEC_LEN), return -1);
+    if (spec->conv == 's') {
+        uint16_t len = 0;
+        ONE_ACT_NO_LOG(*pos + DLOG_DEFERRED_LEN_SIZE > dataLen, return -1);
+        (void)memcpy_s(&len, sizeof(len), data + *pos, DLOG_DEFERRED_LEN_SIZE);
+        *pos += DLOG_DEFERRED_LEN_SIZE;
+        if (len == (uint16_t)DLOG_DEFERRED_NULL_STR) {
+            return snprintf_truncated_s(text, textLen, specStr, (const char *)NULL);
+        }
+        ONE_ACT_NO_LOG(*pos + len > dataLen, return -1);
+        char str[MSG_LENGTH] = { 0 };
+        (void)memcpy_s(str, sizeof(str) - 1U, data + *pos, len);
+        *pos += len;
+        return snprintf_truncated_s(text, textLen, specStr, str);
+    }
+    uint64_t value = 0;
+    ONE_ACT_NO_LOG(!DlogGetArg(data, dataLen, pos, &value), return -1);
+    switch (spec->conv) {
+        case 'd': case 'i':
+            return snprintf_truncated_s(text, textLen, specStr, (long long)(int64_t)value);
+        case 'u': case 'o': case 'x': case 'X':
+            return snprintf_truncated_s(text, textLen, specStr, (unsigned long long)value);
+        case 'c':
+            return snprintf_truncated_s(text, textLen, specStr, (int)(int64_t)value);
+        case 'p':
+            return snprintf_truncated_s(text, textLen, specStr, (void *)(uintptr_t)value);
+        default: {
+            double fValue = 0;
+            (void)memcpy_s(&fValue, sizeof(fValue), &value, sizeof(value));
+            return snprintf_truncated_s(text, textLen, specStr, fValue);
+        }
+    }
+}
+
+/**
+ * @brief       : format data captured by DlogDeferredEncode
+ * @param [in]  : data          encoded data
+ * @param [in]  : dataLen       length of encoded data
+ * @param [out] : text          formatted text, always null terminated
+ * @param [in]  : textLen       max length of text
+ * @return      : length of text
+ */
+uint32_t DlogDeferredDecode(const char *data, uint32_t dataLen, char *text, uint32_t textLen)
+{
+    ONE_ACT_NO_LOG((data == NULL) || (text == NULL) || (textLen == 0U), return 0);
+    text[0] = '\0';
+    uint16_t id = 0;
+    ONE_ACT_NO_LOG(dataLen < DLOG_DEFERRED_ID_SIZE, return 0);
+    (void)memcpy_s(&id, sizeof(id), data, DLOG_DEFERRED_ID_SIZE);
+    ONE_ACT_NO_LOG(id >= DLOG_DEFERRED_FMT_NUM, return 0);
+    const char *fmt = __atomic_load_n(&g_deferredFmt[id].fmt, __ATOMIC_ACQUIRE);
+    ONE_ACT_NO_LOG(fmt == NULL, return 0);
+    uint32_t pos = DLOG_DEFERRED_ID_SIZE;
+
+    uint32_t textPos = 0;
+    const char *cur = fmt;
+    while ((*cur != '\0') && (textPos + 1U < textLen)) {
+        if (*cur != '%') {
+            text[textPos++] = *cur++;
+            continue;
+        }
+        if (cur[1] == '%') {
+            text[textPos++] = '%';
+            cur += 2; // 2: skip "%%"
+            continue;
+        }
+        DeferredSpec spec;
+        ONE_ACT_NO_LOG(!DlogParseSpec(cur, &spec), break);
+        int32_t ret = DlogDecodeArg(data, dataLen, &pos, &spec, text + textPos, textLen - textPos);
+        ONE_ACT_NO_LOG(ret < 0, break);
+        textPos += (uint32_t)ret;
+        cur += spec.len;
+    }
+    text[textPos] = '\0';
+    return textPos;
+}
+
+/**
+ * @brief       : capture log time, format id and arguments, the log head is not built
+ * @param [out] : buf           encoded log
+ * @param [in]  : bufLen        max length of encoded log
+ * @param [in]  : fmt           log content format
+ * @param [in]  : v             variable list, copied and left untouched for fallback
+ * @param [out] : encodeLen     length of encoded log
+ * @return      : LOG_SUCCESS success; LOG_FAILURE caller formats it directly
+ */
+int32_t DlogDeferredEncodeLog(char *buf, uint32_t bufLen, const char *fmt, va_list v, uint32_t *encodeLen)
+{
+    ONE_ACT_NO_LOG((buf == NULL) || (encodeLen == NULL) || (bufLen < sizeof(DeferredTime)), return LOG_FAILURE);
+    struct timespec timeVal = { 0, 0 };
+    ONE_ACT_NO_LOG(DlogGetTimeVal(&timeVal) != LOG_SUCCESS, return LOG_FAILURE);
+    DeferredTime logTime = { (int64_t)timeVal.tv_sec, (int64_t)timeVal.tv_nsec };
+    (void)memcpy_s(buf, bufLen, &logTime, sizeof(logTime));
+    uint32_t contentLen = 0;
+    int32_t ret = DlogDeferredEncode(buf + sizeof(logTime), bufLen - (uint32_t)sizeof(logTime), fmt, v, &contentLen);
+    ONE_ACT_NO_LOG(ret != LOG_SUCCESS, return LOG_FAILURE);
+    *encodeLen = (uint32_t)sizeof(logTime) + contentLen;
+    return LOG_SUCCESS;
+}
+
+/**
+ * @brief       : build log head and format content of log captured by DlogDeferredEncodeLog
+ * @param [in]  : data          encoded log
+ * @param [in]  : dataLen       length of encoded log
+ * @param [in]  : msgArg        module, level and pid of log, timestamp is filled here
+ * @param [out] : text          log head and content, always null terminated
+ * @param [in]  : textLen       max length of text
+ * @return      : length of text, 0 means failure
+ */
+uint32_t DlogDeferredDecodeLog(const char *data, uint32_t dataLen, LogMsgArg *msgArg, char *text, uint32_t textLen)
+{
+    ONE_ACT_NO_LOG((data == NULL) || (msgArg == NULL) || (text == NULL) || (textLen == 0U), return 0);
+    ONE_ACT_NO_LOG(dataLen < sizeof(DeferredTime), return 0);
+    DeferredTime logTime = { 0, 0 };
+    (void)memcpy_s(&logTime, sizeof(logTime), data, sizeof(logTime));
+    const struct timespec timeVal = { (time_t)logTime.sec, (long)logTime.nsec };
+    DlogFormatTime(&timeVal, msgArg->timestamp, TIMESTAMP_LEN);
+    ONE_ACT_NO_LOG(DlogConstructBaseMsg(text, textLen, msgArg) != SYS_OK, return 0);
+    const uint32_t headLen = (uint32_t)strnlen(text, textLen);
+    return headLen + DlogDeferredDecode(data + sizeof(logTime), dataLen - (uint32_t)sizeof(logTime),
+        text + headLen, textLen - headLen);
+}
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef DLOG_DEFERRED_H
+#define DLOG_DEFERRED_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "dlog_message.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/*
+ * Deferred format: the writing thread only captures the log time, a format id and raw argument values,
+ * the send task builds the log head and formats the content when merging into the buffer sent to slogd,
+ * so slogd still receives text.
+ * A format id indexes a process wide table holding a copy of the format, the copy is taken once when the
+ * format address is first seen and kept until process exit, so records survive a dlclose of the caller.
+ * Encoded content: [uint16 fmtId][arg]..., integer/double/pointer args take 8 bytes,
+ * string args take [uint16 len][bytes], len DLOG_DEFERRED_NULL_STR means NULL pointer.
+ * Encoded log: [int64 sec][int64 nsec][encoded content].
+ */
+bool DlogDeferredEnabled(void);
+int32_t DlogDeferredEncode(char *buf, uint32_t bufLen, const char *fmt, va_list v, uint32_t *encodeLen);
+uint32_t DlogDeferredDecode(const char *data, uint32_t dataLen, char *text, uint32_t textLen);
+int32_t DlogDeferredEncodeLog(char *buf, uint32_t bufLen, const char *fmt, va_list v, uint32_t *encodeLen);
+uint32_t DlogDeferredDecodeLog(const char *data, uint32_t dataLen, LogMsgArg *msgArg, char *text, uint32_t textLen);
+void DlogDeferredCheckUnload(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // DLOG_DEFERRED_H
@@ -136,23 +136,28 @@ int64_t DlogTimeDiff(const struct timespec *lastTv)
     return (timeValue > 0) ? timeValue : 0;
 }
 
-void DlogGetTime(char *timeStr, uint32_t length)
+LogStatus DlogGetTimeVal(struct timespec *timeVal)
 {
-    ONE_ACT_ERR_LOG(timeStr == NULL, return, "[input] time is null.");
-    struct timespec currentTimeval = { 0, 0 };
+    ONE_ACT_ERR_LOG(timeVal == NULL, return LOG_FAILURE, "[input] time is null.");
     static bool isTimeInit = false;
     static clockid_t clockId = LOG_CLOCK_ID_DEFAULT;
-    ONE_ACT_ERR_LOG(LogGetTime(&currentTimeval, &isTimeInit, &clockId) != LOG_SUCCESS, return, "get log time failed.");
+    ONE_ACT_ERR_LOG(LogGetTime(timeVal, &isTimeInit, &clockId) != LOG_SUCCESS, return LOG_FAILURE,
+                    "get log time failed.");
+    return LOG_SUCCESS;
+}
 
+void DlogFormatTime(const struct timespec *timeVal, char *timeStr, uint32_t length)
+{
+    ONE_ACT_ERR_LOG((timeVal == NULL) || (timeStr == NULL), return, "[input] time is null.");
     struct tm timeInfo = { 0 };
-    if (GetLocaltimeR(&timeInfo, currentTimeval.tv_sec) != LOG_SUCCESS) {
+    if (GetLocaltimeR(&timeInfo, timeVal->tv_sec) != LOG_SUCCESS) {
         SELF_LOG_ERROR("get local time failed, strerr=%s.", strerror(ToolGetErrorCode()));
         return;
     }
     int32_t ret = snprintf_s(timeStr, length, length - 1U, "%04d-%02d-%02d-%02d:%02d:%02d.%03ld.%03ld",
                              timeInfo.tm_year, timeInfo.tm_mon, timeInfo.tm_mday, timeInfo.tm_hour, timeInfo.tm_min,
-                             timeInfo.tm_sec, (currentTimeval.tv_nsec / TIME_ONE_THOUSAND_MS) / TIME_ONE_THOUSAND_MS,
-                             (currentTimeval.tv_nsec / TIME_ONE_THOUSAND_MS) % TIME_ONE_THOUSAND_MS);
+                             timeInfo.tm_sec, (timeVal->tv_nsec / TIME_ONE_THOUSAND_MS) / TIME_ONE_THOUSAND_MS,
+                             (timeVal->tv_nsec / TIME_ONE_THOUSAND_MS) % TIME_ONE_THOUSAND_MS);
     if (ret == -1) {
         SELF_LOG_ERROR("snprintf_s time failed, result=%d, strerr=%s.", \
                        ret, strerror(ToolGetErrorCode()));
@@ -160,6 +165,14 @@ void DlogGetTime(char *timeStr, uint32_t length)
     return;
 }
 
+void DlogGetTime(char *timeStr, uint32_t length)
+{
+    ONE_ACT_ERR_LOG(timeStr == NULL, return, "[input] time is null.");
+    struct timespec currentTimeval = { 0, 0 };
+    ONE_ACT_NO_LOG(DlogGetTimeVal(&currentTimeval) != LOG_SUCCESS, return);
+    DlogFormatTime(&currentTimeval, timeStr, length);
+}
+
 #else
 int64_t DlogTimeDiff(const struct timespec *lastTv)
 {
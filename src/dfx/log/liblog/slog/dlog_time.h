@@ -18,6 +18,10 @@ extern "C" {
 #endif
 
 void DlogGetTime(char *timeStr, uint32_t length);
+#if (OS_TYPE_DEF == LINUX)
+LogStatus DlogGetTimeVal(struct timespec *timeVal);
+void DlogFormatTime(const struct timespec *timeVal, char *timeStr, uint32_t length);
+#endif
 
 int64_t DlogTimeDiff(const struct timespec *lastTv);
 
@@ -20,6 +20,7 @@ extern "C" {
 
 void AtomicInit(volatile int32_t* ptr, int32_t val);
 int32_t AtomicLoad(volatile int32_t* ptr);
+void AtomicStore(volatile int32_t* ptr, int32_t val);
 bool AtomicCompareExchangeWeak(volatile int32_t* ptr, int32_t desired, int32_t expected);
 int32_t AtomicAdd(volatile int32_t* ptr, int32_t val);
 
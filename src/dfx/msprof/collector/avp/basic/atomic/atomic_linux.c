@@ -14,6 +14,8 @@ void AtomicInit(volatile int32_t* ptr, int32_t val) { atomic_init((volatile atom
 
 int32_t AtomicLoad(volatile int32_t* ptr) { return atomic_load((volatile atomic_int*)ptr); }
 
+void AtomicStore(volatile int32_t* ptr, int32_t val) { atomic_store((volatile atomic_int*)ptr, val); }
+
 bool AtomicCompareExchangeWeak(volatile int32_t* ptr, int32_t desired, int32_t expected)
 {
     return !atomic_compare_exchange_weak((volatile atomic_int*)ptr, &expected, desired);
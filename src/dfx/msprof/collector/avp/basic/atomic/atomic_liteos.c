@@ -14,6 +14,8 @@ void AtomicInit(volatile int32_t* ptr, int32_t val) { LOS_AtomicSet(ptr, val); }
 
 int32_t AtomicLoad(volatile int32_t* ptr) { return LOS_AtomicRead(ptr); }
 
+void AtomicStore(volatile int32_t* ptr, int32_t val) { LOS_AtomicSet(ptr, val); }
+
 bool AtomicCompareExchangeWeak(volatile int32_t* ptr, int32_t desired, int32_t expected)
 {
     return LOS_AtomicCmpXchg32bits(ptr, desired, expected);
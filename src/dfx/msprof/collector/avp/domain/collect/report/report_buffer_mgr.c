@@ -203,6 +203,7 @@ int32_t ReportInitialize(uint32_t length)
         AtomicInit(&g_report[i].rIndex, 0);
         AtomicInit(&g_report[i].wIndex, 0);
         AtomicInit(&g_report[i].idleWriteIndex, 0);
+        AtomicInit(&g_report[i].waitState, REPORT_WAIT_NONE);
         g_report[i].capacity = length;
         g_report[i].mask = length - 1;
         g_report[i].avails = (uint8_t*)OsalCalloc(sizeof(uint8_t) * length);
@@ -284,6 +285,67 @@ void ReportStop(void)
     (void)OsalMutexUnlock(&g_sizeCount[REPORT_ADDITIONAL_INDEX].sizeMtx);
 }
 
+/**
+ * @brief      Get number of records pushed but not popped yet
+ * @param [in] reportType: which type reportType, api_event/compact/additional
+ * @return     record number
+ */
+static uint32_t ReportBufferFill(int32_t reportType)
+{
+    return (uint32_t)AtomicLoad(&g_report[reportType].wIndex) - (uint32_t)AtomicLoad(&g_report[reportType].rIndex);
+}
+
+/**
+ * @brief      Wake up pop thread after push. Pop thread is woken only if it sleeps on an empty buffer,
+ *             or sleeps for a batch and the buffer reaches the watermark, so most pushes take no lock.
+ * @param [in] reportType: which type reportType, api_event/compact/additional
+ * @return     void
+ */
+static void ReportPushNotify(int32_t reportType)
+{
+    int32_t waitState = AtomicLoad(&g_report[reportType].waitState);
+    if (waitState == REPORT_WAIT_NONE ||
+        (waitState == REPORT_WAIT_BATCH && ReportBufferFill(reportType) < REPORT_BUFFER_WAKEUP_WATERMARK)) {
+        return;
+    }
+    (void)OsalMutexLock(&g_report[reportType].bufMtx);
+    if (AtomicLoad(&g_report[reportType].waitState) != REPORT_WAIT_NONE) {
+        AtomicStore(&g_report[reportType].waitState, REPORT_WAIT_NONE);
+        (void)OsalCondSignal(&g_report[reportType].bufCond);
+    }
+    (void)OsalMutexUnlock(&g_report[reportType].bufMtx);
+}
+
+/**
+ * @brief      Wait until there is a batch of data to pop. Sleep until first push when buffer is empty,
+ *             then sleep until buffer reaches the watermark or flush interval expires.
+ * @param [in] reportType: which type reportType, api_event/compact/additional
+ * @return     void
+ */
+static void ReportPopWait(int32_t reportType)
+{
+    (void)OsalMutexLock(&g_report[reportType].bufMtx);
+    while (!g_isQuit) {
+        // publish wait state before checking fill, pairs with wIndex add and waitState load in push
+        AtomicStore(&g_report[reportType].waitState, REPORT_WAIT_EMPTY);
+        uint32_t fill = ReportBufferFill(reportType);
+        if (fill == 0) {
+            MSPROF_LOGD("Wait for %s push signal.", g_reportName[reportType]);
+            (void)OsalCondTimedWait(
+                &g_report[reportType].bufCond, &g_report[reportType].bufMtx, REPORT_BUFFER_IDLE_TIMEOUT_MS);
+            continue;
+        }
+        AtomicStore(&g_report[reportType].waitState, REPORT_WAIT_BATCH);
+        if (ReportBufferFill(reportType) < REPORT_BUFFER_WAKEUP_WATERMARK) {
+            (void)OsalCondTimedWait(
+                &g_report[reportType].bufCond, &g_report[reportType].bufMtx, REPORT_BUFFER_FLUSH_INTERVAL_MS);
+        }
+        break;
+    }
+    AtomicStore(&g_report[reportType].waitState, REPORT_WAIT_NONE);
+    (void)OsalMutexUnlock(&g_report[reportType].bufMtx);
+}
+
 /**
  * @brief      Push api event data into api_event linked list
  * @param [in] aging: aging flag
@@ -318,10 +380,7 @@ int32_t ReportApiPush(uint8_t aging, const struct MsprofApi* data)
         sizeof(struct MsprofApi));
     g_report[REPORT_API_INDEX].avails[index] = DATA_STATUS_IS_READY;
     (void)AtomicAdd(&g_report[REPORT_API_INDEX].wIndex, 1);
-    // wake up api pop wait
-    (void)OsalMutexLock(&g_report[REPORT_API_INDEX].bufMtx);
-    (void)OsalCondSignal(&g_report[REPORT_API_INDEX].bufCond);
-    (void)OsalMutexUnlock(&g_report[REPORT_API_INDEX].bufMtx);
+    ReportPushNotify(REPORT_API_INDEX);
     return MSPROF_ERROR_NONE;
 }
 
@@ -360,10 +419,7 @@ int32_t ReportCompactPush(uint8_t aging, const struct MsprofCompactInfo* data)
         data, sizeof(struct MsprofCompactInfo));
     g_report[REPORT_COMPACT_INDEX].avails[index] = DATA_STATUS_IS_READY;
     (void)AtomicAdd(&g_report[REPORT_COMPACT_INDEX].wIndex, 1);
-    // wake up compact pop wait
-    (void)OsalMutexLock(&g_report[REPORT_COMPACT_INDEX].bufMtx);
-    (void)OsalCondSignal(&g_report[REPORT_COMPACT_INDEX].bufCond);
-    (void)OsalMutexUnlock(&g_report[REPORT_COMPACT_INDEX].bufMtx);
+    ReportPushNotify(REPORT_COMPACT_INDEX);
     return MSPROF_ERROR_NONE;
 }
 
@@ -403,10 +459,7 @@ int32_t ReportAdditionalPush(uint8_t aging, const struct MsprofAdditionalInfo* d
         sizeof(struct MsprofAdditionalInfo), data, sizeof(struct MsprofAdditionalInfo));
     g_report[REPORT_ADDITIONAL_INDEX].avails[index] = DATA_STATUS_IS_READY;
     (void)AtomicAdd(&g_report[REPORT_ADDITIONAL_INDEX].wIndex, 1);
-    // wake up additional pop wait
-    (void)OsalMutexLock(&g_report[REPORT_ADDITIONAL_INDEX].bufMtx);
-    (void)OsalCondSignal(&g_report[REPORT_ADDITIONAL_INDEX].bufCond);
-    (void)OsalMutexUnlock(&g_report[REPORT_ADDITIONAL_INDEX].bufMtx);
+    ReportPushNotify(REPORT_ADDITIONAL_INDEX);
     return MSPROF_ERROR_NONE;
 }
 
@@ -557,23 +610,6 @@ void DumpApi(void)
     }
 }
 
-/**
- * @brief      wait for api data
- * @return     void
- */
-static void ApiPopWait(void)
-{
-    (void)OsalMutexLock(&g_report[REPORT_API_INDEX].bufMtx);
-    int32_t currReadCusor = AtomicLoad(&g_report[REPORT_API_INDEX].rIndex);
-    int32_t currWriteCusor = AtomicLoad(&g_report[REPORT_API_INDEX].wIndex);
-    if (((uint32_t)currReadCusor & g_report[REPORT_API_INDEX].mask) ==
-        ((uint32_t)currWriteCusor & g_report[REPORT_API_INDEX].mask)) {
-        MSPROF_LOGD("Wait for api push signal.");
-        OsalCondWait(&g_report[REPORT_API_INDEX].bufCond, &g_report[REPORT_API_INDEX].bufMtx);
-    }
-    (void)OsalMutexUnlock(&g_report[REPORT_API_INDEX].bufMtx);
-}
-
 /**
  * @brief      pop api data from api linked list, and save it to tmp list
  * @return     void
@@ -681,23 +717,6 @@ void DumpCompact(void)
     }
 }
 
-/**
- * @brief      wait for compact data
- * @return     void
- */
-static void CompactPopWait(void)
-{
-    (void)OsalMutexLock(&g_report[REPORT_COMPACT_INDEX].bufMtx);
-    int32_t currReadCusor = AtomicLoad(&g_report[REPORT_COMPACT_INDEX].rIndex);
-    int32_t currWriteCusor = AtomicLoad(&g_report[REPORT_COMPACT_INDEX].wIndex);
-    if (((uint32_t)currReadCusor & g_report[REPORT_COMPACT_INDEX].mask) ==
-        ((uint32_t)currWriteCusor & g_report[REPORT_COMPACT_INDEX].mask)) {
-        MSPROF_LOGD("Wait for compact push signal.");
-        OsalCondWait(&g_report[REPORT_COMPACT_INDEX].bufCond, &g_report[REPORT_COMPACT_INDEX].bufMtx);
-    }
-    (void)OsalMutexUnlock(&g_report[REPORT_COMPACT_INDEX].bufMtx);
-}
-
 /**
  * @brief      pop compact data from compact linked list, and save it to tmp list
  * @return     void
@@ -778,23 +797,6 @@ void DumpAdditional(void)
     }
 }
 
-/**
- * @brief      wait for additional data
- * @return     void
- */
-static void AdditionalPopWait(void)
-{
-    (void)OsalMutexLock(&g_report[REPORT_ADDITIONAL_INDEX].bufMtx);
-    int32_t currReadCusor = AtomicLoad(&g_report[REPORT_ADDITIONAL_INDEX].rIndex);
-    int32_t currWriteCusor = AtomicLoad(&g_report[REPORT_ADDITIONAL_INDEX].wIndex);
-    if (((uint32_t)currReadCusor & g_report[REPORT_ADDITIONAL_INDEX].mask) ==
-        ((uint32_t)currWriteCusor & g_report[REPORT_ADDITIONAL_INDEX].mask)) {
-        MSPROF_LOGD("Wait for additional push signal.");
-        OsalCondWait(&g_report[REPORT_ADDITIONAL_INDEX].bufCond, &g_report[REPORT_ADDITIONAL_INDEX].bufMtx);
-    }
-    (void)OsalMutexUnlock(&g_report[REPORT_ADDITIONAL_INDEX].bufMtx);
-}
-
 /**
  * @brief      pop additional data from additional linked list, and save it to tmp list
  * @return     void
@@ -870,7 +872,7 @@ static OsalVoidPtr ApiReportHandle(OsalVoidPtr args)
     (void)OsalMutexUnlock(&g_sizeCount[REPORT_API_INDEX].sizeMtx);
     bool* quit = (bool*)args;
     while (!*quit) {
-        ApiPopWait();
+        ReportPopWait(REPORT_API_INDEX);
         ApiPopRun();
     }
     while (CheckReportStatus(REPORT_API_INDEX)) {
@@ -892,7 +894,7 @@ static OsalVoidPtr CompactReportHandle(OsalVoidPtr args)
     (void)OsalMutexUnlock(&g_sizeCount[REPORT_COMPACT_INDEX].sizeMtx);
     bool* quit = (bool*)args;
     while (!*quit) {
-        CompactPopWait();
+        ReportPopWait(REPORT_COMPACT_INDEX);
         CompactPopRun();
     }
     while (CheckReportStatus(REPORT_COMPACT_INDEX)) {
@@ -914,7 +916,7 @@ static OsalVoidPtr AdditionalReportHandle(OsalVoidPtr args)
     (void)OsalMutexUnlock(&g_sizeCount[REPORT_ADDITIONAL_INDEX].sizeMtx);
     bool* quit = (bool*)args;
     while (!*quit) {
-        AdditionalPopWait();
+        ReportPopWait(REPORT_ADDITIONAL_INDEX);
         AdditionalPopRun();
     }
     while (CheckReportStatus(REPORT_ADDITIONAL_INDEX)) {
@@ -30,11 +30,18 @@ extern "C" {
 #define AGING_TITLE_MAX_LENGTH 20
 #define REPORT_BUFFER_MAX_CYCLES 512U
 #define REPORT_BUFFER_MAX_BATCH 32U
+#define REPORT_BUFFER_WAKEUP_WATERMARK REPORT_BUFFER_MAX_BATCH
+#define REPORT_BUFFER_FLUSH_INTERVAL_MS 5U
+#define REPORT_BUFFER_IDLE_TIMEOUT_MS 100U
+#define REPORT_WAIT_NONE 0
+#define REPORT_WAIT_EMPTY 1
+#define REPORT_WAIT_BATCH 2
 
 typedef struct ReportBuffer {
     volatile int32_t wIndex;
     volatile int32_t rIndex;
     volatile int32_t idleWriteIndex;
+    volatile int32_t waitState; // REPORT_WAIT_*, set by pop thread before it sleeps on bufCond
     uint32_t mask;
     uint32_t capacity;
     uint8_t* avails;
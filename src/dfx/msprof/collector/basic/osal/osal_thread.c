@@ -25,6 +25,20 @@ int32_t OsalCondSignal(OsalCond* condition) { return pthread_cond_signal(conditi
 
 VOID OsalCondWait(OsalCond* condition, OsalMutex* mutex) { (void)pthread_cond_wait(condition, mutex); }
 
+int32_t OsalCondTimedWait(OsalCond* condition, OsalMutex* mutex, uint32_t timeoutMs)
+{
+    struct timespec absTime = {0, 0};
+    (void)clock_gettime(CLOCK_REALTIME, &absTime);
+    absTime.tv_sec += (time_t)(timeoutMs / 1000U);
+    absTime.tv_nsec += (long)(timeoutMs % 1000U) * 1000000L;
+    if (absTime.tv_nsec >= 1000000000L) {
+        absTime.tv_sec++;
+        absTime.tv_nsec -= 1000000000L;
+    }
+    int32_t ret = pthread_cond_timedwait(condition, mutex, &absTime);
+    return (ret == ETIMEDOUT) ? OSAL_EN_TIMEOUT : ret;
+}
+
 int32_t OsalCreateThread(OsalThread* threadHandle, UserProcFunc func)
 {
     if ((threadHandle == NULL) || (func == NULL)) {
@@ -28,6 +28,7 @@ int32_t OsalCondInit(OsalCond* condition);
 int32_t OsalCondDestroy(OsalCond* condition);
 int32_t OsalCondSignal(OsalCond* condition);
 VOID OsalCondWait(OsalCond* condition, OsalMutex* mutex);
+int32_t OsalCondTimedWait(OsalCond* condition, OsalMutex* mutex, uint32_t timeoutMs);
 int32_t OsalCreateThread(OsalThread* threadHandle, UserProcFunc func);
 
 #ifdef __cplusplus
@@ -9,6 +9,7 @@
  */
 
 #include "trace_system_api.h"
+#include <sched.h>
 #include "adiag_print.h"
 #include "adiag_utils.h"
 #include "trace_types.h"
@@ -23,6 +24,24 @@ int32_t TraceDlclose(void* handle) { return mmDlclose(handle); }
 
 int32_t TraceGetPid(void) { return mmGetPid(); }
 
+/**
+ * @brief       get the cpu the calling thread is running on
+ * @return      cpu id, -1 if unknown
+ */
+int32_t TraceGetCpuId(void) { return sched_getcpu(); }
+
+/**
+ * @brief       get the number of configured cpus
+ * @return      cpu num, at least 1
+ */
+uint32_t TraceGetCpuNum(void)
+{
+    long cpuNum = sysconf(_SC_NPROCESSORS_CONF);
+    return (cpuNum > 0) ? (uint32_t)cpuNum : 1U;
+}
+
+void TraceSchedYield(void) { (void)sched_yield(); }
+
 int32_t TraceRaise(int32_t signo)
 {
 #if defined _ADIAG_LLT_
@@ -45,6 +45,9 @@ void* TraceDlsym(void* handle, const char* funcName);
 int32_t TraceDlclose(void* handle);
 
 int32_t TraceGetPid(void);
+int32_t TraceGetCpuId(void);
+uint32_t TraceGetCpuNum(void);
+void TraceSchedYield(void);
 
 int32_t TraceRaise(int32_t signo);
 int32_t TraceChmod(const char* dirPath, uint32_t mode);
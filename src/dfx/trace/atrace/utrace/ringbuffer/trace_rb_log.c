@@ -19,15 +19,24 @@
 
 #define AVERAGE(a, b) (((a) + (b)) >> 1)
 #define MIN(a, b) ((a) > (b) ? (b) : (a))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define ALIGN_UP(x, align) (((x) + (align) - 1U) / (align) * (align))
 #define AO_F_ADD(ptr, value)        ((__typeof__(*(ptr)))__sync_fetch_and_add((ptr), (value)))
 #define AO_SUB_F(ptr, value)        ((__typeof__(*(ptr)))__sync_sub_and_fetch((ptr), (value)))
 #define AO_SET(ptr, value)          ((void)__sync_lock_test_and_set((ptr), (value)))
+#define AO_CLR(ptr)                 (__sync_lock_release((ptr)))
 #define AO_CASB(ptr, comp, value)   (__sync_bool_compare_and_swap((ptr), (comp), (value)))
+#define AO_MB()                     (__sync_synchronize())
 #define MAX_RING_BUFFER_SIZE 1024U
 #define MIN_RING_BUFFER_SIZE 1U
 #define MAX_MSG_SIZE 1024U
 #define MIN_MSG_SIZE 64U
 #define MAX_RING_BUFFER_SPACE 131072U // 128M
+#define RB_LOG_MSG_ALIGN 8U
+#define RB_LOG_RING_ALIGN 64U
+#define RB_LOG_MAX_RING_NUM 8U
+#define RB_LOG_RING_MIN_MSG_NUM 32U   // each ring keeps at least this many msgs of msgTxtSize bytes
+#define RB_LOG_WRITE_RETRY_NUM 32U
 
 STATIC INLINE void TraceRbLogInitTime(struct RbLogCtrl *head)
 {
@@ -82,6 +91,74 @@ STATIC INLINE TraStatus TraceRbLogInitDataStruct(struct RbLog *rb, const TraceAt
     return TRACE_SUCCESS;
 }
 
+/**
+ * @brief       get bytes taken by a msg in ring
+ * @param [in]  txtSize:    msg txt size
+ * @return      msg space, with one more byte for the string terminator added on read
+ */
+STATIC INLINE uint32_t TraceRbLogGetMsgSpace(uint32_t txtSize)
+{
+    return ALIGN_UP((uint32_t)sizeof(RbMsgHead) + txtSize + 1U, RB_LOG_MSG_ALIGN);
+}
+
+/**
+ * @brief       get ring num, one ring per cpu as long as every ring can keep enough msgs
+ * @param [in]  attr:       trace attr
+ * @param [in]  dataSpace:  bytes of all ring data
+ * @param [in]  msgSpace:   bytes taken by a msg of msgTxtSize
+ * @return      ring num
+ */
+STATIC uint32_t TraceRbLogGetRingNum(const TraceAttr *attr, uint32_t dataSpace, uint32_t msgSpace)
+{
+    if (attr->noLock == TRACE_LOCK_FREE) {
+        return 1U; // single writer, nothing to spread
+    }
+    uint32_t ringNum = MIN(TraceGetCpuNum(), RB_LOG_MAX_RING_NUM);
+    while ((ringNum > 1U) && ((dataSpace / ringNum) < (msgSpace * RB_LOG_RING_MIN_MSG_NUM))) {
+        ringNum--;
+    }
+    return ringNum;
+}
+
+STATIC INLINE RbLogRing *TraceRbLogGetRing(struct RbLog *rb, uint32_t ringIdx)
+{
+    return (RbLogRing *)(rb->msg + sizeof(RbLogRing) * ringIdx);
+}
+
+STATIC INLINE RbLogMsg *TraceRbLogGetMsgByPos(struct RbLog *rb, const RbLogRing *ring, uint64_t pos)
+{
+    return (RbLogMsg *)(rb->msg + ring->offset + (uint32_t)(pos % rb->head.ringSize));
+}
+
+STATIC INLINE RbLogMsg *TraceRbLogGetScratch(struct RbLog *rb)
+{
+    return (RbLogMsg *)(rb->msg + rb->head.dataSize - rb->head.msgSize);
+}
+
+/**
+ * @brief       get bytes from pos to the end of ring, msgs never wrap around the end of ring
+ * @param [in]  rb:         ringbuffer ptr
+ * @param [in]  pos:        byte position in ring
+ * @return      bytes left
+ */
+STATIC INLINE uint32_t TraceRbLogGetRingLeft(const struct RbLog *rb, uint64_t pos)
+{
+    return rb->head.ringSize - (uint32_t)(pos % rb->head.ringSize);
+}
+
+STATIC void TraceRbLogInitRing(struct RbLog *rb, uint32_t msgSpace, uint32_t ringNum, uint32_t dataSpace)
+{
+    struct RbLogCtrl *head = &rb->head;
+    uint32_t ringHeadSize = (uint32_t)sizeof(RbLogRing) * ringNum;
+    for (uint32_t i = 0; i < ringNum; i++) {
+        RbLogRing *ring = TraceRbLogGetRing(rb, i);
+        ring->offset = ringHeadSize + i * head->ringSize;
+        ring->readEnd = UINT64_MAX;
+    }
+    ADIAG_INF("[%s] init %u rings, ring size %u bytes, max msg space %u bytes, data space %u bytes",
+        head->name, ringNum, head->ringSize, msgSpace, dataSpace);
+}
+
 /**
  * @brief       create log ringbuffer
  * @param [in]  name:       ringbuffer name
@@ -106,7 +183,13 @@ struct RbLog *TraceRbLogCreate(const char *name, const TraceAttr *attr)
         ADIAG_ERR("[%s] buffer space %zu bytes exceed max buffer space %u bytes", name, totalSize, MAX_RING_BUFFER_SPACE);
         return NULL;
     }
-    totalSize += sizeof(RbLog);
+    // the data space of msgSize * bufferSize is split into per-cpu rings of variable length msgs
+    uint32_t msgSpace = TraceRbLogGetMsgSpace(msgTxtSize);
+    uint32_t ringNum = TraceRbLogGetRingNum(attr, msgSize * bufferSize, msgSpace);
+    uint32_t ringSize = MAX((msgSize * bufferSize / ringNum) / RB_LOG_RING_ALIGN * RB_LOG_RING_ALIGN,
+        ALIGN_UP(msgSpace, RB_LOG_RING_ALIGN));
+    uint32_t dataSize = (uint32_t)sizeof(RbLogRing) * ringNum + ringSize * ringNum + msgSize;
+    totalSize = sizeof(RbLog) + dataSize;
     struct RbLog *rb = AdiagMalloc(totalSize);
     if (rb == NULL) {
         ADIAG_ERR("[%s] malloc ring buffer failed.", name);
@@ -124,13 +207,15 @@ struct RbLog *TraceRbLogCreate(const char *name, const TraceAttr *attr)
         ADIAG_SAFE_FREE(rb);
         return NULL;
     }
-    head->readIdx = 0;
-    head->writeIdx = 0;
     head->bufSize = bufferSize;
     head->msgSize = msgSize;
     head->msgTxtSize = msgTxtSize;
     head->mask = bufferSize - 1U;
     head->errCount = 0;
+    head->ringNum = ringNum;
+    head->ringSize = ringSize;
+    head->dataSize = dataSize;
+    TraceRbLogInitRing(rb, msgSpace, ringNum, msgSize * bufferSize);
     TraceRbLogInitTime(head);
     ADIAG_INF("[%s] create ring buffer successfully, "
         "msgSize %u bytes, msgTxtSize %u bytes, bufferSize %u bytes, msg space %u bytes, total space %zu bytes",
@@ -156,9 +241,80 @@ void TraceRbLogDestroy(struct RbLog *rb)
     }
 }
 
-STATIC INLINE RbLogMsg *TraceRbLogGetMsgByIndex(struct RbLog *rb, uint32_t msgIndex)
+/**
+ * @brief       drop oldest msgs of ring until the bytes up to endPos fit in it
+ * @param [in]  rb:         ringbuffer ptr
+ * @param [in]  ring:       ring owned by caller
+ * @param [in]  endPos:     byte position after the msg to write
+ * @return      NA
+ */
+STATIC void TraceRbLogMakeRoom(struct RbLog *rb, RbLogRing *ring, uint64_t endPos)
+{
+    while ((endPos - ring->tailPos) > rb->head.ringSize) {
+        uint32_t left = TraceRbLogGetRingLeft(rb, ring->tailPos);
+        const RbLogMsg *msg = TraceRbLogGetMsgByPos(rb, ring, ring->tailPos);
+        if ((left < sizeof(RbMsgHead)) || (msg->head.txtSize == 0)) {
+            ring->tailPos += left; // skipped end of ring
+            continue;
+        }
+        ring->tailPos += TraceRbLogGetMsgSpace(msg->head.txtSize);
+        ring->msgCount--;
+    }
+    // lock-free readers check tailPos after reading, publish it before the old msgs are overwritten
+    AO_MB();
+}
+
+/**
+ * @brief       write msg to ring, caller owns the ring
+ * @param [in]  rb:         ringbuffer ptr
+ * @param [in]  ring:       ring to write
+ * @param [in]  buffer:     data buffer
+ * @param [in]  txtSize:    data size, not more than msgTxtSize
+ * @return      TraStatus
+ */
+STATIC TraStatus TraceRbLogWriteRing(struct RbLog *rb, RbLogRing *ring, uint8_t bufferType, const char *buffer,
+    uint32_t txtSize)
+{
+    uint64_t pos = ring->headPos;
+    uint32_t left = TraceRbLogGetRingLeft(rb, pos);
+    uint32_t msgSpace = TraceRbLogGetMsgSpace(txtSize);
+    if (left < msgSpace) {
+        TraceRbLogMakeRoom(rb, ring, pos + left);
+        if (left >= sizeof(RbMsgHead)) {
+            TraceRbLogGetMsgByPos(rb, ring, pos)->head.txtSize = 0; // mark the end of ring as skipped
+        }
+        pos += left;
+    }
+    TraceRbLogMakeRoom(rb, ring, pos + msgSpace);
+    RbLogMsg *msg = TraceRbLogGetMsgByPos(rb, ring, pos);
+    int32_t ret = memcpy_s(msg->txt, msgSpace - sizeof(RbMsgHead), buffer, txtSize);
+    if (ret != EOK) {
+        return TRACE_FAILURE;
+    }
+    msg->txt[txtSize] = '\0';
+    // cycle counters of cpus may differ slightly, msgs of one ring must stay in order for the merge on read
+    uint64_t cycle = GetCpuCycleCounter() - rb->head.monotonicTime;
+    cycle = MAX(cycle, ring->lastCycle);
+    msg->head.cycle = cycle;
+    msg->head.txtSize = txtSize;
+    msg->head.busy = false;
+    msg->head.bufferType = bufferType;
+    msg->head.reserve[0] = 0;
+    msg->head.reserve[1] = 0;
+    ring->lastCycle = cycle;
+    AO_MB();
+    ring->headPos = pos + msgSpace;
+    ring->msgCount++;
+    return TRACE_SUCCESS;
+}
+
+STATIC INLINE uint32_t TraceRbLogGetCpuRingIdx(const struct RbLog *rb)
 {
-    return (RbLogMsg *)(rb->msg + rb->head.msgSize * msgIndex);
+    if (rb->head.ringNum == 1U) {
+        return 0;
+    }
+    int32_t cpuId = TraceGetCpuId();
+    return (cpuId < 0) ? 0 : ((uint32_t)cpuId % rb->head.ringNum);
 }
 
 /**
@@ -178,27 +334,29 @@ TraStatus TraceRbLogWriteRbMsg(struct RbLog *rb, uint8_t bufferType, const char
             rb->head.name, txtSize, rb->head.msgTxtSize);
         txtSize = rb->head.msgTxtSize;
     }
-    uint64_t monotonicTime = GetCpuCycleCounter();
-    uint64_t originalWriteIdx = AO_F_ADD(&rb->head.writeIdx, 1);
-    uint32_t writeIdx = (uint32_t)(originalWriteIdx & rb->head.mask);
-    RbLogMsg *msg = TraceRbLogGetMsgByIndex(rb, writeIdx);
-    if (!AO_CASB(&msg->head.busy, false, true)) {
-        uint32_t errCount = AO_F_ADD(&rb->head.errCount, 1);
-        if ((errCount & rb->head.mask) == 0) {
-            ADIAG_WAR("[%s] can not write msg [%s] to index %u, buffer is busy", rb->head.name, buffer, writeIdx);
+    // write to the ring of current cpu, turn to the next ring if it is taken by another thread
+    uint32_t ringIdx = TraceRbLogGetCpuRingIdx(rb);
+    for (uint32_t retry = 0; retry < RB_LOG_WRITE_RETRY_NUM; retry++) {
+        for (uint32_t i = 0; i < rb->head.ringNum; i++) {
+            RbLogRing *ring = TraceRbLogGetRing(rb, (ringIdx + i) % rb->head.ringNum);
+            if (!AO_CASB(&ring->lock, false, true)) {
+                continue;
+            }
+            TraStatus ret = TraceRbLogWriteRing(rb, ring, bufferType, buffer, txtSize);
+            AO_CLR(&ring->lock);
+            if (ret != TRACE_SUCCESS) {
+                ADIAG_ERR("[%s] memcpy_s ringbuffer msg failed.", rb->head.name);
+            }
+            return ret;
         }
-        return TRACE_FAILURE;
+        // all rings are taken, the owner may be preempted on this cpu
+        TraceSchedYield();
     }
-    int32_t ret = memcpy_s(msg->txt, rb->head.msgTxtSize, buffer, txtSize);
-    if (ret != EOK) {
-        ADIAG_ERR("[%s] memcpy_s ringbuffer msg failed.", rb->head.name);
-        return TRACE_FAILURE;
+    uint32_t errCount = AO_F_ADD(&rb->head.errCount, 1);
+    if ((errCount & rb->head.mask) == 0) {
+        ADIAG_WAR("[%s] can not write msg [%s], all rings are busy", rb->head.name, buffer);
     }
-    msg->head.cycle = monotonicTime - rb->head.monotonicTime;
-    msg->head.txtSize = txtSize;
-    msg->head.bufferType = bufferType;
-    AO_SET(&msg->head.busy, false);
-    return TRACE_SUCCESS;
+    return TRACE_FAILURE;
 }
 
 TraStatus TraceRbLogWriteRbMsgNoLock(struct RbLog *rb, uint8_t bufferType, const char *buffer, uint32_t bufSize)
@@ -206,59 +364,69 @@ TraStatus TraceRbLogWriteRbMsgNoLock(struct RbLog *rb, uint8_t bufferType, const
     if ((buffer == NULL) || (bufSize == 0)) {
         return TRACE_INVALID_PARAM;
     }
-    struct RbLogCtrl *head = &rb->head;
-    RbLogMsg *msg = (RbLogMsg *)(rb->msg + head->msgSize * (uint32_t)((++head->writeIdx) & head->mask));
-    uint32_t txtSize = MIN(bufSize, head->msgTxtSize);
-
-    int32_t ret = memcpy_s(msg->txt, head->msgTxtSize, buffer, txtSize);
-    if (ret != EOK) {
-        return TRACE_FAILURE;
-    }
-    msg->head.cycle = GetCpuCycleCounter() - head->monotonicTime;
-    msg->head.txtSize = txtSize;
-    msg->head.bufferType = bufferType;
-    return TRACE_SUCCESS;
+    // single writer, ring num is 1 when created with noLock
+    uint32_t txtSize = MIN(bufSize, rb->head.msgTxtSize);
+    return TraceRbLogWriteRing(rb, TraceRbLogGetRing(rb, 0), bufferType, buffer, txtSize);
 }
 
-STATIC INLINE int RbLogMsgCmp(const void *a, const void *b)
+/**
+ * @brief       count msgs of a copied ring and drop the broken ones at its end
+ * @param [in]  rb:         copied ringbuffer
+ * @param [in]  ring:       copied ring
+ * @return      NA
+ */
+STATIC void TraceRbLogCountRingMsg(struct RbLog *rb, RbLogRing *ring)
 {
-    const RbLogMsg *msgA = (const RbLogMsg *)a;
-    const RbLogMsg *msgB = (const RbLogMsg *)b;
-    if (msgA->head.busy != msgB->head.busy) {
-        return msgA->head.busy ? 1 : 0;     // msgA->head.busy > msgB->head.busy
+    uint64_t pos = ring->tailPos;
+    ring->msgCount = 0;
+    while (pos < ring->headPos) {
+        uint32_t left = TraceRbLogGetRingLeft(rb, pos);
+        const RbLogMsg *msg = TraceRbLogGetMsgByPos(rb, ring, pos);
+        if ((left < sizeof(RbMsgHead)) || (msg->head.txtSize == 0)) {
+            pos += left;
+            continue;
+        }
+        uint32_t msgSpace = TraceRbLogGetMsgSpace(msg->head.txtSize);
+        if ((msg->head.txtSize > rb->head.msgTxtSize) || (msgSpace > left) || (pos + msgSpace > ring->headPos)) {
+            break;
+        }
+        pos += msgSpace;
+        ring->msgCount++;
     }
-    return msgA->head.cycle > msgB->head.cycle;
+    ring->headPos = pos;
 }
 
-STATIC TraStatus TraceRbLogCopyMsg(struct RbLog *newRb, struct RbLog *rb, uint32_t msgIndex)
+/**
+ * @brief       copy one ring to new buffer without stopping its writers
+ * @param [in]  newRb:      new ringbuffer
+ * @param [in]  rb:         original ringbuffer
+ * @param [in]  ringIdx:    ring index
+ * @return      TraStatus
+ */
+STATIC TraStatus TraceRbLogCopyRing(struct RbLog *newRb, struct RbLog *rb, uint32_t ringIdx)
 {
-    uint32_t msgTxtSize = rb->head.msgTxtSize;
-    RbLogMsg *msg = TraceRbLogGetMsgByIndex(rb, msgIndex);
-    RbLogMsg *newMsg = TraceRbLogGetMsgByIndex(newRb, msgIndex);
-
-    uint64_t cycle = msg->head.cycle;
-    int32_t ret = memcpy_s(&newMsg->txt, msgTxtSize, &msg->txt, msgTxtSize);
-    if (ret != EOK) {
-        ADIAG_ERR("[%s] memcpy_s msg txt failed.", rb->head.name);
-        return TRACE_FAILURE;
+    RbLogRing *ring = TraceRbLogGetRing(rb, ringIdx);
+    RbLogRing *newRing = TraceRbLogGetRing(newRb, ringIdx);
+    int32_t ret = memcpy_s(newRing, sizeof(RbLogRing), ring, sizeof(RbLogRing));
+    AO_MB();
+    if (ret == EOK) {
+        ret = memcpy_s(newRb->msg + ring->offset, rb->head.ringSize, rb->msg + ring->offset, rb->head.ringSize);
     }
-    ret = memcpy_s(&newMsg->head, sizeof(RbMsgHead), &msg->head, sizeof(RbMsgHead));
     if (ret != EOK) {
-        ADIAG_ERR("[%s] memcpy_s msg head failed.", rb->head.name);
+        ADIAG_ERR("[%s] memcpy_s ring %u failed.", rb->head.name, ringIdx);
         return TRACE_FAILURE;
     }
-    // cycle has changed before memcpy finished, set busy to true to drop data.
-    if (newMsg->head.cycle != cycle) {
-        newMsg->head.busy = true;
-    }
+    AO_MB();
+    // msgs overwritten while copying are dropped
+    uint64_t tailPos = ring->tailPos;
+    newRing->tailPos = MIN(MAX(newRing->tailPos, tailPos), newRing->headPos);
+    newRing->lock = false;
+    TraceRbLogCountRingMsg(newRb, newRing);
+    newRing->readPos = newRing->tailPos;
+    newRing->readEnd = newRing->headPos;
     return TRACE_SUCCESS;
 }
 
-STATIC void TraceRbLogSort(struct RbLog *rb)
-{
-    qsort(rb->msg, rb->head.bufSize, rb->head.msgSize, RbLogMsgCmp);
-}
-
 /**
  * @brief           get struct entry list
  * @param [in/out]  newRb:      new ringbuffer
@@ -314,14 +482,14 @@ STATIC TraStatus TraceRbLogGetStructEntryList(struct AdiagList **newRbList, cons
 }
 
 /**
- * @brief       copy ringbuffer to new buffer and sort valid msg by cycle
+ * @brief       copy ringbuffer to new buffer, msgs are read from it in cycle order
  * @param [out] newRb:      new ringbuffer
  * @param [in]  rb:         original ringbuffer
  * @return      TraStatus
  */
 TraStatus TraceRbLogGetCopyOfRingBuffer(struct RbLog **newRb, struct RbLog *rb)
 {
-    size_t totalSize = sizeof(RbLog) + (size_t)rb->head.bufSize * rb->head.msgSize;
+    size_t totalSize = sizeof(RbLog) + (size_t)rb->head.dataSize;
     *newRb = AdiagMalloc(totalSize);
     if (*newRb == NULL) {
         ADIAG_ERR("[%s] malloc new ringbuffer failed, size : %zu bytes.", rb->head.name, totalSize);
@@ -333,13 +501,12 @@ TraStatus TraceRbLogGetCopyOfRingBuffer(struct RbLog **newRb, struct RbLog *rb)
         ADIAG_ERR("[%s] memcpy_s ringbuffer failed.", rb->head.name);
         return TRACE_FAILURE;
     }
-    for (uint32_t i = 0; i < rb->head.bufSize; i++) {
-        if (TraceRbLogCopyMsg(*newRb, rb, i) != TRACE_SUCCESS) {
+    for (uint32_t i = 0; i < rb->head.ringNum; i++) {
+        if (TraceRbLogCopyRing(*newRb, rb, i) != TRACE_SUCCESS) {
             ADIAG_SAFE_FREE(*newRb);
             return TRACE_FAILURE;
         }
     }
-    TraceRbLogSort(*newRb);
     // if trace struct not defined, return success
     struct AdiagList *traList = NULL;
     for (uint32_t i = 0; i < TRACE_STRUCT_ENTRY_MAX_NUM; i++) {
@@ -356,108 +523,88 @@ TraStatus TraceRbLogGetCopyOfRingBuffer(struct RbLog **newRb, struct RbLog *rb)
 }
 
 /**
- * @brief       read msg from ringbuffer, must be reentrant, cannot print msg
+ * @brief       get head of the next unread msg of ring, must be reentrant, cannot print msg
+ *              the ring may be written meanwhile, msgs overwritten since the last read are skipped
  * @param [in]  rb:           ringbuffer
- * @param [out] timeStr:      timestamp str
- * @param [out] buffer:       ptr of msg txt in ringbuffer
- * @return      TraStatus
+ * @param [in]  ring:         ring to read
+ * @param [out] msgHead:      head of the msg at ring->readPos
+ * @return      true if there is one
  */
-TraStatus TraceRbLogReadRbMsg(struct RbLog *rb, char *timeStr, uint32_t timeStrSize, char **buffer)
+STATIC bool TraceRbLogPeekRing(struct RbLog *rb, RbLogRing *ring, RbMsgHead *msgHead)
 {
-    RbLogMsg *msg = NULL;
-    for (;rb->head.readIdx != rb->head.bufSize; rb->head.readIdx++) {
-        msg = TraceRbLogGetMsgByIndex(rb, rb->head.readIdx);
-        if (msg->head.busy) { // msg has not been written done
+    uint64_t endPos = MIN(ring->headPos, ring->readEnd);
+    AO_MB();
+    while (true) {
+        if (ring->readPos < ring->tailPos) {
+            ring->readPos = ring->tailPos;
+        }
+        uint64_t pos = ring->readPos;
+        if (pos >= endPos) {
+            return false;
+        }
+        uint32_t left = TraceRbLogGetRingLeft(rb, pos);
+        if (left < sizeof(RbMsgHead)) {
+            ring->readPos = pos + left;
             continue;
         }
-        if (msg->head.txtSize == 0) {
+        *msgHead = TraceRbLogGetMsgByPos(rb, ring, pos)->head;
+        AO_MB();
+        if (pos < ring->tailPos) {
             continue;
         }
-        rb->head.readIdx++;
-        double costTime = (double)msg->head.cycle / (double)rb->head.cpuFreq * (double)FREQ_GHZ_TO_KHZ;
-        uint64_t timestamp = (uint64_t)costTime + rb->head.realTime;
-        TraStatus ret = TimestampToStr(timestamp, timeStr, timeStrSize);
-        if (ret != TRACE_SUCCESS) {
-            return ret;
+        if (msgHead->txtSize == 0) {
+            ring->readPos = pos + left;
+            continue;
         }
-        uint32_t lastIndex = MIN(msg->head.txtSize, rb->head.msgTxtSize - 1U);
-        msg->txt[lastIndex] = '\0';  // ensure msg must have a string terminator
-        *buffer = msg->txt;
-        return TRACE_SUCCESS;
+        return (msgHead->txtSize <= rb->head.msgTxtSize) && (TraceRbLogGetMsgSpace(msgHead->txtSize) <= left);
     }
-    *buffer = NULL;
-    return TRACE_RING_BUFFER_EMPTY;
 }
 
 /**
- * @brief       read msg from ringbuffer, must be reentrant, cannot print msg
+ * @brief       read the oldest unread msg of all rings, must be reentrant, cannot print msg
+ *              msgs of each ring are in cycle order, so a merge of the ring heads gives all msgs in order
  * @param [in]  rb:           ringbuffer
- * @param [out] buffer:       ptr of msg in ringbuffer
- * @param [out] bufLen:       length of msg in ringbuffer
- * @return      TraStatus
+ * @return      msg expanded to msgSize bytes in read scratch of rb, NULL if all msgs have been read
  */
-TraStatus TraceRbLogReadOriRbMsg(struct RbLog *rb, char **buffer, uint32_t *bufLen)
-{
-    RbLogMsg *msg = NULL;
-    for (;rb->head.readIdx != rb->head.bufSize; rb->head.readIdx++) {
-        msg = TraceRbLogGetMsgByIndex(rb, rb->head.readIdx);
-        if (msg->head.txtSize == 0) {
-            continue;
-        }
-        rb->head.readIdx++;
-        *buffer = (char *)msg;
-        *bufLen = rb->head.msgSize;
-        return TRACE_SUCCESS;
-    }
-    *buffer = NULL;
-    *bufLen = 0;
-    return TRACE_RING_BUFFER_EMPTY;
-}
-
-void TraceRbLogPrepareForRead(struct RbLog *rb)
+STATIC RbLogMsg *TraceRbLogReadNextMsg(struct RbLog *rb)
 {
-    rb->head.readIdx = 0;
-}
-
-STATIC RbLogMsg *TraceRbLogGetOldestMsg(struct RbLog *rb, uint64_t *cycle, bool filterBusy)
-{
-    RbLogMsg *oldestMsg = NULL;
-    RbLogMsg *msg = NULL;
-    for (uint32_t i = 0; i < rb->head.bufSize; i++) {
-        msg = TraceRbLogGetMsgByIndex(rb, i);
-        if (msg->head.txtSize == 0) {
-            continue;
+    RbLogMsg *scratch = TraceRbLogGetScratch(rb);
+    while (true) {
+        RbLogRing *oldestRing = NULL;
+        RbMsgHead oldestHead = { 0 };
+        RbMsgHead msgHead = { 0 };
+        for (uint32_t i = 0; i < rb->head.ringNum; i++) {
+            RbLogRing *ring = TraceRbLogGetRing(rb, i);
+            if (!TraceRbLogPeekRing(rb, ring, &msgHead)) {
+                continue;
+            }
+            if ((oldestRing == NULL) || (msgHead.cycle < oldestHead.cycle)) {
+                oldestRing = ring;
+                oldestHead = msgHead;
+            }
         }
-        if ((filterBusy) && (msg->head.busy)) {
-            continue;
+        if (oldestRing == NULL) {
+            return NULL;
         }
-        if (msg->head.cycle <= *cycle) {
-            continue;
+        uint64_t pos = oldestRing->readPos;
+        (void)memset_s(scratch, rb->head.msgSize, 0, rb->head.msgSize);
+        if (memcpy_s(scratch->txt, rb->head.msgTxtSize, TraceRbLogGetMsgByPos(rb, oldestRing, pos)->txt,
+            oldestHead.txtSize) != EOK) {
+            return NULL;
         }
-        if ((oldestMsg == NULL) || (msg->head.cycle < oldestMsg->head.cycle)) {
-            oldestMsg = msg;
+        AO_MB();
+        if (pos < oldestRing->tailPos) {
+            continue; // overwritten while copying
         }
+        scratch->head = oldestHead;
+        oldestRing->readPos = pos + TraceRbLogGetMsgSpace(oldestHead.txtSize);
+        return scratch;
     }
-    if (oldestMsg != NULL) {
-        *cycle = oldestMsg->head.cycle;
-    }
-    return oldestMsg;
 }
 
-/**
- * @brief       read msg from ringbuffer, must be reentrant, cannot print msg
- * @param [in]  rb:           ringbuffer
- * @param [out] timeStr:      timestamp str
- * @param [out] buffer:       ptr of msg txt in ringbuffer
- * @return      TraStatus
- */
-TraStatus TraceRbLogReadRbMsgSafe(struct RbLog *rb, char *timeStr, uint32_t timeStrSize, char **buffer)
+STATIC TraStatus TraceRbLogReadTxtMsg(struct RbLog *rb, char *timeStr, uint32_t timeStrSize, char **buffer)
 {
-    if (rb->head.readIdx == rb->head.bufSize) {
-        return TRACE_RING_BUFFER_EMPTY;
-    }
-    uint64_t cycle = 0;
-    RbLogMsg *msg = TraceRbLogGetOldestMsg(rb, &cycle, true);
+    RbLogMsg *msg = TraceRbLogReadNextMsg(rb);
     if (msg == NULL) {
         return TRACE_RING_BUFFER_EMPTY;
     }
@@ -470,34 +617,93 @@ TraStatus TraceRbLogReadRbMsgSafe(struct RbLog *rb, char *timeStr, uint32_t time
     uint32_t lastIndex = MIN(msg->head.txtSize, rb->head.msgTxtSize - 1U);
     msg->txt[lastIndex] = '\0';  // ensure msg must have a string terminator
     *buffer = msg->txt;
-    msg->head.txtSize = 0;
-    rb->head.readIdx++;
     return TRACE_SUCCESS;
 }
 
 /**
  * @brief       read msg from ringbuffer, must be reentrant, cannot print msg
  * @param [in]  rb:           ringbuffer
- * @param [out] buffer:       ptr of msg in ringbuffer
- * @param [out] bufLen:       length of msg in ringbuffer
+ * @param [out] timeStr:      timestamp str
+ * @param [out] buffer:       ptr of msg txt, valid until the next read
  * @return      TraStatus
  */
-TraStatus TraceRbLogReadOriRbMsgSafe(struct RbLog *rb, char **buffer, uint32_t *bufLen, uint64_t *cycle)
+TraStatus TraceRbLogReadRbMsg(struct RbLog *rb, char *timeStr, uint32_t timeStrSize, char **buffer)
 {
-    if (rb->head.readIdx == rb->head.bufSize) {
-        return TRACE_RING_BUFFER_EMPTY;
+    TraStatus ret = TraceRbLogReadTxtMsg(rb, timeStr, timeStrSize, buffer);
+    if (ret == TRACE_RING_BUFFER_EMPTY) {
+        *buffer = NULL;
     }
-    RbLogMsg *msg = TraceRbLogGetOldestMsg(rb, cycle, false);
+    return ret;
+}
+
+/**
+ * @brief       read msg from ringbuffer, must be reentrant, cannot print msg
+ * @param [in]  rb:           ringbuffer
+ * @param [out] buffer:       ptr of msg expanded to msgSize bytes, valid until the next read
+ * @param [out] bufLen:       length of msg
+ * @return      TraStatus
+ */
+TraStatus TraceRbLogReadOriRbMsg(struct RbLog *rb, char **buffer, uint32_t *bufLen)
+{
+    RbLogMsg *msg = TraceRbLogReadNextMsg(rb);
     if (msg == NULL) {
+        *buffer = NULL;
+        *bufLen = 0;
         return TRACE_RING_BUFFER_EMPTY;
     }
     *buffer = (char *)msg;
     *bufLen = rb->head.msgSize;
-    rb->head.readIdx++;
     return TRACE_SUCCESS;
 }
 
+/**
+ * @brief       restart reading from the oldest msg, msgs written after this are not read
+ * @param [in]  rb:           ringbuffer
+ * @return      NA
+ */
+void TraceRbLogPrepareForRead(struct RbLog *rb)
+{
+    for (uint32_t i = 0; i < rb->head.ringNum; i++) {
+        RbLogRing *ring = TraceRbLogGetRing(rb, i);
+        ring->readPos = ring->tailPos;
+        ring->readEnd = ring->headPos;
+    }
+}
+
+/**
+ * @brief       read msg from ringbuffer being written, must be reentrant, cannot print msg
+ * @param [in]  rb:           ringbuffer
+ * @param [out] timeStr:      timestamp str
+ * @param [out] buffer:       ptr of msg txt, valid until the next read
+ * @return      TraStatus
+ */
+TraStatus TraceRbLogReadRbMsgSafe(struct RbLog *rb, char *timeStr, uint32_t timeStrSize, char **buffer)
+{
+    return TraceRbLogReadTxtMsg(rb, timeStr, timeStrSize, buffer);
+}
+
+/**
+ * @brief       read msg from ringbuffer being written, must be reentrant, cannot print msg
+ * @param [in]  rb:           ringbuffer
+ * @param [out] buffer:       ptr of msg expanded to msgSize bytes, valid until the next read
+ * @param [out] bufLen:       length of msg
+ * @param [out] cycle:        cycle of msg
+ * @return      TraStatus
+ */
+TraStatus TraceRbLogReadOriRbMsgSafe(struct RbLog *rb, char **buffer, uint32_t *bufLen, uint64_t *cycle)
+{
+    TraStatus ret = TraceRbLogReadOriRbMsg(rb, buffer, bufLen);
+    if (ret == TRACE_SUCCESS) {
+        *cycle = ((const RbLogMsg *)*buffer)->head.cycle;
+    }
+    return ret;
+}
+
 uint32_t TracerRbLogGetMsgNum(const RbLog *rb)
 {
-    return (rb->head.writeIdx > (uint64_t)rb->head.bufSize) ? rb->head.bufSize : (uint32_t)rb->head.writeIdx;
+    uint32_t msgNum = 0;
+    for (uint32_t i = 0; i < rb->head.ringNum; i++) {
+        msgNum += ((const RbLogRing *)(rb->msg + sizeof(RbLogRing) * i))->msgCount;
+    }
+    return msgNum;
 }
\ No newline at end of file
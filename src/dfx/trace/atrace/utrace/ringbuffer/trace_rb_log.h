@@ -22,11 +22,12 @@ extern "C" {
 
 #define RB_LOG_MSG_HEAD_RESERVE_LENGTH 2U
 #define RB_LOG_CTRL_NAME_LENGTH 32U
+#define RB_LOG_RING_RESERVE_LENGTH 15U
 
 typedef struct RbMsgHead {
     uint64_t cycle;         // number of cycles when writing msg, relative number of cycles when creating ring buffer
     uint32_t txtSize;
-    bool busy;              // msg block is busy or not
+    bool busy;              // kept for the binary file format, always false
     uint8_t bufferType;     // buffer type of entry handle
     char reserve[RB_LOG_MSG_HEAD_RESERVE_LENGTH];
 } RbMsgHead;
@@ -43,19 +44,36 @@ typedef struct RbLogMsgTime {
 
 typedef struct RbLogCtrl {
     char name[RB_LOG_CTRL_NAME_LENGTH];
-    uint64_t writeIdx;
     uint64_t realTime;
     uint64_t monotonicTime;
     uint64_t cpuFreq;
     int32_t minutesWest;
-    uint32_t readIdx;
-    uint32_t bufSize;
+    uint32_t bufSize;       // number of msgSize msgs the data space is sized for
     uint32_t mask;
-    uint32_t msgSize;
+    uint32_t msgSize;       // size of a msg read by TraceRbLogReadOriRbMsg
     uint32_t msgTxtSize;
     uint32_t errCount;
+    uint32_t ringNum;       // number of per-cpu rings
+    uint32_t ringSize;      // data bytes of each ring
+    uint32_t dataSize;      // bytes of msg, ring heads + ring data + read scratch
 } RbLogCtrl;
 
+/*
+ * One ring per cpu group, placed at the start of RbLog.msg and followed by the ring data.
+ * Msgs are stored with their real length, positions only grow and are taken modulo ringSize.
+ */
+typedef struct RbLogRing {
+    uint64_t headPos;       // byte position of the next msg to write
+    uint64_t tailPos;       // byte position of the oldest msg kept
+    uint64_t readPos;       // byte position of the next msg to read
+    uint64_t readEnd;       // msgs from here on are not read, set by TraceRbLogPrepareForRead
+    uint64_t lastCycle;     // cycle of the latest msg, msgs of one ring are in cycle order
+    uint32_t offset;        // offset of the ring data in RbLog.msg
+    uint32_t msgCount;      // number of msgs between tailPos and headPos
+    bool lock;              // taken while a msg is written
+    char reserve[RB_LOG_RING_RESERVE_LENGTH];   // one ring head per cache line
+} RbLogRing;
+
 typedef struct TraceStructField {
     char name[TRACE_NAME_LENGTH];		    // field name
     uint8_t type;		                    // field type
@@ -104,6 +104,7 @@ static mmEnvInfo s_envList[] = {
     {MM_ENV_SKT_ENABLE, "SKT_ENABLE"},
     {MM_ENV_AUTO_USE_UC_MEMORY, "AUTO_USE_UC_MEMORY"},
     {MM_ENV_SHAREGROUP_PRECONFIG, "SHAREGROUP_PRECONFIG"},
+    {MM_ENV_TDT_HOST_MEM_POOL_LIMIT, "TDT_HOST_MEM_POOL_LIMIT"},
 
     // HCCL
     {MM_ENV_HCCL_RDMA_PCIE_DIRECT_POST_NOSTRICT, "HCCL_RDMA_PCIE_DIRECT_POST_NOSTRICT"},
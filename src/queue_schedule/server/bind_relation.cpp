@@ -529,8 +529,38 @@ void BindRelation::Order(const uint32_t index)
         static_cast<uint32_t>(srcToDstRelation_.size() + srcToDstRelationExtra_.size()));
     if (index == 0U) {
         OrderOneTable(orderedSubscribeQueueId_, srcToDstRelation_, dstToSrcRelation_);
+        BuildRouteTable(routeTable_, orderedSubscribeQueueId_, srcToDstRelation_);
     } else {
         OrderOneTable(orderedSubscribeQueueIdExtra_, srcToDstRelationExtra_, dstToSrcRelationExtra_);
+        BuildRouteTable(routeTableExtra_, orderedSubscribeQueueIdExtra_, srcToDstRelationExtra_);
+    }
+}
+
+void BindRelation::BuildRouteTable(
+    RouteTable& routeTable, const std::vector<EntityInfo>& orderedSubscribeQueueId,
+    const MapEnitityInfoToInfoSet& srcToDstRelation) const
+{
+    routeTable.Clear();
+    routeTable.srcs.reserve(orderedSubscribeQueueId.size());
+    routeTable.dstOffsets.reserve(orderedSubscribeQueueId.size() + 1U);
+    routeTable.dstOffsets.emplace_back(0U);
+    for (const auto& src : orderedSubscribeQueueId) {
+        const auto iter = srcToDstRelation.find(src);
+        if (iter == srcToDstRelation.end()) {
+            BQS_LOG_WARN("Can't find dst queues for src[%s] when build route table.", src.ToString().c_str());
+            continue;
+        }
+        const auto routeIndex = static_cast<uint32_t>(routeTable.srcs.size());
+        routeTable.srcs.emplace_back(src);
+        for (const auto& dst : iter->second) {
+            routeTable.dsts.emplace_back(dst);
+        }
+        routeTable.dstOffsets.emplace_back(static_cast<uint32_t>(routeTable.dsts.size()));
+        if ((src.GetType() == dgw::EntityType::ENTITY_QUEUE) && (src.GetQueueType() == bqs::LOCAL_Q)) {
+            routeTable.queueRoutes[src.GetId()].emplace_back(routeIndex);
+        } else {
+            routeTable.eventlessRoutes.emplace_back(routeIndex);
+        }
     }
 }
 
@@ -601,6 +631,11 @@ const MapEnitityInfoToInfoSet& BindRelation::GetAbnormalDstToSrcRelation() const
 
 const std::vector<EntityInfo>& BindRelation::GetOrderedSubscribeQueueId() const { return orderedSubscribeQueueId_; }
 
+const RouteTable& BindRelation::GetRouteTable(const uint32_t index) const
+{
+    return (index == 0U) ? routeTable_ : routeTableExtra_;
+}
+
 uint32_t BindRelation::CountBinds() const
 {
     uint32_t bindCount = std::accumulate(
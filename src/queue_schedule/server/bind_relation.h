@@ -133,6 +133,29 @@ using EntityInfoPtr = std::shared_ptr<EntityInfo>;
 using EntityInfoSet = std::unordered_set<EntityInfo, EntityInfoHash>;
 using MapEnitityInfoToInfoSet = std::unordered_map<EntityInfo, EntityInfoSet, EntityInfoHash>;
 
+/**
+ * flattened view of one relation table, rebuilt by Order.
+ * route i: src is srcs[i], dst are dsts[dstOffsets[i], dstOffsets[i + 1]), routes are kept in topology order.
+ */
+struct RouteTable {
+    std::vector<EntityInfo> srcs;
+    std::vector<uint32_t> dstOffsets;
+    std::vector<EntityInfo> dsts;
+    // local queue id -> routes whose src is that queue, src of these routes is woken by enqueue event
+    std::unordered_map<uint32_t, std::vector<uint32_t>> queueRoutes;
+    // routes whose src is not a local queue, they must be visited in every schedule
+    std::vector<uint32_t> eventlessRoutes;
+
+    void Clear()
+    {
+        srcs.clear();
+        dstOffsets.clear();
+        dsts.clear();
+        queueRoutes.clear();
+        eventlessRoutes.clear();
+    }
+};
+
 class BindRelation {
 public:
     static BindRelation& GetInstance();
@@ -253,6 +276,12 @@ public:
 
     const std::vector<EntityInfo>& GetOrderedSubscribeQueueIdExtra() const;
 
+    /**
+     * Get flattened route table, it is consistent with ordered subscribe queue of same index.
+     * @return route table
+     */
+    const RouteTable& GetRouteTable(const uint32_t index = 0U) const;
+
     BqsStatus GetBindIndexBySrc(const EntityInfo& srcEntity, uint32_t& index) const;
 
     BqsStatus ClearInputQueue(const uint32_t index, const std::unordered_set<uint32_t>& keySet);
@@ -425,6 +454,10 @@ private:
         std::vector<EntityInfo>& orderedSubscribeQueueId, const MapEnitityInfoToInfoSet& srcToDstRelation,
         const MapEnitityInfoToInfoSet& dstToSrcRelation);
 
+    void BuildRouteTable(
+        RouteTable& routeTable, const std::vector<EntityInfo>& orderedSubscribeQueueId,
+        const MapEnitityInfoToInfoSet& srcToDstRelation) const;
+
     // a queue can be bound to multi queue.
     MapEnitityInfoToInfoSet srcToDstRelation_;
 
@@ -458,6 +491,10 @@ private:
 
     std::vector<EntityInfo> orderedSubscribeQueueIdExtra_;
 
+    // flattened routes of orderedSubscribeQueueId_ and orderedSubscribeQueueIdExtra_
+    RouteTable routeTable_;
+    RouteTable routeTableExtra_;
+
     std::vector<EntityInfo> abnormalSrc_;
     std::vector<EntityInfo> abnormalDst_;
 };
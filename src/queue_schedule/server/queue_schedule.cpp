@@ -13,6 +13,7 @@
 #include <sched.h>
 #include <csignal>
 #include <cerrno>
+#include <algorithm>
 #include <string>
 #include "driver/ascend_hal.h"
 #include "server/bqs_server.h"
@@ -635,6 +636,10 @@ void QueueSchedule::ProcessEnqueueEvent(
     const uint32_t threadIndex, const event_info& event, const uint32_t index, const bool procF2NF)
 {
     auto& queueEventAtomicFlag = (index == 0U) ? queueEventAtomicFlag_ : queueEventAtomicFlagExtra_;
+    if (!procF2NF) {
+        // subevent id of enqueue event is the queue id, record it before the event may be merged
+        MarkQueueReady(event.comm.subevent_id, index);
+    }
     // if other thread is working do nothing; if not set work flag.
     if (!queueEventAtomicFlag.test_and_set()) {
         ProfileManager& profileManager = ProfileManager::GetInstance(index);
@@ -656,7 +661,8 @@ void QueueSchedule::ProcessEnqueueEvent(
         // handle schedule data
         const bool procAsynMemBuff = QueueManager::GetInstance().HandleAsynMemBuffEvent(index);
         const uint64_t scheduleBegin = profileManager.GetCpuTick();
-        ScheduleDataBuffAll(!(procRelation || hasF2NF || procAsynMemBuff), index);
+        const bool dataEnqueue = !(procRelation || hasF2NF || procAsynMemBuff);
+        ScheduleDataBuffAll(dataEnqueue, index, !dataEnqueue);
         StatisticManager::GetInstance().UpdateScheuleStatistic(
             profileManager.GetTimeCost(schedDelay),
             profileManager.GetTimeCost(profileManager.GetCpuTick() - scheduleBegin));
@@ -727,58 +733,36 @@ void QueueSchedule::DynamicSchedule(const uint32_t index) const
     BQS_LOG_DEBUG("finish DynamicSchedule, dynamicScheduleCount is %u", dynamicScheduleCount);
 }
 
-void QueueSchedule::ScheduleDataBuffAll(const bool dataEnqueue, const uint32_t index) const
+void QueueSchedule::ScheduleDataBuffAll(const bool dataEnqueue, const uint32_t index, const bool fullScan)
 {
     BQS_LOG_INFO("the [%u]th thread ScheduleDataBuffAll.", index);
     bool hasDequeueFlag = false;
-    const auto& orderedSubscribeQueues = (index == 0U) ? BindRelation::GetInstance().GetOrderedSubscribeQueueId() :
-                                                         BindRelation::GetInstance().GetOrderedSubscribeQueueIdExtra();
-    const auto& srcToDstRelation = (index == 0U) ? BindRelation::GetInstance().GetSrcToDstRelation() :
-                                                   BindRelation::GetInstance().GetSrcToDstExtraRelation();
+    const auto& routeTable = BindRelation::GetInstance().GetRouteTable(index);
+    auto& readySet = GetReadyQueueSet(index);
+    const auto routeNum = static_cast<uint32_t>(routeTable.srcs.size());
 
-    ProfileManager::GetInstance(index).SetSrcQueueNum(static_cast<uint32_t>(orderedSubscribeQueues.size()));
-    dgw::InnerMessage msg;
-    msg.msgType = dgw::InnerMsgType::INNER_MSG_PUSH;
+    ProfileManager::GetInstance(index).SetSrcQueueNum(routeNum);
     BindRelation::GetInstance().ClearAbnormalEntityInfo(index);
-    if (dgw::EntityManager::Instance(index).IsExistFullEntity() ||
-        dgw::EntityManager::Instance(index).IsExistAsyncMemEntity()) {
-        for (const auto& src : orderedSubscribeQueues) {
-            if (dgw::ScheduleConfig::GetInstance().IsStopped(src.GetSchedCfgKey())) {
-                BQS_LOG_INFO("Skip schedule src[%s] for it has been stopped.", src.ToString().c_str());
-                continue;
-            }
-            const auto iter = srcToDstRelation.find(src);
-            if (iter == srcToDstRelation.end()) {
-                BQS_LOG_WARN("Can't find dst queues for queue[%u].", src.GetId());
-                continue;
-            }
-            for (auto& dst : iter->second) {
-                // process full state for dst entity
-                if (ProcessDstEntity(dst, index) == dgw::FsmStatus::FSM_ERROR) {
-                    BQS_LOG_ERROR("Skip scheduler for routes maybe has been modified");
-                    break;
-                };
-            }
-
-            const auto& srcEntity = src.GetEntity();
-            if (srcEntity->ProcessMessage(msg) == dgw::FsmStatus::FSM_ERROR) {
-                BQS_LOG_ERROR("skip scheduler for routes maybe have been modified");
+    // full state dst is not related to enqueue event of src, visit all routes to process it
+    const bool procDst = dgw::EntityManager::Instance(index).IsExistFullEntity() ||
+                         dgw::EntityManager::Instance(index).IsExistAsyncMemEntity();
+    if (fullScan || procDst || (!CollectReadyRoutes(routeTable, readySet))) {
+        for (auto& word : readySet.words) {
+            (void)word.exchange(0UL, std::memory_order_acq_rel);
+        }
+        readySet.overflow.store(false, std::memory_order_release);
+        for (uint32_t routeIndex = 0U; routeIndex < routeNum; ++routeIndex) {
+            if (!ScheduleRoute(routeTable, routeIndex, procDst, index, hasDequeueFlag)) {
                 break;
             }
-            hasDequeueFlag |= (srcEntity->GetScheduleCount() > 0UL);
         }
     } else {
-        for (const auto& src : orderedSubscribeQueues) {
-            if (dgw::ScheduleConfig::GetInstance().IsStopped(src.GetSchedCfgKey())) {
-                BQS_LOG_INFO("Skip schedule src[%s] for it has been stopped.", src.ToString().c_str());
-                continue;
-            }
-            const auto& srcEntity = src.GetEntity();
-            if (srcEntity->ProcessMessage(msg) == dgw::FsmStatus::FSM_ERROR) {
-                BQS_LOG_ERROR("skip scheduler for routes maybe have been modified");
+        BQS_LOG_DEBUG("the [%u]th thread schedule [%zu] ready routes of [%u].", index, readySet.routes.size(),
+            routeNum);
+        for (const uint32_t routeIndex : readySet.routes) {
+            if (!ScheduleRoute(routeTable, routeIndex, false, index, hasDequeueFlag)) {
                 break;
             }
-            hasDequeueFlag |= (srcEntity->GetScheduleCount() > 0UL);
         }
     }
 
@@ -795,6 +779,78 @@ void QueueSchedule::ScheduleDataBuffAll(const bool dataEnqueue, const uint32_t i
     BindRelation::GetInstance().UpdateRelation(index);
 }
 
+bool QueueSchedule::ScheduleRoute(const RouteTable& routeTable, const uint32_t routeIndex, const bool procDst,
+    const uint32_t index, bool& hasDequeue)
+{
+    const auto& src = routeTable.srcs[routeIndex];
+    if (dgw::ScheduleConfig::GetInstance().IsStopped(src.GetSchedCfgKey())) {
+        BQS_LOG_INFO("Skip schedule src[%s] for it has been stopped.", src.ToString().c_str());
+        return true;
+    }
+    if (procDst) {
+        for (uint32_t dstIndex = routeTable.dstOffsets[routeIndex]; dstIndex < routeTable.dstOffsets[routeIndex + 1U];
+             ++dstIndex) {
+            // process full state for dst entity
+            if (ProcessDstEntity(routeTable.dsts[dstIndex], index) == dgw::FsmStatus::FSM_ERROR) {
+                BQS_LOG_ERROR("Skip scheduler for routes maybe has been modified");
+                break;
+            }
+        }
+    }
+
+    dgw::InnerMessage msg;
+    msg.msgType = dgw::InnerMsgType::INNER_MSG_PUSH;
+    const auto& srcEntity = src.GetEntity();
+    if (srcEntity->ProcessMessage(msg) == dgw::FsmStatus::FSM_ERROR) {
+        BQS_LOG_ERROR("skip scheduler for routes maybe have been modified");
+        // ready queues after this route are dropped, so visit all routes next time
+        GetReadyQueueSet(index).overflow.store(true, std::memory_order_release);
+        return false;
+    }
+    if (srcEntity->GetScheduleCount() > 0UL) {
+        hasDequeue = true;
+        // src may still have data left, keep it ready until a schedule finds it empty
+        if ((src.GetType() == dgw::EntityType::ENTITY_QUEUE) && (src.GetQueueType() == bqs::LOCAL_Q)) {
+            MarkQueueReady(src.GetId(), index);
+        }
+    }
+    return true;
+}
+
+void QueueSchedule::MarkQueueReady(const uint32_t queueId, const uint32_t index)
+{
+    auto& readySet = GetReadyQueueSet(index);
+    if (queueId >= MAX_QUEUE_ID_NUM) {
+        readySet.overflow.store(true, std::memory_order_release);
+        return;
+    }
+    (void)readySet.words[queueId / 64U].fetch_or(1UL << (queueId % 64U), std::memory_order_acq_rel);
+}
+
+bool QueueSchedule::CollectReadyRoutes(const RouteTable& routeTable, ReadyQueueSet& readySet) const
+{
+    if (readySet.overflow.load(std::memory_order_acquire)) {
+        return false;
+    }
+    readySet.routes.clear();
+    for (uint32_t wordIndex = 0U; wordIndex < READY_QUEUE_WORD_NUM; ++wordIndex) {
+        uint64_t word = readySet.words[wordIndex].exchange(0UL, std::memory_order_acq_rel);
+        while (word != 0UL) {
+            const auto queueId = wordIndex * 64U + static_cast<uint32_t>(__builtin_ctzll(word));
+            word &= (word - 1UL);
+            const auto iter = routeTable.queueRoutes.find(queueId);
+            if (iter != routeTable.queueRoutes.end()) {
+                (void)readySet.routes.insert(readySet.routes.end(), iter->second.begin(), iter->second.end());
+            }
+        }
+    }
+    (void)readySet.routes.insert(
+        readySet.routes.end(), routeTable.eventlessRoutes.begin(), routeTable.eventlessRoutes.end());
+    // keep topology order of routes
+    std::sort(readySet.routes.begin(), readySet.routes.end());
+    return true;
+}
+
 dgw::FsmStatus QueueSchedule::ProcessDstEntity(const EntityInfo& entity, const uint32_t index) const
 {
     const auto dstEntity = entity.GetEntity();
@@ -11,6 +11,7 @@
 #ifndef QUEUE_SCHEDULE_BQS_QUEUE_SCHEDULE_H
 #define QUEUE_SCHEDULE_BQS_QUEUE_SCHEDULE_H
 
+#include <array>
 #include <vector>
 #include <thread>
 #include <atomic>
@@ -22,6 +23,19 @@
 #include "common/bqs_msg.h"
 #include "bind_relation.h"
 namespace bqs {
+constexpr uint32_t READY_QUEUE_WORD_NUM = (MAX_QUEUE_ID_NUM + 63U) / 64U;
+
+/**
+ * local queues which got enqueue event but are not scheduled yet, one bit per queue id.
+ * bits are set by any enqueue thread, routes are only used by the thread holding queue event flag.
+ */
+struct ReadyQueueSet {
+    std::array<std::atomic<uint64_t>, READY_QUEUE_WORD_NUM> words = {};
+    // set when ready queues can not be tracked, next schedule has to visit all routes
+    std::atomic<bool> overflow{true};
+    std::vector<uint32_t> routes;
+};
+
 class QueueSchedule {
 public:
     /**
@@ -141,8 +155,37 @@ private:
     /**
      * schedule data buff for all queue.
      * @param dataEnqueue true means data enqueue, false means relation or f2nf enqueue
+     * @param fullScan true means visit all routes, false means only visit routes whose src queue is ready
+     */
+    void ScheduleDataBuffAll(const bool dataEnqueue, const uint32_t index = 0U, const bool fullScan = true);
+
+    /**
+     * schedule one route of route table.
+     * @param routeTable route table
+     * @param routeIndex route index
+     * @param procDst whether process full state of dst entity
+     * @param hasDequeue set to true when src entity has dequeued
+     * @return false means routes may have been modified and schedule should stop
+     */
+    bool ScheduleRoute(const RouteTable& routeTable, const uint32_t routeIndex, const bool procDst,
+        const uint32_t index, bool& hasDequeue);
+
+    /**
+     * mark local queue ready, it will be visited by next schedule.
+     * @param queueId queue id
      */
-    void ScheduleDataBuffAll(const bool dataEnqueue, const uint32_t index = 0U) const;
+    void MarkQueueReady(const uint32_t queueId, const uint32_t index);
+
+    /**
+     * collect ready routes in topology order and clear ready queues.
+     * @return false means ready queues are not tracked and all routes should be visited
+     */
+    bool CollectReadyRoutes(const RouteTable& routeTable, ReadyQueueSet& readySet) const;
+
+    inline ReadyQueueSet& GetReadyQueueSet(const uint32_t index)
+    {
+        return (index == 0U) ? readyQueueSet_ : readyQueueSetExtra_;
+    }
 
     /**
      * process full entity
@@ -219,6 +262,13 @@ private:
 
     std::atomic_flag queueEventAtomicFlagExtra_ = ATOMIC_FLAG_INIT;
 
+    /**
+     * ready local queues of enqueue event
+     */
+    ReadyQueueSet readyQueueSet_;
+
+    ReadyQueueSet readyQueueSetExtra_;
+
     /**
      * daemon threads wait mtx.
      */
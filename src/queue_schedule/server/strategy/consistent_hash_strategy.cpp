@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "strategy/consistent_hash_strategy.h"
+#include "dgw_client.h"
+#include "common/bqs_log.h"
+#include "entity_manager.h"
+#include "strategy/strategy_manager.h"
+
+namespace dgw {
+namespace {
+constexpr uint32_t ENTITY_TYPE_SHIFT = 48U;
+constexpr uint32_t DEVICE_ID_SHIFT = 32U;
+
+// finalizer of splitmix64
+inline uint64_t MixHash(uint64_t value)
+{
+    value ^= value >> 30U;
+    value *= 0xBF58476D1CE4E5B9UL;
+    value ^= value >> 27U;
+    value *= 0x94D049BB133111EBUL;
+    value ^= value >> 31U;
+    return value;
+}
+} // namespace
+
+uint64_t ConsistentHashStrategy::RendezvousWeight(const Entity& entity, const uint64_t transId)
+{
+    const uint64_t entityKey = (static_cast<uint64_t>(entity.GetType()) << ENTITY_TYPE_SHIFT) ^
+                               (static_cast<uint64_t>(entity.GetDeviceId()) << DEVICE_ID_SHIFT) ^
+                               static_cast<uint64_t>(entity.GetId());
+    return MixHash(transId ^ MixHash(entityKey));
+}
+
+FsmStatus ConsistentHashStrategy::Search(
+    const uint32_t groupId, const uint64_t transId, std::vector<EntityPtr>& selEntities, const uint32_t resIndex)
+{
+    const std::vector<EntityPtr>& entitiesInGroup = EntityManager::Instance(resIndex).GetEntitiesInGroup(groupId);
+    if (entitiesInGroup.empty()) {
+        DGW_LOG_ERROR("No entities in group, groupId:%u, transId:%lu", groupId, transId);
+        return FsmStatus::FSM_FAILED;
+    }
+    if (transId == 0UL) {
+        DGW_LOG_ERROR("transId is invalid, transId:%lu", transId);
+        return FsmStatus::FSM_FAILED;
+    }
+
+    size_t idx = 0UL;
+    uint64_t maxWeight = 0UL;
+    for (size_t i = 0UL; i < entitiesInGroup.size(); ++i) {
+        const uint64_t weight = RendezvousWeight(*entitiesInGroup[i], transId);
+        if ((i == 0UL) || (weight > maxWeight)) {
+            maxWeight = weight;
+            idx = i;
+        }
+    }
+    auto& selEntity = entitiesInGroup[idx];
+    selEntities.push_back(selEntity);
+    DGW_LOG_DEBUG(
+        "Select entity id:%u type:%s from group:%u success, index:%zu.", selEntity->GetId(),
+        selEntity->GetTypeDesc().c_str(), groupId, idx);
+    return FsmStatus::FSM_SUCCESS;
+}
+
+REGISTER_STRATEGY(CONSISTENT_HASH, ConsistentHashStrategy);
+} // namespace dgw
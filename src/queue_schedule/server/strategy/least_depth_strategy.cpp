@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "strategy/least_depth_strategy.h"
+#include "dgw_client.h"
+#include "common/bqs_log.h"
+#include "entity_manager.h"
+#include "strategy/consistent_hash_strategy.h"
+#include "strategy/strategy_manager.h"
+
+namespace dgw {
+namespace {
+// the smaller the lighter, entity in full or error state is selected only when all entities are
+inline uint32_t GetStateLoad(const FsmState state)
+{
+    switch (state) {
+        case FsmState::FSM_IDLE_STATE:
+            return 0U;
+        case FsmState::FSM_FULL_STATE:
+            return 2U;
+        case FsmState::FSM_ERROR_STATE:
+            return 3U;
+        default:
+            return 1U;
+    }
+}
+} // namespace
+
+FsmStatus LeastDepthStrategy::Search(
+    const uint32_t groupId, const uint64_t transId, std::vector<EntityPtr>& selEntities, const uint32_t resIndex)
+{
+    const std::vector<EntityPtr>& entitiesInGroup = EntityManager::Instance(resIndex).GetEntitiesInGroup(groupId);
+    if (entitiesInGroup.empty()) {
+        DGW_LOG_ERROR("No entities in group, groupId:%u, transId:%lu", groupId, transId);
+        return FsmStatus::FSM_FAILED;
+    }
+
+    size_t idx = 0UL;
+    uint32_t minLoad = 0U;
+    size_t minDepth = 0UL;
+    uint64_t maxWeight = 0UL;
+    for (size_t i = 0UL; i < entitiesInGroup.size(); ++i) {
+        const Entity& entity = *entitiesInGroup[i];
+        const uint32_t load = GetStateLoad(entity.GetCurState());
+        const size_t depth = entity.GetSendDataObjs().size();
+        const uint64_t weight = ConsistentHashStrategy::RendezvousWeight(entity, transId);
+        const bool lighter = (load < minLoad) || ((load == minLoad) && (depth < minDepth)) ||
+                             ((load == minLoad) && (depth == minDepth) && (weight > maxWeight));
+        if ((i == 0UL) || lighter) {
+            minLoad = load;
+            minDepth = depth;
+            maxWeight = weight;
+            idx = i;
+        }
+    }
+    auto& selEntity = entitiesInGroup[idx];
+    selEntities.push_back(selEntity);
+    DGW_LOG_DEBUG(
+        "Select entity id:%u type:%s state:%s from group:%u success, index:%zu.", selEntity->GetId(),
+        selEntity->GetTypeDesc().c_str(), selEntity->GetStateDesc(selEntity->GetCurState()).c_str(), groupId, idx);
+    return FsmStatus::FSM_SUCCESS;
+}
+
+REGISTER_STRATEGY(LEAST_DEPTH, LeastDepthStrategy);
+} // namespace dgw
@@ -895,6 +895,13 @@ public:
     // aclgraph caching shape for profiling
     virtual rtError_t SetStreamCacheOpInfoSwitch(const Stream* const stm, uint32_t cacheOpInfoSwitch) = 0;
     virtual rtError_t GetStreamCacheOpInfoSwitch(const Stream* const stm, uint32_t* const cacheOpInfoSwitch) = 0;
+    // batched kernel submission
+    virtual rtError_t SetStreamSubmitBatchSize(Stream* const stm, const uint32_t batchSize) = 0;
+    virtual rtError_t GetStreamSubmitBatchSize(const Stream* const stm, uint32_t* const batchSize) = 0;
+    // host wait mode of stream synchronize
+    virtual rtError_t SetStreamSyncWaitMode(Stream* const stm, const uint32_t waitMode) = 0;
+    virtual rtError_t GetStreamSyncWaitMode(const Stream* const stm, uint32_t* const waitMode) = 0;
+    virtual rtError_t GetStreamSyncWaitStat(const Stream* const stm, rtStreamSyncWaitStat_t* const waitStat) = 0;
     virtual rtError_t CacheLastTaskOpInfo(const void* const infoPtr, const size_t infoSize) = 0;
 
     virtual rtError_t CacheLastTaskExtendInfo(const char* const extendInfoPtr, const size_t infoSize) = 0;
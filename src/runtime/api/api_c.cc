@@ -15,6 +15,7 @@
 #include "stream.hpp"
 #include "event.hpp"
 #include "base.hpp"
+#include "latency_stat.hpp"
 #include "prof_ctrl_callback_manager.hpp"
 #include "error_message_manage.hpp"
 #include "errcode_manage.hpp"
@@ -4106,6 +4107,13 @@ rtError_t rtsProfTrace(void* userdata, int32_t length, rtStream_t stream)
     return ACL_RT_SUCCESS;
 }
 
+VISIBILITY_DEFAULT
+rtError_t rtsSetLatencyStat(uint32_t enable)
+{
+    LatencyStatManager::Instance().SetEnable(enable != 0U);
+    return ACL_RT_SUCCESS;
+}
+
 VISIBILITY_DEFAULT
 rtError_t rtsCtxGetFloatOverflowAddr(void** overflowAddr) { return rtCtxGetOverflowAddr(overflowAddr); }
 
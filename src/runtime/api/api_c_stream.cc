@@ -486,6 +486,19 @@ rtError_t rtsStreamSetAttribute(rtStream_t stm, rtStreamAttr stmAttrId, rtStream
             error = apiInstance->SetStreamPriorityValue(exeStream, attrValue->streamPriority);
             break;
         }
+        case RT_STREAM_ATTR_SUBMIT_BATCH: {
+            error = apiInstance->SetStreamSubmitBatchSize(exeStream, attrValue->submitBatchSize);
+            break;
+        }
+        case RT_STREAM_ATTR_SYNC_WAIT_MODE: {
+            error = apiInstance->SetStreamSyncWaitMode(exeStream, attrValue->syncWaitMode);
+            break;
+        }
+        case RT_STREAM_ATTR_SYNC_WAIT_STAT: {
+            RT_LOG_OUTER_MSG_INVALID_PARAM(stmAttrId, "a writable stream attribute");
+            error = RT_ERROR_INVALID_VALUE;
+            break;
+        }
         default:
             RT_LOG_OUTER_MSG_INVALID_PARAM(
                 stmAttrId,
@@ -536,6 +549,18 @@ rtError_t rtsStreamGetAttribute(rtStream_t stm, rtStreamAttr stmAttrId, rtStream
             error = apiInstance->GetStreamPriorityValue(exeStream, &attrValue->streamPriority);
             break;
         }
+        case RT_STREAM_ATTR_SUBMIT_BATCH: {
+            error = apiInstance->GetStreamSubmitBatchSize(exeStream, &attrValue->submitBatchSize);
+            break;
+        }
+        case RT_STREAM_ATTR_SYNC_WAIT_MODE: {
+            error = apiInstance->GetStreamSyncWaitMode(exeStream, &attrValue->syncWaitMode);
+            break;
+        }
+        case RT_STREAM_ATTR_SYNC_WAIT_STAT: {
+            error = apiInstance->GetStreamSyncWaitStat(exeStream, &attrValue->syncWaitStat);
+            break;
+        }
         default:
             RT_LOG_OUTER_MSG_INVALID_PARAM(
                 stmAttrId,
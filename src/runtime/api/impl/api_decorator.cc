@@ -1957,6 +1957,31 @@ rtError_t ApiDecorator::GetStreamCacheOpInfoSwitch(const Stream* const stm, uint
     return impl_->GetStreamCacheOpInfoSwitch(stm, cacheOpInfoSwitch);
 }
 
+rtError_t ApiDecorator::SetStreamSubmitBatchSize(Stream* const stm, const uint32_t batchSize)
+{
+    return impl_->SetStreamSubmitBatchSize(stm, batchSize);
+}
+
+rtError_t ApiDecorator::GetStreamSubmitBatchSize(const Stream* const stm, uint32_t* const batchSize)
+{
+    return impl_->GetStreamSubmitBatchSize(stm, batchSize);
+}
+
+rtError_t ApiDecorator::SetStreamSyncWaitMode(Stream* const stm, const uint32_t waitMode)
+{
+    return impl_->SetStreamSyncWaitMode(stm, waitMode);
+}
+
+rtError_t ApiDecorator::GetStreamSyncWaitMode(const Stream* const stm, uint32_t* const waitMode)
+{
+    return impl_->GetStreamSyncWaitMode(stm, waitMode);
+}
+
+rtError_t ApiDecorator::GetStreamSyncWaitStat(const Stream* const stm, rtStreamSyncWaitStat_t* const waitStat)
+{
+    return impl_->GetStreamSyncWaitStat(stm, waitStat);
+}
+
 rtError_t ApiDecorator::ModelUpdate(Model* mdl) { return impl_->ModelUpdate(mdl); }
 
 rtError_t ApiDecorator::ModelDestroyRegisterCallback(Model* const mdl, const rtCallback_t fn, void* ptr)
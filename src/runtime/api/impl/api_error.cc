@@ -7003,6 +7003,62 @@ rtError_t ApiErrorDecorator::GetStreamCacheOpInfoSwitch(const Stream* const stm,
     return impl_->GetStreamCacheOpInfoSwitch(curStm, cacheOpInfoSwitch);
 }
 
+rtError_t ApiErrorDecorator::SetStreamSubmitBatchSize(Stream* const stm, const uint32_t batchSize)
+{
+    Stream* curStm = Runtime::Instance()->GetCurStream(stm);
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(curStm, RT_ERROR_INVALID_VALUE, "Setting the stream submit batch size");
+    if (batchSize > RT_STREAM_SUBMIT_BATCH_SIZE_MAX) {
+        RT_LOG_OUTER_MSG_INVALID_PARAM_WITH_DESC(
+            "Setting the stream submit batch size", batchSize,
+            "[0, " + std::to_string(RT_STREAM_SUBMIT_BATCH_SIZE_MAX) + "]");
+        return RT_ERROR_INVALID_VALUE;
+    }
+
+    return impl_->SetStreamSubmitBatchSize(curStm, batchSize);
+}
+
+rtError_t ApiErrorDecorator::GetStreamSubmitBatchSize(const Stream* const stm, uint32_t* const batchSize)
+{
+    Stream* curStm = Runtime::Instance()->GetCurStream(const_cast<Stream*>(stm));
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(curStm, RT_ERROR_INVALID_VALUE, "Querying the stream submit batch size");
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(
+        batchSize, RT_ERROR_INVALID_VALUE, "Querying the stream submit batch size");
+
+    return impl_->GetStreamSubmitBatchSize(curStm, batchSize);
+}
+
+rtError_t ApiErrorDecorator::SetStreamSyncWaitMode(Stream* const stm, const uint32_t waitMode)
+{
+    Stream* curStm = Runtime::Instance()->GetCurStream(stm);
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(curStm, RT_ERROR_INVALID_VALUE, "Setting the stream sync wait mode");
+    if (waitMode >= static_cast<uint32_t>(RT_STREAM_SYNC_WAIT_MAX)) {
+        RT_LOG_OUTER_MSG_INVALID_PARAM_WITH_DESC(
+            "Setting the stream sync wait mode", waitMode,
+            "[0, " + std::to_string(RT_STREAM_SYNC_WAIT_MAX) + ")");
+        return RT_ERROR_INVALID_VALUE;
+    }
+
+    return impl_->SetStreamSyncWaitMode(curStm, waitMode);
+}
+
+rtError_t ApiErrorDecorator::GetStreamSyncWaitMode(const Stream* const stm, uint32_t* const waitMode)
+{
+    Stream* curStm = Runtime::Instance()->GetCurStream(const_cast<Stream*>(stm));
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(curStm, RT_ERROR_INVALID_VALUE, "Querying the stream sync wait mode");
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(waitMode, RT_ERROR_INVALID_VALUE, "Querying the stream sync wait mode");
+
+    return impl_->GetStreamSyncWaitMode(curStm, waitMode);
+}
+
+rtError_t ApiErrorDecorator::GetStreamSyncWaitStat(const Stream* const stm, rtStreamSyncWaitStat_t* const waitStat)
+{
+    Stream* curStm = Runtime::Instance()->GetCurStream(const_cast<Stream*>(stm));
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(curStm, RT_ERROR_INVALID_VALUE, "Querying the stream sync wait stat");
+    NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(waitStat, RT_ERROR_INVALID_VALUE, "Querying the stream sync wait stat");
+
+    return impl_->GetStreamSyncWaitStat(curStm, waitStat);
+}
+
 rtError_t ApiErrorDecorator::ModelUpdate(Model* mdl)
 {
     NULL_PTR_RETURN_MSG_OUTER_WITH_FUNC_DESC(mdl, RT_ERROR_INVALID_VALUE, "Model update");
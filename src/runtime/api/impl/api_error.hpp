@@ -150,6 +150,11 @@ public:
         const Stream* const stm, rtStreamCaptureStatus* const status, Model** const captureMdl) override;
     rtError_t SetStreamCacheOpInfoSwitch(const Stream* const stm, uint32_t cacheOpInfoSwitch) override;
     rtError_t GetStreamCacheOpInfoSwitch(const Stream* const stm, uint32_t* const cacheOpInfoSwitch) override;
+    rtError_t SetStreamSubmitBatchSize(Stream* const stm, const uint32_t batchSize) override;
+    rtError_t GetStreamSubmitBatchSize(const Stream* const stm, uint32_t* const batchSize) override;
+    rtError_t SetStreamSyncWaitMode(Stream* const stm, const uint32_t waitMode) override;
+    rtError_t GetStreamSyncWaitMode(const Stream* const stm, uint32_t* const waitMode) override;
+    rtError_t GetStreamSyncWaitStat(const Stream* const stm, rtStreamSyncWaitStat_t* const waitStat) override;
     rtError_t ThreadExchangeCaptureMode(rtStreamCaptureMode* const mode) override;
     rtError_t StreamBeginTaskGrp(Stream* const stm) override;
     rtError_t StreamEndTaskGrp(Stream* const stm, TaskGroup** const handle) override;
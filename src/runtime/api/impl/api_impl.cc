@@ -1777,6 +1777,8 @@ rtError_t ApiImpl::StreamQuery(Stream* const stm)
     }
     rtError_t error = curStm->CheckContextStatus();
     COND_RETURN_ERROR(error != RT_ERROR_NONE, error, "context is abort, status=%#x.", static_cast<uint32_t>(error));
+    error = curStm->FlushBatchedTask();
+    COND_RETURN_ERROR(error != RT_ERROR_NONE, error, "Flush batched task failed.");
     error = curStm->Query();
     COND_RETURN_ERROR(
         (error != RT_ERROR_NONE) && (error != RT_ERROR_STREAM_NOT_COMPLETE), error, "Query stream failed.");
@@ -8148,6 +8150,49 @@ rtError_t ApiImpl::GetStreamCacheOpInfoSwitch(const Stream* const stm, uint32_t*
     return RT_ERROR_NONE;
 }
 
+rtError_t ApiImpl::SetStreamSubmitBatchSize(Stream* const stm, const uint32_t batchSize)
+{
+    const rtError_t error = stm->SetSubmitBatchSize(batchSize);
+    RT_LOG(
+        RT_LOG_INFO, "device_id=%u, stream_id=%d, submitBatchSize=%u, retCode=%#x.", stm->Device_()->Id_(), stm->Id_(),
+        batchSize, static_cast<uint32_t>(error));
+    return error;
+}
+
+rtError_t ApiImpl::GetStreamSubmitBatchSize(const Stream* const stm, uint32_t* const batchSize)
+{
+    *batchSize = stm->GetSubmitBatchSize();
+    return RT_ERROR_NONE;
+}
+
+rtError_t ApiImpl::SetStreamSyncWaitMode(Stream* const stm, const uint32_t waitMode)
+{
+    stm->GetWaitPolicy().SetMode(waitMode);
+    RT_LOG(
+        RT_LOG_INFO, "device_id=%u, stream_id=%d, syncWaitMode=%u.", stm->Device_()->Id_(), stm->Id_(), waitMode);
+    return RT_ERROR_NONE;
+}
+
+rtError_t ApiImpl::GetStreamSyncWaitMode(const Stream* const stm, uint32_t* const waitMode)
+{
+    *waitMode = stm->GetWaitPolicy().GetMode();
+    return RT_ERROR_NONE;
+}
+
+rtError_t ApiImpl::GetStreamSyncWaitStat(const Stream* const stm, rtStreamSyncWaitStat_t* const waitStat)
+{
+    StreamWaitStat stat = {};
+    stm->GetWaitPolicy().GetStat(stat);
+    const auto toU32 = [](const uint64_t val) -> uint32_t {
+        return static_cast<uint32_t>(std::min(val, static_cast<uint64_t>(UINT32_MAX)));
+    };
+    waitStat->spinNum = toU32(stat.spinNum);
+    waitStat->parkNum = toU32(stat.parkNum);
+    waitStat->notifiedNum = toU32(stat.notifiedNum);
+    waitStat->wakeupLatencyMaxUs = toU32(stat.wakeupLatencyMaxUs);
+    return RT_ERROR_NONE;
+}
+
 rtError_t ApiImpl::ModelDestroyRegisterCallback(Model* const mdl, const rtCallback_t fn, void* ptr)
 {
     return mdl->ModelDestroyRegisterCallback(fn, ptr);
@@ -95,6 +95,7 @@ set(common_src_files
     ${RUNTIME_CORE_DIR}/src/common/heterogenous.cc
     ${RUNTIME_CORE_DIR}/src/common/inner_thread_local.cpp
     ${RUNTIME_CORE_DIR}/src/common/performance_record.cc
+    ${RUNTIME_CORE_DIR}/src/common/latency_stat.cc
     ${RUNTIME_CORE_DIR}/src/common/prof_ctrl_callback_manager.cc
     ${RUNTIME_CORE_DIR}/src/common/profiling_agent.cc
     ${RUNTIME_CORE_DIR}/src/common/register_memory.cc
@@ -132,6 +133,7 @@ set(libruntime_profile_src_files
     ${RUNTIME_CORE_DIR}/src/profiler/api_profile_decorator.cc
     ${RUNTIME_CORE_DIR}/src/profiler/api_profile_log_decorator.cc
     ${RUNTIME_CORE_DIR}/src/profiler/npu_driver_record.cc
+    ${RUNTIME_CORE_DIR}/src/profiler/profile_record_ring.cc
     ${RUNTIME_CORE_DIR}/src/profiler/onlineprof.cc
     ${RUNTIME_CORE_DIR}/src/profiler/prof_map_ge_model_device.cc
     ${RUNTIME_CORE_DIR}/src/profiler/profile_log_record.cc
@@ -219,6 +221,7 @@ set(runtime_src_kernel_list
     ${RUNTIME_CORE_DIR}/src/kernel/kernel_utils.cc
     ${RUNTIME_CORE_DIR}/src/kernel/module.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program.cc
+    ${RUNTIME_CORE_DIR}/src/kernel/kernel_bin_cache.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program_common.cc
     ${RUNTIME_CORE_DIR}/src/kernel/symbol_table.cc
     ${RUNTIME_CORE_DIR}/src/kernel/v100/kernel.cc
@@ -221,6 +221,7 @@ set(common_src_files_cmodel
     ${RUNTIME_CORE_DIR}/src/common/task_fail_callback_data_manager.cc
     ${RUNTIME_FEATURE_DIR}/xpu/xpu_task_fail_callback_data_manager.cc
     ${RUNTIME_CORE_DIR}/src/common/performance_record.cc
+    ${RUNTIME_CORE_DIR}/src/common/latency_stat.cc
     ${RUNTIME_CORE_DIR}/src/common/prof_ctrl_callback_manager.cc
     ${RUNTIME_CORE_DIR}/src/common/rt_log.cc
     ${RUNTIME_CORE_DIR}/src/common/dev_info_manage.cc
@@ -271,6 +272,7 @@ set(libruntime_cmodel_profile_src_files
     ${RUNTIME_CORE_DIR}/src/profiler/prof_map_ge_model_device.cc
     ${RUNTIME_CORE_DIR}/src/profiler/profile_log_record.cc
     ${RUNTIME_CORE_DIR}/src/profiler/npu_driver_record.cc
+    ${RUNTIME_CORE_DIR}/src/profiler/profile_record_ring.cc
 )
 
 set(libruntime_cmodel_aclrt_impl_src_files
@@ -447,6 +449,7 @@ set(libruntime_cmodel_src_files
     ${RUNTIME_CORE_DIR}/src/kernel/module.cc
     ${RUNTIME_CORE_DIR}/src/kernel/funcsymbol_table.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program.cc
+    ${RUNTIME_CORE_DIR}/src/kernel/kernel_bin_cache.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program_common.cc
     ${RUNTIME_CORE_DIR}/src/kernel/symbol_table.cc
     ${RUNTIME_CORE_DIR}/src/kernel/kernel_utils.cc
@@ -585,6 +588,7 @@ set(libruntime_cmodel_v200_src_files
     ${RUNTIME_CORE_DIR}/src/kernel/v100/program_plat.cc
     ${RUNTIME_CORE_DIR}/src/kernel/module.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program.cc
+    ${RUNTIME_CORE_DIR}/src/kernel/kernel_bin_cache.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program_common.cc
     ${RUNTIME_CORE_DIR}/src/kernel/symbol_table.cc
     ${RUNTIME_CORE_DIR}/src/kernel/kernel_utils.cc
@@ -108,6 +108,7 @@ set(common_src_files
     ${RUNTIME_CORE_DIR}/src/common/task_fail_callback_data_manager.cc
     ${RUNTIME_FEATURE_DIR}/xpu/xpu_task_fail_callback_data_manager_tiny_stub.cc
     ${RUNTIME_CORE_DIR}/src/common/performance_record.cc
+    ${RUNTIME_CORE_DIR}/src/common/latency_stat.cc
     ${RUNTIME_CORE_DIR}/src/common/prof_ctrl_callback_manager.cc
     ${RUNTIME_CORE_DIR}/src/common/rt_log.cc
     ${RUNTIME_CORE_DIR}/src/common/dev_info_manage.cc
@@ -144,6 +145,7 @@ set(libruntime_profile_src_files
     ${RUNTIME_CORE_DIR}/src/profiler/prof_map_ge_model_device.cc
     ${RUNTIME_CORE_DIR}/src/profiler/profile_log_record.cc
     ${RUNTIME_CORE_DIR}/src/profiler/npu_driver_record.cc
+    ${RUNTIME_CORE_DIR}/src/profiler/profile_record_ring.cc
 )
 set(libruntime_arg_loader_files
     ${RUNTIME_CORE_DIR}/src/kernel/arg_loader/uma_arg_loader.cc
@@ -260,6 +262,7 @@ set(libruntime_common_src_files
     ${RUNTIME_CORE_DIR}/src/kernel/kernel.cc
     ${RUNTIME_CORE_DIR}/src/kernel/module.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program.cc
+    ${RUNTIME_CORE_DIR}/src/kernel/kernel_bin_cache.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program_common.cc
     ${RUNTIME_CORE_DIR}/src/kernel/kernel_utils.cc
     ${RUNTIME_CORE_DIR}/src/kernel/v100/program_plat.cc
@@ -404,6 +407,7 @@ set(libruntime_v100_src_files
     ${RUNTIME_CORE_DIR}/src/kernel/kernel.cc
     ${RUNTIME_CORE_DIR}/src/kernel/module.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program.cc
+    ${RUNTIME_CORE_DIR}/src/kernel/kernel_bin_cache.cc
     ${RUNTIME_CORE_DIR}/src/kernel/program_common.cc
     ${RUNTIME_CORE_DIR}/src/kernel/kernel_utils.cc
     ${RUNTIME_CORE_DIR}/src/launch/memory_common.cc
@@ -468,6 +472,7 @@ set(libruntime_v100_src_files
     ${RUNTIME_CORE_DIR}/src/profiler/api_profile_log_decorator.cc
     ${RUNTIME_CORE_DIR}/src/profiler/profile_log_record.cc
     ${RUNTIME_CORE_DIR}/src/profiler/npu_driver_record.cc
+    ${RUNTIME_CORE_DIR}/src/profiler/profile_record_ring.cc
     ${libruntime_arg_loader_files}
     ${RUNTIME_CORE_DIR}/src/device/device_state_callback_manager.cc
     ${RUNTIME_CORE_DIR}/src/stream/stream_state_callback_manager.cc
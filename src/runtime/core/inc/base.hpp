@@ -464,47 +464,49 @@ static inline uint64_t GetWallUs()
 #endif
 }
 
-#ifdef TEMP_PERFORMANCE
-static inline long long GetThreadNs()
-{
-    mmTimespec timeSpec = mmGetTickCount();
-    return timeSpec.tv_sec * 1000000000LL + timeSpec.tv_nsec;
-}
-
-#define TIMESTAMP_BEGIN(VAR)              \
-    do {                                  \
-        VAR##Time.fetch_sub(GetWallUs()); \
+#if defined(TEMP_PERFORMANCE) || !defined(SYSTRACE_ON)
+// Latency of the code between TIMESTAMP_BEGIN and TIMESTAMP_END is recorded into a histogram when the latency stat
+// switch is on (TEMP_PERFORMANCE, env ASCEND_RT_LATENCY_STAT or rtsSetLatencyStat). Only the switch is tested
+// inline, the begin time is not touched while it is off. The rest lives in latency_stat.cc, see latency_stat.hpp.
+class LatencyStat;
+extern std::atomic<bool> g_latencyStatEnable;
+uint64_t LatencyStatBegin();
+void LatencyStatEnd(LatencyStat& stat, const uint64_t beginCycle);
+void LatencyStatDump(const LatencyStat& stat);
+
+#define TIMESTAMP_BEGIN(VAR)                                                                 \
+    do {                                                                                     \
+        if (unlikely(::cce::runtime::g_latencyStatEnable.load(std::memory_order_relaxed))) { \
+            VAR##Begin = ::cce::runtime::LatencyStatBegin();                                 \
+        }                                                                                    \
     } while (false)
 
-#define TIMESTAMP_END(VAR)                \
-    do {                                  \
-        VAR##Time.fetch_add(GetWallUs()); \
-        VAR##Count.fetch_add(1);          \
+#define TIMESTAMP_END(VAR)                                                                   \
+    do {                                                                                     \
+        if (unlikely(::cce::runtime::g_latencyStatEnable.load(std::memory_order_relaxed)) && \
+            (VAR##Begin != 0ULL)) {                                                          \
+            ::cce::runtime::LatencyStatEnd(VAR##Stat, VAR##Begin);                           \
+            VAR##Begin = 0ULL;                                                               \
+        }                                                                                    \
     } while (false)
 
-#define TIMESTAMP_DEFINE(VAR)                            \
-    __THREAD_LOCAL__ std::atomic<int32_t> VAR##Count{0}; \
-    __THREAD_LOCAL__ std::atomic<long long> VAR##Time{0};
+#define TIMESTAMP_DEFINE(VAR)                    \
+    ::cce::runtime::LatencyStat VAR##Stat(#VAR); \
+    __THREAD_LOCAL__ uint64_t VAR##Begin = 0ULL;
 
-#define TIMESTAMP_EXTERN(VAR)                                \
-    extern __THREAD_LOCAL__ std::atomic<int32_t> VAR##Count; \
-    extern __THREAD_LOCAL__ std::atomic<long long> VAR##Time;
+#define TIMESTAMP_EXTERN(VAR)                     \
+    extern ::cce::runtime::LatencyStat VAR##Stat; \
+    extern __THREAD_LOCAL__ uint64_t VAR##Begin;
 
 #ifndef TEMP_PERFORMANCE_NOT_OUTPUT
-#define TIMESTAMP_DUMP(VAR)                                                                                          \
-    do {                                                                                                             \
-        int32_t count = VAR##Count;                                                                                  \
-        long long totalTime = VAR##Time;                                                                             \
-        RT_LOG(                                                                                                      \
-            RT_LOG_ERROR, "[" #VAR "] TIME = %.3f us, COUNT = %d", count ? (float64_t)totalTime / count : 0, count); \
-    } while (false)
+#define TIMESTAMP_DUMP(VAR) ::cce::runtime::LatencyStatDump(VAR##Stat)
 #else
 #define TIMESTAMP_DUMP(VAR)
 #endif
 
 #define TIMESTAMP_NAME(VAR)
 
-#elif defined SYSTRACE_ON
+#else
 #define ATRACE_TAG ATRACE_TAG_GRAPHICS
 #include <utils/Trace.h>
 #define TIMESTAMP_EXTERN(VAR)
@@ -515,14 +517,6 @@ static inline long long GetThreadNs()
 #define TIMESTAMP_BEGIN(VAR) ATRACE_BEGIN(#VAR)
 #define TIMESTAMP_END(VAR) ATRACE_END()
 #define TIMESTAMP_NAME(VAR) ATRACE_NAME(VAR)
-
-#else
-#define TIMESTAMP_BEGIN(VAR)
-#define TIMESTAMP_END(VAR)
-#define TIMESTAMP_DEFINE(VAR)
-#define TIMESTAMP_EXTERN(VAR)
-#define TIMESTAMP_DUMP(VAR)
-#define TIMESTAMP_NAME(VAR)
 #endif
 
 void RtLogErrorLevelControl(bool isLogError, const char* format, ...);
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef CCE_RUNTIME_LATENCY_STAT_HPP
+#define CCE_RUNTIME_LATENCY_STAT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "base.hpp"
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#elif defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace cce {
+namespace runtime {
+// log-linear buckets: values below 4 are exact, every power of two above is split into 4 sub buckets
+constexpr uint32_t LATENCY_STAT_SUB_BUCKET_BITS = 2U;
+constexpr uint32_t LATENCY_STAT_SUB_BUCKET_NUM = 1U << LATENCY_STAT_SUB_BUCKET_BITS;
+constexpr uint32_t LATENCY_STAT_BUCKET_NUM = 160U;  // covers 2^40 cycles, larger values fall into the last bucket
+constexpr uint32_t LATENCY_STAT_SHARD_NUM = 8U;
+
+struct LatencyStatSummary {
+    uint64_t count;
+    uint64_t sumCycle;
+    uint64_t maxCycle;
+    uint64_t p50Cycle;
+    uint64_t p99Cycle;
+    uint64_t p999Cycle;
+};
+
+// Latency histogram of one instrumented site, fed by TIMESTAMP_BEGIN/TIMESTAMP_END in base.hpp.
+// The switch is g_latencyStatEnable declared in base.hpp, so that the macros test it without this header.
+// Instances are static objects which link themselves into a global list on construction.
+// Recording is lock free: a thread always hits the same cache line aligned shard, the shards are allocated
+// on the first record after the switch is on and are never released.
+class LatencyStat {
+public:
+    explicit LatencyStat(const char* const name);
+    ~LatencyStat() = default;
+    LatencyStat(const LatencyStat&) = delete;
+    LatencyStat& operator=(const LatencyStat&) = delete;
+
+    static bool IsEnabled()
+    {
+        return g_latencyStatEnable.load(std::memory_order_relaxed);
+    }
+
+    static void SetEnable(const bool enable)
+    {
+        g_latencyStatEnable.store(enable, std::memory_order_relaxed);
+    }
+
+    // cycle counter, never returns 0 so that 0 can mark "not begun"
+    static uint64_t Now()
+    {
+#if defined(__aarch64__)
+        uint64_t cycle;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(cycle));
+#elif defined(__x86_64__) || defined(_M_X64)
+        const uint64_t cycle = static_cast<uint64_t>(__rdtsc());
+#else
+        const uint64_t cycle = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        return cycle | 1ULL;
+    }
+
+    void Record(const uint64_t beginCycle)
+    {
+        if (beginCycle == 0ULL) {
+            return;
+        }
+        const uint64_t endCycle = Now();
+        // begin and end read on different cores may be slightly out of order
+        RecordCycle((endCycle > beginCycle) ? (endCycle - beginCycle) : 0ULL);
+    }
+
+    void RecordCycle(const uint64_t cycle);
+    bool GetSummary(LatencyStatSummary& summary) const;
+    void Reset();
+    void Dump() const;
+
+    const char* GetName() const
+    {
+        return name_;
+    }
+
+    LatencyStat* GetNext() const
+    {
+        return next_;
+    }
+
+    static LatencyStat* GetListHead()
+    {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    static uint32_t GetBucketIndex(const uint64_t cycle);
+    // smallest value that falls into the bucket
+    static uint64_t GetBucketLowerBound(const uint32_t idx);
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sumCycle;
+        std::atomic<uint64_t> maxCycle;
+        std::atomic<uint64_t> buckets[LATENCY_STAT_BUCKET_NUM];
+    };
+
+    Shard* GetShards();
+    static uint32_t GetShardIndex();
+
+    const char* name_;
+    std::atomic<Shard*> shards_{nullptr};
+    LatencyStat* next_{nullptr};
+
+    static std::atomic<LatencyStat*> head_;
+};
+
+// Runtime switch and periodic exporter of all LatencyStat instances.
+// env ASCEND_RT_LATENCY_STAT=1 turns it on at runtime init, the summary is appended to the file given by
+// ASCEND_RT_LATENCY_STAT_PATH (or written to the event log) every ASCEND_RT_LATENCY_STAT_INTERVAL seconds.
+class LatencyStatManager : public ThreadRunnable {
+public:
+    static LatencyStatManager& Instance();
+    ~LatencyStatManager() override = default;
+
+    void InitFromEnv();
+    void SetEnable(const bool enable);
+    // stop the exporter thread and export once more, called on runtime destruction
+    void Stop();
+    void Export();
+    void Run(const void* param) override;
+
+    // cycle to ns ratio, calibrated between the time the switch was turned on and now
+    float64_t GetNsPerCycle();
+
+private:
+    LatencyStatManager() = default;
+    void StartExporter();
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+    Thread* exporter_{nullptr};
+    bool exporterRunFlag_{false};
+    uint32_t intervalSec_{60U};
+    std::string outputPath_;
+    uint64_t baseCycle_{0ULL};
+    uint64_t baseNs_{0ULL};
+};
+} // namespace runtime
+} // namespace cce
+
+#endif // CCE_RUNTIME_LATENCY_STAT_HPP
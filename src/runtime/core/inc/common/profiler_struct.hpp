@@ -280,6 +280,7 @@ enum rtProfileDataType_t : uint32_t {
     RT_PROFILE_TYPE_MEMCPY_EXT_INFO = 810, /* memcpy extended info */
     RT_PROFILE_TYPE_MEMSET_INFO = 811,     /* memset info */
     RT_PROFILE_TYPE_MEMMNG_INFO = 812,     /* memory management info */
+    RT_PROFILE_TYPE_RT_CALL_RECORD = 813,  /* profile log record of runtime api and driver call */
     RT_PROFILE_TYPE_API_BEGIN = 1000,      /* regist task type and task name for Parsing task info*/
     RT_PROFILE_TYPE_API_END = 2000,
     RT_PROFILE_TYPE_MAX = 2001
@@ -117,7 +117,8 @@ enum ThreadType {
     THREAD_RECYCLE,
     THREAD_REPORTRAS,
     THREAD_PRINTF,
-    THREAD_CALLBACK
+    THREAD_CALLBACK,
+    THREAD_SUBMIT_BATCH
 };
 
 // Runtime engine for task processing, including sending command
@@ -147,6 +148,18 @@ public:
         Stream* const stm, const uint16_t endTaskId, bool isCqeProcess = false);
     virtual rtError_t SyncTask(
         Stream* const stm, const uint32_t taskId, const bool isStreamSync, int32_t timeout = -1, bool isForce = false);
+    // Batched kernel submission, only supported by the stars engine.
+    virtual rtError_t SetSubmitBatch(Stream* const stm, const uint32_t maxTaskNum)
+    {
+        (void)stm;
+        (void)maxTaskNum;
+        return RT_ERROR_FEATURE_NOT_SUPPORT;
+    }
+    virtual rtError_t FlushBatchedTask(Stream* const stm)
+    {
+        (void)stm;
+        return RT_ERROR_NONE;
+    }
     void ReportProfData(TaskInfo* const workTask) const;
     bool ProcessTask(TaskInfo* workTask, const uint32_t deviceId);
     rtError_t ProcessTaskWait(TaskInfo* const task) const;
@@ -10,7 +10,8 @@
 #ifndef __CCE_RUNTIME_SCHEDULER_HPP__
 #define __CCE_RUNTIME_SCHEDULER_HPP__
 
-#include <queue>
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include "base.hpp"
@@ -37,19 +38,55 @@ public:
     virtual void TaskCompleted(TaskInfo* const tsk) const;
 };
 
+constexpr uint32_t FIFO_SCHEDULER_QUEUE_DEPTH = 16384U; // must be power of 2
+constexpr uint32_t FIFO_SCHEDULER_BATCH_NUM = 32U;
+constexpr uint32_t FIFO_SCHEDULER_MIN_SPIN = 64U;
+constexpr uint32_t FIFO_SCHEDULER_MAX_SPIN = 4096U;
+// a producer facing a full ring yields FULL_YIELD_NUM times, then sleeps FULL_SLEEP_US per retry and gives up
+// after FULL_RETRY_NUM sleeps (about 10s)
+constexpr uint32_t FIFO_SCHEDULER_FULL_YIELD_NUM = 1024U;
+constexpr uint32_t FIFO_SCHEDULER_FULL_SLEEP_US = 50U;
+constexpr uint32_t FIFO_SCHEDULER_FULL_RETRY_NUM = 200000U;
+
 // Schedule tasks in first in first out mode, without qos consideration.
+// Tasks are kept in a bounded multi-producer single-consumer ring: user threads claim slots with one CAS,
+// the sending thread drains up to FIFO_SCHEDULER_BATCH_NUM tasks per wakeup, spins adaptively when the ring
+// is empty and parks on the condition variable only after that. Producers signal only a parked consumer.
 class FifoScheduler : public Scheduler {
 public:
-    FifoScheduler() = default;
+    FifoScheduler();
     ~FifoScheduler() override = default;
 
+    // tsk == nullptr only wakes a waiting PopTask, which then returns nullptr.
+    // Returns RT_ERROR_TASKRES_QUEUE_FULL if the ring stays full for the whole retry budget.
     rtError_t PushTask(TaskInfo* const tsk) override;
     TaskInfo* PopTask() override;
 
 private:
+    struct alignas(16) Cell {
+        std::atomic<uint64_t> sequence;
+        TaskInfo* task;
+    };
+
+    uint32_t DrainBatch();
+    bool HasTask() const;
+    void WaitForTask();
+    void WakeUpConsumer();
+
+    // producer side
+    alignas(64) std::atomic<uint64_t> enqueuePos_{0U};
+    std::atomic<bool> wakeUp_{false};
+    // consumer side, only accessed by the sending thread
+    alignas(64) uint64_t dequeuePos_ = 0U;
+    uint32_t batchHead_ = 0U;
+    uint32_t batchTail_ = 0U;
+    uint32_t spinLimit_ = FIFO_SCHEDULER_MIN_SPIN;
+    std::array<TaskInfo*, FIFO_SCHEDULER_BATCH_NUM> batch_ = {};
+    // parking
+    alignas(64) std::atomic<bool> parked_{false};
     std::mutex taskQueMutex_;
     std::condition_variable emptyCond_;
-    std::queue<TaskInfo*> taskQueue_;
+    std::array<Cell, FIFO_SCHEDULER_QUEUE_DEPTH> taskQueue_;
 };
 } // namespace runtime
 } // namespace cce
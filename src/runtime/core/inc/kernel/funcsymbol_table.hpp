@@ -30,6 +30,7 @@ public:
 private:
     std::map<const void*, Kernel*> funcSymbolMap_;
     SpinLock funcSymbolMapLock_;
+    KernelLookupIndex lookupIndex_;
 };
 
 } // namespace runtime
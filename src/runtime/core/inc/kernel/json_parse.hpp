@@ -14,6 +14,8 @@
 namespace cce {
 namespace runtime {
 rtError_t GetJsonObj(const std::string& path, std::string& jsonFileRealPath, nlohmann::json& kernelJsonObj);
+// read the json file which has the same name with binary file without parsing it
+rtError_t GetJsonText(const std::string& path, std::string& jsonFileRealPath, std::string& jsonText);
 void GetCpuKernelFromJson(const nlohmann::json& jsonObj, std::vector<CpuKernelInfo>& kernelInfos);
 } // namespace runtime
 } // namespace cce
@@ -10,6 +10,7 @@
 #ifndef CCE_RUNTIME_KERNEL_TABLE_HPP
 #define CCE_RUNTIME_KERNEL_TABLE_HPP
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <vector>
@@ -26,6 +27,7 @@
 namespace cce {
 namespace runtime {
 constexpr uint32_t KERNEL_ARRAY_SIZE_PER_ALLOC = 2048U;
+constexpr uint32_t KERNEL_LOOKUP_READER_SHARDS = 16U;
 constexpr uint32_t RT_KERNEL_ATTR_TYPE_INVALID = 0x7FFFFFFFU;
 
 // 算子注册的类型分为CPU算子和非CPU算子
@@ -336,6 +338,54 @@ typedef struct {
     int32_t matchIndex;
 } rtHalfSearchResult_t;
 
+struct KernelLookupSnapshot {
+    uint64_t generation;
+    uint32_t num;
+    rtKernelArr_t* entries; // sorted by stub
+};
+
+/*
+ * Read-mostly index from stub (or function symbol) to kernel. Readers search an immutable snapshot without any lock,
+ * writers are serialized by the owner's lock, publish a new snapshot and wait for a grace period before the old one
+ * and the kernels removed from it are freed. The grace period is tracked by two phases of per-shard reader counters.
+ */
+class KernelLookupIndex : public NoCopy {
+public:
+    KernelLookupIndex() = default;
+    ~KernelLookupIndex() override;
+
+    // Called under the owner's lock after kernels were added, the snapshot is rebuilt on next miss.
+    void MarkStale()
+    {
+        stale_.store(true, std::memory_order_release);
+    }
+
+    bool IsStale() const
+    {
+        return stale_.load(std::memory_order_acquire);
+    }
+
+    // Called under the owner's lock with the whole table sorted by stub. When it returns, no reader can see any
+    // kernel which is not in arr. On allocation failure the index is left empty and stale.
+    rtError_t Publish(const rtKernelArr_t* const arr, const uint32_t num);
+
+    // Return false when the index is stale and the caller must search its table under the lock. acquire (may be
+    // null) is called inside the read-side critical section, the found kernel is not freed before it returns.
+    bool Find(const void* const stub, bool (*const acquire)(const Kernel* const), Kernel*& kernel);
+
+private:
+    struct alignas(64) ReaderCounter {
+        std::atomic<uint64_t> count{0ULL};
+    };
+
+    void Synchronize();
+
+    std::atomic<KernelLookupSnapshot*> snapshot_{nullptr};
+    std::atomic<bool> stale_{false};
+    std::atomic<uint32_t> phase_{0U};
+    ReaderCounter readers_[2U][KERNEL_LOOKUP_READER_SHARDS];
+};
+
 class KernelTable {
 public:
     KernelTable();
@@ -356,6 +406,7 @@ public:
 private:
     void ReleaseKernelsOnDestroy();
     SpinLock kernelMapLock_;
+    KernelLookupIndex lookupIndex_;
     std::map<std::string, Kernel*> kernelInfoExtMap_;
     std::map<std::string, const void*> invKernelMap_;
     std::multimap<const Program*, const void*> programStubMultiMap_;
@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "latency_stat.hpp"
+#include <cinttypes>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include "securec.h"
+#include "mmpa/mmpa_api.h"
+#include "base.hpp"
+
+namespace cce {
+namespace runtime {
+namespace {
+constexpr uint32_t LATENCY_STAT_ENV_LEN = 4096U;
+constexpr uint32_t LATENCY_STAT_MAX_INTERVAL_SEC = 86400U;
+constexpr uint64_t LATENCY_STAT_MIN_CALIBRATE_NS = 1000000ULL;  // 1ms
+constexpr float64_t LATENCY_STAT_NS_PER_US = 1000.0;
+constexpr float64_t LATENCY_STAT_NS_PER_SEC = 1000000000.0;
+constexpr size_t LATENCY_STAT_LINE_LEN = 256U;
+
+inline uint32_t HighestBit(const uint64_t val)
+{
+#ifndef WIN32
+    return static_cast<uint32_t>(63 - __builtin_clzll(val)); // 63: 最高位下标
+#else
+    DWORD bitIdx = 0;
+    (void)_BitScanReverse64(&bitIdx, val);
+    return static_cast<uint32_t>(bitIdx);
+#endif
+}
+
+uint64_t GetSteadyNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+// representative value of a bucket, for the exact buckets it is the value itself
+uint64_t GetBucketMidValue(const uint32_t idx)
+{
+    const uint64_t lower = LatencyStat::GetBucketLowerBound(idx);
+    if (idx < LATENCY_STAT_SUB_BUCKET_NUM) {
+        return lower;
+    }
+    return lower + ((LatencyStat::GetBucketLowerBound(idx + 1U) - lower) / 2ULL);
+}
+
+int32_t FormatSummary(const char* const name, const LatencyStatSummary& summary, const float64_t nsPerCycle,
+    char_t* const buf, const size_t bufLen)
+{
+    const float64_t usPerCycle = nsPerCycle / LATENCY_STAT_NS_PER_US;
+    return snprintf_s(buf, bufLen, bufLen - 1U,
+        "[%s] count=%" PRIu64 ", mean=%.3fus, p50=%.3fus, p99=%.3fus, p999=%.3fus, max=%.3fus", name, summary.count,
+        static_cast<float64_t>(summary.sumCycle) * usPerCycle / static_cast<float64_t>(summary.count),
+        static_cast<float64_t>(summary.p50Cycle) * usPerCycle, static_cast<float64_t>(summary.p99Cycle) * usPerCycle,
+        static_cast<float64_t>(summary.p999Cycle) * usPerCycle, static_cast<float64_t>(summary.maxCycle) * usPerCycle);
+}
+} // namespace
+
+std::atomic<bool> g_latencyStatEnable{false};
+std::atomic<LatencyStat*> LatencyStat::head_{nullptr};
+
+uint64_t LatencyStatBegin()
+{
+    return LatencyStat::Now();
+}
+
+void LatencyStatEnd(LatencyStat& stat, const uint64_t beginCycle)
+{
+    stat.Record(beginCycle);
+}
+
+void LatencyStatDump(const LatencyStat& stat)
+{
+    stat.Dump();
+}
+
+LatencyStat::LatencyStat(const char* const name) : name_(name)
+{
+    LatencyStat* head = head_.load(std::memory_order_relaxed);
+    do {
+        next_ = head;
+    } while (!head_.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+uint32_t LatencyStat::GetBucketIndex(const uint64_t cycle)
+{
+    if (cycle < LATENCY_STAT_SUB_BUCKET_NUM) {
+        return static_cast<uint32_t>(cycle);
+    }
+    const uint32_t msb = HighestBit(cycle);
+    const uint32_t sub =
+        static_cast<uint32_t>(cycle >> (msb - LATENCY_STAT_SUB_BUCKET_BITS)) & (LATENCY_STAT_SUB_BUCKET_NUM - 1U);
+    const uint32_t idx = ((msb - 1U) << LATENCY_STAT_SUB_BUCKET_BITS) + sub;
+    return (idx < LATENCY_STAT_BUCKET_NUM) ? idx : (LATENCY_STAT_BUCKET_NUM - 1U);
+}
+
+uint64_t LatencyStat::GetBucketLowerBound(const uint32_t idx)
+{
+    if (idx < LATENCY_STAT_SUB_BUCKET_NUM) {
+        return static_cast<uint64_t>(idx);
+    }
+    const uint32_t group = idx >> LATENCY_STAT_SUB_BUCKET_BITS;
+    const uint64_t sub = static_cast<uint64_t>(idx & (LATENCY_STAT_SUB_BUCKET_NUM - 1U));
+    return (static_cast<uint64_t>(LATENCY_STAT_SUB_BUCKET_NUM) + sub) << (group - 1U);
+}
+
+uint32_t LatencyStat::GetShardIndex()
+{
+    static std::atomic<uint32_t> nextShard{0U};
+    static __THREAD_LOCAL__ uint32_t shardIdx = UINT32_MAX;
+    if (unlikely(shardIdx == UINT32_MAX)) {
+        shardIdx = nextShard.fetch_add(1U, std::memory_order_relaxed) % LATENCY_STAT_SHARD_NUM;
+    }
+    return shardIdx;
+}
+
+LatencyStat::Shard* LatencyStat::GetShards()
+{
+    Shard* shards = shards_.load(std::memory_order_acquire);
+    if (likely(shards != nullptr)) {
+        return shards;
+    }
+    Shard* const newShards = new (std::nothrow) Shard[LATENCY_STAT_SHARD_NUM]();
+    if (newShards == nullptr) {
+        return nullptr;
+    }
+    if (!shards_.compare_exchange_strong(shards, newShards, std::memory_order_acq_rel)) {
+        delete[] newShards;
+        return shards;
+    }
+    return newShards;
+}
+
+void LatencyStat::RecordCycle(const uint64_t cycle)
+{
+    Shard* const shards = GetShards();
+    if (unlikely(shards == nullptr)) {
+        return;
+    }
+    Shard& shard = shards[GetShardIndex()];
+    (void)shard.count.fetch_add(1ULL, std::memory_order_relaxed);
+    (void)shard.sumCycle.fetch_add(cycle, std::memory_order_relaxed);
+    (void)shard.buckets[GetBucketIndex(cycle)].fetch_add(1ULL, std::memory_order_relaxed);
+    uint64_t curMax = shard.maxCycle.load(std::memory_order_relaxed);
+    while ((cycle > curMax) && !shard.maxCycle.compare_exchange_weak(curMax, cycle, std::memory_order_relaxed)) {
+    }
+}
+
+bool LatencyStat::GetSummary(LatencyStatSummary& summary) const
+{
+    (void)memset_s(&summary, sizeof(summary), 0, sizeof(summary));
+    const Shard* const shards = shards_.load(std::memory_order_acquire);
+    if (shards == nullptr) {
+        return false;
+    }
+    uint64_t buckets[LATENCY_STAT_BUCKET_NUM] = {};
+    for (uint32_t i = 0U; i < LATENCY_STAT_SHARD_NUM; i++) {
+        summary.sumCycle += shards[i].sumCycle.load(std::memory_order_relaxed);
+        summary.maxCycle = std::max(summary.maxCycle, shards[i].maxCycle.load(std::memory_order_relaxed));
+        for (uint32_t j = 0U; j < LATENCY_STAT_BUCKET_NUM; j++) {
+            const uint64_t num = shards[i].buckets[j].load(std::memory_order_relaxed);
+            buckets[j] += num;
+            summary.count += num;
+        }
+    }
+    if (summary.count == 0ULL) {
+        return false;
+    }
+
+    // rank of each percentile in per mille, rounded up
+    const uint64_t ranks[] = {(summary.count * 500ULL + 999ULL) / 1000ULL, (summary.count * 990ULL + 999ULL) / 1000ULL,
+                              (summary.count * 999ULL + 999ULL) / 1000ULL};
+    uint64_t* const results[] = {&summary.p50Cycle, &summary.p99Cycle, &summary.p999Cycle};
+    uint32_t rankIdx = 0U;
+    uint64_t accumulated = 0ULL;
+    for (uint32_t j = 0U; (j < LATENCY_STAT_BUCKET_NUM) && (rankIdx < (sizeof(ranks) / sizeof(ranks[0]))); j++) {
+        accumulated += buckets[j];
+        while ((rankIdx < (sizeof(ranks) / sizeof(ranks[0]))) && (accumulated >= ranks[rankIdx])) {
+            *results[rankIdx] = std::min(GetBucketMidValue(j), summary.maxCycle);
+            rankIdx++;
+        }
+    }
+    return true;
+}
+
+void LatencyStat::Reset()
+{
+    Shard* const shards = shards_.load(std::memory_order_acquire);
+    if (shards == nullptr) {
+        return;
+    }
+    for (uint32_t i = 0U; i < LATENCY_STAT_SHARD_NUM; i++) {
+        shards[i].count.store(0ULL, std::memory_order_relaxed);
+        shards[i].sumCycle.store(0ULL, std::memory_order_relaxed);
+        shards[i].maxCycle.store(0ULL, std::memory_order_relaxed);
+        for (uint32_t j = 0U; j < LATENCY_STAT_BUCKET_NUM; j++) {
+            shards[i].buckets[j].store(0ULL, std::memory_order_relaxed);
+        }
+    }
+}
+
+void LatencyStat::Dump() const
+{
+    LatencyStatSummary summary;
+    if (!GetSummary(summary)) {
+        return;
+    }
+    char_t line[LATENCY_STAT_LINE_LEN] = {};
+    if (FormatSummary(name_, summary, LatencyStatManager::Instance().GetNsPerCycle(), line, sizeof(line)) > 0) {
+        RT_LOG(RT_LOG_EVENT, "%s", line);
+    }
+}
+
+LatencyStatManager& LatencyStatManager::Instance()
+{
+    static LatencyStatManager instance;
+    return instance;
+}
+
+void LatencyStatManager::InitFromEnv()
+{
+    bool enable = false;
+#ifdef TEMP_PERFORMANCE
+    enable = true;
+#endif
+    char_t envValue[LATENCY_STAT_ENV_LEN] = {};
+    if ((mmGetEnv("ASCEND_RT_LATENCY_STAT", static_cast<char_t*>(envValue), sizeof(envValue)) == EN_OK) &&
+        (envValue[0] == '1')) {
+        enable = true;
+    }
+    if (!enable) {
+        return;
+    }
+    {
+        const std::unique_lock<std::mutex> lock(mtx_);
+        if (mmGetEnv("ASCEND_RT_LATENCY_STAT_PATH", static_cast<char_t*>(envValue), sizeof(envValue)) == EN_OK) {
+            outputPath_ = envValue;
+        }
+        if (mmGetEnv("ASCEND_RT_LATENCY_STAT_INTERVAL", static_cast<char_t*>(envValue), sizeof(envValue)) ==
+            EN_OK) {
+            const uint64_t interval = std::strtoull(static_cast<char_t*>(envValue), nullptr, 10);
+            if ((interval > 0ULL) && (interval <= LATENCY_STAT_MAX_INTERVAL_SEC)) {
+                intervalSec_ = static_cast<uint32_t>(interval);
+            }
+        }
+        RT_LOG(RT_LOG_EVENT, "Latency stat enabled, interval=%us, path=%s.", intervalSec_,
+            outputPath_.empty() ? "log" : outputPath_.c_str());
+    }
+    SetEnable(true);
+}
+
+void LatencyStatManager::SetEnable(const bool enable)
+{
+    bool needExport = false;
+    {
+        const std::unique_lock<std::mutex> lock(mtx_);
+        const bool curEnable = LatencyStat::IsEnabled();
+        if (enable == curEnable) {
+            return;
+        }
+        if (enable) {
+            // start a new window, the calibration base is also taken here
+            for (LatencyStat* stat = LatencyStat::GetListHead(); stat != nullptr; stat = stat->GetNext()) {
+                stat->Reset();
+            }
+            baseCycle_ = LatencyStat::Now();
+            baseNs_ = GetSteadyNs();
+            StartExporter();
+        } else {
+            needExport = true;
+        }
+        LatencyStat::SetEnable(enable);
+    }
+    if (needExport) {
+        Export();
+    }
+}
+
+void LatencyStatManager::StartExporter()
+{
+    if (exporter_ != nullptr) {
+        return;
+    }
+    exporterRunFlag_ = true;
+    exporter_ = OsalFactory::CreateThread("RT_LATENCY_STAT", this, nullptr);
+    if (exporter_ == nullptr) {
+        exporterRunFlag_ = false;
+        RT_LOG(RT_LOG_WARNING, "Failed to create latency stat exporter thread, export on reset only.");
+        return;
+    }
+    if (exporter_->Start() != EN_OK) {
+        exporterRunFlag_ = false;
+        DELETE_O(exporter_);
+        RT_LOG(RT_LOG_WARNING, "Failed to start latency stat exporter thread, export on reset only.");
+    }
+}
+
+void LatencyStatManager::Stop()
+{
+    Thread* exporter = nullptr;
+    {
+        const std::unique_lock<std::mutex> lock(mtx_);
+        exporterRunFlag_ = false;
+        exporter = exporter_;
+        exporter_ = nullptr;
+    }
+    cond_.notify_all();
+    if (exporter != nullptr) {
+        exporter->Join();
+        DELETE_O(exporter);
+    }
+    if (LatencyStat::IsEnabled()) {
+        Export();
+    }
+}
+
+void LatencyStatManager::Run(const void* param)
+{
+    UNUSED(param);
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (exporterRunFlag_) {
+        (void)cond_.wait_for(lock, std::chrono::seconds(intervalSec_));
+        if (!exporterRunFlag_) {
+            break;
+        }
+        if (LatencyStat::IsEnabled()) {
+            lock.unlock();
+            Export();
+            lock.lock();
+        }
+    }
+}
+
+float64_t LatencyStatManager::GetNsPerCycle()
+{
+#if defined(__aarch64__)
+    uint64_t freq;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+    if (freq != 0ULL) {
+        return LATENCY_STAT_NS_PER_SEC / static_cast<float64_t>(freq);
+    }
+#elif !defined(__x86_64__) && !defined(_M_X64)
+    return 1.0;  // Now() falls back to steady clock ns
+#endif
+    uint64_t baseCycle = 0ULL;
+    uint64_t baseNs = 0ULL;
+    {
+        const std::unique_lock<std::mutex> lock(mtx_);
+        baseCycle = baseCycle_;
+        baseNs = baseNs_;
+    }
+    if ((baseCycle == 0ULL) || ((GetSteadyNs() - baseNs) < LATENCY_STAT_MIN_CALIBRATE_NS)) {
+        // too short to calibrate, measure a window of our own without holding the lock
+        baseCycle = LatencyStat::Now();
+        baseNs = GetSteadyNs();
+        std::this_thread::sleep_for(std::chrono::nanoseconds(LATENCY_STAT_MIN_CALIBRATE_NS));
+    }
+    const uint64_t elapsedCycle = LatencyStat::Now() - baseCycle;
+    const uint64_t elapsedNs = GetSteadyNs() - baseNs;
+    return (elapsedCycle == 0ULL) ? 1.0 : (static_cast<float64_t>(elapsedNs) / static_cast<float64_t>(elapsedCycle));
+}
+
+void LatencyStatManager::Export()
+{
+    const float64_t nsPerCycle = GetNsPerCycle();
+    std::string outputPath;
+    {
+        const std::unique_lock<std::mutex> lock(mtx_);
+        outputPath = outputPath_;
+    }
+    std::ofstream out;
+    if (!outputPath.empty()) {
+        out.open(outputPath, std::ios::out | std::ios::app);
+        if (!out.is_open()) {
+            RT_LOG(RT_LOG_WARNING, "Open latency stat file failed, path=%s, write to log.", outputPath.c_str());
+        } else {
+            out << "# pid=" << PidTidFetcher::GetCurrentPid() << ", steady_time_us=" << (GetSteadyNs() / 1000ULL)
+                << "\n";
+        }
+    }
+    for (const LatencyStat* stat = LatencyStat::GetListHead(); stat != nullptr; stat = stat->GetNext()) {
+        LatencyStatSummary summary;
+        char_t line[LATENCY_STAT_LINE_LEN] = {};
+        if ((!stat->GetSummary(summary)) ||
+            (FormatSummary(stat->GetName(), summary, nsPerCycle, line, sizeof(line)) <= 0)) {
+            continue;
+        }
+        if (out.is_open()) {
+            out << line << '\n';
+        } else {
+            RT_LOG(RT_LOG_EVENT, "latency stat: %s", line);
+        }
+    }
+}
+} // namespace runtime
+} // namespace cce
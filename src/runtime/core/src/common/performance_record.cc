@@ -9,6 +9,7 @@
  */
 
 #include "base.hpp"
+#include "latency_stat.hpp"
 
 namespace cce {
 namespace runtime {
@@ -206,6 +206,7 @@ rtError_t ProfilingAgent::RegisterProfTypeInfo() const
         {RT_PROFILE_TYPE_MEMCPY_EXT_INFO, "memcpy_ext_info"},
         {RT_PROFILE_TYPE_MEMSET_INFO, "memset_info"},
         {RT_PROFILE_TYPE_MEMMNG_INFO, "memmng_info"},
+        {RT_PROFILE_TYPE_RT_CALL_RECORD, "rt_call_record"},
 
         // task track
         {RT_PROFILE_TYPE_TASK_TRACK, "task_track"},
@@ -8,38 +8,143 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 #include "scheduler.hpp"
+#include <chrono>
+#include <thread>
 
 namespace cce {
 namespace runtime {
+namespace {
+constexpr uint64_t FIFO_SCHEDULER_QUEUE_MASK = static_cast<uint64_t>(FIFO_SCHEDULER_QUEUE_DEPTH) - 1ULL;
+static_assert((FIFO_SCHEDULER_QUEUE_DEPTH & (FIFO_SCHEDULER_QUEUE_DEPTH - 1U)) == 0U, "depth must be power of 2");
+} // namespace
+
 void Scheduler::TaskCompleted(TaskInfo* const tsk) const
 {
     UNUSED(tsk);
     // default, we do nothing for task complete
 }
 
+FifoScheduler::FifoScheduler() : Scheduler()
+{
+    for (uint32_t i = 0U; i < FIFO_SCHEDULER_QUEUE_DEPTH; i++) {
+        taskQueue_[i].sequence.store(static_cast<uint64_t>(i), std::memory_order_relaxed);
+        taskQueue_[i].task = nullptr;
+    }
+}
+
 rtError_t FifoScheduler::PushTask(TaskInfo* const tsk)
 {
-    const std::unique_lock<std::mutex> queueLock(taskQueMutex_);
-    taskQueue_.push(tsk);
+    if (unlikely(tsk == nullptr)) {
+        wakeUp_.store(true, std::memory_order_release);
+        WakeUpConsumer();
+        return RT_ERROR_NONE;
+    }
 
-    emptyCond_.notify_one();
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    uint32_t fullRetry = 0U;
+    while (true) {
+        cell = &taskQueue_[pos & FIFO_SCHEDULER_QUEUE_MASK];
+        const uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(seq - pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1ULL, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // queue full, wait for sending thread to drain
+            fullRetry++;
+            if (fullRetry <= FIFO_SCHEDULER_FULL_YIELD_NUM) {
+                std::this_thread::yield();
+            } else if (fullRetry <= (FIFO_SCHEDULER_FULL_YIELD_NUM + FIFO_SCHEDULER_FULL_RETRY_NUM)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(FIFO_SCHEDULER_FULL_SLEEP_US));
+            } else {
+                RT_LOG(RT_LOG_WARNING, "Task queue stays full, depth=%u.", FIFO_SCHEDULER_QUEUE_DEPTH);
+                return RT_ERROR_TASKRES_QUEUE_FULL;
+            }
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->task = tsk;
+    cell->sequence.store(pos + 1ULL, std::memory_order_release);
 
+    WakeUpConsumer();
     return RT_ERROR_NONE;
 }
 
+void FifoScheduler::WakeUpConsumer()
+{
+    // pairs with the fence in WaitForTask: either the consumer sees the new task, or we see it parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+        const std::unique_lock<std::mutex> queueLock(taskQueMutex_);
+        emptyCond_.notify_one();
+    }
+}
+
+bool FifoScheduler::HasTask() const
+{
+    const Cell& cell = taskQueue_[dequeuePos_ & FIFO_SCHEDULER_QUEUE_MASK];
+    return (cell.sequence.load(std::memory_order_acquire) == (dequeuePos_ + 1ULL)) ||
+           wakeUp_.load(std::memory_order_acquire);
+}
+
+uint32_t FifoScheduler::DrainBatch()
+{
+    batchHead_ = 0U;
+    batchTail_ = 0U;
+    while (batchTail_ < FIFO_SCHEDULER_BATCH_NUM) {
+        Cell& cell = taskQueue_[dequeuePos_ & FIFO_SCHEDULER_QUEUE_MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != (dequeuePos_ + 1ULL)) {
+            break;
+        }
+        batch_[batchTail_++] = cell.task;
+        cell.sequence.store(dequeuePos_ + FIFO_SCHEDULER_QUEUE_DEPTH, std::memory_order_release);
+        dequeuePos_++;
+    }
+    return batchTail_;
+}
+
+void FifoScheduler::WaitForTask()
+{
+    // spin first, the spin budget grows when spinning pays off and shrinks when we end up parking
+    for (uint32_t i = 0U; i < spinLimit_; i++) {
+        if (HasTask()) {
+            spinLimit_ = std::min(spinLimit_ * 2U, FIFO_SCHEDULER_MAX_SPIN);
+            return;
+        }
+        std::this_thread::yield();
+    }
+    spinLimit_ = std::max(spinLimit_ / 2U, FIFO_SCHEDULER_MIN_SPIN);
+
+    std::unique_lock<std::mutex> queueLock(taskQueMutex_);
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!HasTask()) {
+        emptyCond_.wait(queueLock);
+    }
+    parked_.store(false, std::memory_order_relaxed);
+}
+
 TIMESTAMP_EXTERN(PopTask);
 TaskInfo* FifoScheduler::PopTask()
 {
-    std::unique_lock<std::mutex> queueLock(taskQueMutex_);
+    if (batchHead_ < batchTail_) {
+        return batch_[batchHead_++];
+    }
 
     // wait for new task come
-    while (taskQueue_.empty()) {
-        emptyCond_.wait(queueLock);
+    while (DrainBatch() == 0U) {
+        if (wakeUp_.exchange(false, std::memory_order_acq_rel)) {
+            return nullptr;
+        }
+        WaitForTask();
     }
 
     TIMESTAMP_BEGIN(PopTask);
-    TaskInfo* const frontTask = taskQueue_.front();
-    taskQueue_.pop();
+    TaskInfo* const frontTask = batch_[batchHead_++];
     TIMESTAMP_END(PopTask);
     return frontTask;
 }
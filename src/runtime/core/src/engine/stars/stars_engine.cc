@@ -42,6 +42,8 @@ namespace {
 constexpr uint16_t TASK_RECLAIM_MAX_NUM = 64U;       // Max reclaim num per query.
 constexpr uint16_t TASK_QUERY_INTERVAL_NUM = 64U;    // Shared memory query interval.
 constexpr uint16_t TASK_WAIT_EXECUTE_MAX_NUM = 512U; // Max number of tasks waiting to be executed on device.
+constexpr uint64_t SUBMIT_BATCH_TIMEOUT_US = 50ULL;  // Max time a kernel is held back by batched submission.
+constexpr uint32_t SUBMIT_BATCH_SQ_DEPTH_RATIO = 4U; // Batched SQEs take at most 1/4 of the sq.
 } // namespace
 
 namespace cce {
@@ -83,6 +85,10 @@ void StarsEngine::Run(const void* const param)
             PrintfRun();
             break;
         }
+        case THREAD_SUBMIT_BATCH: {
+            SubmitBatchRun();
+            break;
+        }
         default: {
             RT_LOG(RT_LOG_ERROR, "Unknown thread type.");
             break;
@@ -157,6 +163,7 @@ rtError_t StarsEngine::Stop()
         RT_LOG(RT_LOG_INFO, "StarsEngine joined monitor thread OK.");
         DELETE_O(monitorThread_);
     }
+    DestroySubmitBatchThread();
     DestroyPrintfThread();
     return RT_ERROR_NONE;
 }
@@ -981,6 +988,225 @@ rtError_t StarsEngine::SendTask(TaskInfo* const workTask, uint16_t& taskId, uint
     return error;
 }
 
+rtError_t StarsEngine::SetSubmitBatch(Stream* const stm, const uint32_t maxTaskNum)
+{
+    uint32_t batchTaskNum = std::min(maxTaskNum, stm->GetSqDepth() / SUBMIT_BATCH_SQ_DEPTH_RATIO);
+    batchTaskNum = (batchTaskNum > 1U) ? batchTaskNum : 0U;
+    if (batchTaskNum != 0U) {
+        const rtError_t ret = CreateSubmitBatchThread();
+        COND_RETURN_ERROR_MSG_INNER(ret != RT_ERROR_NONE, ret, "Failed to create submit batch thread, stream_id=%d.",
+            stm->Id_());
+    }
+    stm->StreamLock();
+    const rtError_t error = SendBatchedSqe(stm);
+    StreamSubmitBatch& batch = stm->GetSubmitBatch();
+    if (error == RT_ERROR_NONE) {
+        batch.maxTaskNum = batchTaskNum;
+        if (batchTaskNum == 0U) {
+            std::vector<rtStarsSqe_t>().swap(batch.sqes);
+        } else {
+            batch.sqes.reserve(static_cast<size_t>(batchTaskNum) * SQE_NUM_PER_STARS_TASK_MAX);
+        }
+    }
+    stm->StreamUnLock();
+    COND_RETURN_ERROR_MSG_INNER(error != RT_ERROR_NONE, error, "Failed to flush batched task, stream_id=%d.",
+        stm->Id_());
+
+    const std::lock_guard<std::mutex> lk(batchStreamMutex_);
+    if (batchTaskNum == 0U) {
+        (void)batchStreams_.erase(stm);
+    } else {
+        (void)batchStreams_.insert(stm);
+    }
+    RT_LOG(RT_LOG_INFO, "stream_id=%d, submit batch size=%u, effective size=%u.", stm->Id_(), maxTaskNum,
+        batchTaskNum);
+    return RT_ERROR_NONE;
+}
+
+rtError_t StarsEngine::FlushBatchedTask(Stream* const stm)
+{
+    stm->StreamLock();
+    rtError_t error = SendBatchedSqe(stm);
+    StreamSubmitBatch& batch = stm->GetSubmitBatch();
+    // a batch sent by the submit batch thread may have failed since the last call, report it once
+    error = (error != RT_ERROR_NONE) ? error : batch.error;
+    batch.error = RT_ERROR_NONE;
+    stm->StreamUnLock();
+    return error;
+}
+
+bool StarsEngine::IsBatchableTask(const Stream* const stm, const TaskInfo* const workTask) const
+{
+    // only plain kernels of a single-operator stream, other tasks may be waited on by the host or another stream
+    if (stm->GetSubmitBatchSize() <= 1U) {
+        return false;
+    }
+    if ((workTask->type != TS_TASK_TYPE_KERNEL_AICORE) && (workTask->type != TS_TASK_TYPE_KERNEL_AIVEC)) {
+        return false;
+    }
+    return (!stm->IsSoftwareSqEnable()) && (!stm->GetBindFlag()) && (stm->Model_() == nullptr);
+}
+
+uint64_t StarsEngine::GetBatchRemainTime(const StreamSubmitBatch& batch) const
+{
+    const uint64_t passTime = ClockGetTimeIntervalUs(batch.beginTime);
+    return (passTime >= SUBMIT_BATCH_TIMEOUT_US) ? 0ULL : (SUBMIT_BATCH_TIMEOUT_US - passTime);
+}
+
+rtError_t StarsEngine::AppendBatchedSqe(Stream* const stm, const rtStarsSqe_t* const sqe, const uint32_t sqeNum)
+{
+    StreamSubmitBatch& batch = stm->GetSubmitBatch();
+    if (batch.taskNum == 0U) {
+        batch.beginTime = ClockGetTimeUs();
+        // let the submit batch thread send it when the deadline passes
+        const std::lock_guard<std::mutex> lk(batchWakeMutex_);
+        batchPendingNum_++;
+        batchWakeCond_.notify_one();
+    }
+    (void)batch.sqes.insert(batch.sqes.end(), sqe, sqe + sqeNum);
+    batch.sqeNum += sqeNum;
+    batch.taskNum++;
+    if ((batch.taskNum >= batch.maxTaskNum) || (GetBatchRemainTime(batch) == 0ULL)) {
+        return SendBatchedSqe(stm);
+    }
+    return RT_ERROR_NONE;
+}
+
+rtError_t StarsEngine::SendBatchedSqe(Stream* const stm)
+{
+    StreamSubmitBatch& batch = stm->GetSubmitBatch();
+    if (batch.taskNum == 0U) {
+        return RT_ERROR_NONE;
+    }
+    Device* const dev = GetDevice();
+    Driver* const devDrv = dev->Driver_();
+    COND_RETURN_ERROR(devDrv == nullptr, RT_ERROR_DRV_ERR, "Failed to find device driver.");
+    const uint32_t devId = dev->Id_();
+    const uint32_t tsId = dev->DevGetTsId();
+    const uint32_t sqId = stm->GetSqId();
+    uint64_t beginCnt = 0ULL;
+    uint64_t endCnt = 0ULL;
+    uint16_t checkCount = 0U;
+    uint32_t tryCount = 0U;
+    rtError_t error = RT_ERROR_NONE;
+
+    while (true) {
+        TIMESTAMP_BEGIN(SqTaskSend);
+        error = devDrv->SqTaskSend(sqId, batch.sqes.data(), devId, tsId, batch.sqeNum);
+        TIMESTAMP_END(SqTaskSend);
+        if (likely(error == RT_ERROR_NONE)) {
+            break;
+        }
+        RT_LOG(
+            RT_LOG_WARNING, "device_id=%u, ts_id=%u, sq_id=%u, stream_id=%d, task_num=%u, sqe_num=%u, error=%#x",
+            devId, tsId, sqId, stm->Id_(), batch.taskNum, batch.sqeNum, static_cast<uint32_t>(error));
+        tryCount++;
+        if (stm->PrintStmDfxAndCheckDevice(beginCnt, endCnt, checkCount, tryCount) != RT_ERROR_NONE) {
+            RT_LOG(
+                RT_LOG_ERROR, "Failed to send batched SQE. Reason: device status error, device_id=%u, stream_id=%d.",
+                devId, stm->Id_());
+            // kept until the next synchronize or query of the stream
+            batch.error = error;
+            break;
+        }
+    }
+
+    RT_LOG(
+        RT_LOG_INFO,
+        "Sq batched task send finished, device_id=%u, ts_id=%u, sq_id=%u, stream_id=%d, task_num=%u, sqe_num=%u, "
+        "tryCount=%u, taskHead=%u, taskTail=%u.",
+        devId, tsId, sqId, stm->Id_(), batch.taskNum, batch.sqeNum, tryCount, stm->GetTaskHead(), stm->GetTaskTail());
+    batch.taskNum = 0U;
+    batch.sqeNum = 0U;
+    batch.sqes.clear();
+    {
+        const std::lock_guard<std::mutex> lk(batchWakeMutex_);
+        batchPendingNum_ = (batchPendingNum_ > 0U) ? (batchPendingNum_ - 1U) : 0U;
+    }
+    return error;
+}
+
+uint64_t StarsEngine::FlushExpiredBatches()
+{
+    uint64_t waitTime = 0ULL;
+    const std::lock_guard<std::mutex> lk(batchStreamMutex_);
+    for (Stream* const stm : batchStreams_) {
+        stm->StreamLock();
+        const StreamSubmitBatch& batch = stm->GetSubmitBatch();
+        if (batch.taskNum != 0U) {
+            const uint64_t remainTime = GetBatchRemainTime(batch);
+            if (remainTime == 0ULL) {
+                (void)SendBatchedSqe(stm);
+            } else {
+                waitTime = (waitTime == 0ULL) ? remainTime : std::min(waitTime, remainTime);
+            }
+        }
+        stm->StreamUnLock();
+    }
+    return waitTime;
+}
+
+rtError_t StarsEngine::CreateSubmitBatchThread(void)
+{
+    const std::lock_guard<std::mutex> lk(batchStreamMutex_);
+    // one thread per device, created by the first stream that turns batched submission on
+    if (batchThread_ != nullptr) {
+        return RT_ERROR_NONE;
+    }
+
+    void* const submitBatch = RtValueToPtr<void*>(THREAD_SUBMIT_BATCH);
+    const std::string threadName = "RT_SUBMIT_BATCH_" + std::to_string(device_->Id_());
+    batchThread_.reset(OsalFactory::CreateThread(threadName.c_str(), this, submitBatch));
+    NULL_PTR_RETURN(batchThread_, RT_ERROR_MEMORY_ALLOCATION);
+    batchThreadRunFlag_ = true;
+    const int32_t error = batchThread_->Start();
+    if (error != EN_OK) {
+        batchThreadRunFlag_ = false;
+        batchThread_.reset(nullptr);
+        return RT_ERROR_ENGINE_THREAD;
+    }
+    return RT_ERROR_NONE;
+}
+
+void StarsEngine::DestroySubmitBatchThread(void)
+{
+    if (batchThread_ != nullptr) {
+        {
+            const std::lock_guard<std::mutex> lk(batchWakeMutex_);
+            batchThreadRunFlag_ = false;
+            batchWakeCond_.notify_one();
+        }
+        batchThread_->Join();
+        RT_LOG(RT_LOG_INFO, "Stars engine joined submit batch thread OK.");
+        batchThread_.reset(nullptr);
+    }
+    return;
+}
+
+void StarsEngine::SubmitBatchRun(void)
+{
+    RT_LOG(RT_LOG_INFO, "SubmitBatchRun thread start.");
+    uint64_t waitTime = 0ULL;
+    while (batchThreadRunFlag_) {
+        {
+            std::unique_lock<std::mutex> lk(batchWakeMutex_);
+            if (waitTime == 0ULL) {
+                // nothing is held back, sleep until a stream starts a batch
+                batchWakeCond_.wait(lk, [this]() { return (batchPendingNum_ != 0U) || (!batchThreadRunFlag_); });
+                waitTime = SUBMIT_BATCH_TIMEOUT_US;
+            }
+            (void)batchWakeCond_.wait_for(
+                lk, std::chrono::microseconds(waitTime), [this]() { return !batchThreadRunFlag_; });
+        }
+        if (!batchThreadRunFlag_) {
+            break;
+        }
+        waitTime = FlushExpiredBatches();
+    }
+    RT_LOG(RT_LOG_INFO, "SubmitBatchRun thread leave.");
+    return;
+}
+
 rtError_t StarsEngine::RecycleTaskBySqHead(Stream* const stm, uint32_t& finishTaskId)
 {
     uint16_t sqHead = 0U;
@@ -1183,6 +1409,9 @@ void StarsEngine::SyncTaskCheckResult(const rtError_t error, const Stream* const
 rtError_t StarsEngine::SyncTask(
     Stream* const stm, const uint32_t taskId, const bool isStreamSync, int32_t timeout, bool isForce)
 {
+    const rtError_t flushRet = stm->FlushBatchedTask();
+    COND_RETURN_ERROR_MSG_INNER(flushRet != RT_ERROR_NONE, flushRet, "Failed to flush batched task, stream_id=%d.",
+        stm->Id_());
     if (stm->IsSeparateSendAndRecycle()) {
         rtError_t error = RT_ERROR_NONE;
         error = stm->SynchronizeImpl(taskId, static_cast<uint16_t>(taskId), timeout);
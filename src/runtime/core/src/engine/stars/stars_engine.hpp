@@ -12,6 +12,9 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <condition_variable>
 #include "base.hpp"
 #include "osal.hpp"
@@ -25,6 +28,8 @@
 
 namespace cce {
 namespace runtime {
+struct StreamSubmitBatch;
+
 // Runtime engine for STARS task processing, including sending command and receiving report for stars remove thread.
 class StarsEngine : public Engine {
 public:
@@ -44,6 +49,14 @@ public:
         Stream* const stm, const uint32_t taskId, const bool isStreamSync, int32_t timeout = -1,
         bool isForce = false) override;
 
+    rtError_t SetSubmitBatch(Stream* const stm, const uint32_t maxTaskNum) override;
+    rtError_t FlushBatchedTask(Stream* const stm) override;
+    bool IsBatchableTask(const Stream* const stm, const TaskInfo* const workTask) const;
+    // hold back the SQEs of a kernel, called with the stream lock held
+    rtError_t AppendBatchedSqe(Stream* const stm, const rtStarsSqe_t* const sqe, const uint32_t sqeNum);
+    // send the held back SQEs with one driver call, called with the stream lock held
+    rtError_t SendBatchedSqe(Stream* const stm);
+
     void ProcReport(
         const uint32_t taskId, const bool isStreamSync, const uint32_t cnt, rtCqReport_t* const logicReport,
         bool& isFinished, uint32_t cqId);
@@ -104,6 +117,14 @@ private:
 
     rtError_t SendTask(TaskInfo* const workTask, uint16_t& taskId, uint32_t* const flipTaskId = nullptr) override;
 
+    // us left before the held back SQEs must be sent, 0 when the batch is due
+    uint64_t GetBatchRemainTime(const StreamSubmitBatch& batch) const;
+    // send the batches that are due, return the us to wait for the next one, 0 when nothing is held back
+    uint64_t FlushExpiredBatches();
+    rtError_t CreateSubmitBatchThread(void);
+    void DestroySubmitBatchThread(void);
+    void SubmitBatchRun(void);
+
     rtError_t SubmitSend(TaskInfo* const workTask, uint32_t* const flipTaskId) override;
 
     rtError_t StarsResumeRtsq(const rtCqReport_t& logicCq, const uint16_t taskType, Stream* const failStm) const;
@@ -148,6 +169,14 @@ private:
 
     mmSem_t recycleThreadSem_;
 
+    std::mutex batchStreamMutex_;
+    std::set<Stream*> batchStreams_; // streams with batched submission on, swept by the submit batch thread
+    std::unique_ptr<Thread> batchThread_;
+    std::atomic<bool> batchThreadRunFlag_{false};
+    std::mutex batchWakeMutex_;
+    std::condition_variable batchWakeCond_;
+    uint32_t batchPendingNum_ = 0U; // non-empty batches, protected by batchWakeMutex_
+
 #ifndef CFG_DEV_PLATFORM_PC
     error_message::Context errorContext_ = {0UL, "", "", ""};
 #endif
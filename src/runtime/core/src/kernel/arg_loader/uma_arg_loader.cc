@@ -61,20 +61,21 @@ rtError_t UmaArgLoader::Init()
         uint32_t val = RT_CAPABILITY_NOT_SUPPORT;
         (void)device_->Driver_()->CheckSupportPcieBarCopy(device_->Id_(), val, false);
         isPcieBarSupport = (val == RT_CAPABILITY_SUPPORT);
+        const H2DCopyPolicy argsPolicy = H2DCopyMgr::GetArgsCopyPolicy();
         uint32_t argAllocatorSize = initCount;
         if (device_->GetDevProperties().argsAllocatorSize != 0U) {
             argAllocatorSize = device_->GetDevProperties().argsAllocatorSize;
         }
         argAllocator_ = new (std::nothrow) H2DCopyMgr(
             device_, itemSize_, argAllocatorSize, device_->GetDevProperties().maxSupportTaskNum,
-            BufferAllocator::LINEAR, COPY_POLICY_DEFAULT); // 512 cell for init
+            BufferAllocator::LINEAR, argsPolicy); // 512 cell for init
         COND_RETURN_AND_MSG_OUTER(
             argAllocator_ == nullptr, RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013, sizeof(H2DCopyMgr), "new");
         if (device_->IsSupportFeature(RtOptionalFeatureType::RT_FEATURE_KERNEL_UMA_SUPER_ARGS_ALLOC)) {
             const uint32_t superArgAllocatorSize = device_->GetDevProperties().superArgAllocatorSize;
             superArgAllocator_ = new (std::nothrow) H2DCopyMgr(
                 device_, MULTI_GRAPH_SUPER_ARG_ENTRY_SIZE, superArgAllocatorSize,
-                device_->GetDevProperties().maxSupportTaskNum, BufferAllocator::LINEAR, COPY_POLICY_DEFAULT);
+                device_->GetDevProperties().maxSupportTaskNum, BufferAllocator::LINEAR, argsPolicy);
 
             COND_RETURN_AND_MSG_OUTER(
                 superArgAllocator_ == nullptr, RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013, sizeof(H2DCopyMgr),
@@ -82,7 +83,7 @@ rtError_t UmaArgLoader::Init()
             const uint32_t maxArgAllocatorSize = device_->GetDevProperties().maxArgAllocatorSize;
             maxArgAllocator_ = new (std::nothrow) H2DCopyMgr(
                 device_, maxItemSize_, maxArgAllocatorSize, device_->GetDevProperties().maxSupportTaskNum,
-                BufferAllocator::LINEAR, COPY_POLICY_DEFAULT);
+                BufferAllocator::LINEAR, argsPolicy);
 
             COND_RETURN_AND_MSG_OUTER(
                 maxArgAllocator_ == nullptr, RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013, sizeof(H2DCopyMgr), "new");
@@ -91,7 +92,7 @@ rtError_t UmaArgLoader::Init()
             if (Runtime::Instance()->GetAicpuCnt() != 0) {
                 maxArgAllocator_ = new (std::nothrow) H2DCopyMgr(
                     device_, maxItemSize_, ARG_MAX_ENTRY_INIT_NUM, device_->GetDevProperties().maxSupportTaskNum,
-                    BufferAllocator::LINEAR, COPY_POLICY_DEFAULT);
+                    BufferAllocator::LINEAR, argsPolicy);
                 COND_RETURN_AND_MSG_OUTER(
                     maxArgAllocator_ == nullptr, RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013, sizeof(H2DCopyMgr),
                     "new");
@@ -20,6 +20,7 @@
 #include "program.hpp"
 #include "context.hpp"
 #include "json_parse.hpp"
+#include "kernel_bin_cache.hpp"
 
 namespace cce {
 namespace runtime {
@@ -74,14 +75,6 @@ static uint32_t ParseMagic(const nlohmann::json& kernelJson)
     }
 }
 
-static void ParseInterCrossSync(const nlohmann::json& kernelJson, ElfProgram* const prog)
-{
-    if (kernelJson.contains("intercoreSync") && kernelJson["intercoreSync"] == 1U) {
-        RT_LOG(RT_LOG_DEBUG, "support inter core sync");
-        prog->SetIsSupportInterCoreSync(true);
-    }
-}
-
 static rtError_t ParseDebugOptions(const nlohmann::json& kernelJson)
 {
     if (kernelJson.find("debugOptions") == kernelJson.end()) {
@@ -102,6 +95,41 @@ static rtError_t ParseDebugOptions(const nlohmann::json& kernelJson)
     return RT_ERROR_NONE;
 }
 
+// Everything ParseKernelJsonFile needs from the json file, it is cached by content so warm start skips parsing.
+static rtError_t GetKernelJsonSummary(
+    const std::string& binRealPath, std::string& jsonFileRealPath, KernelJsonSummary& summary)
+{
+    std::string jsonText;
+    const rtError_t error = GetJsonText(binRealPath, jsonFileRealPath, jsonText);
+    if (error != RT_ERROR_NONE) {
+        return error;
+    }
+
+    const KernelBinCache& binCache = KernelBinCache::Instance();
+    if (binCache.LoadJsonSummary(jsonText, summary)) {
+        return RT_ERROR_NONE;
+    }
+
+    nlohmann::json kernelJsonObj;
+    try {
+        kernelJsonObj = nlohmann::json::parse(jsonText);
+    } catch (nlohmann::json::exception& e) {
+        RT_LOG(RT_LOG_ERROR, "Parse kernel json file=[%s] failed, because %s.", jsonFileRealPath.c_str(), e.what());
+        return RT_ERROR_INVALID_VALUE;
+    }
+
+    summary = {};
+    if (kernelJsonObj.contains("intercoreSync") && kernelJsonObj["intercoreSync"] == 1U) {
+        summary.interCoreSync = 1U;
+    }
+    summary.debugOptionsRet = ParseDebugOptions(kernelJsonObj);
+    if (summary.debugOptionsRet == RT_ERROR_NONE) {
+        summary.jsonMagic = ParseMagic(kernelJsonObj);
+    }
+    binCache.StoreJsonSummary(jsonText, summary);
+    return RT_ERROR_NONE;
+}
+
 rtError_t BinaryLoader::ParseLoadOptions()
 {
     if (loadOptions_ == nullptr) {
@@ -241,22 +269,24 @@ rtError_t BinaryLoader::ReadBinaryFile()
 
 rtError_t BinaryLoader::ParseKernelJsonFile(ElfProgram* const prog) const
 {
-    nlohmann::json kernelJsonObj;
+    KernelJsonSummary summary = {};
     std::string jsonFileRealPath;
-    rtError_t error = GetJsonObj(binRealPath_, jsonFileRealPath, kernelJsonObj);
+    const rtError_t error = GetKernelJsonSummary(binRealPath_, jsonFileRealPath, summary);
     if (error != RT_ERROR_NONE) {
         RT_LOG(RT_LOG_WARNING, "kernel json is not exists. bin=[%s]", binRealPath_.c_str());
         return RT_ERROR_NONE;
     }
 
-    ParseInterCrossSync(kernelJsonObj, prog);
+    if (summary.interCoreSync == 1U) {
+        RT_LOG(RT_LOG_DEBUG, "support inter core sync");
+        prog->SetIsSupportInterCoreSync(true);
+    }
 
-    error = ParseDebugOptions(kernelJsonObj);
-    ERROR_RETURN(error, "Parse debug options failed, json=[%s]", jsonFileRealPath.c_str());
+    ERROR_RETURN(summary.debugOptionsRet, "Parse debug options failed, json=[%s]", jsonFileRealPath.c_str());
 
     rtKernelAttrType kernelAttrType = static_cast<rtKernelAttrType>(RT_KERNEL_ATTR_TYPE_INVALID);
     /* jsonMagic > optionMagic > defaultMagic */
-    const uint32_t jsonMagic = ParseMagic(kernelJsonObj);
+    const uint32_t jsonMagic = summary.jsonMagic;
     if (jsonMagic != 0U) {
         kernelAttrType = Runtime::Instance()->Magic2KernelAttrType(jsonMagic);
         if (kernelAttrType != static_cast<rtKernelAttrType>(RT_KERNEL_ATTR_TYPE_INVALID)) {
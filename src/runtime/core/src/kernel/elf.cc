@@ -9,6 +9,7 @@
  */
 #include "elf.hpp"
 #include <cstdlib>
+#include <cstring>
 #include "securec.h"
 #include "logger.hpp"
 #include "error_message_manage.hpp"
@@ -171,6 +172,110 @@ uint64_t ByteGetLittleEndian(const uint8_t field[], const int32_t size)
     return ret;
 }
 
+static inline uint16_t ElfByteSwap(const uint16_t val)
+{
+    return __builtin_bswap16(val);
+}
+
+static inline uint32_t ElfByteSwap(const uint32_t val)
+{
+    return __builtin_bswap32(val);
+}
+
+static inline uint64_t ElfByteSwap(const uint64_t val)
+{
+    return __builtin_bswap64(val);
+}
+
+// Loads a fixed-width ELF field at once instead of byte by byte, NEED_SWAP is set when the endianness of the
+// ELF object differs from the host.
+template <bool NEED_SWAP, typename T>
+static inline T ElfLoad(const uint8_t field[])
+{
+    T val;
+    // fixed-size memcpy is lowered to a single unaligned load
+    (void)std::memcpy(&val, field, sizeof(T));
+    return NEED_SWAP ? ElfByteSwap(val) : val;
+}
+
+static bool ElfNeedByteSwap(const rtElfData* const elfData)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    constexpr bool hostBigEndian = true;
+#else
+    constexpr bool hostBigEndian = false;
+#endif
+    // ELFDATANONE and unknown values are treated as little endian, the same as SetGetByteFunc
+    const bool elfBigEndian = (static_cast<int32_t>(elfData->elf_header.e_ident[EI_DATA]) == ELFDATA2MSB);
+    return elfBigEndian != hostBigEndian;
+}
+
+template <bool NEED_SWAP>
+static int32_t DecodeSectionHeaders(
+    const rtElfData* const elfData, const Elf64_External_Shdr* const shdrs, const uint32_t num,
+    Elf_Internal_Shdr* internalShdrs)
+{
+    for (uint32_t i = 0U; i < num; i++) {
+        const uint64_t objOffset = RtPtrToValue(shdrs + (i + 1)) - RtPtrToValue(elfData->obj_ptr_origin);
+        if (objOffset > elfData->obj_size) {
+            RT_LOG_OUTER_MSG_IMPL(
+                ErrorCode::EE1014, "The offset " + std::to_string(objOffset) + " of the section ranked " +
+                                       std::to_string(i) + " exceeds the size " + std::to_string(elfData->obj_size) +
+                                       " of the ELF object");
+            return ELF_FAIL;
+        }
+
+        const Elf64_External_Shdr& ext = shdrs[i];
+        internalShdrs->sh_name = ElfLoad<NEED_SWAP, uint32_t>(ext.sh_name);
+        internalShdrs->sh_type = ElfLoad<NEED_SWAP, uint32_t>(ext.sh_type);
+        internalShdrs->sh_flags = ElfLoad<NEED_SWAP, uint64_t>(ext.sh_flags);
+        internalShdrs->sh_addr = ElfLoad<NEED_SWAP, uint64_t>(ext.sh_addr);
+        internalShdrs->sh_size = ElfLoad<NEED_SWAP, uint64_t>(ext.sh_size);
+        internalShdrs->sh_entsize = ElfLoad<NEED_SWAP, uint64_t>(ext.sh_entsize);
+        internalShdrs->sh_link = ElfLoad<NEED_SWAP, uint32_t>(ext.sh_link);
+        internalShdrs->sh_info = ElfLoad<NEED_SWAP, uint32_t>(ext.sh_info);
+        internalShdrs->sh_offset = ElfLoad<NEED_SWAP, uint64_t>(ext.sh_offset);
+        internalShdrs->sh_addralign = ElfLoad<NEED_SWAP, uint64_t>(ext.sh_addralign);
+        if (internalShdrs->sh_link > num) {
+            RT_LOG_OUTER_MSG_IMPL(
+                ErrorCode::EE1014, "The value " + std::to_string(internalShdrs->sh_link) +
+                                       " of sh_link in the section ranked " + std::to_string(i) +
+                                       " is invalid. The valid value range is [0, " + std::to_string(num) + "]");
+            return ELF_FAIL;
+        }
+        internalShdrs++;
+    }
+    return ELF_SUCCESS;
+}
+
+template <bool NEED_SWAP>
+static bool DecodeElfSymbols(
+    const rtElfData* const elfData, const Elf64_External_Sym* const esyms, const uint64_t number,
+    Elf_Internal_Sym* psym)
+{
+    for (uint64_t j = 0U; j < number; j++) {
+        const uint64_t objOffset = RtPtrToValue(esyms + (j + 1)) - RtPtrToValue(elfData->obj_ptr_origin);
+        if (objOffset > elfData->obj_size) {
+            RT_LOG_OUTER_MSG_IMPL(
+                ErrorCode::EE1014, "The offset " + std::to_string(objOffset) + " of the sh_ent ranked " +
+                                       std::to_string(j) + " exceeds the size " + std::to_string(elfData->obj_size) +
+                                       " of the ELF object");
+            return false;
+        }
+
+        const Elf64_External_Sym& ext = esyms[j];
+        psym->st_name = ElfLoad<NEED_SWAP, uint32_t>(ext.st_name);
+        psym->st_info = ext.st_info[0U];
+        psym->st_other = ext.st_other[0U];
+        psym->st_shndx = ElfLoad<NEED_SWAP, uint16_t>(ext.st_shndx);
+        psym->st_value = ElfLoad<NEED_SWAP, uint64_t>(ext.st_value);
+        psym->st_size = ElfLoad<NEED_SWAP, uint64_t>(ext.st_size);
+        psym->st_target_internal = 0U;
+        psym++;
+    }
+    return true;
+}
+
 std::unique_ptr<char_t[]> GetStringTableCopy(const char_t* const src, const uint64_t size)
 {
     /* Check for overflow. */
@@ -206,7 +311,6 @@ int32_t Get64bitSectionHeaders(rtElfData* const elfData)
     }
     Elf64_External_Shdr* shdrs = nullptr;
     Elf_Internal_Shdr* internalShdrs = nullptr;
-    uint32_t i;
     const uint32_t size = elfData->elf_header.e_shentsize;
     const uint32_t num = elfData->elf_header.e_shnum;
 
@@ -244,37 +348,10 @@ int32_t Get64bitSectionHeaders(rtElfData* const elfData)
     }
 
     internalShdrs = elfData->section_headers;
-    for (i = 0U; (i < num) && (GetByte != nullptr); i++) {
-        const uint64_t objOffset = RtPtrToValue(shdrs + (i + 1)) - RtPtrToValue(elfData->obj_ptr_origin);
-        if (objOffset > elfData->obj_size) {
-            RT_LOG_OUTER_MSG_IMPL(
-                ErrorCode::EE1014, "The offset " + std::to_string(objOffset) + " of the section ranked " +
-                                       std::to_string(i) + " exceeds the size " + std::to_string(elfData->obj_size) +
-                                       " of the ELF object");
-            return ELF_FAIL;
-        }
-
-        internalShdrs->sh_name = static_cast<uint32_t>(GetByte(static_cast<const uint8_t*>(shdrs[i].sh_name), 4));
-        internalShdrs->sh_type = static_cast<uint32_t>(GetByte(static_cast<const uint8_t*>(shdrs[i].sh_type), 4));
-        internalShdrs->sh_flags = GetByte(static_cast<const uint8_t*>(shdrs[i].sh_flags), 8);
-        internalShdrs->sh_addr = GetByte(static_cast<const uint8_t*>(shdrs[i].sh_addr), 8);
-        internalShdrs->sh_size = GetByte(static_cast<const uint8_t*>(shdrs[i].sh_size), 8);
-        internalShdrs->sh_entsize = GetByte(static_cast<const uint8_t*>(shdrs[i].sh_entsize), 8);
-        internalShdrs->sh_link = static_cast<uint32_t>(GetByte(static_cast<const uint8_t*>(shdrs[i].sh_link), 8));
-        internalShdrs->sh_info = static_cast<uint32_t>(GetByte(static_cast<const uint8_t*>(shdrs[i].sh_info), 8));
-        internalShdrs->sh_offset = GetByte(static_cast<const uint8_t*>(shdrs[i].sh_offset), 8);
-        internalShdrs->sh_addralign = GetByte(static_cast<const uint8_t*>(shdrs[i].sh_addralign), 8);
-        if (internalShdrs->sh_link > num) {
-            RT_LOG_OUTER_MSG_IMPL(
-                ErrorCode::EE1014, "The value " + std::to_string(internalShdrs->sh_link) +
-                                       " of sh_link in the section ranked " + std::to_string(i) +
-                                       " is invalid. The valid value range is [0, " + std::to_string(num) + "]");
-            return ELF_FAIL;
-        }
-        internalShdrs++;
+    if (ElfNeedByteSwap(elfData)) {
+        return DecodeSectionHeaders<true>(elfData, shdrs, num, internalShdrs);
     }
-
-    return ELF_SUCCESS;
+    return DecodeSectionHeaders<false>(elfData, shdrs, num, internalShdrs);
 }
 
 std::unique_ptr<Elf_Internal_Sym[]> Get64bitElfSymbols(
@@ -287,7 +364,6 @@ std::unique_ptr<Elf_Internal_Sym[]> Get64bitElfSymbols(
     uint64_t number;
     Elf64_External_Sym* esyms = nullptr;
     Elf_Internal_Sym* psym = nullptr;
-    uint32_t j;
     *numSymsReturn = 0UL;
 
     if (section->sh_size == 0ULL) {
@@ -328,24 +404,10 @@ std::unique_ptr<Elf_Internal_Sym[]> Get64bitElfSymbols(
     }
 
     psym = isyms.get();
-    for (j = 0U; (j < number) && (GetByte != nullptr); j++) {
-        const uint64_t objOffset = RtPtrToValue(esyms + (j + 1)) - RtPtrToValue(elfData->obj_ptr_origin);
-        if (objOffset > elfData->obj_size) {
-            RT_LOG_OUTER_MSG_IMPL(
-                ErrorCode::EE1014, "The offset " + std::to_string(objOffset) + " of the sh_ent ranked " +
-                                       std::to_string(j) + " exceeds the size " + std::to_string(elfData->obj_size) +
-                                       " of the ELF object");
-            return nullptr;
-        }
-
-        psym->st_name = GetByte(static_cast<const uint8_t*>(esyms[j].st_name), 4);
-        psym->st_info = static_cast<uint8_t>(GetByte(static_cast<const uint8_t*>(esyms[j].st_info), 1));
-        psym->st_other = static_cast<uint8_t>(GetByte(static_cast<const uint8_t*>(esyms[j].st_other), 1));
-        psym->st_shndx = static_cast<uint32_t>(GetByte(static_cast<const uint8_t*>(esyms[j].st_shndx), 2));
-        psym->st_value = GetByte(static_cast<const uint8_t*>(esyms[j].st_value), 8);
-        psym->st_size = GetByte(static_cast<const uint8_t*>(esyms[j].st_size), 8);
-        psym->st_target_internal = 0U;
-        psym++;
+    const bool decoded = ElfNeedByteSwap(elfData) ? DecodeElfSymbols<true>(elfData, esyms, number, psym) :
+                                                    DecodeElfSymbols<false>(elfData, esyms, number, psym);
+    if (!decoded) {
+        return nullptr;
     }
 
     *numSymsReturn = number;
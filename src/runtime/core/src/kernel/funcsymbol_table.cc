@@ -32,6 +32,7 @@ rtError_t FuncSymbolTable::Register(void* binHandle, const void* symbol, const c
         return RT_ERROR_NONE;
     }
     funcSymbolMap_.emplace(symbol, kernel);
+    lookupIndex_.MarkStale();
     funcSymbolMapLock_.Unlock();
 
     RT_LOG(RT_LOG_DEBUG, "Register function symbol success, symbol=%p", symbol);
@@ -41,7 +42,19 @@ rtError_t FuncSymbolTable::Register(void* binHandle, const void* symbol, const c
 Kernel* FuncSymbolTable::Lookup(const void* symbol)
 {
     Kernel* retKernel = nullptr;
+    if (lookupIndex_.Find(symbol, nullptr, retKernel)) {
+        return retKernel;
+    }
+
     funcSymbolMapLock_.Lock();
+    if (lookupIndex_.IsStale()) {
+        std::vector<rtKernelArr_t> symbols;
+        symbols.reserve(funcSymbolMap_.size());
+        for (const auto& item : funcSymbolMap_) {
+            symbols.push_back({item.first, item.second});
+        }
+        (void)lookupIndex_.Publish(symbols.data(), static_cast<uint32_t>(symbols.size()));
+    }
     const auto iter = funcSymbolMap_.find(symbol);
     if (iter != funcSymbolMap_.end()) {
         retKernel = iter->second;
@@ -11,12 +11,13 @@
 #include "json_parse.hpp"
 #include "utils.h"
 #include <fstream>
+#include <iterator>
 #include <string>
 
 namespace cce {
 namespace runtime {
 
-rtError_t GetJsonObj(const std::string& path, std::string& jsonFileRealPath, nlohmann::json& kernelJsonObj)
+static std::string GetKernelJsonPath(const std::string& path)
 {
     // json file have the same name with binary file. binary file suffix is .o, json file suffix is .json
     std::string jsonFilePath;
@@ -24,9 +25,12 @@ rtError_t GetJsonObj(const std::string& path, std::string& jsonFileRealPath, nlo
     if (dotPos != std::string::npos) {
         jsonFilePath = path.substr(0, dotPos);
     }
-    jsonFilePath = jsonFilePath + ".json";
+    return RealPath(jsonFilePath + ".json");
+}
 
-    jsonFileRealPath = RealPath(jsonFilePath);
+rtError_t GetJsonObj(const std::string& path, std::string& jsonFileRealPath, nlohmann::json& kernelJsonObj)
+{
+    jsonFileRealPath = GetKernelJsonPath(path);
     if (jsonFileRealPath.empty()) {
         return RT_ERROR_INVALID_VALUE;
     }
@@ -42,6 +46,21 @@ rtError_t GetJsonObj(const std::string& path, std::string& jsonFileRealPath, nlo
     return RT_ERROR_NONE;
 }
 
+rtError_t GetJsonText(const std::string& path, std::string& jsonFileRealPath, std::string& jsonText)
+{
+    jsonFileRealPath = GetKernelJsonPath(path);
+    if (jsonFileRealPath.empty()) {
+        return RT_ERROR_INVALID_VALUE;
+    }
+
+    std::ifstream f(jsonFileRealPath, std::ios::binary);
+    if (!f.is_open()) {
+        return RT_ERROR_INVALID_VALUE;
+    }
+    (void)jsonText.assign(std::istreambuf_iterator<char_t>(f), std::istreambuf_iterator<char_t>());
+    return RT_ERROR_NONE;
+}
+
 void GetCpuKernelFromJson(const nlohmann::json& jsonObj, std::vector<CpuKernelInfo>& kernelInfos)
 {
     CpuKernelInfo kernelInfo{};
@@ -8,8 +8,10 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 #include "kernel.hpp"
+#include <algorithm>
 #include <list>
 #include <string_view>
+#include <thread>
 #include "error_message_manage.hpp"
 #include "runtime.hpp"
 #include "program.hpp"
@@ -128,6 +130,126 @@ void Kernel::SetMixMinStackSize()
     minStackSize1_ = minStackSize1_ > minStackSize2_ ? minStackSize1_ : minStackSize2_;
 }
 
+namespace {
+// Globally unique, so a per-thread cache entry can never match a snapshot of another table.
+std::atomic<uint64_t> g_kernelLookupGeneration{0ULL};
+std::atomic<uint32_t> g_kernelLookupReaderSlot{0U};
+
+struct KernelLookupCache {
+    uint64_t generation;
+    const void* stub;
+    Kernel* kernel;
+};
+
+__THREAD_LOCAL__ KernelLookupCache g_kernelLookupCache = {0ULL, nullptr, nullptr};
+__THREAD_LOCAL__ uint32_t g_kernelLookupReaderShard = UINT32_MAX;
+
+uint32_t GetKernelLookupReaderShard()
+{
+    if (unlikely(g_kernelLookupReaderShard == UINT32_MAX)) {
+        g_kernelLookupReaderShard =
+            g_kernelLookupReaderSlot.fetch_add(1U, std::memory_order_relaxed) % KERNEL_LOOKUP_READER_SHARDS;
+    }
+    return g_kernelLookupReaderShard;
+}
+
+void FreeKernelLookupSnapshot(KernelLookupSnapshot* snapshot)
+{
+    if (snapshot != nullptr) {
+        delete[] snapshot->entries;
+        delete snapshot;
+    }
+}
+
+bool AcquireKernelProgram(const Kernel* const kernel)
+{
+    // Program was releasing and kernel will be deleted later.
+    return Runtime::Instance()->GetProgram(kernel->Program_());
+}
+} // namespace
+
+KernelLookupIndex::~KernelLookupIndex()
+{
+    FreeKernelLookupSnapshot(snapshot_.load(std::memory_order_relaxed));
+}
+
+rtError_t KernelLookupIndex::Publish(const rtKernelArr_t* const arr, const uint32_t num)
+{
+    rtError_t error = RT_ERROR_NONE;
+    KernelLookupSnapshot* newSnapshot = nullptr;
+    if (num > 0U) {
+        newSnapshot = new (std::nothrow) KernelLookupSnapshot();
+        rtKernelArr_t* const entries = new (std::nothrow) rtKernelArr_t[num];
+        if ((newSnapshot == nullptr) || (entries == nullptr)) {
+            RT_LOG_OUTER_MSG_IMPL(ErrorCode::EE1013, sizeof(rtKernelArr_t) * num, "new");
+            delete newSnapshot;
+            delete[] entries;
+            newSnapshot = nullptr;
+            error = RT_ERROR_MEMORY_ALLOCATION;
+        } else {
+            (void)std::copy(arr, arr + num, entries);
+            newSnapshot->generation = g_kernelLookupGeneration.fetch_add(1U, std::memory_order_relaxed) + 1U;
+            newSnapshot->num = num;
+            newSnapshot->entries = entries;
+        }
+    }
+
+    KernelLookupSnapshot* const oldSnapshot = snapshot_.exchange(newSnapshot, std::memory_order_seq_cst);
+    stale_.store(error != RT_ERROR_NONE, std::memory_order_release);
+    Synchronize();
+    FreeKernelLookupSnapshot(oldSnapshot);
+    return error;
+}
+
+void KernelLookupIndex::Synchronize()
+{
+    // Flip twice so that every reader counted in either phase has left, new readers go to the other phase
+    // and cannot keep the wait going forever.
+    for (uint32_t round = 0U; round < 2U; round++) {
+        const uint32_t oldPhase = phase_.fetch_xor(1U, std::memory_order_seq_cst) & 1U;
+        for (uint32_t i = 0U; i < KERNEL_LOOKUP_READER_SHARDS; i++) {
+            while (readers_[oldPhase][i].count.load(std::memory_order_seq_cst) != 0ULL) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+bool KernelLookupIndex::Find(const void* const stub, bool (*const acquire)(const Kernel* const), Kernel*& kernel)
+{
+    kernel = nullptr;
+    const uint32_t phase = phase_.load(std::memory_order_seq_cst) & 1U;
+    std::atomic<uint64_t>& counter = readers_[phase][GetKernelLookupReaderShard()].count;
+    (void)counter.fetch_add(1ULL, std::memory_order_seq_cst);
+    if (stale_.load(std::memory_order_acquire)) {
+        (void)counter.fetch_sub(1ULL, std::memory_order_release);
+        return false;
+    }
+
+    const KernelLookupSnapshot* const snapshot = snapshot_.load(std::memory_order_seq_cst);
+    if (snapshot != nullptr) {
+        KernelLookupCache& cache = g_kernelLookupCache;
+        if ((cache.generation == snapshot->generation) && (cache.stub == stub)) {
+            kernel = cache.kernel;
+        } else {
+            const rtKernelArr_t* const begin = snapshot->entries;
+            const rtKernelArr_t* const end = begin + snapshot->num;
+            const rtKernelArr_t* const iter = std::lower_bound(
+                begin, end, stub,
+                [](const rtKernelArr_t& entry, const void* const key) { return entry.stub < key; });
+            if ((iter != end) && (iter->stub == stub)) {
+                kernel = iter->kernel;
+                cache = {snapshot->generation, stub, kernel};
+            }
+        }
+    }
+    if ((kernel != nullptr) && (acquire != nullptr) && (!acquire(kernel))) {
+        kernel = nullptr;
+    }
+    (void)counter.fetch_sub(1ULL, std::memory_order_release);
+    return true;
+}
+
 KernelTable::KernelTable() : kernelArr_(nullptr), rtKernelArrPos_(0UL), kernelArrAllocTimes_(1UL) {}
 
 KernelTable::~KernelTable() { ReleaseKernelsOnDestroy(); }
@@ -253,6 +375,7 @@ rtError_t KernelTable::Add(Kernel*& addKernel)
         (void)programStubMultiMap_.insert({prog, stub});
         rtKernelArrPos_ += 1;
         InitEmbeddedInnerHandle<Kernel>(addKernel);
+        lookupIndex_.MarkStale();
     } else {
         const std::string temp = kernelArr_[halfSearchResult.matchIndex].kernel->Name_();
         RT_LOG(RT_LOG_WARNING, "Add kernel failed, using registered stubfun=%p --> kernel_name=%s", stub, temp.c_str());
@@ -267,6 +390,7 @@ rtError_t KernelTable::Add(Kernel*& addKernel)
 
 rtError_t KernelTable::RemoveAll(const Program* const prog)
 {
+    std::vector<Kernel*> delKernels;
     kernelMapLock_.Lock();
     const auto iterRange = programStubMultiMap_.equal_range(prog);
     for (auto iter = iterRange.first; iter != iterRange.second; ++iter) {
@@ -291,14 +415,21 @@ rtError_t KernelTable::RemoveAll(const Program* const prog)
                     copySize, ret);
             }
 
-            ResetEmbeddedInnerHandle<Kernel>(delKernel);
-            delete delKernel;
+            delKernels.push_back(delKernel);
             rtKernelArrPos_ -= 1;
         }
     }
     (void)programStubMultiMap_.erase(iterRange.first, iterRange.second);
+    if (!delKernels.empty()) {
+        // lock-free readers may still hold the removed kernels until the new snapshot is published
+        (void)lookupIndex_.Publish(kernelArr_, rtKernelArrPos_);
+    }
     kernelMapLock_.Unlock();
 
+    for (Kernel* const delKernel : delKernels) {
+        ResetEmbeddedInnerHandle<Kernel>(delKernel);
+        delete delKernel;
+    }
     return RT_ERROR_NONE;
 }
 
@@ -306,8 +437,17 @@ rtError_t KernelTable::RemoveAll(const Program* const prog)
 Kernel* KernelTable::Lookup(const void* const stub)
 {
     Kernel* retKernel = nullptr;
+    if (lookupIndex_.Find(stub, &AcquireKernelProgram, retKernel)) {
+        RT_LOG(RT_LOG_DEBUG, "KernelTable Lookup end, stub=%p.", stub);
+        return retKernel;
+    }
+
     rtHalfSearchResult_t halfSearchResult;
     kernelMapLock_.Lock();
+    if (lookupIndex_.IsStale()) {
+        // kernels were added since last publish, later lookups go lock-free again
+        (void)lookupIndex_.Publish(kernelArr_, rtKernelArrPos_);
+    }
     HalfSearch(rtKernelArrPos_, stub, &halfSearchResult);
     retKernel = halfSearchResult.matchFlag ? kernelArr_[halfSearchResult.matchIndex].kernel : nullptr;
     if (retKernel != nullptr) {
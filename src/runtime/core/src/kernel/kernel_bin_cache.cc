@@ -0,0 +1,766 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+#include "kernel_bin_cache.hpp"
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <vector>
+#include "securec.h"
+#include "mmpa/mmpa_api.h"
+#include "runtime.hpp"
+#include "osal.hpp"
+#include "utils.h"
+
+namespace cce {
+namespace runtime {
+namespace {
+constexpr uint32_t KERNEL_BIN_CACHE_MAGIC = 0x434B5452U; // "RTKC"
+constexpr uint32_t KERNEL_BIN_CACHE_VERSION = 2U;
+constexpr uint32_t KERNEL_BIN_CACHE_KIND_ELF = 1U;
+constexpr uint32_t KERNEL_BIN_CACHE_KIND_JSON = 2U;
+constexpr uint64_t KERNEL_BIN_CACHE_NO_OFFSET = UINT64_MAX;
+constexpr size_t KERNEL_BIN_CACHE_PATH_LEN = 4096U;
+
+struct KernelBinCacheHead {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t runtimeId;
+    uint64_t hash;
+    uint64_t size;
+    uint32_t kind;
+    uint32_t chipType;
+    uint64_t payloadSize;
+    uint64_t payloadHash;
+};
+
+// Pointers into the binary are kept as offsets from obj_ptr_origin.
+struct CachedElfData {
+    Elf_Internal_Ehdr elfHeader;
+    uint64_t textOffset;
+    uint64_t textSize;
+    uint64_t stackSize;
+    uint64_t soNameOffset;
+    uint64_t fftsAddrOffset;
+    uint64_t l2CacheHintCfgOffset;
+    uint64_t printFifoSpaceOffset;
+    uint64_t simtPrintFifoSpaceOffset;
+    uint32_t kernelNum;
+    uint32_t funcNum;
+    uint32_t ascendMetaFlag;
+    uint32_t dataFlag;
+    uint32_t sectionNum;
+    uint32_t globalSymbolNum;
+    uint32_t objectSymbolNum;
+    uint32_t reserved;
+};
+
+struct CachedKernel {
+    int32_t offset;
+    int32_t length;
+    uint32_t funcType;
+    uint32_t crossCoreSync;
+    uint32_t taskRation;
+    uint16_t dfxSize;
+    uint16_t userArgsNum;
+    uint64_t dfxOffset;
+    uint32_t kernelVfType;
+    uint32_t shareMemSize;
+    int32_t elfDataFlag;
+    uint32_t minStackSize;
+    uint64_t functionEntry;
+    uint32_t funcEntryType;
+    uint32_t schedMode;
+    uint64_t paramTotalSize;
+    uint32_t paramCount;
+    uint32_t paramInfoNum;
+    uint32_t nameLen;
+    uint8_t hasParamSummary;
+    uint8_t earlyStartEnable;
+    uint16_t reserved;
+};
+
+// globalSymbolMap entry, or STT_OBJECT symbol whose fill callback has to be replayed on load
+struct CachedSymbol {
+    uint64_t value;
+    uint64_t size;
+    uint32_t nameLen;
+    uint32_t reserved;
+};
+
+struct ObjectSymbol {
+    std::string name;
+    uint64_t offset;
+    uint32_t size;
+};
+
+constexpr uint64_t HASH_PRIME1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t HASH_PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t HASH_PRIME3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t HASH_PRIME4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t HASH_PRIME5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t HashRotl(const uint64_t val, const uint32_t bits)
+{
+    return (val << bits) | (val >> (64U - bits));
+}
+
+inline uint64_t HashRead64(const uint8_t* const ptr)
+{
+    uint64_t val;
+    std::memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+inline uint64_t HashRound(const uint64_t acc, const uint64_t input)
+{
+    return HashRotl(acc + (input * HASH_PRIME2), 31U) * HASH_PRIME1;
+}
+
+inline uint64_t HashMerge(const uint64_t acc, const uint64_t val)
+{
+    return ((acc ^ HashRound(0ULL, val)) * HASH_PRIME1) + HASH_PRIME4;
+}
+
+// xxh64 style: four 8-byte lanes per 32-byte stripe, the binaries are hashed on every load so a byte-wise
+// hash would cost as much as the parse it saves. The key only picks the entry, hits are verified by memcmp.
+uint64_t HashContent(const void* const data, const uint64_t len)
+{
+    const uint8_t* ptr = static_cast<const uint8_t*>(data);
+    const uint8_t* const end = ptr + len;
+    uint64_t hash;
+    if (len >= 32ULL) {
+        uint64_t v1 = HASH_PRIME1 + HASH_PRIME2;
+        uint64_t v2 = HASH_PRIME2;
+        uint64_t v3 = 0ULL;
+        uint64_t v4 = 0ULL - HASH_PRIME1;
+        for (; (end - ptr) >= 32; ptr += 32) {
+            v1 = HashRound(v1, HashRead64(ptr));
+            v2 = HashRound(v2, HashRead64(ptr + 8));
+            v3 = HashRound(v3, HashRead64(ptr + 16));
+            v4 = HashRound(v4, HashRead64(ptr + 24));
+        }
+        hash = HashRotl(v1, 1U) + HashRotl(v2, 7U) + HashRotl(v3, 12U) + HashRotl(v4, 18U);
+        hash = HashMerge(HashMerge(HashMerge(HashMerge(hash, v1), v2), v3), v4);
+    } else {
+        hash = HASH_PRIME5;
+    }
+    hash += len;
+    for (; (end - ptr) >= 8; ptr += 8) {
+        hash = (HashRotl(hash ^ HashRound(0ULL, HashRead64(ptr)), 27U) * HASH_PRIME1) + HASH_PRIME4;
+    }
+    for (; ptr < end; ptr++) {
+        hash = HashRotl(hash ^ (static_cast<uint64_t>(*ptr) * HASH_PRIME5), 11U) * HASH_PRIME1;
+    }
+    hash ^= hash >> 33U;
+    hash *= HASH_PRIME2;
+    hash ^= hash >> 29U;
+    hash *= HASH_PRIME3;
+    hash ^= hash >> 32U;
+    return hash;
+}
+
+template <typename T>
+void AppendPod(std::string& buf, const T& val)
+{
+    (void)buf.append(RtPtrToPtr<const char_t*>(&val), sizeof(T));
+}
+
+class CacheReader {
+public:
+    CacheReader(const uint8_t* const data, const uint64_t size) : data_(data), size_(size) {}
+    ~CacheReader() = default;
+
+    template <typename T>
+    bool Read(T& val)
+    {
+        return ReadBytes(&val, sizeof(T));
+    }
+
+    bool ReadBytes(void* const dst, const uint64_t len)
+    {
+        if ((size_ - pos_) < len) {
+            return false;
+        }
+        if (len != 0ULL) {
+            (void)memcpy_s(dst, len, data_ + pos_, len);
+        }
+        pos_ += len;
+        return true;
+    }
+
+    bool ReadString(std::string& str, const uint32_t len)
+    {
+        if ((size_ - pos_) < len) {
+            return false;
+        }
+        (void)str.assign(RtPtrToPtr<const char_t*>(data_ + pos_), len);
+        pos_ += len;
+        return true;
+    }
+
+    bool IsEnd() const
+    {
+        return pos_ == size_;
+    }
+
+private:
+    const uint8_t* data_;
+    uint64_t size_;
+    uint64_t pos_{0ULL};
+};
+
+class CacheFileMapping {
+public:
+    CacheFileMapping() = default;
+    ~CacheFileMapping()
+    {
+        if (addr_ != nullptr) {
+            (void)munmap(addr_, len_);
+        }
+    }
+    CacheFileMapping(const CacheFileMapping&) = delete;
+    CacheFileMapping& operator=(const CacheFileMapping&) = delete;
+
+    bool Map(const std::string& path)
+    {
+        const int32_t fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st = {};
+        if ((fstat(fd, &st) != 0) || (st.st_size < static_cast<off_t>(sizeof(KernelBinCacheHead)))) {
+            (void)close(fd);
+            return false;
+        }
+        void* const addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        (void)close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        addr_ = addr;
+        len_ = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    const uint8_t* Data() const
+    {
+        return static_cast<const uint8_t*>(addr_);
+    }
+
+    uint64_t Size() const
+    {
+        return static_cast<uint64_t>(len_);
+    }
+
+private:
+    void* addr_{nullptr};
+    size_t len_{0U};
+};
+
+uint64_t EncodeOffset(const void* const ptr, const rtElfData* const elfData)
+{
+    if (ptr == nullptr) {
+        return KERNEL_BIN_CACHE_NO_OFFSET;
+    }
+    const uintptr_t base = RtPtrToValue(elfData->obj_ptr_origin);
+    const uintptr_t addr = RtPtrToValue(ptr);
+    if ((addr < base) || ((addr - base) >= elfData->obj_size)) {
+        return elfData->obj_size; // invalid, rejected by IsValidOffset
+    }
+    return static_cast<uint64_t>(addr - base);
+}
+
+bool IsValidOffset(const uint64_t offset, const uint64_t size)
+{
+    return (offset == KERNEL_BIN_CACHE_NO_OFFSET) || (offset < size);
+}
+
+template <typename T>
+T* DecodeOffset(char_t* const binary, const uint64_t offset)
+{
+    return (offset == KERNEL_BIN_CACHE_NO_OFFSET) ? nullptr : RtPtrToPtr<T*>(binary + offset);
+}
+
+// Mirror of GetSymbolName: collect the STT_OBJECT symbols of the first symbol table whose fill callbacks run
+// while parsing, so that a warm start can replay them on the new binary buffer.
+bool CollectObjectSymbols(const rtElfData* const elfData, std::vector<ObjectSymbol>& symbols)
+{
+    const uint32_t shNum = elfData->elf_header.e_shnum;
+    const Elf_Internal_Shdr* section = elfData->section_headers;
+    for (uint32_t index = 0U; index < shNum; index++, section++) {
+        if ((section->sh_type != static_cast<uint32_t>(SHT_SYMTAB)) || (section->sh_entsize == 0ULL)) {
+            continue;
+        }
+        uint64_t numSyms = 0ULL;
+        const std::unique_ptr<Elf_Internal_Sym[]> symTab = Get64bitElfSymbols(elfData, section, &numSyms);
+        if (symTab == nullptr) {
+            continue;
+        }
+        if (section->sh_link >= shNum) {
+            return false;
+        }
+        const Elf_Internal_Shdr* const stringSec = elfData->section_headers + section->sh_link;
+        if (stringSec->sh_size == 0ULL) {
+            return true;
+        }
+        if ((stringSec->sh_offset > elfData->obj_size) ||
+            (stringSec->sh_size > (elfData->obj_size - stringSec->sh_offset))) {
+            return false;
+        }
+        const char_t* const stringTab = elfData->obj_ptr_origin + stringSec->sh_offset;
+        for (uint64_t si = 0ULL; si < numSyms; si++) {
+            const Elf_Internal_Sym& sym = symTab[si];
+            if (ELF_ST_TYPE(sym.st_info) != STT_OBJECT) {
+                continue;
+            }
+            if (sym.st_shndx >= shNum) {
+                return true;
+            }
+            if (sym.st_name >= stringSec->sh_size) {
+                return false;
+            }
+            const Elf_Internal_Shdr* const shdr = elfData->section_headers + sym.st_shndx;
+            const uint64_t offset = sym.st_value + shdr->sh_offset - shdr->sh_addr;
+            if (offset > elfData->obj_size) {
+                return false;
+            }
+            const size_t len = strnlen(stringTab + sym.st_name, static_cast<size_t>(stringSec->sh_size - sym.st_name));
+            symbols.push_back({std::string(stringTab + sym.st_name, len), offset, static_cast<uint32_t>(sym.st_size)});
+        }
+        return true;
+    }
+    return true;
+}
+
+bool EncodeKernel(const RtKernel& kernel, const rtElfData* const elfData, std::string& payload)
+{
+    const RtKernelMetaInfo& meta = kernel.metaInfo;
+    CachedKernel cached = {};
+    cached.offset = kernel.offset;
+    cached.length = kernel.length;
+    cached.funcType = meta.funcType;
+    cached.crossCoreSync = meta.crossCoreSync;
+    cached.taskRation = meta.taskRation;
+    cached.dfxSize = meta.dfxSize;
+    cached.userArgsNum = meta.userArgsNum;
+    cached.dfxOffset = EncodeOffset(meta.dfxAddr, elfData);
+    cached.kernelVfType = meta.kernelVfType;
+    cached.shareMemSize = meta.shareMemSize;
+    cached.elfDataFlag = meta.elfDataFlag;
+    cached.minStackSize = meta.minStackSize;
+    cached.functionEntry = meta.functionEntry;
+    cached.funcEntryType = static_cast<uint32_t>(meta.funcEntryType);
+    cached.schedMode = meta.schedMode;
+    cached.paramTotalSize = meta.paramTotalSize;
+    cached.paramCount = meta.paramCount;
+    cached.paramInfoNum = (meta.paramInfos != nullptr) ? meta.paramCount : 0U;
+    cached.nameLen = (kernel.name != nullptr) ? static_cast<uint32_t>(strnlen(kernel.name, NAME_MAX_LENGTH)) : 0U;
+    cached.hasParamSummary = meta.hasParamSummary ? 1U : 0U;
+    cached.earlyStartEnable = meta.earlyStartEnable ? 1U : 0U;
+    if ((kernel.name == nullptr) || !IsValidOffset(cached.dfxOffset, elfData->obj_size)) {
+        return false;
+    }
+
+    AppendPod(payload, cached);
+    (void)payload.append(kernel.name, cached.nameLen);
+    for (uint32_t i = 0U; i < cached.paramInfoNum; i++) {
+        AppendPod(payload, meta.paramInfos[i]);
+    }
+    return true;
+}
+
+bool DecodeKernel(CacheReader& reader, char_t* const binary, const uint64_t size, RtKernel& kernel)
+{
+    CachedKernel cached = {};
+    if (!reader.Read(cached) || (cached.nameLen >= NAME_MAX_LENGTH) || !IsValidOffset(cached.dfxOffset, size) ||
+        ((cached.paramInfoNum != 0U) && (cached.paramInfoNum != cached.paramCount))) {
+        return false;
+    }
+    kernel.name = new (std::nothrow) char_t[cached.nameLen + 1U];
+    if (kernel.name == nullptr) {
+        RT_LOG_OUTER_MSG_IMPL(ErrorCode::EE1013, cached.nameLen + 1U, "new");
+        return false;
+    }
+    kernel.name[cached.nameLen] = '\0';
+    if (!reader.ReadBytes(kernel.name, cached.nameLen)) {
+        return false;
+    }
+    kernel.offset = cached.offset;
+    kernel.length = cached.length;
+
+    RtKernelMetaInfo& meta = kernel.metaInfo;
+    meta.funcType = cached.funcType;
+    meta.crossCoreSync = cached.crossCoreSync;
+    meta.taskRation = cached.taskRation;
+    meta.dfxAddr = DecodeOffset<const void>(binary, cached.dfxOffset);
+    meta.dfxSize = cached.dfxSize;
+    meta.userArgsNum = cached.userArgsNum;
+    meta.kernelVfType = cached.kernelVfType;
+    meta.shareMemSize = cached.shareMemSize;
+    meta.elfDataFlag = cached.elfDataFlag;
+    meta.minStackSize = cached.minStackSize;
+    meta.functionEntry = cached.functionEntry;
+    meta.funcEntryType = static_cast<KernelFunctionEntryType>(cached.funcEntryType);
+    meta.schedMode = cached.schedMode;
+    meta.paramCount = cached.paramCount;
+    meta.paramTotalSize = cached.paramTotalSize;
+    meta.hasParamSummary = (cached.hasParamSummary != 0U);
+    meta.earlyStartEnable = (cached.earlyStartEnable != 0U);
+    meta.paramInfos = nullptr;
+    if (cached.paramInfoNum != 0U) {
+        meta.paramInfos = std::shared_ptr<ElfParamInfo[]>(new (std::nothrow) ElfParamInfo[cached.paramInfoNum]);
+        if (meta.paramInfos == nullptr) {
+            RT_LOG_OUTER_MSG_IMPL(ErrorCode::EE1013, sizeof(ElfParamInfo) * cached.paramInfoNum, "new");
+            return false;
+        }
+        for (uint32_t i = 0U; i < cached.paramInfoNum; i++) {
+            if (!reader.Read(meta.paramInfos[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Map the entry and check it belongs to this runtime build and content, payload range is returned by reader.
+// The entry keeps a copy of the source content after the head, so a hash collision is a miss, not a wrong kernel.
+bool MapEntry(
+    const std::string& path, const KernelBinCacheHead& expect, const void* const source,
+    CacheFileMapping& mapping, std::unique_ptr<CacheReader>& reader)
+{
+    if (!mapping.Map(path)) {
+        return false;
+    }
+    KernelBinCacheHead head = {};
+    (void)memcpy_s(&head, sizeof(head), mapping.Data(), sizeof(head));
+    const uint64_t bodySize = mapping.Size() - sizeof(head);
+    if ((head.magic != KERNEL_BIN_CACHE_MAGIC) || (head.version != KERNEL_BIN_CACHE_VERSION) ||
+        (head.runtimeId != expect.runtimeId) || (head.kind != expect.kind) || (head.hash != expect.hash) ||
+        (head.size != expect.size) || (head.chipType != expect.chipType) || (head.size > bodySize) ||
+        (head.payloadSize != (bodySize - head.size))) {
+        RT_LOG(RT_LOG_INFO, "Kernel binary cache entry is stale, path=%s.", path.c_str());
+        return false;
+    }
+    const uint8_t* const payload = mapping.Data() + sizeof(head) + head.size;
+    if ((memcmp(mapping.Data() + sizeof(head), source, static_cast<size_t>(head.size)) != 0) ||
+        (head.payloadHash != HashContent(payload, head.payloadSize))) {
+        RT_LOG(RT_LOG_INFO, "Kernel binary cache entry does not match the content, path=%s.", path.c_str());
+        return false;
+    }
+    reader.reset(new (std::nothrow) CacheReader(payload, head.payloadSize));
+    return reader != nullptr;
+}
+
+void WriteEntry(
+    const std::string& path, const KernelBinCacheHead& head, const void* const source, const std::string& payload)
+{
+    // write to a private file first, rename is atomic so readers never see a partial entry
+    const std::string tmpPath =
+        path + "." + std::to_string(PidTidFetcher::GetCurrentPid()) + "." +
+        std::to_string(PidTidFetcher::GetCurrentTid()) + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        RT_LOG(RT_LOG_WARNING, "Open kernel binary cache file failed, path=%s.", tmpPath.c_str());
+        return;
+    }
+    (void)out.write(RtPtrToPtr<const char_t*>(&head), static_cast<std::streamsize>(sizeof(head)));
+    (void)out.write(static_cast<const char_t*>(source), static_cast<std::streamsize>(head.size));
+    (void)out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    out.close();
+    if (out.fail() || (rename(tmpPath.c_str(), path.c_str()) != 0)) {
+        RT_LOG(RT_LOG_WARNING, "Write kernel binary cache file failed, path=%s.", path.c_str());
+        (void)remove(tmpPath.c_str());
+        return;
+    }
+    RT_LOG(RT_LOG_INFO, "Write kernel binary cache file, path=%s, size=%zu.", path.c_str(), payload.size());
+}
+
+KernelBinCacheHead MakeHead(const uint64_t runtimeId, const uint32_t kind, const uint64_t hash, const uint64_t size)
+{
+    KernelBinCacheHead head = {};
+    head.magic = KERNEL_BIN_CACHE_MAGIC;
+    head.version = KERNEL_BIN_CACHE_VERSION;
+    head.runtimeId = runtimeId;
+    head.kind = kind;
+    head.hash = hash;
+    head.size = size;
+    head.chipType = static_cast<uint32_t>(Runtime::Instance()->GetChipType());
+    return head;
+}
+
+// Identify the runtime library build by its file size and modify time, an upgraded runtime gets a new id.
+uint64_t GetRuntimeId()
+{
+    struct {
+        uint64_t version;
+        uint64_t size;
+        uint64_t mtime;
+    } id = {KERNEL_BIN_CACHE_VERSION, 0ULL, 0ULL};
+    Dl_info info;
+    struct stat st = {};
+    if ((dladdr(RtPtrToPtr<void*>(&GetRuntimeId), &info) != 0) && (info.dli_fname != nullptr) &&
+        (stat(info.dli_fname, &st) == 0)) {
+        id.size = static_cast<uint64_t>(st.st_size);
+        id.mtime = static_cast<uint64_t>(st.st_mtime);
+    }
+    return GetQuickHash(&id, sizeof(id));
+}
+
+std::string GetCachePathFromEnv()
+{
+    char_t cachePath[KERNEL_BIN_CACHE_PATH_LEN] = {};
+    if (mmGetEnv("ASCEND_KERNEL_BIN_CACHE_PATH", static_cast<char_t*>(cachePath), sizeof(cachePath)) != EN_OK) {
+        return std::string();
+    }
+    return std::string(cachePath);
+}
+} // namespace
+
+KernelBinCache& KernelBinCache::Instance()
+{
+    static KernelBinCache instance;
+    return instance;
+}
+
+KernelBinCache::KernelBinCache() : KernelBinCache(GetCachePathFromEnv())
+{
+}
+
+KernelBinCache::KernelBinCache(const std::string& cachePath)
+{
+    if (cachePath.empty()) {
+        return;
+    }
+    cacheDir_ = RealPath(cachePath);
+    if (cacheDir_.empty()) {
+        RT_LOG(RT_LOG_WARNING, "Kernel binary cache path is invalid, path=%s.", cachePath.c_str());
+        return;
+    }
+    runtimeId_ = GetRuntimeId();
+    RT_LOG(
+        RT_LOG_EVENT, "Kernel binary cache enabled, path=%s, runtimeId=%#" PRIx64 ".", cacheDir_.c_str(), runtimeId_);
+}
+
+std::string KernelBinCache::GetEntryPath(const uint64_t hash, const uint64_t size, const char_t* const suffix) const
+{
+    char_t name[64] = {};
+    (void)snprintf_s(name, sizeof(name), sizeof(name) - 1U, "/%016" PRIx64 "_%" PRIu64, hash, size);
+    return cacheDir_ + name + suffix;
+}
+
+uint64_t KernelBinCache::HashBinary(const void* const binary, const uint64_t size) const
+{
+    if (!IsEnabled() || (binary == nullptr)) {
+        return 0ULL;
+    }
+    return HashContent(binary, size);
+}
+
+RtKernel* KernelBinCache::LoadElf(
+    char_t* const binary, const uint64_t size, const uint64_t binHash, rtElfData* const elfData) const
+{
+    if (!IsEnabled() || (binary == nullptr) || (size < sizeof(Elf64_External_Ehdr))) {
+        return nullptr;
+    }
+    const std::string path = GetEntryPath(binHash, size, ".kbin");
+    CacheFileMapping mapping;
+    std::unique_ptr<CacheReader> reader = nullptr;
+    if (!MapEntry(path, MakeHead(runtimeId_, KERNEL_BIN_CACHE_KIND_ELF, binHash, size), binary, mapping, reader)) {
+        return nullptr;
+    }
+
+    CachedElfData cached = {};
+    if (!reader->Read(cached) || (cached.funcNum == 0U) || (cached.kernelNum > cached.funcNum) ||
+        (cached.sectionNum == 0U) || (cached.sectionNum != cached.elfHeader.e_shnum) ||
+        !IsValidOffset(cached.soNameOffset, size) || !IsValidOffset(cached.fftsAddrOffset, size) ||
+        !IsValidOffset(cached.l2CacheHintCfgOffset, size) || !IsValidOffset(cached.printFifoSpaceOffset, size) ||
+        !IsValidOffset(cached.simtPrintFifoSpaceOffset, size)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Elf_Internal_Shdr[]> sections(new (std::nothrow) Elf_Internal_Shdr[cached.sectionNum]);
+    if ((sections == nullptr) || !reader->ReadBytes(sections.get(), sizeof(Elf_Internal_Shdr) * cached.sectionNum)) {
+        return nullptr;
+    }
+
+    std::map<std::string, std::pair<uint64_t, uint64_t>> globalSymbolMap;
+    CachedSymbol sym = {};
+    std::string name;
+    for (uint32_t i = 0U; i < cached.globalSymbolNum; i++) {
+        if (!reader->Read(sym) || !reader->ReadString(name, sym.nameLen)) {
+            return nullptr;
+        }
+        globalSymbolMap[name] = {sym.value, sym.size};
+    }
+    std::vector<ObjectSymbol> objectSymbols;
+    for (uint32_t i = 0U; i < cached.objectSymbolNum; i++) {
+        if (!reader->Read(sym) || !reader->ReadString(name, sym.nameLen) || (sym.value > size)) {
+            return nullptr;
+        }
+        objectSymbols.push_back({name, sym.value, static_cast<uint32_t>(sym.size)});
+    }
+
+    RtKernel* kernels = new (std::nothrow) RtKernel[cached.funcNum]();
+    if (kernels == nullptr) {
+        RT_LOG_OUTER_MSG_IMPL(ErrorCode::EE1013, sizeof(RtKernel) * cached.funcNum, "new");
+        return nullptr;
+    }
+    std::function<void()> const errReleaseKernels = [&kernels, &cached]() {
+        for (uint32_t i = 0U; i < cached.kernelNum; i++) {
+            DELETE_A(kernels[i].name);
+        }
+        delete[] kernels;
+        kernels = nullptr;
+    };
+    ScopeGuard kernelsGuard(errReleaseKernels);
+    for (uint32_t i = 0U; i < cached.kernelNum; i++) {
+        if (!DecodeKernel(*reader, binary, size, kernels[i])) {
+            return nullptr;
+        }
+    }
+    if (!reader->IsEnd()) {
+        return nullptr;
+    }
+    kernelsGuard.ReleaseGuard();
+
+    elfData->obj_ptr_origin = binary;
+    elfData->obj_ptr = binary + sizeof(Elf64_External_Ehdr);
+    elfData->elf_header = cached.elfHeader;
+    elfData->section_headers = sections.release();
+    elfData->text_offset = cached.textOffset;
+    elfData->text_size = cached.textSize;
+    elfData->kernel_num = cached.kernelNum;
+    elfData->func_num = cached.funcNum;
+    elfData->so_name = DecodeOffset<const char_t>(binary, cached.soNameOffset);
+    elfData->stackSize = cached.stackSize;
+    elfData->dataFlag = (cached.dataFlag != 0U);
+    elfData->ascendMetaFlag = cached.ascendMetaFlag;
+    elfData->symbolAddr.g_sysFftsAddr = DecodeOffset<uint64_t>(binary, cached.fftsAddrOffset);
+    elfData->symbolAddr.g_opL2CacheHintCfg = DecodeOffset<uint64_t>(binary, cached.l2CacheHintCfgOffset);
+    elfData->symbolAddr.g_sysPrintFifoSpace = DecodeOffset<uint64_t>(binary, cached.printFifoSpaceOffset);
+    elfData->symbolAddr.g_sysSimtPrintFifoSpace = DecodeOffset<uint64_t>(binary, cached.simtPrintFifoSpaceOffset);
+    elfData->globalSymbolMap.swap(globalSymbolMap);
+
+    Runtime* const rtInstance = Runtime::Instance();
+    for (const auto& objSym : objectSymbols) {
+        (void)rtInstance->ExeCallbackFillFunc(objSym.name, binary + objSym.offset, objSym.size);
+    }
+    RT_LOG(RT_LOG_INFO, "Load kernel binary from cache, path=%s, kernelNum=%u.", path.c_str(), cached.kernelNum);
+    return kernels;
+}
+
+void KernelBinCache::StoreElf(const uint64_t binHash, const std::string& source, const rtElfData* const elfData,
+    const RtKernel* const kernels) const
+{
+    if (!IsEnabled() || (kernels == nullptr) || (elfData->section_headers == nullptr) ||
+        (source.size() != elfData->obj_size)) {
+        return;
+    }
+    std::vector<ObjectSymbol> objectSymbols;
+    if (!CollectObjectSymbols(elfData, objectSymbols)) {
+        RT_LOG(RT_LOG_INFO, "Kernel binary is not cacheable, symbol table is out of range.");
+        return;
+    }
+
+    CachedElfData cached = {};
+    cached.elfHeader = elfData->elf_header;
+    cached.textOffset = elfData->text_offset;
+    cached.textSize = elfData->text_size;
+    cached.stackSize = elfData->stackSize;
+    cached.soNameOffset = EncodeOffset(elfData->so_name, elfData);
+    cached.fftsAddrOffset = EncodeOffset(elfData->symbolAddr.g_sysFftsAddr, elfData);
+    cached.l2CacheHintCfgOffset = EncodeOffset(elfData->symbolAddr.g_opL2CacheHintCfg, elfData);
+    cached.printFifoSpaceOffset = EncodeOffset(elfData->symbolAddr.g_sysPrintFifoSpace, elfData);
+    cached.simtPrintFifoSpaceOffset = EncodeOffset(elfData->symbolAddr.g_sysSimtPrintFifoSpace, elfData);
+    cached.kernelNum = elfData->kernel_num;
+    cached.funcNum = elfData->func_num;
+    cached.ascendMetaFlag = elfData->ascendMetaFlag;
+    cached.dataFlag = elfData->dataFlag ? 1U : 0U;
+    cached.sectionNum = elfData->elf_header.e_shnum;
+    cached.globalSymbolNum = static_cast<uint32_t>(elfData->globalSymbolMap.size());
+    cached.objectSymbolNum = static_cast<uint32_t>(objectSymbols.size());
+    const uint64_t size = elfData->obj_size;
+    if (!IsValidOffset(cached.soNameOffset, size) || !IsValidOffset(cached.fftsAddrOffset, size) ||
+        !IsValidOffset(cached.l2CacheHintCfgOffset, size) || !IsValidOffset(cached.printFifoSpaceOffset, size) ||
+        !IsValidOffset(cached.simtPrintFifoSpaceOffset, size)) {
+        return;
+    }
+
+    std::string payload;
+    AppendPod(payload, cached);
+    (void)payload.append(
+        RtPtrToPtr<const char_t*>(elfData->section_headers), sizeof(Elf_Internal_Shdr) * cached.sectionNum);
+    CachedSymbol sym = {};
+    for (const auto& item : elfData->globalSymbolMap) {
+        sym.value = item.second.first;
+        sym.size = item.second.second;
+        sym.nameLen = static_cast<uint32_t>(item.first.size());
+        AppendPod(payload, sym);
+        (void)payload.append(item.first);
+    }
+    for (const auto& objSym : objectSymbols) {
+        sym.value = objSym.offset;
+        sym.size = objSym.size;
+        sym.nameLen = static_cast<uint32_t>(objSym.name.size());
+        AppendPod(payload, sym);
+        (void)payload.append(objSym.name);
+    }
+    for (uint32_t i = 0U; i < cached.kernelNum; i++) {
+        if (!EncodeKernel(kernels[i], elfData, payload)) {
+            RT_LOG(RT_LOG_INFO, "Kernel binary is not cacheable, kernel %u is out of range.", i);
+            return;
+        }
+    }
+
+    KernelBinCacheHead head = MakeHead(runtimeId_, KERNEL_BIN_CACHE_KIND_ELF, binHash, size);
+    head.payloadSize = payload.size();
+    head.payloadHash = HashContent(payload.data(), payload.size());
+    WriteEntry(GetEntryPath(binHash, size, ".kbin"), head, source.data(), payload);
+}
+
+bool KernelBinCache::LoadJsonSummary(const std::string& jsonText, KernelJsonSummary& summary) const
+{
+    if (!IsEnabled()) {
+        return false;
+    }
+    const uint64_t hash = HashContent(jsonText.data(), jsonText.size());
+    CacheFileMapping mapping;
+    std::unique_ptr<CacheReader> reader = nullptr;
+    const KernelBinCacheHead expect = MakeHead(runtimeId_, KERNEL_BIN_CACHE_KIND_JSON, hash, jsonText.size());
+    if (!MapEntry(GetEntryPath(hash, jsonText.size(), ".kjson"), expect, jsonText.data(), mapping, reader)) {
+        return false;
+    }
+    return reader->Read(summary) && reader->IsEnd();
+}
+
+void KernelBinCache::StoreJsonSummary(const std::string& jsonText, const KernelJsonSummary& summary) const
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    const uint64_t hash = HashContent(jsonText.data(), jsonText.size());
+    std::string payload;
+    AppendPod(payload, summary);
+    KernelBinCacheHead head = MakeHead(runtimeId_, KERNEL_BIN_CACHE_KIND_JSON, hash, jsonText.size());
+    head.payloadSize = payload.size();
+    head.payloadHash = HashContent(payload.data(), payload.size());
+    WriteEntry(GetEntryPath(hash, jsonText.size(), ".kjson"), head, jsonText.data(), payload);
+}
+} // namespace runtime
+} // namespace cce
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef __CCE_RUNTIME_KERNEL_BIN_CACHE_HPP__
+#define __CCE_RUNTIME_KERNEL_BIN_CACHE_HPP__
+
+#include <string>
+#include "base.hpp"
+#include "elf.hpp"
+
+namespace cce {
+namespace runtime {
+// Result of parsing the json file which has the same name with the operator binary.
+struct KernelJsonSummary {
+    uint32_t interCoreSync;
+    rtError_t debugOptionsRet;
+    uint32_t jsonMagic;
+    uint32_t reserved;
+};
+
+// On-disk cache of parsed operator binaries, enabled by env ASCEND_KERNEL_BIN_CACHE_PATH.
+// An entry is keyed by the content hash and size of the binary (or json) and by the chip type, and is dropped
+// when it was written by another build of the runtime library. The entry keeps a copy of the content which is
+// compared on load, so a hash collision is a miss. Entries are memory-mapped on load and
+// replaced atomically by rename on store, so concurrent processes may share one cache directory.
+class KernelBinCache : public NoCopy {
+public:
+    static KernelBinCache& Instance();
+    // Cache rooted at cachePath, disabled when the path is empty or invalid. Instance() uses the env path.
+    explicit KernelBinCache(const std::string& cachePath);
+    ~KernelBinCache() override = default;
+
+    bool IsEnabled() const
+    {
+        return !cacheDir_.empty();
+    }
+
+    // return 0 when cache is disabled
+    uint64_t HashBinary(const void* const binary, const uint64_t size) const;
+
+    // Rebuild elfData and the kernel table of binary from cache, return nullptr on cache miss.
+    RtKernel* LoadElf(
+        char_t* const binary, const uint64_t size, const uint64_t binHash, rtElfData* const elfData) const;
+    // Called right after ProcessObject succeeded on the same thread, source is the binary before parsing.
+    void StoreElf(const uint64_t binHash, const std::string& source, const rtElfData* const elfData,
+        const RtKernel* const kernels) const;
+
+    bool LoadJsonSummary(const std::string& jsonText, KernelJsonSummary& summary) const;
+    void StoreJsonSummary(const std::string& jsonText, const KernelJsonSummary& summary) const;
+
+private:
+    KernelBinCache();
+    std::string GetEntryPath(const uint64_t hash, const uint64_t size, const char_t* const suffix) const;
+
+    std::string cacheDir_;
+    uint64_t runtimeId_{0ULL};
+};
+} // namespace runtime
+} // namespace cce
+
+#endif // __CCE_RUNTIME_KERNEL_BIN_CACHE_HPP__
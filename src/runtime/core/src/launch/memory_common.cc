@@ -100,6 +100,10 @@ rtError_t MemSetAsync(
         MemLocationTypeToString(attributes.location.type).c_str(), fillVal, fillCount, destMax);
 
     if ((attributes.location.type == RT_MEMORY_LOC_HOST) || (attributes.location.type == RT_MEMORY_LOC_UNREGISTERED)) {
+        if ((ptr != nullptr) && (fillCount <= destMax)) {
+            MemsetD8Optimized(static_cast<uint8_t*>(ptr), static_cast<uint8_t>(fillVal), fillCount);
+            return RT_ERROR_NONE;
+        }
         const errno_t ret = memset_s(ptr, destMax, static_cast<int32_t>(fillVal), fillCount);
         COND_RETURN_ERROR_MSG_CALL(
             ERR_MODULE_SYSTEM, ret != EOK, RT_ERROR_SEC_HANDLE,
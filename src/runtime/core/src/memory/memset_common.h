@@ -19,7 +19,12 @@ namespace runtime {
 
 class Stream;
 
+// Fill host memory, large fills use streaming stores and are split across a few worker threads
 void MemsetD32Optimized(uint32_t* dst, uint32_t value, size_t count);
+void MemsetD16Optimized(uint16_t* dst, uint16_t value, size_t count);
+void MemsetD8Optimized(uint8_t* dst, uint8_t value, size_t count);
+// Fill host memory on the calling thread with regular stores, whatever the size
+void MemsetD32Serial(uint32_t* dst, uint32_t value, size_t count);
 // Perform 32-bit fill on Host memory (using SIMD acceleration)
 rtError_t MemsetD32OnHost(void* dst, uint64_t destMax, uint32_t value, uint64_t count);
 // Perform 32-bit fill on Device memory (temporary Host memory + asynchronous copy)
@@ -9,7 +9,13 @@
  */
 
 #include "memset_common.h"
+#include <condition_variable>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+#include "base.hpp"
+#include "osal.hpp"
 
 // ==================== Platform detection macros ====================
 #if defined(__x86_64__)
@@ -62,6 +68,46 @@ __attribute__((target("avx512f"))) static inline void Memset32_AVX512(uint32_t*
     }
 }
 
+// Streaming stores bypass the cache, dst must be aligned to the vector width
+__attribute__((target("sse2"))) static inline void Memset32_SSE2_NT(uint32_t* dst, uint32_t value, size_t count)
+{
+    __m128i val = _mm_set1_epi32(static_cast<int>(value));
+    size_t i = 0UL;
+    for (; i + 4ULL <= count; i += 4ULL) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), val);
+    }
+    _mm_sfence();
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+__attribute__((target("avx2"))) static inline void Memset32_AVX2_NT(uint32_t* dst, uint32_t value, size_t count)
+{
+    __m256i val = _mm256_set1_epi32(static_cast<int>(value));
+    size_t i = 0UL;
+    for (; i + 8ULL <= count; i += 8ULL) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), val);
+    }
+    _mm_sfence();
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
+__attribute__((target("avx512f"))) static inline void Memset32_AVX512_NT(uint32_t* dst, uint32_t value, size_t count)
+{
+    __m512i val = _mm512_set1_epi32(static_cast<int>(value));
+    size_t i = 0UL;
+    for (; i + 16ULL <= count; i += 16ULL) {
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), val);
+    }
+    _mm_sfence();
+    for (; i < count; ++i) {
+        dst[i] = value;
+    }
+}
+
 // LCOV_EXCL_START
 static inline bool CpuSupportsAVX2(void)
 {
@@ -103,34 +149,59 @@ static inline void Memset32_NEON(uint32_t* dst, uint32_t value, size_t count)
 // -------------------- Function pointer type --------------------
 using Memset32Func = void (*)(uint32_t*, uint32_t, size_t);
 
+struct Memset32Kernel {
+    Memset32Func temporal;
+    Memset32Func nonTemporal;
+    size_t nonTemporalAlign;
+};
+
 // -------------------- Runtime selector -------------------------
-static inline Memset32Func GetOptimalMemset32Func(void)
+static inline Memset32Kernel GetOptimalMemset32Kernel(void)
 {
 #ifdef RT_ARCH_X86
     if (CpuSupportsAVX512F()) {
-        return Memset32_AVX512;
+        return {Memset32_AVX512, Memset32_AVX512_NT, 64ULL};
     } else if (CpuSupportsAVX2()) {
-        return Memset32_AVX2;
+        return {Memset32_AVX2, Memset32_AVX2_NT, 32ULL};
     } else {
-        return Memset32_Naive;
+        return {Memset32_Naive, Memset32_SSE2_NT, 16ULL};
     }
 #elif defined(RT_ARCH_ARM)
-    return Memset32_NEON;
+    // NEON has no streaming store intrinsic, large fills only gain from the worker threads
+    return {Memset32_NEON, Memset32_NEON, 16ULL};
 #else
-    return Memset32_Naive;
+    return {Memset32_Naive, Memset32_Naive, sizeof(uint32_t)};
 #endif
 }
 
-// -------------------- Public entry (with alignment optimization) --------------------
-void MemsetD32Optimized(uint32_t* dst, uint32_t value, size_t count)
+// -------------------- Size thresholds --------------------------
+constexpr size_t MEMSET_NT_DEFAULT_LLC_BYTES = 16ULL * 1024ULL * 1024ULL;
+constexpr size_t MEMSET_NT_MIN_THRESHOLD_BYTES = 1024ULL * 1024ULL;
+constexpr size_t MEMSET_PARALLEL_MIN_BYTES = 32ULL * 1024ULL * 1024ULL;
+constexpr size_t MEMSET_PARALLEL_PART_ALIGN = 4096ULL / sizeof(uint32_t);
+constexpr size_t MEMSET_MAX_WORKER_NUM = 3ULL;
+
+// A fill larger than half of the last level cache would evict most of the caller's working set anyway,
+// so it is written with streaming stores from there on.
+static size_t GetNonTemporalThreshold(void)
 {
-    if (count == 0UL) {
-        return;
+    long llcBytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (llcBytes <= 0L) {
+        llcBytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
     }
+    const size_t llcSize = (llcBytes > 0L) ? static_cast<size_t>(llcBytes) : MEMSET_NT_DEFAULT_LLC_BYTES;
+    const size_t threshold = llcSize / 2ULL;
+    RT_LOG(RT_LOG_INFO, "memset llc size=%zu, non-temporal threshold=%zu.", llcSize, threshold);
+    return (threshold > MEMSET_NT_MIN_THRESHOLD_BYTES) ? threshold : MEMSET_NT_MIN_THRESHOLD_BYTES;
+}
 
-    static Memset32Func optimal_func = GetOptimalMemset32Func();
-    const size_t kAlignBytes = 32ULL;
+static void MemsetD32Range(uint32_t* dst, uint32_t value, size_t count, bool nonTemporal)
+{
+    static const Memset32Kernel kernel = GetOptimalMemset32Kernel();
     uintptr_t addr = reinterpret_cast<uintptr_t>(dst);
+    // streaming stores need the vector alignment, which an element misaligned dst never reaches
+    const bool useNonTemporal = nonTemporal && ((addr & (sizeof(uint32_t) - 1ULL)) == 0ULL);
+    const size_t kAlignBytes = useNonTemporal ? kernel.nonTemporalAlign : 32ULL;
     size_t offset = 0UL;
 
     // Handle misaligned prefix
@@ -143,7 +214,197 @@ void MemsetD32Optimized(uint32_t* dst, uint32_t value, size_t count)
     // Handle aligned main body
     size_t remaining = count - offset;
     if (remaining > 0UL) {
-        optimal_func(dst + offset, value, remaining);
+        const Memset32Func func = useNonTemporal ? kernel.nonTemporal : kernel.temporal;
+        func(dst + offset, value, remaining);
+    }
+}
+
+// -------------------- Worker pool ------------------------------
+// Large fills are split into page aligned parts, the caller fills part 0 and every worker one of the others.
+// Workers are created on the first large fill and live until exit. Only one fill uses the pool at a time,
+// a concurrent one (or one in a forked child, which has no workers) is done by the caller alone.
+class MemsetWorkerPool : public ThreadRunnable {
+public:
+    static MemsetWorkerPool& Instance()
+    {
+        static MemsetWorkerPool pool;
+        return pool;
+    }
+
+    bool Fill(uint32_t* dst, uint32_t value, size_t count, bool nonTemporal)
+    {
+        std::unique_lock<std::mutex> fillLock(fillMutex_, std::try_to_lock);
+        if ((!fillLock.owns_lock()) || (!EnsureWorkers())) {
+            return false;
+        }
+        const size_t partNum = workers_.size() + 1ULL;
+        size_t partCount = (count + partNum - 1ULL) / partNum;
+        partCount = (partCount + MEMSET_PARALLEL_PART_ALIGN - 1ULL) / MEMSET_PARALLEL_PART_ALIGN *
+                    MEMSET_PARALLEL_PART_ALIGN;
+        const MemsetJob job = {dst, value, count, partCount, nonTemporal};
+        {
+            const std::lock_guard<std::mutex> lk(mutex_);
+            job_ = job;
+            pending_ = workers_.size();
+            ++generation_;
+        }
+        cond_.notify_all();
+        FillPart(job, 0ULL);
+        std::unique_lock<std::mutex> lk(mutex_);
+        doneCond_.wait(lk, [this]() { return pending_ == 0ULL; });
+        return true;
+    }
+
+    void Run(const void* param) override
+    {
+        const size_t partIdx = static_cast<size_t>(RtPtrToValue(param));
+        uint64_t seenGeneration = 0ULL;
+        std::unique_lock<std::mutex> lk(mutex_);
+        while (true) {
+            cond_.wait(lk, [this, &seenGeneration]() { return stop_ || (generation_ != seenGeneration); });
+            if (stop_) {
+                return;
+            }
+            seenGeneration = generation_;
+            const MemsetJob job = job_;
+            lk.unlock();
+            FillPart(job, partIdx);
+            lk.lock();
+            --pending_;
+            if (pending_ == 0ULL) {
+                doneCond_.notify_one();
+            }
+        }
+    }
+
+private:
+    struct MemsetJob {
+        uint32_t* dst;
+        uint32_t value;
+        size_t count;
+        size_t partCount;
+        bool nonTemporal;
+    };
+
+    MemsetWorkerPool() = default;
+
+    ~MemsetWorkerPool() override
+    {
+        {
+            const std::lock_guard<std::mutex> lk(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for (std::unique_ptr<Thread>& worker : workers_) {
+            worker->Join();
+        }
+        workers_.clear();
+    }
+
+    static void FillPart(const MemsetJob& job, size_t partIdx)
+    {
+        const size_t begin = partIdx * job.partCount;
+        if (begin >= job.count) {
+            return;
+        }
+        const size_t partCount = ((job.count - begin) < job.partCount) ? (job.count - begin) : job.partCount;
+        MemsetD32Range(job.dst + begin, job.value, partCount, job.nonTemporal);
+    }
+
+    // called with fillMutex_ held
+    bool EnsureWorkers(void)
+    {
+        const pid_t pid = getpid();
+        if (created_) {
+            return (pid == ownerPid_) && (!workers_.empty());
+        }
+        created_ = true;
+        ownerPid_ = pid;
+        const long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+        // leave half of the cores to the rest of the process
+        size_t workerNum = (cpuNum > 2L) ? (static_cast<size_t>(cpuNum) / 2ULL - 1ULL) : 0ULL;
+        workerNum = (workerNum < MEMSET_MAX_WORKER_NUM) ? workerNum : MEMSET_MAX_WORKER_NUM;
+        for (size_t i = 0ULL; i < workerNum; ++i) {
+            std::unique_ptr<Thread> worker(
+                OsalFactory::CreateThread("RT_MEMSET", this, RtValueToPtr<void*>(static_cast<uint64_t>(i + 1ULL))));
+            COND_RETURN_WARN(worker == nullptr, !workers_.empty(), "create memset worker failed, worker num=%zu.",
+                workers_.size());
+            COND_RETURN_WARN(worker->Start() != EN_OK, !workers_.empty(), "start memset worker failed, worker num=%zu.",
+                workers_.size());
+            workers_.push_back(std::move(worker));
+        }
+        RT_LOG(RT_LOG_INFO, "memset worker num=%zu.", workers_.size());
+        return !workers_.empty();
+    }
+
+    std::mutex fillMutex_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable doneCond_;
+    std::vector<std::unique_ptr<Thread>> workers_;
+    MemsetJob job_ = {};
+    uint64_t generation_ = 0ULL;
+    size_t pending_ = 0ULL;
+    bool stop_ = false;
+    bool created_ = false;
+    pid_t ownerPid_ = 0;
+};
+
+// -------------------- Public entry --------------------
+void MemsetD32Serial(uint32_t* dst, uint32_t value, size_t count)
+{
+    if (count == 0UL) {
+        return;
+    }
+    MemsetD32Range(dst, value, count, false);
+}
+
+void MemsetD32Optimized(uint32_t* dst, uint32_t value, size_t count)
+{
+    if (count == 0UL) {
+        return;
+    }
+    static const size_t nonTemporalThreshold = GetNonTemporalThreshold();
+    const size_t bytes = count * sizeof(uint32_t);
+    const bool nonTemporal = (bytes >= nonTemporalThreshold);
+    if ((bytes >= MEMSET_PARALLEL_MIN_BYTES) && MemsetWorkerPool::Instance().Fill(dst, value, count, nonTemporal)) {
+        return;
+    }
+    MemsetD32Range(dst, value, count, nonTemporal);
+}
+
+void MemsetD16Optimized(uint16_t* dst, uint16_t value, size_t count)
+{
+    size_t offset = 0UL;
+    while ((offset < count) && ((reinterpret_cast<uintptr_t>(dst + offset) & (sizeof(uint32_t) - 1ULL)) != 0ULL)) {
+        dst[offset] = value;
+        ++offset;
+    }
+    const size_t count32 = (count - offset) / 2ULL;
+    const uint32_t value32 = (static_cast<uint32_t>(value) << 16U) | static_cast<uint32_t>(value);
+    MemsetD32Optimized(reinterpret_cast<uint32_t*>(dst + offset), value32, count32);
+    for (offset += count32 * 2ULL; offset < count; ++offset) {
+        dst[offset] = value;
+    }
+}
+
+void MemsetD8Optimized(uint8_t* dst, uint8_t value, size_t count)
+{
+    // libc memset is already vectorized, only large fills gain from streaming stores and the workers
+    static const size_t nonTemporalThreshold = GetNonTemporalThreshold();
+    if (count < nonTemporalThreshold) {
+        (void)memset(dst, value, count);
+        return;
+    }
+    size_t offset = 0UL;
+    while ((reinterpret_cast<uintptr_t>(dst + offset) & (sizeof(uint32_t) - 1ULL)) != 0ULL) {
+        dst[offset] = value;
+        ++offset;
+    }
+    const size_t count32 = (count - offset) / sizeof(uint32_t);
+    MemsetD32Optimized(reinterpret_cast<uint32_t*>(dst + offset), ExpandByteToU32(value), count32);
+    for (offset += count32 * sizeof(uint32_t); offset < count; ++offset) {
+        dst[offset] = value;
     }
 }
 
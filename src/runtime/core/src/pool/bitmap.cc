@@ -8,12 +8,67 @@
  * See LICENSE in the root of the software repository for the full text of the License.
  */
 #include "bitmap.hpp"
+#include "osal.hpp"
 #include "error_message_manage.hpp"
 
 namespace cce {
 namespace runtime {
 constexpr uint32_t maxAllocIdCountTh = 10U * 1024U;
 constexpr uint32_t minAvailableIdCountTh = 1024U;
+constexpr uint32_t BITMAP_WORD_BITS = 64U; // 64:bit of uint64_t
+constexpr uint32_t BITMAP_THREAD_HINT_NUM = 4U;
+
+namespace {
+// last word each thread allocated from, keeps concurrent threads off the same word once they diverge
+struct BitmapThreadHint {
+    const Bitmap* owner;
+    uint32_t wordIdx;
+};
+__THREAD_LOCAL__ BitmapThreadHint g_bitmapThreadHint[BITMAP_THREAD_HINT_NUM];
+__THREAD_LOCAL__ uint32_t g_bitmapThreadHintVictim;
+
+inline uint32_t WordNum(const uint32_t bitNum)
+{
+    return (bitNum + BITMAP_WORD_BITS - 1U) / BITMAP_WORD_BITS;
+}
+
+uint64_t* NewFullBitmap(const uint32_t bitNum)
+{
+    const uint32_t wordNum = WordNum(bitNum);
+    uint64_t* const map = new (std::nothrow) uint64_t[wordNum];
+    if (map == nullptr) {
+        return nullptr;
+    }
+    for (uint32_t i = 0U; i < wordNum; i++) {
+        map[i] = static_cast<uint64_t>(-1); // 1-Free; 0-Occupied
+    }
+    if ((bitNum % BITMAP_WORD_BITS) != 0U) {
+        map[wordNum - 1U] = (1ULL << (static_cast<uint64_t>(bitNum) % 64ULL)) - 1ULL;
+    }
+    return map;
+}
+
+void DeleteBitmaps(uint64_t* const bitmap, uint64_t* const summaryL1, uint64_t* const summaryL2)
+{
+    delete[] bitmap;
+    delete[] summaryL1;
+    delete[] summaryL2;
+}
+
+void UpdateThreadHint(const Bitmap* const owner, const uint32_t wordIdx)
+{
+    for (uint32_t i = 0U; i < BITMAP_THREAD_HINT_NUM; i++) {
+        if (g_bitmapThreadHint[i].owner == owner) {
+            g_bitmapThreadHint[i].wordIdx = wordIdx;
+            return;
+        }
+    }
+    const uint32_t victim = g_bitmapThreadHintVictim % BITMAP_THREAD_HINT_NUM;
+    g_bitmapThreadHint[victim].owner = owner;
+    g_bitmapThreadHint[victim].wordIdx = wordIdx;
+    g_bitmapThreadHintVictim = victim + 1U;
+}
+} // namespace
 
 Bitmap::Bitmap(const uint32_t maxIdCnt)
     : NoCopy(), freeBitmap_(nullptr), maxIdCount_(maxIdCnt), allocedCnt_(0U), lastAllocIdx_(0U)
@@ -28,31 +83,123 @@ rtError_t Bitmap::AllocBitmap()
         return RT_ERROR_NONE;
     }
 
-    mutex_.lock();
+    const std::lock_guard<std::mutex> lock(mutex_);
     if (freeBitmap_ != nullptr) {
-        mutex_.unlock();
         return RT_ERROR_NONE;
     }
-    uint64_t* tmpBitmap = nullptr;
-    COND_PROC_RETURN_ERROR_MSG_INNER(
-        (maxIdCount_ == 0U), RT_ERROR_POOL_RESOURCE, mutex_.unlock(),
+    COND_RETURN_ERROR_MSG_INNER((maxIdCount_ == 0U), RT_ERROR_POOL_RESOURCE,
         "Failed to allocate bitmap because max ID count is 0.");
-    const uint32_t maxBitmapIdx = (maxIdCount_ - 1U) / 64U; // 64:bit of uint64_t
-    tmpBitmap = new (std::nothrow) uint64_t[maxBitmapIdx + 1U];
+    const uint32_t wordNum = WordNum(maxIdCount_);
+    const uint32_t l1WordNum = WordNum(wordNum);
+    l2WordNum_ = WordNum(l1WordNum);
+    uint64_t* const tmpBitmap = NewFullBitmap(maxIdCount_);
+    uint64_t* const tmpSummaryL1 = NewFullBitmap(wordNum);
+    uint64_t* const tmpSummaryL2 = NewFullBitmap(l1WordNum);
+    const size_t totalSize = static_cast<size_t>(wordNum + l1WordNum + l2WordNum_) * sizeof(uint64_t);
     COND_PROC_RETURN_AND_MSG_OUTER(
-        (tmpBitmap == nullptr), RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013, mutex_.unlock(),
-        std::to_string(static_cast<size_t>(maxBitmapIdx + 1U) * sizeof(uint64_t)).c_str(), "new");
+        ((tmpBitmap == nullptr) || (tmpSummaryL1 == nullptr) || (tmpSummaryL2 == nullptr)),
+        RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013, DeleteBitmaps(tmpBitmap, tmpSummaryL1, tmpSummaryL2),
+        std::to_string(totalSize).c_str(), "new");
+    summaryL1_ = tmpSummaryL1;
+    summaryL2_ = tmpSummaryL2;
+    // summaries must be visible before freeBitmap_ publishes the bitmap to lock-free readers
+    MEMORY_FENCE();
+    freeBitmap_ = tmpBitmap;
+
+    return RT_ERROR_NONE;
+}
 
-    for (uint32_t i = 0U; i <= maxBitmapIdx; i++) {
-        tmpBitmap[i] = static_cast<uint64_t>(-1); // 1-Free; 0-Occupied
+void Bitmap::SetSummary(const uint32_t mapIdx) const
+{
+    const uint32_t l1Idx = mapIdx / BITMAP_WORD_BITS;
+    FetchAndOr(&summaryL1_[l1Idx], 1ULL << (mapIdx % BITMAP_WORD_BITS));
+    FetchAndOr(&summaryL2_[l1Idx / BITMAP_WORD_BITS], 1ULL << (l1Idx % BITMAP_WORD_BITS));
+}
+
+void Bitmap::ClearSummary(const uint32_t mapIdx) const
+{
+    // clear first and recheck afterwards, a concurrent FreeId either sees the cleared bit or we see its id
+    const uint32_t l1Idx = mapIdx / BITMAP_WORD_BITS;
+    FetchAndAnd(&summaryL1_[l1Idx], ~(1ULL << (mapIdx % BITMAP_WORD_BITS)));
+    if (freeBitmap_[mapIdx] != 0ULL) {
+        SetSummary(mapIdx);
+        return;
     }
-    if ((maxIdCount_ % 64U) != 0U) {              // 64 bit
-        tmpBitmap[maxBitmapIdx] = (1ULL << (static_cast<uint64_t>(maxIdCount_) % 64ULL)) - 1ULL;
+    if (summaryL1_[l1Idx] != 0ULL) {
+        return;
     }
-    freeBitmap_ = tmpBitmap;
-    mutex_.unlock();
+    const uint32_t l2Idx = l1Idx / BITMAP_WORD_BITS;
+    FetchAndAnd(&summaryL2_[l2Idx], ~(1ULL << (l1Idx % BITMAP_WORD_BITS)));
+    if (summaryL1_[l1Idx] != 0ULL) {
+        FetchAndOr(&summaryL2_[l2Idx], 1ULL << (l1Idx % BITMAP_WORD_BITS));
+    }
+}
 
-    return RT_ERROR_NONE;
+uint32_t Bitmap::FindFreeWord(const uint32_t start, const uint32_t end) const
+{
+    // walk summaryL2_ to skip 4096 occupied words at a time, then summaryL1_ to find the word
+    uint32_t l1Idx = start / BITMAP_WORD_BITS;
+    uint64_t l1Mask = static_cast<uint64_t>(-1) << (start % BITMAP_WORD_BITS);
+    while ((l1Idx * BITMAP_WORD_BITS) < end) {
+        const uint32_t l2Idx = l1Idx / BITMAP_WORD_BITS;
+        if (l2Idx >= l2WordNum_) {
+            break;
+        }
+        const uint64_t l2Bits = summaryL2_[l2Idx] & (static_cast<uint64_t>(-1) << (l1Idx % BITMAP_WORD_BITS));
+        if (l2Bits == 0ULL) {
+            l1Idx = (l2Idx + 1U) * BITMAP_WORD_BITS;
+            l1Mask = static_cast<uint64_t>(-1);
+            continue;
+        }
+        const uint32_t nextL1Idx = (l2Idx * BITMAP_WORD_BITS) + static_cast<uint32_t>(BitScan(l2Bits));
+        if (nextL1Idx != l1Idx) {
+            l1Idx = nextL1Idx;
+            l1Mask = static_cast<uint64_t>(-1);
+        }
+        const uint64_t l1Bits = summaryL1_[l1Idx] & l1Mask;
+        if (l1Bits != 0ULL) {
+            const uint32_t mapIdx = (l1Idx * BITMAP_WORD_BITS) + static_cast<uint32_t>(BitScan(l1Bits));
+            return (mapIdx < end) ? mapIdx : end;
+        }
+        l1Idx++;
+        l1Mask = static_cast<uint64_t>(-1);
+    }
+    return end;
+}
+
+int32_t Bitmap::TryAllocInWord(const uint32_t mapIdx, const uint64_t allocMask)
+{
+    while (true) {
+        const uint64_t currentBitmap = freeBitmap_[mapIdx];
+        const uint64_t availBitmap = currentBitmap & allocMask;
+        if (availBitmap == 0ULL) {
+            return -1;
+        }
+        // index of rightmost 1
+        const uint64_t bitIdx = BitScan(availBitmap);
+        const uint64_t newBitmap = currentBitmap & ~(1ULL << bitIdx);
+        // only one thread could occupy the id
+        // other threads loop again to find other free id
+        if (CompareAndExchange(&freeBitmap_[mapIdx], currentBitmap, newBitmap)) {
+            if (newBitmap == 0ULL) {
+                ClearSummary(mapIdx);
+            }
+            (void)allocedCnt_.fetch_add(1U, std::memory_order_relaxed);
+            return static_cast<int32_t>((mapIdx * BITMAP_WORD_BITS) + static_cast<uint32_t>(bitIdx));
+        }
+    }
+}
+
+uint32_t Bitmap::GetStartWord(const uint32_t wordNum) const
+{
+    uint32_t start = lastAllocIdx_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0U; i < BITMAP_THREAD_HINT_NUM; i++) {
+        if (g_bitmapThreadHint[i].owner == this) {
+            start = g_bitmapThreadHint[i].wordIdx;
+            break;
+        }
+    }
+    return (start < wordNum) ? start : 0U;
 }
 
 int32_t Bitmap::AllocId(uint32_t maxAllocCount)
@@ -61,89 +208,87 @@ int32_t Bitmap::AllocId(uint32_t maxAllocCount)
     COND_RETURN_ERROR_MSG_INNER(
         (error != RT_ERROR_NONE), -1, "Failed to allocate bitmap, retCode=%#x", static_cast<uint32_t>(error));
 
-    int32_t maxAllocBitmapIdx;
     // calculate the correct max count and max bitmap index for allocation
     if ((maxAllocCount == 0U) || (maxAllocCount > maxIdCount_)) {
         maxAllocCount = maxIdCount_;
     }
-    maxAllocBitmapIdx = (static_cast<int32_t>(maxAllocCount) - 1) / 64; // 64:bit of uint64_t
-    const uint32_t allocRemainder = maxAllocCount % 64U;                // 64:bit of uint64_t
-    if (allocRemainder != 0U) {
-        maxAllocBitmapIdx = maxAllocBitmapIdx - 1;                      // exclude the incomplete bitmap
-    }
+    const uint32_t fullWordNum = maxAllocCount / BITMAP_WORD_BITS; // exclude the incomplete bitmap
+    const uint32_t allocRemainder = maxAllocCount % BITMAP_WORD_BITS;
 
-    if ((maxAllocCount > maxAllocIdCountTh) && (freeBitmap_[maxAllocBitmapIdx] == 0)) {
-        RT_LOG(RT_LOG_WARNING, "alloced=%u max=%u", allocedCnt_, maxAllocCount);
-        if (((std::max(maxAllocCount, allocedCnt_) - std::min(maxAllocCount, allocedCnt_) < minAvailableIdCountTh) &&
+    const uint32_t allocedCnt = allocedCnt_.load(std::memory_order_relaxed);
+    if ((maxAllocCount > maxAllocIdCountTh) && (freeBitmap_[fullWordNum - 1U] == 0ULL)) {
+        RT_LOG(RT_LOG_WARNING, "alloced=%u max=%u", allocedCnt, maxAllocCount);
+        if (((std::max(maxAllocCount, allocedCnt) - std::min(maxAllocCount, allocedCnt) < minAvailableIdCountTh) &&
              (maxAllocCount != maxIdCount_)) ||
-            (allocedCnt_ == maxIdCount_)) {
+            (allocedCnt == maxIdCount_)) {
             /* utilization is larger than 90% */
             return -1;
         }
     }
 
-    uint64_t currentBitmap;
-    uint32_t mapIdx = lastAllocIdx_;
-    for (int32_t i = 0; i <= maxAllocBitmapIdx; i++) {
-        // non-zero means there are free id
-        while (true) {
-            currentBitmap = freeBitmap_[mapIdx];
-            if (currentBitmap == 0ULL) {
+    // search [start, fullWordNum) then wrap to [0, start), each failed word moves the cursor forward
+    const uint32_t start = GetStartWord(fullWordNum);
+    uint32_t pos = start;
+    uint32_t end = fullWordNum;
+    for (uint32_t round = 0U; round < 2U; round++) {
+        while (pos < end) {
+            const uint32_t mapIdx = FindFreeWord(pos, end);
+            if (mapIdx >= end) {
                 break;
             }
-            // index of leftmost 1
-            const uint64_t bitIdx = BitScan(currentBitmap);
-            const uint64_t newBitmap = currentBitmap & ~(1UL << bitIdx);
-            // only one thread could occupy the id
-            // other threads loop again to find other free id
-            if (CompareAndExchange(&freeBitmap_[mapIdx], currentBitmap, newBitmap)) {
-                allocedCnt_++;
-                lastAllocIdx_ = mapIdx;
-                return (static_cast<int32_t>(mapIdx) * 64) + static_cast<int32_t>(bitIdx); // 64 bit
+            const int32_t id = TryAllocInWord(mapIdx, static_cast<uint64_t>(-1));
+            if (id >= 0) {
+                UpdateThreadHint(this, mapIdx);
+                if (lastAllocIdx_.load(std::memory_order_relaxed) != mapIdx) {
+                    lastAllocIdx_.store(mapIdx, std::memory_order_relaxed);
+                }
+                return id;
             }
+            // stale summary bit, the word was drained by others or occupied directly
+            ClearSummary(mapIdx);
+            pos = mapIdx + 1U;
         }
-
-        // normalize the index to 0~maxAllocBitmapIdx
-        mapIdx = (mapIdx + 1U) % (static_cast<uint32_t>(maxAllocBitmapIdx) + 1U);
+        pos = 0U;
+        end = start;
     }
+
     if (allocRemainder != 0U) { // process the incomplete bitmap
-        mapIdx = static_cast<uint32_t>(maxAllocBitmapIdx) + 1U;
-        while (true) {
-            currentBitmap = freeBitmap_[mapIdx];
-            if ((currentBitmap & ((1UL << allocRemainder) - 1UL)) == 0UL) {
-                break;
-            }
-            // index of leftmost 1
-            const uint64_t bitIdx = BitScan(currentBitmap);
-            const uint64_t newBitmap = currentBitmap & ~(1ULL << bitIdx);
-            // only one thread could occupy the id
-            // other threads loop again to find other free id
-            if (CompareAndExchange(&freeBitmap_[mapIdx], currentBitmap, newBitmap)) {
-                allocedCnt_++;
-                lastAllocIdx_ = (mapIdx > 0U ? mapIdx - 1 : 0U);
-                return (static_cast<int32_t>(mapIdx) * 64) + static_cast<int32_t>(bitIdx); // 64 bit
-            }
+        const int32_t id = TryAllocInWord(fullWordNum, (1ULL << allocRemainder) - 1ULL);
+        if (id >= 0) {
+            const uint32_t hintIdx = (fullWordNum > 0U) ? (fullWordNum - 1U) : 0U;
+            UpdateThreadHint(this, hintIdx);
+            lastAllocIdx_.store(hintIdx, std::memory_order_relaxed);
+            return id;
         }
     }
 
     return -1;
 }
 
+void Bitmap::DecAllocedCnt()
+{
+    uint32_t cnt = allocedCnt_.load(std::memory_order_relaxed);
+    while ((cnt > 0U) && !allocedCnt_.compare_exchange_weak(cnt, cnt - 1U, std::memory_order_relaxed)) {
+    }
+}
+
 void Bitmap::FreeId(const int32_t id)
 {
     if (likely((id >= 0) && (static_cast<uint32_t>(id) < maxIdCount_) && (freeBitmap_ != nullptr))) {
-        const uint32_t mapIdx = static_cast<uint32_t>(id) / 64U; // 64:bit of uint64_t
-        const uint32_t bitIdx = static_cast<uint32_t>(id) % 64U; // 64:bit of uint64_t
+        const uint32_t mapIdx = static_cast<uint32_t>(id) / BITMAP_WORD_BITS;
+        const uint32_t bitIdx = static_cast<uint32_t>(id) % BITMAP_WORD_BITS;
         FetchAndOr(&freeBitmap_[mapIdx], 1ULL << bitIdx);
-        allocedCnt_ = (allocedCnt_ > 0U) ? (allocedCnt_ - 1U) : 0U;
+        SetSummary(mapIdx);
+        DecAllocedCnt();
     }
 }
+
 bool Bitmap::IsIdOccupied(const int32_t id) const
 {
     if (likely((id >= 0) && (static_cast<uint32_t>(id) < maxIdCount_) && (freeBitmap_ != nullptr))) {
-        const uint32_t mapIdx = static_cast<uint32_t>(id) / 64U; // 64:bit of uint64_t
-        const uint32_t bitIdx = static_cast<uint32_t>(id) % 64U; // 64:bit of uint64_t
-        if ((freeBitmap_[mapIdx] & (1UL << bitIdx)) == 0UL) {
+        const uint32_t mapIdx = static_cast<uint32_t>(id) / BITMAP_WORD_BITS;
+        const uint32_t bitIdx = static_cast<uint32_t>(id) % BITMAP_WORD_BITS;
+        if ((freeBitmap_[mapIdx] & (1ULL << bitIdx)) == 0ULL) {
             return true;
         }
     }
@@ -154,9 +299,12 @@ bool Bitmap::IsIdOccupied(const int32_t id) const
 void Bitmap::OccupyId(const int32_t id) const
 {
     if (likely((id >= 0) && (static_cast<uint32_t>(id) < maxIdCount_) && (freeBitmap_ != nullptr))) {
-        const uint32_t mapIdx = static_cast<uint32_t>(id) / 64U; // 64:bit of uint64_t
-        const uint32_t bitIdx = static_cast<uint32_t>(id) % 64U; // 64:bit of uint64_t
+        const uint32_t mapIdx = static_cast<uint32_t>(id) / BITMAP_WORD_BITS;
+        const uint32_t bitIdx = static_cast<uint32_t>(id) % BITMAP_WORD_BITS;
         FetchAndAnd(&freeBitmap_[mapIdx], ~(1ULL << bitIdx));
+        if (freeBitmap_[mapIdx] == 0ULL) {
+            ClearSummary(mapIdx);
+        }
     }
 }
 
@@ -10,11 +10,18 @@
 #ifndef CCE_RUNTIME_BITMAP_HPP
 #define CCE_RUNTIME_BITMAP_HPP
 
+#include <atomic>
 #include <mutex>
 #include "base.hpp"
 
 namespace cce {
 namespace runtime {
+/*
+ * freeBitmap_: 1-Free; 0-Occupied, one bit per id.
+ * summaryL1_:  bit i set means freeBitmap_[i] may have free id.
+ * summaryL2_:  bit j set means summaryL1_[j] is not zero.
+ * A summary bit may be transiently set for an empty word, but is never left cleared for a word with free id.
+ */
 class Bitmap : public NoCopy {
 public:
     explicit Bitmap(const uint32_t maxIdCnt);
@@ -23,19 +30,39 @@ public:
         if (freeBitmap_ != nullptr) {
             delete[] freeBitmap_;
         }
+        if (summaryL1_ != nullptr) {
+            delete[] summaryL1_;
+        }
+        if (summaryL2_ != nullptr) {
+            delete[] summaryL2_;
+        }
     }
     rtError_t AllocBitmap(void);
     int32_t AllocId(uint32_t maxAllocCount = 0);
     void FreeId(const int32_t id);
     bool IsIdOccupied(const int32_t id) const;
     void OccupyId(const int32_t id) const;
+    uint32_t GetAllocedCount() const
+    {
+        return allocedCnt_.load(std::memory_order_relaxed);
+    }
 
 private:
+    uint32_t GetStartWord(uint32_t wordNum) const;
+    uint32_t FindFreeWord(uint32_t start, uint32_t end) const;
+    int32_t TryAllocInWord(uint32_t mapIdx, uint64_t allocMask);
+    void SetSummary(uint32_t mapIdx) const;
+    void ClearSummary(uint32_t mapIdx) const;
+    void DecAllocedCnt();
+
     volatile uint64_t* freeBitmap_;
+    volatile uint64_t* summaryL1_{nullptr};
+    volatile uint64_t* summaryL2_{nullptr};
     uint32_t maxIdCount_;
+    uint32_t l2WordNum_{0U};
     std::mutex mutex_;
-    uint32_t allocedCnt_;
-    uint32_t lastAllocIdx_;
+    std::atomic<uint32_t> allocedCnt_;
+    std::atomic<uint32_t> lastAllocIdx_;
 };
 } // namespace runtime
 } // namespace cce
@@ -15,6 +15,41 @@
 
 namespace cce {
 namespace runtime {
+namespace {
+constexpr uint32_t H2D_COPY_STAT_MIN_SIZE_BIT = 6U;      // 64B
+constexpr uint32_t H2D_COPY_STAT_MIN_LATENCY_BIT = 8U;   // 256ns
+constexpr uint64_t H2D_COPY_AUTO_WARMUP_CNT = 16ULL;     // copies per size bucket tried round robin first
+constexpr uint64_t H2D_COPY_AUTO_EXPLORE_INTERVAL = 256ULL;
+constexpr uint64_t H2D_COPY_AUTO_AVG_WEIGHT = 8ULL;      // a new sample counts 1/8 in the moving average
+constexpr uint64_t H2D_COPY_S_TO_NS = 1000000000ULL;
+constexpr uint32_t H2D_COPY_POLICY_ENV_LEN = 16U;
+constexpr uint32_t H2D_COPY_STAT_ENV_LEN = 4U;
+
+inline uint64_t GetTickNs(void)
+{
+    const mmTimespec tick = mmGetTickCount();
+    return (static_cast<uint64_t>(tick.tv_sec) * H2D_COPY_S_TO_NS) + static_cast<uint64_t>(tick.tv_nsec);
+}
+
+// index of the lowest power of 2 >= val above 2^minBit, clamped to [0, num - 1]
+inline uint32_t GetLog2Bin(const uint64_t val, const uint32_t minBit, const uint32_t num)
+{
+    if (val <= (1ULL << minBit)) {
+        return 0U;
+    }
+    const uint32_t bit = static_cast<uint32_t>(64 - __builtin_clzll(val - 1ULL)); // 64: bit width of uint64_t
+    return ((bit - minBit) < num) ? (bit - minBit) : (num - 1U);
+}
+
+inline uint32_t GetStatShardIdx(void)
+{
+    static std::atomic<uint32_t> nextShardIdx{0U};
+    static thread_local const uint32_t shardIdx =
+        nextShardIdx.fetch_add(1U, std::memory_order_relaxed) % H2D_COPY_STAT_SHARD_NUM;
+    return shardIdx;
+}
+} // namespace
+
 H2DCopyMgr::H2DCopyMgr(
     Device* const dev, const uint32_t size, const uint32_t initCnt, const uint32_t maxCnt,
     const BufferAllocator::Strategy stg, H2DCopyPolicy policy)
@@ -24,7 +59,10 @@ H2DCopyMgr::H2DCopyMgr(
       drv_(dev->Driver_()),
       device_(dev),
       isPiecBarSupport_(false),
-      policy_(policy)
+      policy_((policy == COPY_POLICY_AUTO) ? COPY_POLICY_DEFAULT : policy),
+      isAutoPolicy_(policy == COPY_POLICY_AUTO),
+      isStatEnable_((policy == COPY_POLICY_AUTO) || IsCopyStatEnabled()),
+      copyStat_(nullptr)
 {
     Init(dev, size);
     cpyInfoDmaMap_.cpyDmaMap.clear();
@@ -58,7 +96,7 @@ H2DCopyMgr::H2DCopyMgr(
     } else {
         // no op
     }
-    RT_LOG(RT_LOG_INFO, "alloc h2d copy buff success, policy %d", policy_);
+    RT_LOG(RT_LOG_INFO, "alloc h2d copy buff success, policy %d, auto %d", policy_, isAutoPolicy_);
 }
 
 H2DCopyMgr::H2DCopyMgr(Device* const dev, H2DCopyPolicy policy)
@@ -68,7 +106,10 @@ H2DCopyMgr::H2DCopyMgr(Device* const dev, H2DCopyPolicy policy)
       drv_(dev->Driver_()),
       device_(dev),
       isPiecBarSupport_(false),
-      policy_(policy)
+      policy_((policy == COPY_POLICY_AUTO) ? COPY_POLICY_SYNC : policy),
+      isAutoPolicy_(false),
+      isStatEnable_(IsCopyStatEnabled()),
+      copyStat_(nullptr)
 {
     cpyInfoDmaMap_.cpyDmaMap.clear();
     cpyInfoUbMap_.cpyUbMap.clear();
@@ -77,6 +118,22 @@ H2DCopyMgr::H2DCopyMgr(Device* const dev, H2DCopyPolicy policy)
 
 H2DCopyMgr::~H2DCopyMgr()
 {
+    CopyStatTable* table = copyStat_.load(std::memory_order_acquire);
+    for (uint32_t cpyPolicy = 0U; (table != nullptr) && (cpyPolicy < static_cast<uint32_t>(COPY_POLICY_MAX));
+         cpyPolicy++) {
+        for (uint32_t bucket = 0U; bucket < H2D_COPY_STAT_SIZE_BUCKET_NUM; bucket++) {
+            H2DCopyStat stat = {};
+            (void)GetCopyStat(static_cast<H2DCopyPolicy>(cpyPolicy), bucket, stat);
+            if (stat.count == 0ULL) {
+                continue;
+            }
+            RT_LOG(
+                RT_LOG_INFO, "h2d copy stat, policy=%u, size bucket=%u, count=%" PRIu64 ", bytes=%" PRIu64
+                ", copy=%" PRIu64 "ns, wait=%" PRIu64 "ns.", cpyPolicy, bucket, stat.count, stat.bytes, stat.copyNs,
+                stat.waitNs);
+        }
+    }
+    DELETE_O(table);
     DELETE_O(devAllocator_);
     if (policy_ == COPY_POLICY_ASYNC_PCIE_DMA) {
         DELETE_O(handleAllocator_);
@@ -141,6 +198,7 @@ void* H2DCopyMgr::AllocDevMem(const bool isLogError)
         CpyHandle* handle = static_cast<CpyHandle*>(item);
         handle->devAddr = devAllocator_->AllocItem();
         handle->copyStatus = ASYNC_COPY_STATU_INIT;
+        handle->statBucket = H2D_COPY_STAT_SIZE_BUCKET_NUM;
         return item;
     } else {
         return devAllocator_->AllocItem(isLogError);
@@ -193,17 +251,7 @@ void H2DCopyMgr::FreeDevMem(void* item)
     if (policy_ == COPY_POLICY_ASYNC_PCIE_DMA) {
         CpyHandle* handle = static_cast<CpyHandle*>(item);
         if (handle->copyStatus != ASYNC_COPY_STATU_INIT) {
-            if (handle->isDmaPool) {
-                error = drv_->MemCopyAsyncWaitFinishEx(handle->dmaHandle);
-            } else {
-                error = drv_->MemCopyAsyncWaitFinish(handle->copyStatus);
-            }
-            if (error != RT_ERROR_NONE) {
-                RT_LOG(
-                    RT_LOG_ERROR, "MemCopyAsyncWaitFinish for cpy result failed, retCode=%#x, isDmaPool=%d.", error,
-                    handle->isDmaPool);
-            }
-            handle->copyStatus = ASYNC_COPY_STATU_INIT;
+            (void)WaitAsyncCopy(handle);
         }
         devAllocator_->FreeByItem(handle->devAddr);
         handleAllocator_->FreeByItem(item);
@@ -217,10 +265,28 @@ TIMESTAMP_EXTERN(rtKernelLaunch_MemCopyPcie);
 TIMESTAMP_EXTERN(rtKernelLaunch_MemCopyAsync_HostCpy);
 TIMESTAMP_EXTERN(rtKernelLaunch_MemCopyAsync_DmaFind);
 rtError_t H2DCopyMgr::H2DMemCopy(void* dst, const void* const src, const uint64_t size)
+{
+    CopyStatTable* const table = isStatEnable_ ? GetCopyStatTable() : nullptr;
+    if (table == nullptr) {
+        return DoH2DMemCopy(policy_, dst, src, size);
+    }
+    const uint32_t sizeBucket = GetSizeBucket(size);
+    const H2DCopyPolicy cpyPolicy = isAutoPolicy_ ? SelectAutoPolicy(*table, sizeBucket) : policy_;
+    const uint64_t beginNs = GetTickNs();
+    const rtError_t error = DoH2DMemCopy(cpyPolicy, dst, src, size);
+    if (error == RT_ERROR_NONE) {
+        CpyHandle* const handle = (policy_ == COPY_POLICY_ASYNC_PCIE_DMA) ? static_cast<CpyHandle*>(dst) : nullptr;
+        RecordCopy(*table, cpyPolicy, sizeBucket, size, GetTickNs() - beginNs, handle);
+    }
+    return error;
+}
+
+rtError_t H2DCopyMgr::DoH2DMemCopy(
+    const H2DCopyPolicy cpyPolicy, void* dst, const void* const src, const uint64_t size)
 {
     rtError_t error = RT_ERROR_NONE;
 
-    if (policy_ == COPY_POLICY_PCIE_BAR) {
+    if (cpyPolicy == COPY_POLICY_PCIE_BAR) {
         TIMESTAMP_BEGIN(rtKernelLaunch_MemCopyPcie);
         const errno_t ret = memcpy_s(dst, size, src, size);
         COND_RETURN_ERROR_MSG_CALL(
@@ -228,7 +294,7 @@ rtError_t H2DCopyMgr::H2DMemCopy(void* dst, const void* const src, const uint64_
             "%s failed. Reason: Standard function memcpy_s failed. [Errno %d] %s. dst=%p, src=%p, size=%" PRIu64 ".",
             "Copying memory from host to device", ret, strerror(ret), dst, src, size);
         TIMESTAMP_END(rtKernelLaunch_MemCopyPcie);
-    } else if (policy_ == COPY_POLICY_ASYNC_PCIE_DMA) {
+    } else if (cpyPolicy == COPY_POLICY_ASYNC_PCIE_DMA) {
         CpyHandle* handle = static_cast<CpyHandle*>(dst);
         const ReadProtect rp(&mapLock_);
         TIMESTAMP_BEGIN(rtKernelLaunch_MemCopyAsync_DmaFind);
@@ -265,8 +331,11 @@ rtError_t H2DCopyMgr::H2DMemCopy(void* dst, const void* const src, const uint64_
         }
         TIMESTAMP_END(rtKernelLaunch_MemCopyAsync);
         handle->copyStatus = ASYNC_COPY_STATU_SUCC;
-    } else if (policy_ == COPY_POLICY_SYNC) {
-        error = drv_->MemCopySync(dst, size, src, size, RT_MEMCPY_HOST_TO_DEVICE);
+    } else if (cpyPolicy == COPY_POLICY_SYNC) {
+        // AUTO may copy into a buffer of the async policy synchronously, the handle then stays in the init state
+        void* const devAddr =
+            (policy_ == COPY_POLICY_ASYNC_PCIE_DMA) ? static_cast<CpyHandle*>(dst)->devAddr : dst;
+        error = drv_->MemCopySync(devAddr, size, src, size, RT_MEMCPY_HOST_TO_DEVICE);
         if (error != RT_ERROR_NONE) {
             RT_LOG(RT_LOG_ERROR, "Failed to copy memory synchronously, retCode=%#x.", error);
             return error;
@@ -282,25 +351,201 @@ rtError_t H2DCopyMgr::H2DMemCopyWaitFinish(void* devAddr)
     if (policy_ == COPY_POLICY_ASYNC_PCIE_DMA) {
         CpyHandle* handle = static_cast<CpyHandle*>(devAddr);
         if (handle->copyStatus != ASYNC_COPY_STATU_INIT) {
-            rtError_t error = RT_ERROR_NONE;
-            if (handle->isDmaPool) {
-                error = drv_->MemCopyAsyncWaitFinishEx(handle->dmaHandle);
-            } else {
-                error = drv_->MemCopyAsyncWaitFinish(handle->copyStatus);
-            }
-            handle->copyStatus = ASYNC_COPY_STATU_INIT;
-            if (error != RT_ERROR_NONE) {
-                RT_LOG(
-                    RT_LOG_ERROR, "MemCopyAsyncWaitFinish for cpy result failed, retCode=%#x, isDmaPool=%d.", error,
-                    handle->isDmaPool);
-                return error;
-            }
+            return WaitAsyncCopy(handle);
+        }
+    }
+
+    return RT_ERROR_NONE;
+}
+
+rtError_t H2DCopyMgr::WaitAsyncCopy(CpyHandle* const handle)
+{
+    // only set when the copy was recorded, the statistics table exists then
+    const bool isStatCopy = (handle->statBucket < H2D_COPY_STAT_SIZE_BUCKET_NUM);
+    const uint64_t beginNs = isStatCopy ? GetTickNs() : 0ULL;
+    rtError_t error = RT_ERROR_NONE;
+    if (handle->isDmaPool) {
+        error = drv_->MemCopyAsyncWaitFinishEx(handle->dmaHandle);
+    } else {
+        error = drv_->MemCopyAsyncWaitFinish(handle->copyStatus);
+    }
+    handle->copyStatus = ASYNC_COPY_STATU_INIT;
+    if (error != RT_ERROR_NONE) {
+        RT_LOG(
+            RT_LOG_ERROR, "MemCopyAsyncWaitFinish for cpy result failed, retCode=%#x, isDmaPool=%d.", error,
+            handle->isDmaPool);
+        return error;
+    }
+    if (isStatCopy) {
+        // the cost of an async copy is only known here, it is what the caller spent submitting and waiting
+        CopyStatTable* const table = copyStat_.load(std::memory_order_acquire);
+        const uint64_t waitNs = GetTickNs() - beginNs;
+        (void)table->shard[GetStatShardIdx()].slot[COPY_POLICY_ASYNC_PCIE_DMA][handle->statBucket].waitNs.fetch_add(
+            waitNs, std::memory_order_relaxed);
+        UpdateAvgCost(table->avgCostNs[COPY_POLICY_ASYNC_PCIE_DMA][handle->statBucket], handle->copyNs + waitNs);
+        handle->statBucket = H2D_COPY_STAT_SIZE_BUCKET_NUM;
+    }
+    return RT_ERROR_NONE;
+}
+
+uint32_t H2DCopyMgr::GetSizeBucket(const uint64_t size)
+{
+    return GetLog2Bin(size, H2D_COPY_STAT_MIN_SIZE_BIT, H2D_COPY_STAT_SIZE_BUCKET_NUM);
+}
+
+H2DCopyPolicy H2DCopyMgr::GetArgsCopyPolicy(void)
+{
+    static const H2DCopyPolicy argsPolicy = []() -> H2DCopyPolicy {
+        char_t envValue[H2D_COPY_POLICY_ENV_LEN] = {};
+        if ((mmGetEnv("ASCEND_RT_H2D_COPY_POLICY", static_cast<char_t*>(envValue), sizeof(envValue)) == EN_OK) &&
+            (strcmp(static_cast<char_t*>(envValue), "auto") == 0)) {
+            RT_LOG(RT_LOG_INFO, "h2d copy policy of args is auto.");
+            return COPY_POLICY_AUTO;
         }
+        return COPY_POLICY_DEFAULT;
+    }();
+    return argsPolicy;
+}
+
+bool H2DCopyMgr::IsCopyStatEnabled(void)
+{
+    static const bool isStatEnable = []() -> bool {
+        char_t envValue[H2D_COPY_STAT_ENV_LEN] = {};
+        if ((mmGetEnv("ASCEND_RT_H2D_COPY_STAT", static_cast<char_t*>(envValue), sizeof(envValue)) == EN_OK) &&
+            (strcmp(static_cast<char_t*>(envValue), "1") == 0)) {
+            RT_LOG(RT_LOG_INFO, "h2d copy stat is enabled.");
+            return true;
+        }
+        return false;
+    }();
+    return isStatEnable;
+}
+
+H2DCopyMgr::CopyStatTable* H2DCopyMgr::GetCopyStatTable(void)
+{
+    CopyStatTable* table = copyStat_.load(std::memory_order_acquire);
+    if (table != nullptr) {
+        return table;
+    }
+    CopyStatTable* const newTable = new (std::nothrow) CopyStatTable();
+    COND_RETURN_WARN(
+        newTable == nullptr, nullptr, "Failed to create h2d copy stat table, size=%zu.", sizeof(CopyStatTable));
+    if (copyStat_.compare_exchange_strong(table, newTable, std::memory_order_acq_rel)) {
+        return newTable;
+    }
+    delete newTable;
+    return table;
+}
+
+// Buffers are bound to the policy they were allocated for, so AUTO only chooses between that policy and a driver
+// sync copy, which every device buffer supports. Each size bucket first tries both in turn, then uses the one with
+// the lower moving average cost and gives the other one a copy every H2D_COPY_AUTO_EXPLORE_INTERVAL copies.
+H2DCopyPolicy H2DCopyMgr::SelectAutoPolicy(CopyStatTable& table, const uint32_t sizeBucket)
+{
+    if ((policy_ != COPY_POLICY_PCIE_BAR) && (policy_ != COPY_POLICY_ASYNC_PCIE_DMA)) {
+        return policy_;
+    }
+    const uint64_t seq = table.autoCopyCnt[sizeBucket].fetch_add(1ULL, std::memory_order_relaxed);
+    if (seq < H2D_COPY_AUTO_WARMUP_CNT) {
+        return ((seq & 1ULL) == 0ULL) ? policy_ : COPY_POLICY_SYNC;
+    }
+    const H2DCopyPolicy best = GetAutoSelectedPolicy(sizeBucket);
+    if ((seq % H2D_COPY_AUTO_EXPLORE_INTERVAL) != 0ULL) {
+        return best;
+    }
+    return (best == COPY_POLICY_SYNC) ? policy_ : COPY_POLICY_SYNC;
+}
+
+H2DCopyPolicy H2DCopyMgr::GetAutoSelectedPolicy(const uint32_t sizeBucket) const
+{
+    if ((!isAutoPolicy_) || (sizeBucket >= H2D_COPY_STAT_SIZE_BUCKET_NUM) ||
+        ((policy_ != COPY_POLICY_PCIE_BAR) && (policy_ != COPY_POLICY_ASYNC_PCIE_DMA))) {
+        return policy_;
     }
+    const CopyStatTable* const table = copyStat_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        return policy_;
+    }
+    const uint64_t ownCost = table->avgCostNs[policy_][sizeBucket].load(std::memory_order_relaxed);
+    const uint64_t syncCost = table->avgCostNs[COPY_POLICY_SYNC][sizeBucket].load(std::memory_order_relaxed);
+    // 0 means no finished copy yet, such a policy keeps being tried
+    if ((ownCost == 0ULL) || (syncCost == 0ULL)) {
+        return (ownCost == 0ULL) ? policy_ : COPY_POLICY_SYNC;
+    }
+    return (syncCost < ownCost) ? COPY_POLICY_SYNC : policy_;
+}
+
+void H2DCopyMgr::RecordCopy(
+    CopyStatTable& table, const H2DCopyPolicy cpyPolicy, const uint32_t sizeBucket, const uint64_t size,
+    const uint64_t costNs, CpyHandle* const handle)
+{
+    CopyStatSlot& slot = table.shard[GetStatShardIdx()].slot[cpyPolicy][sizeBucket];
+    (void)slot.count.fetch_add(1ULL, std::memory_order_relaxed);
+    (void)slot.bytes.fetch_add(size, std::memory_order_relaxed);
+    (void)slot.copyNs.fetch_add(costNs, std::memory_order_relaxed);
+    (void)slot.latencyHist[GetLog2Bin(costNs, H2D_COPY_STAT_MIN_LATENCY_BIT, H2D_COPY_STAT_LATENCY_BIN_NUM)]
+        .fetch_add(1ULL, std::memory_order_relaxed);
+    if ((handle != nullptr) && (handle->copyStatus != ASYNC_COPY_STATU_INIT)) {
+        handle->statBucket = sizeBucket;
+        handle->copyNs = costNs;
+        return;
+    }
+    UpdateAvgCost(table.avgCostNs[cpyPolicy][sizeBucket], costNs);
+}
+
+void H2DCopyMgr::UpdateAvgCost(std::atomic<uint64_t>& avgCostNs, const uint64_t costNs)
+{
+    // concurrent updates may drop a sample, which a moving average tolerates
+    const uint64_t avg = avgCostNs.load(std::memory_order_relaxed);
+    const uint64_t newAvg =
+        (avg == 0ULL) ? (costNs | 1ULL) : (avg - (avg / H2D_COPY_AUTO_AVG_WEIGHT) + (costNs / H2D_COPY_AUTO_AVG_WEIGHT));
+    avgCostNs.store((newAvg == 0ULL) ? 1ULL : newAvg, std::memory_order_relaxed);
+}
 
+rtError_t H2DCopyMgr::GetCopyStat(const H2DCopyPolicy policy, const uint32_t sizeBucket, H2DCopyStat& stat) const
+{
+    COND_RETURN_ERROR(
+        (policy >= COPY_POLICY_MAX) || (sizeBucket >= H2D_COPY_STAT_SIZE_BUCKET_NUM), RT_ERROR_INVALID_VALUE,
+        "invalid h2d copy stat query, policy=%d, size bucket=%u.", policy, sizeBucket);
+    stat = {};
+    const CopyStatTable* const table = copyStat_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        return RT_ERROR_NONE;
+    }
+    for (const CopyStatShard& shard : table->shard) {
+        const CopyStatSlot& slot = shard.slot[policy][sizeBucket];
+        stat.count += slot.count.load(std::memory_order_relaxed);
+        stat.bytes += slot.bytes.load(std::memory_order_relaxed);
+        stat.copyNs += slot.copyNs.load(std::memory_order_relaxed);
+        stat.waitNs += slot.waitNs.load(std::memory_order_relaxed);
+        for (uint32_t i = 0U; i < H2D_COPY_STAT_LATENCY_BIN_NUM; i++) {
+            stat.latencyHist[i] += slot.latencyHist[i].load(std::memory_order_relaxed);
+        }
+    }
     return RT_ERROR_NONE;
 }
 
+void H2DCopyMgr::ResetCopyStat(void)
+{
+    CopyStatTable* const table = copyStat_.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        return;
+    }
+    for (CopyStatShard& shard : table->shard) {
+        for (auto& policySlots : shard.slot) {
+            for (CopyStatSlot& slot : policySlots) {
+                slot.count.store(0ULL, std::memory_order_relaxed);
+                slot.bytes.store(0ULL, std::memory_order_relaxed);
+                slot.copyNs.store(0ULL, std::memory_order_relaxed);
+                slot.waitNs.store(0ULL, std::memory_order_relaxed);
+                for (auto& bin : slot.latencyHist) {
+                    bin.store(0ULL, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+}
+
 rtError_t H2DCopyMgr::ArgsPoolConvertAddr(void)
 {
     const WriteProtect wp(cpyInfoDmaMap_.mapLock);
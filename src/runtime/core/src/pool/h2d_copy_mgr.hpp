@@ -10,6 +10,7 @@
 #ifndef CCE_RUNTIME_H2D_COPY_MGR_HPP
 #define CCE_RUNTIME_H2D_COPY_MGR_HPP
 
+#include <atomic>
 #include <unordered_map>
 #include "base.hpp"
 #include "osal.hpp"
@@ -29,9 +30,25 @@ enum H2DCopyPolicy {
     COPY_POLICY_ASYNC_PCIE_DMA,
     COPY_POLICY_SYNC,
     COPY_POLICY_UB,
+    COPY_POLICY_AUTO,
     COPY_POLICY_MAX
 };
 
+// size bucket i holds copies of (64B << (i - 1), 64B << i], the last one everything larger
+constexpr uint32_t H2D_COPY_STAT_SIZE_BUCKET_NUM = 12U;
+// latency bin i holds copies of [256ns << (i - 1), 256ns << i), the last one everything slower
+constexpr uint32_t H2D_COPY_STAT_LATENCY_BIN_NUM = 16U;
+// copy threads are spread over the shards so they do not update the same counters
+constexpr uint32_t H2D_COPY_STAT_SHARD_NUM = 4U;
+
+struct H2DCopyStat {
+    uint64_t count;
+    uint64_t bytes;
+    uint64_t copyNs;   // time spent in H2DMemCopy
+    uint64_t waitNs;   // time spent waiting for async copies to finish
+    uint64_t latencyHist[H2D_COPY_STAT_LATENCY_BIN_NUM]; // by time spent in H2DMemCopy
+};
+
 struct CpyAddrMgr {
     uint64_t devBaseAddr;
     uint64_t hostBaseAddr;
@@ -75,6 +92,8 @@ struct CpyHandle {
     void* devAddr;
     struct DMA_ADDR* dmaHandle;
     bool isDmaPool;
+    uint32_t statBucket;
+    uint64_t copyNs;
 };
 
 class H2DCopyMgr : public NoCopy {
@@ -96,11 +115,46 @@ public:
     rtError_t UbArgsPoolConvertAddr(void);
 
     H2DCopyPolicy GetPolicy(void) const { return policy_; }
+    bool IsAutoPolicy(void) const { return isAutoPolicy_; }
+    // all zero unless AUTO or ASCEND_RT_H2D_COPY_STAT=1 is enabled
+    rtError_t GetCopyStat(const H2DCopyPolicy policy, const uint32_t sizeBucket, H2DCopyStat& stat) const;
+    // the moving averages AUTO selects by are kept
+    void ResetCopyStat(void);
+    // the policy AUTO currently prefers for the size bucket, or the fixed policy if AUTO is not enabled
+    H2DCopyPolicy GetAutoSelectedPolicy(const uint32_t sizeBucket) const;
+    static uint32_t GetSizeBucket(const uint64_t size);
+    // COPY_POLICY_AUTO if ASCEND_RT_H2D_COPY_POLICY=auto, otherwise COPY_POLICY_DEFAULT
+    static H2DCopyPolicy GetArgsCopyPolicy(void);
+    static bool IsCopyStatEnabled(void);
     uint64_t GetUbHostAddr(const uint64_t devAddr, void** devTsegInfo, void** hostTsegInfo);
     static void* MallocUbBuffer(const size_t size, void* const para);
     static void FreeUbBuffer(void* const addr, void* const para);
 
 private:
+    struct CopyStatSlot {
+        std::atomic<uint64_t> count{0ULL};
+        std::atomic<uint64_t> bytes{0ULL};
+        std::atomic<uint64_t> copyNs{0ULL};
+        std::atomic<uint64_t> waitNs{0ULL};
+        std::atomic<uint64_t> latencyHist[H2D_COPY_STAT_LATENCY_BIN_NUM]{};
+    };
+    struct alignas(64) CopyStatShard { // 64: cache line size
+        CopyStatSlot slot[COPY_POLICY_MAX][H2D_COPY_STAT_SIZE_BUCKET_NUM];
+    };
+    struct CopyStatTable {
+        CopyStatShard shard[H2D_COPY_STAT_SHARD_NUM];
+        std::atomic<uint64_t> avgCostNs[COPY_POLICY_MAX][H2D_COPY_STAT_SIZE_BUCKET_NUM]{}; // copy + wait, for AUTO
+        std::atomic<uint64_t> autoCopyCnt[H2D_COPY_STAT_SIZE_BUCKET_NUM]{};
+    };
+
+    rtError_t DoH2DMemCopy(const H2DCopyPolicy cpyPolicy, void* dst, const void* const src, const uint64_t size);
+    rtError_t WaitAsyncCopy(CpyHandle* const handle);
+    CopyStatTable* GetCopyStatTable(void);
+    H2DCopyPolicy SelectAutoPolicy(CopyStatTable& table, const uint32_t sizeBucket);
+    void RecordCopy(
+        CopyStatTable& table, const H2DCopyPolicy cpyPolicy, const uint32_t sizeBucket, const uint64_t size,
+        const uint64_t costNs, CpyHandle* const handle);
+    static void UpdateAvgCost(std::atomic<uint64_t>& avgCostNs, const uint64_t costNs);
     static void* MallocBuffer(const size_t size, void* const para);
     static void FreeBuffer(void* const addr, void* const para);
     static void* MallocPcieBarBuffer(size_t size, void* para);
@@ -114,6 +168,9 @@ private:
     CpyDmaInfo cpyInfoDmaMap_;
     CpyUbInfo cpyInfoUbMap_;
     mmRWLock_t mapLock_;
+    bool isAutoPolicy_;
+    bool isStatEnable_;
+    std::atomic<CopyStatTable*> copyStat_; // created by the first copy with statistics enabled
 };
 
 rtError_t GetMemTsegInfo(
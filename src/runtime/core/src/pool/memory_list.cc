@@ -12,114 +12,261 @@
 
 namespace cce {
 namespace runtime {
-MemoryList::MemoryList() : NoCopy() {}
+namespace {
+constexpr uint32_t BITS_OF_UINT64 = 64U;
+
+// 最高位 1 的下标，val 不能为 0
+inline uint32_t HighestBit(const uint64_t val)
+{
+#ifndef WIN32
+    return static_cast<uint32_t>(63 - __builtin_clzll(val)); // 63: 最高位下标
+#else
+    DWORD bitIdx = 0;
+    (void)_BitScanReverse64(&bitIdx, val);
+    return static_cast<uint32_t>(bitIdx);
+#endif
+}
+
+// 低 n 位之外的所有位，n < 64
+inline uint64_t MaskFrom(const uint32_t n)
+{
+    return ~((1ULL << n) - 1ULL);
+}
+} // namespace
+
+MemoryList::MemoryList() : NoCopy()
+{
+    for (uint32_t i = 0U; i < MEMORY_LIST_MAX_GRANULE_NUM; i++) {
+        freeHead_[i] = MEMORY_LIST_INVALID_IDX;
+        freeNext_[i] = MEMORY_LIST_INVALID_IDX;
+        freePrev_[i] = MEMORY_LIST_INVALID_IDX;
+        blockHead_[i] = MEMORY_LIST_INVALID_IDX;
+    }
+}
 
 MemoryList::~MemoryList() noexcept
 {
-    ListNode* cur = head_;
-    ListNode* next;
-    while (cur != nullptr) {
-        next = cur->next;
-        delete cur->block;
-        delete cur;
-        cur = next;
-    }
-}
-
-// 添加内存块到链表
-rtError_t MemoryList::AddBlock(void* address, size_t size)
-{
-    rtError_t error = RT_ERROR_NONE;
-    MemoryBlock* block = new (std::nothrow) MemoryBlock;
-    COND_RETURN_AND_MSG_OUTER(
-        block == nullptr, RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013, std::to_string(sizeof(MemoryBlock)).c_str(),
-        "new");
-    block->address = address;
-    block->size = size;
-
-    ListNode* node = new (std::nothrow) ListNode;
-    COND_GOTO_MSG_OUTER(
-        node == nullptr, BLOCK_FREE, error, RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013,
-        std::to_string(sizeof(ListNode)).c_str(), "new");
-    node->block = block;
-    node->next = nullptr;
-
-    // 如果链表为空，将头结点和尾节点都指向新节点
-    if (head_ == nullptr) {
-        head_ = node;
-        tail_ = node;
+    baseAddr_ = nullptr;
+}
+
+uint32_t MemoryList::SizeToGranule(size_t size)
+{
+    return static_cast<uint32_t>((size + MEMORY_LIST_GRANULE_SIZE - 1U) / MEMORY_LIST_GRANULE_SIZE);
+}
+
+rtError_t MemoryList::Init(void* address, size_t size)
+{
+    NULL_PTR_RETURN(address, RT_ERROR_INVALID_VALUE);
+    const uint32_t granuleNum = static_cast<uint32_t>(size / MEMORY_LIST_GRANULE_SIZE);
+    COND_RETURN_ERROR(
+        (granuleNum == 0U) || (granuleNum > MEMORY_LIST_MAX_GRANULE_NUM), RT_ERROR_INVALID_VALUE,
+        "Invalid memory list size=%zu, granule size=%zu, max granule num=%u.", size, MEMORY_LIST_GRANULE_SIZE,
+        MEMORY_LIST_MAX_GRANULE_NUM);
+    baseAddr_ = static_cast<uint8_t*>(address);
+    granuleNum_ = granuleNum;
+    InsertFreeBlock(0U, static_cast<uint16_t>(granuleNum));
+    return RT_ERROR_NONE;
+}
+
+void MemoryList::SetBlock(uint16_t start, uint16_t granuleNum, bool isFree)
+{
+    blockSize_[start] = granuleNum;
+    blockFree_[start] = isFree;
+    blockHead_[start + granuleNum - 1U] = start;
+    startBitmap_[start / BITS_OF_UINT64] |= (1ULL << (start % BITS_OF_UINT64));
+}
+
+// 块被相邻块吸收后不再是块首
+void MemoryList::ClearBlock(uint16_t start)
+{
+    blockSize_[start] = 0U;
+    blockFree_[start] = false;
+    startBitmap_[start / BITS_OF_UINT64] &= ~(1ULL << (start % BITS_OF_UINT64));
+}
+
+void MemoryList::InsertFreeBlock(uint16_t start, uint16_t granuleNum)
+{
+    SetBlock(start, granuleNum, true);
+    const uint32_t cls = granuleNum - 1U;
+    const uint16_t head = freeHead_[cls];
+    freeNext_[start] = head;
+    freePrev_[start] = MEMORY_LIST_INVALID_IDX;
+    if (head != MEMORY_LIST_INVALID_IDX) {
+        freePrev_[head] = start;
+    }
+    freeHead_[cls] = start;
+    freeBitmap_[cls / BITS_OF_UINT64] |= (1ULL << (cls % BITS_OF_UINT64));
+    summaryBitmap_ |= (1ULL << (cls / BITS_OF_UINT64));
+    freeBlockNum_++;
+}
+
+void MemoryList::RemoveFreeBlock(uint16_t start)
+{
+    const uint32_t cls = blockSize_[start] - 1U;
+    const uint16_t prev = freePrev_[start];
+    const uint16_t next = freeNext_[start];
+    if (prev != MEMORY_LIST_INVALID_IDX) {
+        freeNext_[prev] = next;
     } else {
-        // 否则将新节点添加到链表末尾
-        tail_->next = node;
-        tail_ = node;
+        freeHead_[cls] = next;
+    }
+    if (next != MEMORY_LIST_INVALID_IDX) {
+        freePrev_[next] = prev;
+    }
+    freeNext_[start] = MEMORY_LIST_INVALID_IDX;
+    freePrev_[start] = MEMORY_LIST_INVALID_IDX;
+    blockFree_[start] = false;
+
+    if (freeHead_[cls] == MEMORY_LIST_INVALID_IDX) {
+        const uint32_t word = cls / BITS_OF_UINT64;
+        freeBitmap_[word] &= ~(1ULL << (cls % BITS_OF_UINT64));
+        if (freeBitmap_[word] == 0ULL) {
+            summaryBitmap_ &= ~(1ULL << word);
+        }
     }
-    return error;
-BLOCK_FREE:
-    DELETE_O(block);
-    return RT_ERROR_MEMORY_ALLOCATION;
+    freeBlockNum_ = (freeBlockNum_ > 0U) ? (freeBlockNum_ - 1U) : 0U;
+}
+
+// 查找粒度数不小于 granuleNum 的最小空闲块
+uint16_t MemoryList::FindFreeBlock(uint32_t granuleNum) const
+{
+    const uint32_t cls = granuleNum - 1U;
+    uint32_t word = cls / BITS_OF_UINT64;
+    const uint64_t bits = freeBitmap_[word] & MaskFrom(cls % BITS_OF_UINT64);
+    if (bits != 0ULL) {
+        return freeHead_[(word * BITS_OF_UINT64) + static_cast<uint32_t>(BitScan(bits))];
+    }
+
+    word++;
+    if (word >= MEMORY_LIST_BITMAP_NUM) {
+        return MEMORY_LIST_INVALID_IDX;
+    }
+    const uint64_t summary = summaryBitmap_ & MaskFrom(word);
+    if (summary == 0ULL) {
+        return MEMORY_LIST_INVALID_IDX;
+    }
+    word = static_cast<uint32_t>(BitScan(summary));
+    return freeHead_[(word * BITS_OF_UINT64) + static_cast<uint32_t>(BitScan(freeBitmap_[word]))];
 }
 
 // 获取符合要求的内存块
 void* MemoryList::GetBlock(size_t size)
 {
-    ListNode* node = head_;
-    while (node != nullptr) {
-        if (node->block->size >= size) {
-            void* address = node->block->address;
-            if (node->block->size == size) {
-                // 从链表中删除节点
-                RemoveNode(node);
-            } else {
-                // 更新链表中的地址
-                node->block->address = RtPtrToPtr<void*>(RtPtrToPtr<uint8_t*>(node->block->address) + size);
-                node->block->size -= size;
-            }
-            return address;
-        }
-        node = node->next;
+    if ((size == 0U) || (granuleNum_ == 0U)) {
+        return nullptr;
     }
-    return nullptr; // 没有找到符合要求的内存块
+    const uint32_t granuleNum = SizeToGranule(size);
+    if (granuleNum > granuleNum_) {
+        return nullptr;
+    }
+
+    const uint16_t start = FindFreeBlock(granuleNum);
+    if (start == MEMORY_LIST_INVALID_IDX) {
+        return nullptr; // 没有找到符合要求的内存块
+    }
+
+    const uint16_t blockNum = blockSize_[start];
+    RemoveFreeBlock(start);
+    if (blockNum > granuleNum) {
+        // 剩余部分作为新的空闲块
+        InsertFreeBlock(static_cast<uint16_t>(start + granuleNum), static_cast<uint16_t>(blockNum - granuleNum));
+    }
+    SetBlock(start, static_cast<uint16_t>(granuleNum), false);
+
+    usedSize_ += static_cast<size_t>(granuleNum) * MEMORY_LIST_GRANULE_SIZE;
+    highWaterMark_ = std::max(highWaterMark_, usedSize_);
+    usedBlockNum_++;
+    return RtPtrToPtr<void*>(baseAddr_ + (static_cast<size_t>(start) * MEMORY_LIST_GRANULE_SIZE));
 }
 
-// 删除链表中的节点
-void MemoryList::RemoveNode(ListNode* node)
+bool MemoryList::IsValidAddress(const void* address) const
 {
-    if (node == head_) {
-        head_ = node->next;
-        if (node == tail_) {
-            tail_ = nullptr; // 如果删除的是唯一节点，更新尾指针
-        }
-    } else {
-        ListNode* prev = head_;
-        while (prev->next != node) {
-            prev = prev->next;
+    const uint8_t* addr = static_cast<const uint8_t*>(address);
+    return (baseAddr_ != nullptr) && (addr >= baseAddr_) &&
+           (addr < (baseAddr_ + (static_cast<size_t>(granuleNum_) * MEMORY_LIST_GRANULE_SIZE)));
+}
+
+// 归还内存块，并与前后相邻的空闲块合并
+size_t MemoryList::AddBlock(void* address, size_t size)
+{
+    COND_RETURN_WARN(!IsValidAddress(address), 0U, "address=%p is out of memory list range.", address);
+    const size_t offset = static_cast<size_t>(static_cast<uint8_t*>(address) - baseAddr_);
+    uint16_t start = static_cast<uint16_t>(offset / MEMORY_LIST_GRANULE_SIZE);
+    COND_RETURN_WARN(
+        ((offset % MEMORY_LIST_GRANULE_SIZE) != 0U) || (blockSize_[start] == 0U) || blockFree_[start], 0U,
+        "address=%p is not an allocated block, size=%zu.", address, size);
+
+    uint16_t granuleNum = blockSize_[start];
+    COND_LOG(
+        SizeToGranule(size) != granuleNum, "release size=%zu mismatch with block size=%zu, address=%p.", size,
+        static_cast<size_t>(granuleNum) * MEMORY_LIST_GRANULE_SIZE, address);
+    const size_t releaseSize = static_cast<size_t>(granuleNum) * MEMORY_LIST_GRANULE_SIZE;
+    usedSize_ = (usedSize_ >= releaseSize) ? (usedSize_ - releaseSize) : 0U;
+    usedBlockNum_ = (usedBlockNum_ > 0U) ? (usedBlockNum_ - 1U) : 0U;
+
+    // 与后继空闲块合并
+    const uint32_t next = static_cast<uint32_t>(start) + granuleNum;
+    if ((next < granuleNum_) && blockFree_[next]) {
+        const uint16_t nextNum = blockSize_[next];
+        RemoveFreeBlock(static_cast<uint16_t>(next));
+        ClearBlock(static_cast<uint16_t>(next));
+        granuleNum = static_cast<uint16_t>(granuleNum + nextNum);
+    }
+    // 与前驱空闲块合并，通过前一个粒度上的边界标记找到前驱块首
+    if (start > 0U) {
+        const uint16_t prev = blockHead_[start - 1U];
+        if (blockFree_[prev]) {
+            const uint16_t prevNum = blockSize_[prev];
+            RemoveFreeBlock(prev);
+            ClearBlock(start);
+            start = prev;
+            granuleNum = static_cast<uint16_t>(granuleNum + prevNum);
         }
-        prev->next = node->next;
-        if (node == tail_) {
-            tail_ = prev; // 如果删除的是尾节点，更新尾指针
+    }
+    InsertFreeBlock(start, granuleNum);
+    return releaseSize;
+}
+
+// 查找粒度所属块的块首：块首位图中不大于 granule 的最高位
+uint16_t MemoryList::FindBlockHead(uint16_t granule) const
+{
+    int32_t word = static_cast<int32_t>(granule / BITS_OF_UINT64);
+    const uint32_t bit = granule % BITS_OF_UINT64;
+    uint64_t bits = startBitmap_[word] & ((bit == (BITS_OF_UINT64 - 1U)) ? UINT64_MAX : ((1ULL << (bit + 1U)) - 1ULL));
+    while (bits == 0ULL) {
+        word--;
+        if (word < 0) {
+            return MEMORY_LIST_INVALID_IDX;
         }
+        bits = startBitmap_[word];
     }
-    delete node->block;
-    delete node;
+    return static_cast<uint16_t>((static_cast<uint32_t>(word) * BITS_OF_UINT64) + HighestBit(bits));
 }
 
-// 查看地址是否在链表中存储
+// 查看地址是否在空闲块中
 bool MemoryList::ContainsAddress(void* address) const
 {
-    ListNode* current = head_;
-
-    while (current != nullptr) {
-        // 使用指针比较来检查地址是否在当前内存块范围内
-        int8_t* blockStart = static_cast<int8_t*>(current->block->address);
-        int8_t* blockEnd = blockStart + current->block->size;
-
-        if (address >= blockStart && address < blockEnd) {
-            return true; // 找到地址
-        }
-        current = current->next;
+    if (!IsValidAddress(address)) {
+        return false;
     }
+    const size_t offset = static_cast<size_t>(static_cast<uint8_t*>(address) - baseAddr_);
+    const uint16_t head = FindBlockHead(static_cast<uint16_t>(offset / MEMORY_LIST_GRANULE_SIZE));
+    return (head != MEMORY_LIST_INVALID_IDX) && blockFree_[head];
+}
 
-    return false; // 没有找到地址
+void MemoryList::GetStat(MemoryListStat& stat) const
+{
+    stat.totalSize = static_cast<size_t>(granuleNum_) * MEMORY_LIST_GRANULE_SIZE;
+    stat.usedSize = usedSize_;
+    stat.highWaterMark = highWaterMark_;
+    stat.freeBlockNum = freeBlockNum_;
+    stat.usedBlockNum = usedBlockNum_;
+    stat.largestFreeBlock = 0U;
+    if (summaryBitmap_ != 0ULL) {
+        const uint32_t word = HighestBit(summaryBitmap_);
+        const uint32_t cls = (word * BITS_OF_UINT64) + HighestBit(freeBitmap_[word]);
+        stat.largestFreeBlock = static_cast<size_t>(cls + 1U) * MEMORY_LIST_GRANULE_SIZE;
+    }
 }
 } // namespace runtime
 } // namespace cce
@@ -16,36 +16,87 @@
 
 namespace cce {
 namespace runtime {
+// 内存块的最小管理粒度，与 kernel 内存 4K 对齐（POOL_ALIGN_SIZE）保持一致
+constexpr size_t MEMORY_LIST_GRANULE_SIZE = 4096U;
+// 单个链表可管理的最大粒度数（2M / 4K）
+constexpr uint32_t MEMORY_LIST_MAX_GRANULE_NUM = 512U;
+constexpr uint32_t MEMORY_LIST_BITMAP_NUM = MEMORY_LIST_MAX_GRANULE_NUM / 64U; // 64:bit of uint64_t
+constexpr uint16_t MEMORY_LIST_INVALID_IDX = 0xFFFFU;
 
-// 内存块结构体
-struct MemoryBlock {
-    void* address; // 指向内存块的起始地址
-    size_t size;   // 内存块的大小
-};
-
-// 链表节点结构体
-struct ListNode {
-    MemoryBlock* block; // 指向内存块结构体的指针
-    ListNode* next;     // 指向下一个节点的指针
+// 内存块统计信息
+struct MemoryListStat {
+    size_t totalSize = 0U;        // 管理的内存总大小
+    size_t usedSize = 0U;         // 已分配的内存大小
+    size_t highWaterMark = 0U;    // 已分配内存的历史峰值
+    size_t largestFreeBlock = 0U; // 最大空闲块大小
+    uint32_t freeBlockNum = 0U;   // 空闲块数量
+    uint32_t usedBlockNum = 0U;   // 已分配块数量
 };
 
+/*
+ * 按粒度分级的空闲块管理（segregated fit）：
+ * 每个空闲块按其粒度数挂在对应的空闲链表上，两级位图记录非空链表，
+ * 分配时通过位扫描找到不小于申请大小的最小空闲块（best fit），释放时借助边界标记立即与相邻空闲块合并，
+ * 分配与释放均为 O(1)。元数据全部保存在 host 侧数组中，不访问 device 内存，也不会按块申请堆内存。
+ */
 class MemoryList : public NoCopy {
 public:
     explicit MemoryList();
 
     ~MemoryList() noexcept override;
-    // 调用前确定是否需要加锁保护
-    rtError_t AddBlock(void* address, size_t size);
+    // 初始化管理的内存区间，size 不超过 MEMORY_LIST_MAX_GRANULE_NUM 个粒度
+    rtError_t Init(void* address, size_t size);
+    // 调用前确定是否需要加锁保护；归还 GetBlock 分配的内存块，返回实际归还的大小，非法地址返回 0
+    size_t AddBlock(void* address, size_t size);
     // 调用前确定是否需要加锁保护
     void* GetBlock(size_t size);
-    // 查看地址是否在链表中存储
+    // 查看地址是否在空闲块中
     bool ContainsAddress(void* address) const;
+    // 获取统计信息，调用前确定是否需要加锁保护
+    void GetStat(MemoryListStat& stat) const;
+
+    size_t GetUsedSize() const
+    {
+        return usedSize_;
+    }
+
+    // 按管理粒度对齐后的实际分配大小
+    static size_t AlignSize(size_t size)
+    {
+        return static_cast<size_t>(SizeToGranule(size)) * MEMORY_LIST_GRANULE_SIZE;
+    }
 
 private:
-    void RemoveNode(ListNode* node);
+    static uint32_t SizeToGranule(size_t size);
+    void InsertFreeBlock(uint16_t start, uint16_t granuleNum);
+    void RemoveFreeBlock(uint16_t start);
+    uint16_t FindFreeBlock(uint32_t granuleNum) const;
+    void SetBlock(uint16_t start, uint16_t granuleNum, bool isFree);
+    void ClearBlock(uint16_t start);
+    uint16_t FindBlockHead(uint16_t granule) const;
+    bool IsValidAddress(const void* address) const;
+
+    uint8_t* baseAddr_ = nullptr;
+    uint32_t granuleNum_ = 0U;
+    size_t usedSize_ = 0U;
+    size_t highWaterMark_ = 0U;
+    uint32_t usedBlockNum_ = 0U;
+    uint32_t freeBlockNum_ = 0U;
 
-    ListNode* head_ = nullptr;
-    ListNode* tail_ = nullptr;
+    // 第一级位图：bit i 表示 freeBitmap_[i] 非空
+    uint64_t summaryBitmap_ = 0ULL;
+    // 第二级位图：bit n 表示粒度数为 n + 1 的空闲链表非空
+    uint64_t freeBitmap_[MEMORY_LIST_BITMAP_NUM] = {};
+    // bit g 表示粒度 g 是某个块（空闲或已分配）的块首，用于查找任意地址所属的块
+    uint64_t startBitmap_[MEMORY_LIST_BITMAP_NUM] = {};
+    // 按粒度数分级的空闲链表头
+    uint16_t freeHead_[MEMORY_LIST_MAX_GRANULE_NUM];
+    // 以下数组均以块起始粒度下标索引，仅在块首（blockSize_ 与 freeNext_/freePrev_）或块尾（blockHead_）有效
+    uint16_t freeNext_[MEMORY_LIST_MAX_GRANULE_NUM];
+    uint16_t freePrev_[MEMORY_LIST_MAX_GRANULE_NUM];
+    uint16_t blockSize_[MEMORY_LIST_MAX_GRANULE_NUM] = {}; // 块的粒度数，0 表示非块首
+    uint16_t blockHead_[MEMORY_LIST_MAX_GRANULE_NUM];      // 边界标记：块尾指向块首
+    bool blockFree_[MEMORY_LIST_MAX_GRANULE_NUM] = {};
 };
 } // namespace runtime
 } // namespace cce
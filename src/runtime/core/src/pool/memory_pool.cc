@@ -14,7 +14,7 @@ namespace cce {
 namespace runtime {
 
 MemoryPool::MemoryPool(Device* dev, const bool isReadOnly)
-    : NoCopy(), device_(dev), driver_(dev->Driver_()), usedSize_(0), isReadOnly_(isReadOnly)
+    : NoCopy(), device_(dev), driver_(dev->Driver_()), isReadOnly_(isReadOnly)
 {}
 
 MemoryPool::~MemoryPool() noexcept
@@ -31,7 +31,7 @@ MemoryPool::~MemoryPool() noexcept
     driver_ = nullptr;
 }
 
-size_t MemoryPool::GetUsedSize() const { return usedSize_; }
+size_t MemoryPool::GetUsedSize() const { return usedSize_.load(std::memory_order_relaxed); }
 
 const void* MemoryPool::GetAddr() const { return addr_; }
 
@@ -46,46 +46,77 @@ rtError_t MemoryPool::Init()
     COND_RETURN_AND_MSG_OUTER(
         memoryList_ == nullptr, RT_ERROR_MEMORY_ALLOCATION, ErrorCode::EE1013,
         std::to_string(sizeof(MemoryList)).c_str(), "new");
-    return memoryList_->AddBlock(addr_, POOL_SIZE_2M);
+    return memoryList_->Init(addr_, POOL_SIZE_2M);
 }
 
 // 分配内存
 void* MemoryPool::Allocate(size_t size)
 {
-    // 从链表中获取一个符合要求的内存块
+    // 快速判断，避免已满的池参与锁竞争
+    if (usedSize_.load(std::memory_order_relaxed) + size > POOL_SIZE_2M) {
+        return nullptr;
+    }
+    const std::lock_guard<std::mutex> lock(mutex_);
+    // 从空闲块中获取一个符合要求的内存块
     void* addr = memoryList_->GetBlock(size);
     if (addr != nullptr) {
-        usedSize_ += size;
+        usedSize_.store(memoryList_->GetUsedSize(), std::memory_order_relaxed);
     }
     return addr;
 }
 
 // 释放内存
-void MemoryPool::Release(void* address, size_t size)
+size_t MemoryPool::Release(void* address, size_t size)
 {
-    // 将释放的内存块重新添加到链表中
-    memoryList_->AddBlock(address, size);
-    if (usedSize_ >= size) {
-        usedSize_ -= size;
-    } else {
-        RT_LOG(RT_LOG_EVENT, "release memory size[%lu] beyond the used memory size[%lu]!", size, usedSize_);
-        usedSize_ = 0;
+    const std::lock_guard<std::mutex> lock(mutex_);
+    // 将释放的内存块归还并与相邻空闲块合并
+    const size_t releaseSize = memoryList_->AddBlock(address, size);
+    if (releaseSize == 0U) {
+        RT_LOG(
+            RT_LOG_EVENT, "release memory addr=%p size[%lu] is not an allocated block, used size[%lu]!", address, size,
+            memoryList_->GetUsedSize());
     }
+    usedSize_.store(memoryList_->GetUsedSize(), std::memory_order_relaxed);
+    return releaseSize;
 }
 
-// 检查指针是否在内存池范围内
-bool MemoryPool::Contains(void* ptr) const
+bool MemoryPool::TryRelease(void* ptr, size_t size, size_t& releaseSize)
 {
-    if (usedSize_ == 0) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if ((!InRange(ptr)) || (memoryList_->GetUsedSize() == 0U) || memoryList_->ContainsAddress(ptr)) {
         return false;
     }
+    releaseSize = memoryList_->AddBlock(ptr, size);
+    if (releaseSize == 0U) {
+        RT_LOG(
+            RT_LOG_EVENT, "release memory addr=%p size[%lu] is not an allocated block, used size[%lu]!", ptr, size,
+            memoryList_->GetUsedSize());
+    }
+    usedSize_.store(memoryList_->GetUsedSize(), std::memory_order_relaxed);
+    return true;
+}
 
-    if (memoryList_->ContainsAddress(ptr)) {
+// 检查指针是否在内存池已分配的内存中
+bool MemoryPool::Contains(void* ptr) const
+{
+    if ((!InRange(ptr)) || (usedSize_.load(std::memory_order_relaxed) == 0U)) {
         return false;
     }
 
-    return (static_cast<int8_t*>(ptr) >= static_cast<int8_t*>(addr_)) &&
-           (static_cast<int8_t*>(ptr) < (static_cast<int8_t*>(addr_) + POOL_SIZE_2M));
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return !memoryList_->ContainsAddress(ptr);
+}
+
+bool MemoryPool::InRange(const void* ptr) const
+{
+    return (static_cast<const int8_t*>(ptr) >= static_cast<const int8_t*>(addr_)) &&
+           (static_cast<const int8_t*>(ptr) < (static_cast<const int8_t*>(addr_) + POOL_SIZE_2M));
+}
+
+void MemoryPool::GetStat(MemoryListStat& stat) const
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    memoryList_->GetStat(stat);
 }
 
 void* MemoryPool::AllocDevMem(const uint32_t size) const
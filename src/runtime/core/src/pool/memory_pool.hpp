@@ -10,6 +10,7 @@
 #ifndef CCE_RUNTIME_MEMORY_POOL_HPP
 #define CCE_RUNTIME_MEMORY_POOL_HPP
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include "base.hpp"
@@ -30,17 +31,26 @@ public:
     // 申请device内存
     void* AllocDevMem(const uint32_t size) const;
 
-    // 分配内存
+    // 分配内存（内部持池锁）
     void* Allocate(size_t size);
 
-    // 释放内存
-    void Release(void* address, size_t size);
+    // 释放内存（内部持池锁），返回实际归还的大小
+    size_t Release(void* address, size_t size);
 
-    // 检查指针是否在内存池范围内
+    // 原子化的 Contains + Release（内部持池锁）：ptr 属于本池已分配内存时释放并返回 true
+    bool TryRelease(void* ptr, size_t size, size_t& releaseSize);
+
+    // 检查指针是否在内存池已分配的内存中（内部持池锁）
     bool Contains(void* ptr) const;
 
+    // 检查指针是否在内存池地址区间内，不加锁
+    bool InRange(const void* ptr) const;
+
     size_t GetUsedSize() const;
 
+    // 获取内存池的使用量、峰值及最大空闲块等统计信息
+    void GetStat(MemoryListStat& stat) const;
+
     bool GetReadOnlyFlag() const;
 
     const void* GetAddr() const;
@@ -48,7 +58,7 @@ public:
     std::mutex* GetMemoryPoolAdviseMutex();
 
 private:
-    // 内存块链表
+    // 空闲块管理
     MemoryList* memoryList_ = nullptr;
 
     // 内存池起始地址
@@ -56,10 +66,12 @@ private:
 
     Device* device_ = nullptr;
     Driver* driver_ = nullptr;
-    // 已使用的内存大小
-    size_t usedSize_ = 0U;
+    // 已使用的内存大小，池锁内修改，可无锁读取
+    std::atomic<size_t> usedSize_{0U};
     bool isReadOnly_ = false;
 
+    // 池锁：保护 memoryList_，不同内存池的分配释放互不阻塞
+    mutable std::mutex mutex_;
     std::mutex mutexAdviseMem_;
 };
 } // namespace runtime
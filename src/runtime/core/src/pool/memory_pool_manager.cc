@@ -17,6 +17,14 @@
 
 namespace cce {
 namespace runtime {
+namespace {
+constexpr uint32_t POOL_INDEX_SHIFT = 21U; // 2M 槽
+
+inline uintptr_t PoolIndexSlot(const void* ptr)
+{
+    return RtPtrToValue(ptr) >> POOL_INDEX_SHIFT;
+}
+} // namespace
 
 MemoryPoolManager::MemoryPoolManager(Device* dev, int32_t initialPoolsNum)
     : NoCopy(), device_(dev), driver_(dev->Driver_()), numPools_(initialPoolsNum)
@@ -31,6 +39,7 @@ MemoryPoolManager::~MemoryPoolManager() noexcept
     device_ = nullptr;
     RT_LOG(RT_LOG_DEBUG, "~MemoryPoolManager release device memory, size=%u.", pools_.size());
     TIMESTAMP_BEGIN(ReleaseMemoryPoolManager);
+    poolIndex_.clear();
     for (auto pool : pools_) {
         if (pool != nullptr) {
             delete pool;
@@ -55,10 +64,12 @@ rtError_t MemoryPoolManager::Init()
             error != RT_ERROR_NONE, MEMORY_POOL_FREE, error, RT_ERROR_MEMORY_ALLOCATION,
             "Failed to allocate device memory.");
         pools_.push_back(mPool);
+        IndexPool(mPool);
     }
     return error;
 MEMORY_POOL_FREE:
     DELETE_O(mPool);
+    poolIndex_.clear();
     for (auto pool : pools_) {
         DELETE_O(pool);
     }
@@ -66,17 +77,14 @@ MEMORY_POOL_FREE:
     return error;
 }
 
-void* MemoryPoolManager::Allocate(const size_t size, const bool readOnly)
+void* MemoryPoolManager::AllocateFromPools(const size_t size, const bool readOnly)
 {
-    // 超出2M
-    if (size == 0 || (size > POOL_SIZE_2M)) {
-        return nullptr;
-    }
-    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // 调用者必须已持有 mutex_ 读锁或写锁，池内分配由池锁保护
     for (auto pool : pools_) {
         if (readOnly == pool->GetReadOnlyFlag()) {
             void* block = pool->Allocate(size);
             if (block != nullptr) {
+                AddUsedSize(MemoryList::AlignSize(size));
                 RT_LOG(
                     RT_LOG_DEBUG, "drv devId=%u, alloc size=%u, pool=%#" PRIx64 ", addr=%#" PRIx64 ", readOnly=%d.",
                     device_->Id_(), size, pool, pool->GetAddr(), readOnly);
@@ -84,56 +92,105 @@ void* MemoryPoolManager::Allocate(const size_t size, const bool readOnly)
             }
         }
     }
+    return nullptr;
+}
+
+void* MemoryPoolManager::Allocate(const size_t size, const bool readOnly)
+{
+    // 超出2M
+    if (size == 0 || (size > POOL_SIZE_2M)) {
+        return nullptr;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        void* block = AllocateFromPools(size, readOnly);
+        if (block != nullptr) {
+            return block;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // 释放读锁到获取写锁期间其他线程可能已新建内存池或释放了内存，先重试一次
+    void* block = AllocateFromPools(size, readOnly);
+    if (block != nullptr) {
+        return block;
+    }
 
     // 没有可用的内存池，创建一个新的内存池
     const rtError_t error = AddMemoryPool(readOnly);
     if (error != RT_ERROR_NONE) {
         return nullptr;
     }
-    return pools_.back()->Allocate(size); // 使用刚刚添加的池
+    block = pools_.back()->Allocate(size); // 使用刚刚添加的池
+    if (block != nullptr) {
+        AddUsedSize(MemoryList::AlignSize(size));
+    }
+    return block;
+}
+
+MemoryPool* MemoryPoolManager::FindPool(void* ptr) const
+{
+    // 调用者必须已持有 mutex_ 读锁或写锁
+    const auto range = poolIndex_.equal_range(PoolIndexSlot(ptr));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->Contains(ptr)) {
+            return it->second;
+        }
+    }
+    return nullptr;
+}
+
+MemoryPool* MemoryPoolManager::ReleaseToPool(void* ptr, size_t size)
+{
+    // 调用者必须已持有 mutex_ 读锁，Contains + Release 在池锁内原子完成
+    const auto range = poolIndex_.equal_range(PoolIndexSlot(ptr));
+    for (auto it = range.first; it != range.second; ++it) {
+        size_t releaseSize = 0U;
+        if (it->second->TryRelease(ptr, size, releaseSize)) {
+            SubUsedSize(releaseSize);
+            return it->second;
+        }
+    }
+    return nullptr;
 }
 
 TIMESTAMP_EXTERN(MemoryPoolManagerRelease);
 void MemoryPoolManager::Release(void* ptr, size_t size)
 {
     TIMESTAMP_BEGIN(MemoryPoolManagerRelease);
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    for (auto pool : pools_) {
-        if (pool->Contains(ptr)) {
-            pool->Release(ptr, size);
-            RT_LOG(RT_LOG_DEBUG, "release device memory, ptr=%#" PRIx64 ", size=%u.", ptr, size);
-            CheckAndReleasePools();
-            TIMESTAMP_END(MemoryPoolManagerRelease);
-            return;
-        }
-    }
+    (void)TryRelease(ptr, size);
     TIMESTAMP_END(MemoryPoolManagerRelease);
 }
 
 bool MemoryPoolManager::TryRelease(void* ptr, size_t size)
 {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    for (auto pool : pools_) {
-        if (pool->Contains(ptr)) {
-            pool->Release(ptr, size);
-            RT_LOG(RT_LOG_DEBUG, "TryRelease device memory, ptr=%#" PRIx64 ", size=%u.", ptr, size);
-            CheckAndReleasePools();
-            return true;
+    bool needCheck = false;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        const MemoryPool* pool = ReleaseToPool(ptr, size);
+        if (pool == nullptr) {
+            return false;
         }
+        RT_LOG(RT_LOG_DEBUG, "TryRelease device memory, ptr=%#" PRIx64 ", size=%u.", ptr, size);
+        // 只有池变为空闲时才可能需要回收内存池
+        needCheck = (pool->GetUsedSize() == 0U);
     }
-    return false;
+    if (needCheck) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        CheckAndReleasePools();
+    }
+    return true;
 }
 
 PoolMemInfo MemoryPoolManager::GetPoolMemInfo(void* ptr)
 {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    for (MemoryPool* pool : pools_) {
-        if (pool->Contains(ptr)) {
-            RT_LOG(
-                RT_LOG_DEBUG, "GetPoolMemInfo device_id=%u, pool=%#" PRIx64 ", addr=%#" PRIx64 ", ptr=%#" PRIx64,
-                device_->Id_(), pool, pool->GetAddr(), ptr);
-            return {pool->GetAddr(), pool->GetMemoryPoolAdviseMutex(), true};
-        }
+    MemoryPool* pool = FindPool(ptr);
+    if (pool != nullptr) {
+        RT_LOG(
+            RT_LOG_DEBUG, "GetPoolMemInfo device_id=%u, pool=%#" PRIx64 ", addr=%#" PRIx64 ", ptr=%#" PRIx64,
+            device_->Id_(), pool, pool->GetAddr(), ptr);
+        return {pool->GetAddr(), pool->GetMemoryPoolAdviseMutex(), true};
     }
     RT_LOG(RT_LOG_DEBUG, "GetPoolMemInfo not found, device_id=%u, ptr=%#" PRIx64, device_->Id_(), ptr);
     return {nullptr, nullptr, false};
@@ -152,6 +209,7 @@ rtError_t MemoryPoolManager::AddMemoryPool(const bool readOnly)
         error != RT_ERROR_NONE, MEMORY_POOL_FREE, error, RT_ERROR_MEMORY_ALLOCATION,
         "Failed to allocate device memory.");
     pools_.push_back(pool);
+    IndexPool(pool);
     ++numPools_;
     return RT_ERROR_NONE;
 MEMORY_POOL_FREE:
@@ -162,12 +220,35 @@ MEMORY_POOL_FREE:
 bool MemoryPoolManager::Contains(void* ptr)
 {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    for (auto pool : pools_) {
-        if (pool->Contains(ptr)) {
-            return true;
+    return FindPool(ptr) != nullptr;
+}
+
+void MemoryPoolManager::IndexPool(MemoryPool* pool)
+{
+    // 调用者必须已持有 mutex_ 写锁
+    const uint8_t* addr = static_cast<const uint8_t*>(pool->GetAddr());
+    const uintptr_t firstSlot = PoolIndexSlot(addr);
+    const uintptr_t lastSlot = PoolIndexSlot(addr + POOL_SIZE_2M - 1U);
+    for (uintptr_t slot = firstSlot; slot <= lastSlot; ++slot) {
+        poolIndex_.emplace(slot, pool);
+    }
+}
+
+void MemoryPoolManager::UnindexPool(const MemoryPool* pool)
+{
+    // 调用者必须已持有 mutex_ 写锁
+    const uint8_t* addr = static_cast<const uint8_t*>(pool->GetAddr());
+    const uintptr_t firstSlot = PoolIndexSlot(addr);
+    const uintptr_t lastSlot = PoolIndexSlot(addr + POOL_SIZE_2M - 1U);
+    for (uintptr_t slot = firstSlot; slot <= lastSlot; ++slot) {
+        const auto range = poolIndex_.equal_range(slot);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == pool) {
+                (void)poolIndex_.erase(it);
+                break;
+            }
         }
     }
-    return false;
 }
 
 void MemoryPoolManager::CheckAndReleasePools()
@@ -187,6 +268,7 @@ void MemoryPoolManager::CheckAndReleasePools()
         auto it = pools_.cbegin();
         while ((it != pools_.cend()) && (freePoolCount > maxFreePools_)) {
             if ((*it)->GetUsedSize() == 0) {
+                UnindexPool(*it);
                 delete *it;
                 it = pools_.erase(it); // 从 deque 中移除并释放内存池
                 --freePoolCount;
@@ -200,16 +282,53 @@ void MemoryPoolManager::CheckAndReleasePools()
     }
 }
 
+void MemoryPoolManager::AddUsedSize(const size_t size)
+{
+    const size_t usedSize = usedSize_.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t highWaterMark = highWaterMark_.load(std::memory_order_relaxed);
+    while ((usedSize > highWaterMark) &&
+           (!highWaterMark_.compare_exchange_weak(highWaterMark, usedSize, std::memory_order_relaxed))) {
+    }
+}
+
+void MemoryPoolManager::SubUsedSize(const size_t size)
+{
+    size_t usedSize = usedSize_.load(std::memory_order_relaxed);
+    while (!usedSize_.compare_exchange_weak(
+        usedSize, (usedSize >= size) ? (usedSize - size) : 0U, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryPoolManager::GetStat(MemoryPoolStat& stat) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    stat = MemoryPoolStat();
+    size_t freeSize = 0U;
+    MemoryListStat poolStat;
+    for (const MemoryPool* pool : pools_) {
+        pool->GetStat(poolStat);
+        stat.totalSize += poolStat.totalSize;
+        freeSize += poolStat.totalSize - poolStat.usedSize;
+        stat.freeBlockNum += poolStat.freeBlockNum;
+        stat.largestFreeBlock = std::max(stat.largestFreeBlock, poolStat.largestFreeBlock);
+    }
+    stat.poolNum = static_cast<uint32_t>(pools_.size());
+    stat.usedSize = usedSize_.load(std::memory_order_relaxed);
+    stat.highWaterMark = highWaterMark_.load(std::memory_order_relaxed);
+    if (freeSize != 0U) {
+        stat.fragmentation = 1.0 - (static_cast<double>(stat.largestFreeBlock) / static_cast<double>(freeSize));
+    }
+}
+
 std::mutex* MemoryPoolManager::GetMemoryPoolAdviseMutex(void* ptr)
 {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    for (MemoryPool* pool : pools_) {
-        if (pool->Contains(ptr)) {
-            RT_LOG(
-                RT_LOG_DEBUG, "drv device_id=%u, pool=%#" PRIx64 ", addr=%#" PRIx64 ", ptr=%#" PRIx64 "",
-                device_->Id_(), pool, pool->GetAddr(), ptr);
-            return pool->GetMemoryPoolAdviseMutex();
-        }
+    MemoryPool* pool = FindPool(ptr);
+    if (pool != nullptr) {
+        RT_LOG(
+            RT_LOG_DEBUG, "drv device_id=%u, pool=%#" PRIx64 ", addr=%#" PRIx64 ", ptr=%#" PRIx64 "", device_->Id_(),
+            pool, pool->GetAddr(), ptr);
+        return pool->GetMemoryPoolAdviseMutex();
     }
 
     RT_LOG(RT_LOG_DEBUG, "drv device_id=%u, ptr=%#" PRIx64 "", device_->Id_(), ptr);
@@ -219,13 +338,12 @@ std::mutex* MemoryPoolManager::GetMemoryPoolAdviseMutex(void* ptr)
 const void* MemoryPoolManager::GetMemoryPoolBaseAddr(void* ptr)
 {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    for (MemoryPool* pool : pools_) {
-        if (pool->Contains(ptr)) {
-            RT_LOG(
-                RT_LOG_DEBUG, "drv device_id=%u, pool=%#" PRIx64 ", addr=%#" PRIx64 ", ptr=%#" PRIx64 "",
-                device_->Id_(), pool, pool->GetAddr(), ptr);
-            return pool->GetAddr();
-        }
+    const MemoryPool* pool = FindPool(ptr);
+    if (pool != nullptr) {
+        RT_LOG(
+            RT_LOG_DEBUG, "drv device_id=%u, pool=%#" PRIx64 ", addr=%#" PRIx64 ", ptr=%#" PRIx64 "", device_->Id_(),
+            pool, pool->GetAddr(), ptr);
+        return pool->GetAddr();
     }
 
     RT_LOG(RT_LOG_DEBUG, "drv device_id=%u, ptr=%#" PRIx64 "", device_->Id_(), ptr);
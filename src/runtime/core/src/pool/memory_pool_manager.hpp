@@ -10,9 +10,11 @@
 #ifndef CCE_RUNTIME_MEMORY_POOL_MANAGER_HPP
 #define CCE_RUNTIME_MEMORY_POOL_MANAGER_HPP
 
+#include <atomic>
 #include <deque>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
 #include "base.hpp"
 
 namespace cce {
@@ -28,6 +30,17 @@ struct PoolMemInfo {
     bool found = false;
 };
 
+// 内存池管理统计信息，fragmentation = 1 - 最大空闲块 / 空闲总量，取值 [0, 1]，越大碎片越严重
+struct MemoryPoolStat {
+    uint32_t poolNum = 0U;
+    size_t totalSize = 0U;
+    size_t usedSize = 0U;
+    size_t highWaterMark = 0U;
+    size_t largestFreeBlock = 0U;
+    uint32_t freeBlockNum = 0U;
+    double fragmentation = 0.0;
+};
+
 class MemoryPoolManager : public NoCopy {
 public:
     explicit MemoryPoolManager(Device* dev, int32_t initialPoolsNum = 1);
@@ -39,7 +52,7 @@ public:
     // 从内存池中分配内存，如果没有空闲池则创建一个新池
     void* Allocate(const size_t size, const bool readOnly);
 
-    // 释放内存回到相应的内存池（内部持写锁，原子操作）
+    // 释放内存回到相应的内存池（持读锁定位内存池，持池锁释放，仅在池变为空闲时持写锁回收）
     void Release(void* ptr, size_t size);
 
     // 原子化的 Contains + Release：找到则释放并返回 true，否则返回 false
@@ -55,6 +68,9 @@ public:
     std::mutex* GetMemoryPoolAdviseMutex(void* ptr);
     const void* GetMemoryPoolBaseAddr(void* ptr);
 
+    // 查询所有内存池的使用量、峰值及碎片率
+    void GetStat(MemoryPoolStat& stat) const;
+
 private:
     // 创建一个新的内存池并增加池的数量（调用者必须持有 mutex_ 写锁）
     rtError_t AddMemoryPool(const bool readOnly);
@@ -62,14 +78,35 @@ private:
     // 检查并释放空闲池（调用者必须持有 mutex_ 写锁）
     void CheckAndReleasePools();
 
+    // 从已有内存池中分配（调用者必须持有 mutex_ 读锁或写锁）
+    void* AllocateFromPools(const size_t size, const bool readOnly);
+
+    // 在地址索引中查找并释放 ptr 所在的内存池（调用者必须持有 mutex_ 读锁），返回所在池，未找到返回 nullptr
+    MemoryPool* ReleaseToPool(void* ptr, size_t size);
+
+    // 在地址索引中查找 ptr 所属的内存池（调用者必须持有 mutex_ 读锁或写锁）
+    MemoryPool* FindPool(void* ptr) const;
+
+    // 维护地址索引（调用者必须持有 mutex_ 写锁）
+    void IndexPool(MemoryPool* pool);
+    void UnindexPool(const MemoryPool* pool);
+
+    void AddUsedSize(const size_t size);
+    void SubUsedSize(const size_t size);
+
     // 使用 deque 而非 vector：push_back 不会使已有元素的指针/引用失效
     // 即使 vector realloc 导致迭代器失效的并发遍历场景，deque 的指针稳定性也能避免悬空
     std::deque<MemoryPool*> pools_;
-    mutable std::shared_mutex mutex_; // 读写锁：读操作 shared_lock，写操作 unique_lock
+    // 读写锁：分配、释放、查询持 shared_lock，仅增删内存池时持 unique_lock；池内数据由各池自己的锁保护
+    mutable std::shared_mutex mutex_;
+    // 地址索引：以 2M 槽号（addr >> 21）为键，每个池按其起止地址登记在至多两个槽中，按地址 O(1) 定位所属池
+    std::unordered_multimap<uintptr_t, MemoryPool*> poolIndex_;
     Device* device_ = nullptr;
     Driver* driver_ = nullptr;
     int32_t numPools_ = 0;     // 当前内存池的数量
     int32_t maxFreePools_ = 5; // 空闲池数量
+    std::atomic<size_t> usedSize_{0U};      // 所有内存池已分配的内存大小
+    std::atomic<size_t> highWaterMark_{0U}; // 已分配内存的历史峰值
 };
 } // namespace runtime
 } // namespace cce
@@ -9,6 +9,7 @@
  */
 #include "npu_driver_record.hpp"
 #include "profiler.hpp"
+#include "profile_record_ring.hpp"
 #include "runtime.hpp"
 
 namespace cce {
@@ -32,22 +33,11 @@ NpuDriverRecord::NpuDriverRecord(const uint16_t opType)
     return;
 }
 
-void NpuDriverRecord::PrintRecord(const rtProfileRecordSyncDrv_t& recordSyncDrv) const
-{
-    RT_LOG(
-        RT_LOG_INFO,
-        "DrvApiCall: RecordType=%hu OperationType=%hu"
-        " pid=%u tid=%u seq=%u start=%" PRIu64 " end=%" PRIu64 "",
-        recordSyncDrv.type, recordSyncDrv.drvOpType, recordSyncDrv.pid, recordSyncDrv.tid, recordSyncDrv.seqId,
-        recordSyncDrv.startStamp, recordSyncDrv.endStamp);
-    return;
-}
-
 void NpuDriverRecord::SaveRecord()
 {
     if (needSave_) {
         record_.endStamp = GetTickCount();
-        PrintRecord(record_);
+        ProfileRecordRing::Push(record_);
     }
     return;
 }
@@ -21,7 +21,6 @@ public:
     void SaveRecord();
 
 private:
-    void PrintRecord(const rtProfileRecordSyncDrv_t& recordSyncDrv) const;
     bool needSave_;
     rtProfileRecordSyncDrv_t record_{};
 };
@@ -9,6 +9,7 @@
  */
 #include "profile_log_record.hpp"
 #include "profiler.hpp"
+#include "profile_record_ring.hpp"
 
 namespace cce {
 namespace runtime {
@@ -25,24 +26,14 @@ ProfileLogRecord::ProfileLogRecord(const uint16_t recordType, const uint16_t opT
 }
 
 ProfileLogRecord::ProfileLogRecord(const uint16_t opType, const Profiler* const profilerInfo)
+    : ProfileLogRecord(PROFILE_RECORD_TYPE_RT_CALL_RT, opType, profilerInfo)
 {
-    ProfileLogRecord(PROFILE_RECORD_TYPE_RT_CALL_RT, opType, profilerInfo);
-}
-
-void ProfileLogRecord::PrintRecord(const rtProfileRecordSyncRt_t& recordSyncRt) const
-{
-    RT_LOG(
-        RT_LOG_INFO,
-        "RtApiCall: RecordType=%hu OperationType=%hu"
-        " pid=%u tid=%u seq=%u start=%" PRIu64 " end=%" PRIu64 "",
-        recordSyncRt.type, recordSyncRt.rtOpType, recordSyncRt.pid, recordSyncRt.tid, recordSyncRt.seqId,
-        recordSyncRt.startStamp, recordSyncRt.endStamp);
 }
 
 void ProfileLogRecord::SaveRecord()
 {
     record_.endStamp = GetTickCount();
-    PrintRecord(record_);
+    ProfileRecordRing::Push(record_);
     return;
 }
 
@@ -24,7 +24,6 @@ public:
     void SaveRecord();
 
 private:
-    void PrintRecord(const rtProfileRecordSyncRt_t& recordSyncRt) const;
     rtProfileRecordSyncRt_t record_{};
 };
 } // namespace runtime
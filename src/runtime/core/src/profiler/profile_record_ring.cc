@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include "profile_record_ring.hpp"
+#include <mutex>
+#include "securec.h"
+#include "error_message_manage.hpp"
+
+namespace cce {
+namespace runtime {
+namespace {
+constexpr uint32_t PROFILE_RECORD_RING_MASK = PROFILE_RECORD_RING_DEPTH - 1U;
+static_assert((PROFILE_RECORD_RING_DEPTH & PROFILE_RECORD_RING_MASK) == 0U, "depth must be power of 2");
+static_assert(sizeof(ProfileRecordEntry) <= MSPROF_COMPACT_INFO_DATA_LENGTH, "record must fit in compact info");
+
+// Single producer ring. The owner thread is the only producer; the consumer side is guarded by draining,
+// so either the owner or FlushAll drains it. A ring is handed over to a new thread when its owner exits.
+struct ProfileRecordRingNode {
+    ProfileRecordEntry entries[PROFILE_RECORD_RING_DEPTH];
+    std::atomic<uint32_t> head{0U};
+    std::atomic<uint32_t> tail{0U};
+    std::atomic<bool> draining{false};
+    bool inUse{true};
+    std::atomic<uint64_t> dropCount{0ULL};
+    ProfileRecordRingNode* next{nullptr};
+};
+
+std::mutex g_ringListMutex;
+ProfileRecordRingNode* g_ringList = nullptr;
+
+std::atomic<uint64_t> g_opCount[PROFILE_RECORD_OP_TYPE_NUM];
+std::atomic<uint64_t> g_opTotalNs[PROFILE_RECORD_OP_TYPE_NUM];
+std::atomic<uint64_t> g_opMaxNs[PROFILE_RECORD_OP_TYPE_NUM];
+
+ProfileRecordRingNode* AcquireRing()
+{
+    const std::unique_lock<std::mutex> lock(g_ringListMutex);
+    for (ProfileRecordRingNode* node = g_ringList; node != nullptr; node = node->next) {
+        if (!node->inUse) {
+            node->inUse = true;
+            return node;
+        }
+    }
+    ProfileRecordRingNode* const node = new (std::nothrow) ProfileRecordRingNode();
+    if (node == nullptr) {
+        return nullptr;
+    }
+    node->next = g_ringList;
+    g_ringList = node;
+    return node;
+}
+
+void ReleaseRing(ProfileRecordRingNode* const node)
+{
+    const std::unique_lock<std::mutex> lock(g_ringListMutex);
+    node->inUse = false;
+}
+
+class ProfileRecordRingHolder {
+public:
+    ProfileRecordRingHolder() = default;
+    ~ProfileRecordRingHolder()
+    {
+        // keep the records, they are drained by the next owner or FlushAll
+        if (node_ != nullptr) {
+            ReleaseRing(node_);
+        }
+    }
+
+    ProfileRecordRingNode* Get()
+    {
+        if (unlikely(node_ == nullptr)) {
+            node_ = AcquireRing();
+        }
+        return node_;
+    }
+
+private:
+    ProfileRecordRingNode* node_{nullptr};
+};
+
+void AccumulateOpStat(const rtProfileRecordSyncRt_t& record)
+{
+    if (record.rtOpType >= PROFILE_RECORD_OP_TYPE_NUM) {
+        return;
+    }
+    const uint64_t costNs = (record.endStamp > record.startStamp) ? (record.endStamp - record.startStamp) : 0ULL;
+    (void)g_opCount[record.rtOpType].fetch_add(1ULL, std::memory_order_relaxed);
+    (void)g_opTotalNs[record.rtOpType].fetch_add(costNs, std::memory_order_relaxed);
+    uint64_t curMax = g_opMaxNs[record.rtOpType].load(std::memory_order_relaxed);
+    while ((costNs > curMax) &&
+           !g_opMaxNs[record.rtOpType].compare_exchange_weak(curMax, costNs, std::memory_order_relaxed)) {
+    }
+}
+
+void ReportRecord(const ProfileRecordEntry& entry)
+{
+    MsprofCompactInfo compactInfo{};
+    compactInfo.level = MSPROF_REPORT_RUNTIME_LEVEL;
+    compactInfo.type = RT_PROFILE_TYPE_RT_CALL_RECORD;
+    compactInfo.timeStamp = entry.sysCycle;
+    compactInfo.threadId = entry.record.tid;
+    compactInfo.dataLen = static_cast<uint32_t>(sizeof(ProfileRecordEntry));
+    (void)memcpy_s(compactInfo.data.info, sizeof(compactInfo.data.info), &entry, sizeof(ProfileRecordEntry));
+    const int32_t ret = MsprofReportCompactInfo(true, &compactInfo, static_cast<uint32_t>(sizeof(MsprofCompactInfo)));
+    if (ret != MSPROF_ERROR_NONE) {
+        RT_LOG(RT_LOG_WARNING, "Failed to report profile record, type=%hu, opType=%hu, retCode=%d.",
+            entry.record.type, entry.record.rtOpType, ret);
+    }
+}
+
+void Drain(ProfileRecordRingNode* const node)
+{
+    bool expected = false;
+    if (!node->draining.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return;
+    }
+    uint32_t head = node->head.load(std::memory_order_relaxed);
+    const uint32_t tail = node->tail.load(std::memory_order_acquire);
+    for (; head != tail; head++) {
+        const ProfileRecordEntry& entry = node->entries[head & PROFILE_RECORD_RING_MASK];
+        AccumulateOpStat(entry.record);
+        ReportRecord(entry);
+    }
+    node->head.store(head, std::memory_order_release);
+    node->draining.store(false, std::memory_order_release);
+}
+} // namespace
+
+void ProfileRecordRing::Push(const rtProfileRecordSyncRt_t& record)
+{
+    static thread_local ProfileRecordRingHolder holder;
+    ProfileRecordRingNode* const node = holder.Get();
+    if (unlikely(node == nullptr)) {
+        return;
+    }
+    const uint32_t tail = node->tail.load(std::memory_order_relaxed);
+    const uint32_t head = node->head.load(std::memory_order_acquire);
+    if (unlikely((tail - head) >= PROFILE_RECORD_RING_DEPTH)) {
+        // FlushAll is draining the ring right now
+        (void)node->dropCount.fetch_add(1ULL, std::memory_order_relaxed);
+        return;
+    }
+    ProfileRecordEntry& entry = node->entries[tail & PROFILE_RECORD_RING_MASK];
+    entry.record = record;
+    entry.sysCycle = MsprofSysCycleTime();
+    node->tail.store(tail + 1U, std::memory_order_release);
+    if ((tail + 1U - head) >= PROFILE_RECORD_RING_DRAIN_WATERMARK) {
+        Drain(node);
+    }
+}
+
+void ProfileRecordRing::Push(const rtProfileRecordSyncDrv_t& record)
+{
+    static_assert(sizeof(rtProfileRecordSyncDrv_t) == sizeof(rtProfileRecordSyncRt_t), "record layout mismatch");
+    rtProfileRecordSyncRt_t recordRt;
+    recordRt.type = record.type;
+    recordRt.rtOpType = record.drvOpType;
+    recordRt.pid = record.pid;
+    recordRt.tid = record.tid;
+    recordRt.seqId = record.seqId;
+    recordRt.startStamp = record.startStamp;
+    recordRt.endStamp = record.endStamp;
+    Push(recordRt);
+}
+
+void ProfileRecordRing::FlushAll()
+{
+    const std::unique_lock<std::mutex> lock(g_ringListMutex);
+    for (ProfileRecordRingNode* node = g_ringList; node != nullptr; node = node->next) {
+        Drain(node);
+    }
+}
+
+bool ProfileRecordRing::GetOpStat(const uint16_t opType, ProfileRecordOpStat& stat)
+{
+    if (opType >= PROFILE_RECORD_OP_TYPE_NUM) {
+        return false;
+    }
+    stat.count = g_opCount[opType].load(std::memory_order_relaxed);
+    stat.totalNs = g_opTotalNs[opType].load(std::memory_order_relaxed);
+    stat.maxNs = g_opMaxNs[opType].load(std::memory_order_relaxed);
+    return stat.count != 0ULL;
+}
+
+void ProfileRecordRing::DumpOpStat()
+{
+    FlushAll();
+    uint64_t dropCount = 0ULL;
+    {
+        const std::unique_lock<std::mutex> lock(g_ringListMutex);
+        for (const ProfileRecordRingNode* node = g_ringList; node != nullptr; node = node->next) {
+            dropCount += node->dropCount.load(std::memory_order_relaxed);
+        }
+    }
+    for (uint32_t i = 0U; i < PROFILE_RECORD_OP_TYPE_NUM; i++) {
+        ProfileRecordOpStat stat = {};
+        if (!GetOpStat(static_cast<uint16_t>(i), stat)) {
+            continue;
+        }
+        RT_LOG(RT_LOG_EVENT, "profile record stat: opType=%u, count=%" PRIu64 ", total=%" PRIu64 "ns, avg=%" PRIu64
+            "ns, max=%" PRIu64 "ns", i, stat.count, stat.totalNs, stat.totalNs / stat.count, stat.maxNs);
+    }
+    RT_LOG(RT_LOG_EVENT, "profile record dropped=%" PRIu64 ".", dropCount);
+}
+
+void ProfileRecordRing::ResetOpStat()
+{
+    for (uint32_t i = 0U; i < PROFILE_RECORD_OP_TYPE_NUM; i++) {
+        g_opCount[i].store(0ULL, std::memory_order_relaxed);
+        g_opTotalNs[i].store(0ULL, std::memory_order_relaxed);
+        g_opMaxNs[i].store(0ULL, std::memory_order_relaxed);
+    }
+    const std::unique_lock<std::mutex> lock(g_ringListMutex);
+    for (ProfileRecordRingNode* node = g_ringList; node != nullptr; node = node->next) {
+        node->dropCount.store(0ULL, std::memory_order_relaxed);
+    }
+}
+} // namespace runtime
+} // namespace cce
@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#ifndef CCE_RUNTIME_PROFILE_RECORD_RING_HPP
+#define CCE_RUNTIME_PROFILE_RECORD_RING_HPP
+
+#include <atomic>
+#include "profiler_struct.hpp"
+
+namespace cce {
+namespace runtime {
+constexpr uint32_t PROFILE_RECORD_RING_DEPTH = 256U;           // must be power of 2
+constexpr uint32_t PROFILE_RECORD_RING_DRAIN_WATERMARK = 128U; // the owner thread drains in bulk from here
+constexpr uint32_t PROFILE_RECORD_OP_TYPE_NUM = 256U;          // rtProfApiType_t and rtDrvOperationType_t
+
+// RT_CALL_RT and RT_CALL_DRV records share the layout of rtProfileRecordSyncRt_t
+struct ProfileRecordEntry {
+    rtProfileRecordSyncRt_t record;
+    uint64_t sysCycle;
+};
+
+struct ProfileRecordOpStat {
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+};
+
+// Fixed-size binary records of runtime api calls and driver calls, collected when profile log is enabled.
+// Every thread owns a single producer ring, records are reported to msprof as RT_PROFILE_TYPE_RT_CALL_RECORD in
+// bulk, by the owner thread itself when the ring passes the watermark, or by FlushAll for all threads.
+// Per op type count / total / max time is accumulated while draining.
+class ProfileRecordRing {
+public:
+    static void Push(const rtProfileRecordSyncRt_t& record);
+    static void Push(const rtProfileRecordSyncDrv_t& record);
+    static void FlushAll();
+    static bool GetOpStat(const uint16_t opType, ProfileRecordOpStat& stat);
+    static void DumpOpStat();
+    static void ResetOpStat();
+};
+} // namespace runtime
+} // namespace cce
+
+#endif // CCE_RUNTIME_PROFILE_RECORD_RING_HPP
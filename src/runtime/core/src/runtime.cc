@@ -12,6 +12,9 @@
 #include <fstream>
 #include <algorithm>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "mmpa/mmpa_api.h"
 #include "driver/ascend_hal.h"
 #include "api_impl.hpp"
@@ -30,6 +33,7 @@
 #include "driver.hpp"
 #include "subscribe.hpp"
 #include "base.hpp"
+#include "latency_stat.hpp"
 #include "device_state_callback_manager.hpp"
 #include "prof_ctrl_callback_manager.hpp"
 #include "errcode_manage.hpp"
@@ -39,6 +43,7 @@
 #include "inner_thread_local.hpp"
 #include "prof_api.h"
 #include "profiling_agent.hpp"
+#include "profile_record_ring.hpp"
 #include "task_submit.hpp"
 #include "atrace_log.hpp"
 #include "platform/platform_info.h"
@@ -1568,6 +1573,7 @@ rtError_t Runtime::Init()
 
     InitNpuCollectPath();
     InitStreamSyncMode();
+    LatencyStatManager::Instance().InitFromEnv();
 
     FindDcacheLockOp();
 
@@ -3494,6 +3500,7 @@ rtError_t Runtime::RuntimeProfileLogStart(const uint64_t profConfig, const int32
     if ((profileLogType_ & PROF_RUNTIME_PROFILE_LOG_MASK) == 0ULL) { // disabled
         apiError_->SetImpl(const_cast<Api*>(impl));
         profileLogType_ |= PROF_RUNTIME_PROFILE_LOG_MASK;
+        ProfileRecordRing::ResetOpStat();
         profiler_->SetProfLogEnable(true);
         RT_LOG(RT_LOG_INFO, "Start");
     } else {
@@ -3519,6 +3526,8 @@ rtError_t Runtime::RuntimeProfileLogStop(
         profiler_->SetProfLogEnable(false);
         apiError_->SetImpl(apiImpl_);
         profileLogType_ &= (~(PROF_RUNTIME_PROFILE_LOG_MASK));
+        // report what is left in the rings of all threads
+        ProfileRecordRing::DumpOpStat();
         RT_LOG(RT_LOG_INFO, "Stop");
     } else {
         RT_LOG(RT_LOG_WARNING, "api profile log not enabled");
@@ -5193,10 +5202,62 @@ rtError_t Runtime::GetElfOffset(void* const elfData, const uint32_t elfLen, uint
 }
 
 // 调用方保证binFileName路径是realpath标准化之后的路径
+namespace {
+// Kernel binaries at least this large are read with read(2) into an uninitialized buffer instead of through ifstream.
+constexpr uint64_t KERNEL_BIN_READ_THRESHOLD = 256ULL * 1024ULL;
+
+/*
+ * Read the kernel binary into a buffer sized by fstat on the same fd, so the file is read once without seeking
+ * and the buffer is not zero-filled first. A file truncated meanwhile gives a short read and the buffer is
+ * dropped. Return false to fall back to ifstream.
+ */
+bool ReadKernelBinFile(const char_t* const binFileName, char_t** const buffer, uint64_t* const length)
+{
+    const int32_t fd = open(binFileName, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st = {};
+    if ((fstat(fd, &st) != 0) || (!S_ISREG(st.st_mode)) ||
+        (static_cast<uint64_t>(st.st_size) < KERNEL_BIN_READ_THRESHOLD)) {
+        (void)close(fd);
+        return false;
+    }
+    const size_t fileLen = static_cast<size_t>(st.st_size);
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    char_t* data = new (std::nothrow) char_t[fileLen];
+    size_t readLen = 0U;
+    while ((data != nullptr) && (readLen < fileLen)) {
+        const ssize_t ret = read(fd, data + readLen, fileLen - readLen);
+        if ((ret < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (ret <= 0) {
+            RT_LOG(RT_LOG_WARNING, "Read kernel binary %s failed, read=%zu, len=%zu, errno=%d.", binFileName,
+                readLen, fileLen, errno);
+            DELETE_A(data);
+            break;
+        }
+        readLen += static_cast<size_t>(ret);
+    }
+    (void)close(fd);
+    if (data == nullptr) {
+        return false;
+    }
+    *buffer = data;
+    *length = static_cast<uint64_t>(fileLen);
+    RT_LOG(RT_LOG_INFO, "Read kernel binary %s, len=%" PRIu64 ".", binFileName, *length);
+    return true;
+}
+} // namespace
+
 rtError_t Runtime::GetKernelBinByFileName(
     const char_t* const binFileName, char_t** const buffer, uint64_t* length) const
 {
     *length = 0U;
+    if (ReadKernelBinFile(binFileName, buffer, length)) {
+        return RT_ERROR_NONE;
+    }
     std::ifstream file(binFileName, std::ios::binary | std::ios::in);
     COND_RETURN_ERROR_MSG_INNER(
         !file.is_open(), RT_ERROR_INVALID_VALUE, "File %s does not exist or is inaccessible. errno=%d, reason=%s.",
@@ -29,6 +29,7 @@
 #include "driver.hpp"
 #include "subscribe.hpp"
 #include "base.hpp"
+#include "latency_stat.hpp"
 #include "device_state_callback_manager.hpp"
 #include "prof_ctrl_callback_manager.hpp"
 #include "errcode_manage.hpp"
@@ -60,6 +61,7 @@ Runtime::~Runtime()
     if (hasRuntimeExitHostState) {
         PrepareProcessExitNoThrow();
     }
+    LatencyStatManager::Instance().Stop();
 
     // Runtime direct-exit must not unload libtsdclient.so: its global destructors
     // can enter TSD/HDC/driver close paths while lower modules are also exiting.
@@ -19,6 +19,7 @@
 #include "runtime.hpp"
 #include "context.hpp"
 #include "group_device.hpp"
+#include "raw_device.hpp"
 #include "event.hpp"
 #include "api.hpp"
 #include "npu_driver.hpp"
@@ -89,6 +90,17 @@ __THREAD_LOCAL__ bool Stream::isNeedStreamAsyncRecycle_ = false;
 constexpr uint64_t TASK_SENDING_WAIT_CHECK_TIME = 840000U;
 constexpr uint16_t TASK_SENDING_WAIT_CHECK_COUNT = 2U;
 constexpr uint16_t SQE_DEPTH_1k = 1024U;
+constexpr uint64_t SYNC_WAIT_SPIN_US = 5ULL;              // spin time of one wait round
+constexpr uint64_t SYNC_WAIT_SPIN_THRESHOLD_US = 100ULL;  // adaptive mode spins when the task is expected sooner
+constexpr uint64_t SYNC_WAIT_PARK_MIN_US = 20ULL;
+constexpr uint64_t SYNC_WAIT_PARK_MAX_US = 1000ULL;
+constexpr uint64_t SYNC_WAIT_SAMPLE_GAP_US = 2000ULL;     // no wait for longer than this, progress is not learned
+constexpr uint32_t SYNC_WAIT_SAMPLE_ID_SHIFT = 48U;
+constexpr uint64_t SYNC_WAIT_SAMPLE_TIME_MASK = (1ULL << SYNC_WAIT_SAMPLE_ID_SHIFT) - 1ULL;
+constexpr uint64_t SYNC_WAIT_US_TO_NS = 1000ULL;
+constexpr uint64_t SYNC_WAIT_TASK_TIME_WEIGHT = 8ULL;     // new sample weighs 1/8 in the learned task time
+constexpr uint64_t SYNC_WAIT_UNTRAINED_PARK_TASK_NUM = 10ULL;
+constexpr uint64_t SYNC_WAIT_UNTRAINED_PARK_US = 50ULL;
 Stream::Stream(Device* const dev, const uint32_t prio) : Stream(dev, prio, 0U) {}
 
 Stream::Stream(Device* const dev, const uint32_t prio, const uint32_t stmFlags, DvppGrp* const dvppGrp)
@@ -1432,6 +1444,20 @@ rtError_t Stream::TearDown(const bool terminal, bool flag)
     if (fusioning_) {
         RT_LOG(RT_LOG_WARNING, "fusion is not match, stream_id=%d", stmId);
     }
+    if (submitBatch_.maxTaskNum > 1U) {
+        // send the held back kernels and stop the engine from tracking this stream
+        (void)SetSubmitBatchSize(0U);
+    }
+    StreamWaitStat waitStat = {};
+    waitPolicy_.GetStat(waitStat);
+    if ((waitStat.spinNum != 0ULL) || (waitStat.parkNum != 0ULL)) {
+        RT_LOG(
+            RT_LOG_INFO,
+            "stream_id=%d, sync wait mode=%u, spin=%" PRIu64 ", park=%" PRIu64 ", notified=%" PRIu64
+            ", poll=%" PRIu64 ", wakeup latency total=%" PRIu64 "us, max=%" PRIu64 "us, task time=%" PRIu64 "ns.",
+            stmId, waitPolicy_.GetMode(), waitStat.spinNum, waitStat.parkNum, waitStat.notifiedNum,
+            waitStat.pollNum, waitStat.wakeupLatencySumUs, waitStat.wakeupLatencyMaxUs, waitStat.taskTimeNs);
+    }
     const bool starsFlag = dev->IsStarsPlatform();
     if (Runtime::IsProcessExiting(rt)) {
         WaitAsyncRecycleThreadOnTearDown(starsFlag);
@@ -1920,28 +1946,172 @@ bool Stream::IsTaskExcuted(const uint32_t executeEndTaskid, const uint32_t taskI
     return TASK_ID_GEQ(executeEndTaskid, taskId);
 }
 
-bool Stream::SynchronizeDelayTime(const uint16_t finishedId, const uint16_t taskId)
+void StreamWaitPolicy::Learn(const uint16_t finishedId, const uint64_t nowUs)
 {
-    constexpr uint16_t LARGER_THRESHOLD = 10U;
-    constexpr uint16_t SLEEP_UNIT = 5U;
-    constexpr uint16_t perSchedYield = 100U;
-    uint16_t exeTaskId = (finishedId == MAX_UINT16_NUM) ? executeEndTaskid_.Value() : finishedId;
-    if (TASK_ID_LEQ(TASK_ID_ADD(exeTaskId, LARGER_THRESHOLD), taskId)) {
-        std::this_thread::sleep_for(std::chrono::microseconds(LARGER_THRESHOLD * SLEEP_UNIT));
-    } else if (TASK_ID_LEQ(TASK_ID_ADD(exeTaskId, 1U), taskId)) {
-        uint32_t tryCount = 0U;
-        const uint64_t beginTime = GetWallUs();
-        while (GetWallUs() - beginTime < SLEEP_UNIT) {
-            if (TASK_ID_GEQ(executeEndTaskid_.Value(), taskId)) {
-                return true;
-            }
-            tryCount++;
-            if (tryCount % perSchedYield == 0) {
-                std::this_thread::yield();
-            }
+    const uint64_t lastWaitUs = lastWaitUs_.exchange(nowUs, std::memory_order_relaxed);
+    const uint64_t last = lastSample_.load(std::memory_order_relaxed);
+    const uint16_t lastId = static_cast<uint16_t>(last >> SYNC_WAIT_SAMPLE_ID_SHIFT);
+    const bool isContinuous = (last != 0ULL) && ((nowUs - lastWaitUs) <= SYNC_WAIT_SAMPLE_GAP_US);
+    if (isContinuous && (lastId == finishedId)) {
+        return;
+    }
+    lastSample_.store(
+        (static_cast<uint64_t>(finishedId) << SYNC_WAIT_SAMPLE_ID_SHIFT) | (nowUs & SYNC_WAIT_SAMPLE_TIME_MASK),
+        std::memory_order_relaxed);
+    // the device may have run while nobody was waiting, such a sample says nothing about the task time
+    if ((!isContinuous) || (!TASK_ID_LT(lastId, finishedId))) {
+        return;
+    }
+    const uint64_t lastUs = last & SYNC_WAIT_SAMPLE_TIME_MASK;
+    const uint64_t elapsedNs = (((nowUs & SYNC_WAIT_SAMPLE_TIME_MASK) > lastUs) ?
+        ((nowUs & SYNC_WAIT_SAMPLE_TIME_MASK) - lastUs) : 0ULL) * SYNC_WAIT_US_TO_NS;
+    const uint64_t sampleNs = elapsedNs / static_cast<uint64_t>(TASK_ID_SUB(finishedId, lastId));
+    const uint64_t oldNs = taskTimeNs_.load(std::memory_order_relaxed);
+    const uint64_t newNs = (oldNs == 0ULL) ? sampleNs :
+        ((oldNs * (SYNC_WAIT_TASK_TIME_WEIGHT - 1ULL)) + sampleNs) / SYNC_WAIT_TASK_TIME_WEIGHT;
+    taskTimeNs_.store(std::max(newNs, static_cast<uint64_t>(1U)), std::memory_order_relaxed);
+}
+
+uint64_t StreamWaitPolicy::NowUs() const
+{
+    return (clock_ != nullptr) ? clock_() : ClockGetTimeUs();
+}
+
+bool StreamWaitPolicy::Spin(const std::function<bool()>& isDone, StreamWaitStat& local) const
+{
+    constexpr uint32_t perSchedYield = 100U;
+    local.spinNum++;
+    if (!isDone) {
+        // the caller polls the device itself
+        return false;
+    }
+    uint32_t tryCount = 0U;
+    bool done = false;
+    const uint64_t beginTime = ClockGetTimeUs();
+    while ((!done) && (ClockGetTimeIntervalUs(beginTime) < SYNC_WAIT_SPIN_US)) {
+        done = isDone();
+        tryCount++;
+        if ((tryCount % perSchedYield) == 0U) {
+            std::this_thread::yield();
         }
     }
-    return false;
+    local.pollNum += tryCount;
+    return done;
+}
+
+bool StreamWaitPolicy::Park(const uint64_t timeUs, const std::function<bool()>& isDone, StreamWaitStat& local)
+{
+    local.parkNum++;
+    std::unique_lock<std::mutex> parkLock(parkMutex_);
+    (void)parkedNum_.fetch_add(1U, std::memory_order_relaxed);
+    // pairs with the fence in Notify: either we see the new execute end task id, or the notifier sees us parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool done = isDone && isDone();
+    uint64_t pollNum = isDone ? 1ULL : 0ULL;
+    if (!done) {
+        const uint64_t seq = notifySeq_;
+        const uint64_t deadline = ClockGetTimeUs() + timeUs;
+        const bool notified = parkCond_.wait_for(
+            parkLock, std::chrono::microseconds(timeUs), [this, seq]() { return notifySeq_ != seq; });
+        const uint64_t now = ClockGetTimeUs();
+        const uint64_t wakeTime = notified ? notifyTimeUs_ : deadline;
+        const uint64_t latency = (now > wakeTime) ? (now - wakeTime) : 0ULL;
+        COND_PROC(notified, local.notifiedNum++);
+        local.wakeupLatencySumUs += latency;
+        local.wakeupLatencyMaxUs = std::max(local.wakeupLatencyMaxUs, latency);
+        done = isDone && isDone();
+        pollNum += isDone ? 1ULL : 0ULL;
+    }
+    (void)parkedNum_.fetch_sub(1U, std::memory_order_relaxed);
+    local.pollNum += pollNum;
+    return done;
+}
+
+void StreamWaitPolicy::Publish(const StreamWaitStat& local)
+{
+    COND_PROC(local.spinNum != 0ULL, (void)spinNum_.fetch_add(local.spinNum, std::memory_order_relaxed));
+    COND_PROC(local.pollNum != 0ULL, (void)pollNum_.fetch_add(local.pollNum, std::memory_order_relaxed));
+    if (local.parkNum == 0ULL) {
+        return;
+    }
+    (void)parkNum_.fetch_add(local.parkNum, std::memory_order_relaxed);
+    COND_PROC(local.notifiedNum != 0ULL, (void)notifiedNum_.fetch_add(local.notifiedNum, std::memory_order_relaxed));
+    (void)wakeupLatencySumUs_.fetch_add(local.wakeupLatencySumUs, std::memory_order_relaxed);
+    uint64_t maxLatency = wakeupLatencyMaxUs_.load(std::memory_order_relaxed);
+    while ((local.wakeupLatencyMaxUs > maxLatency) &&
+           (!wakeupLatencyMaxUs_.compare_exchange_weak(
+               maxLatency, local.wakeupLatencyMaxUs, std::memory_order_relaxed))) {
+    }
+}
+
+bool StreamWaitPolicy::Wait(const uint16_t finishedId, const uint16_t taskId, const std::function<bool()>& isDone)
+{
+    uint64_t remainTaskNum = 1ULL;
+    if (finishedId != MAX_UINT16_NUM) {
+        Learn(finishedId, NowUs());
+        remainTaskNum = TASK_ID_LT(finishedId, taskId) ? static_cast<uint64_t>(TASK_ID_SUB(taskId, finishedId)) : 0ULL;
+    }
+    if (remainTaskNum == 0ULL) {
+        return isDone && isDone();
+    }
+
+    const uint64_t taskTimeNs = taskTimeNs_.load(std::memory_order_relaxed);
+    const uint64_t expectUs = (remainTaskNum * taskTimeNs) / SYNC_WAIT_US_TO_NS;
+    const uint64_t parkUs = std::min(std::max(expectUs / 2U, SYNC_WAIT_PARK_MIN_US), SYNC_WAIT_PARK_MAX_US);
+    StreamWaitStat local = {};
+    bool done = false;
+    switch (GetMode()) {
+        case RT_STREAM_SYNC_WAIT_LOW_LATENCY:
+            done = Spin(isDone, local);
+            break;
+        case RT_STREAM_SYNC_WAIT_LOW_CPU:
+            done = Park((taskTimeNs == 0ULL) ? SYNC_WAIT_PARK_MAX_US : parkUs, isDone, local);
+            break;
+        default:
+            if (taskTimeNs == 0ULL) {
+                // nothing learned yet, keep the fixed policy: sleep 50us when 10 or more tasks are pending
+                done = (remainTaskNum >= SYNC_WAIT_UNTRAINED_PARK_TASK_NUM) ?
+                    Park(SYNC_WAIT_UNTRAINED_PARK_US, isDone, local) : Spin(isDone, local);
+            } else {
+                done = (expectUs <= SYNC_WAIT_SPIN_THRESHOLD_US) ? Spin(isDone, local) : Park(parkUs, isDone, local);
+            }
+            break;
+    }
+    Publish(local);
+    return done;
+}
+
+void StreamWaitPolicy::Notify()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parkedNum_.load(std::memory_order_relaxed) == 0U) {
+        return;
+    }
+    const std::lock_guard<std::mutex> parkLock(parkMutex_);
+    notifySeq_++;
+    notifyTimeUs_ = ClockGetTimeUs();
+    parkCond_.notify_all();
+}
+
+void StreamWaitPolicy::GetStat(StreamWaitStat& stat) const
+{
+    stat.spinNum = spinNum_.load(std::memory_order_relaxed);
+    stat.parkNum = parkNum_.load(std::memory_order_relaxed);
+    stat.notifiedNum = notifiedNum_.load(std::memory_order_relaxed);
+    stat.pollNum = pollNum_.load(std::memory_order_relaxed);
+    stat.wakeupLatencySumUs = wakeupLatencySumUs_.load(std::memory_order_relaxed);
+    stat.wakeupLatencyMaxUs = wakeupLatencyMaxUs_.load(std::memory_order_relaxed);
+    stat.taskTimeNs = taskTimeNs_.load(std::memory_order_relaxed);
+}
+
+bool Stream::SynchronizeDelayTime(const uint16_t finishedId, const uint16_t taskId)
+{
+    const uint16_t exeTaskId = (finishedId == MAX_UINT16_NUM) ? executeEndTaskid_.Value() : finishedId;
+    if (!TASK_ID_LT(exeTaskId, taskId)) {
+        return false;
+    }
+    return waitPolicy_.Wait(
+        exeTaskId, taskId, [this, taskId]() -> bool { return TASK_ID_GEQ(executeEndTaskid_.Value(), taskId); });
 }
 
 rtError_t Stream::SynchronizeExecutedTask(const uint32_t taskId, const mmTimespec& beginTime, int32_t timeout)
@@ -2051,9 +2221,28 @@ rtError_t Stream::SynchronizeImpl(const uint32_t syncTaskId, const uint16_t conc
     return error;
 }
 
+rtError_t Stream::SetSubmitBatchSize(const uint32_t batchSize)
+{
+    Engine* const engine = RtPtrToPtr<RawDevice*>(device_)->Engine_();
+    NULL_PTR_RETURN_MSG(engine, RT_ERROR_FEATURE_NOT_SUPPORT);
+    return engine->SetSubmitBatch(this, batchSize);
+}
+
+rtError_t Stream::FlushBatchedTask()
+{
+    // nothing can be held back when batched submission is off, skip the stream lock
+    if (submitBatch_.maxTaskNum <= 1U) {
+        return RT_ERROR_NONE;
+    }
+    Engine* const engine = RtPtrToPtr<RawDevice*>(device_)->Engine_();
+    NULL_PTR_RETURN_MSG(engine, RT_ERROR_NONE);
+    return engine->FlushBatchedTask(this);
+}
+
 rtError_t Stream::Synchronize(const bool isNeedWaitSyncCq, int32_t timeout)
 {
-    rtError_t error = RT_ERROR_NONE;
+    rtError_t error = FlushBatchedTask();
+    COND_RETURN_ERROR(error != RT_ERROR_NONE, error, "Failed to flush batched task, stream_id=%d.", streamId_);
     if (device_->IsStarsPlatform()) {
         if (!IsSeparateSendAndRecycle() || GetBindFlag()) {
             error = StarsWaitForTask(lastTaskId_, isNeedWaitSyncCq, timeout);
@@ -3019,8 +3208,8 @@ rtError_t Stream::WaitForTask(const uint32_t taskId, const bool isNeedWaitSyncCq
         error = CheckContextStatus(false);
         COND_RETURN_ERROR(error != RT_ERROR_NONE, error, "context is abort, status=%#x.", static_cast<int32_t>(error));
 
-        if ((currentId != UINT32_MAX) && TASK_ID_LT(TASK_ID_ADD(currentId, RT_SYNC_SLEEP_INTERVAL), taskId)) {
-            (void)mmSleep(1U);
+        if (currentId != UINT32_MAX) {
+            (void)waitPolicy_.Wait(static_cast<uint16_t>(currentId), static_cast<uint16_t>(taskId), nullptr);
         }
 
         tryCount++;
@@ -4088,8 +4277,8 @@ rtError_t Stream::StarsWaitForTask(const uint32_t taskId, const bool isNeedWaitS
         COND_RETURN_ERROR(
             errorCode != RT_ERROR_NONE, errorCode, "context is abort, status=%#x.", static_cast<uint32_t>(errorCode));
 
-        if ((currentId != UINT16_MAX) && TASK_ID_LT(TASK_ID_ADD(currentId, RT_SYNC_SLEEP_INTERVAL), taskId)) {
-            (void)mmSleep(1U);
+        if (currentId != UINT16_MAX) {
+            (void)waitPolicy_.Wait(static_cast<uint16_t>(currentId), static_cast<uint16_t>(taskId), nullptr);
         }
 
         tryCount++;
@@ -13,6 +13,9 @@
 #include <list>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <set>
 #include <fstream>
 #include <sstream>
@@ -98,6 +101,71 @@ struct RtTaskCqeStatus {
     bool isCqeArrived;
 };
 
+struct StreamWaitStat {
+    uint64_t spinNum;            // waits served by spinning
+    uint64_t parkNum;            // waits that slept
+    uint64_t notifiedNum;        // sleeps ended by the recycle path rather than by time out
+    uint64_t pollNum;            // checks of the execute end task id made while waiting
+    uint64_t wakeupLatencySumUs; // from notify (or sleep deadline) to the waiter running again
+    uint64_t wakeupLatencyMaxUs;
+    uint64_t taskTimeNs;         // learned time to complete one task
+};
+
+// Host wait used by stream synchronize. It learns the time one task of the stream takes from the progress seen by
+// earlier waits, spins when the waited task is expected soon and sleeps otherwise. A sleeper is woken early when
+// the recycle path advances the execute end task id.
+class StreamWaitPolicy {
+public:
+    using ClockFunc = uint64_t (*)();
+    // clock: time in us used to learn the task time, nullptr for the monotonic clock. Tests pass a fake one.
+    explicit StreamWaitPolicy(const ClockFunc clock = nullptr) : clock_(clock) {}
+
+    void SetMode(const uint32_t mode) { mode_.store(mode, std::memory_order_relaxed); }
+    uint32_t GetMode() const { return mode_.load(std::memory_order_relaxed); }
+
+    // finishedId: last finished task, MAX_UINT16_NUM if unknown. isDone: optional, re-checked while waiting.
+    // Return true when isDone turned true.
+    bool Wait(const uint16_t finishedId, const uint16_t taskId, const std::function<bool()>& isDone);
+    void Notify();
+    void GetStat(StreamWaitStat& stat) const;
+
+private:
+    uint64_t NowUs() const;
+    void Learn(const uint16_t finishedId, const uint64_t nowUs);
+    // Spin and Park count into local, Wait publishes it once
+    bool Spin(const std::function<bool()>& isDone, StreamWaitStat& local) const;
+    bool Park(const uint64_t timeUs, const std::function<bool()>& isDone, StreamWaitStat& local);
+    void Publish(const StreamWaitStat& local);
+
+    const ClockFunc clock_;
+    std::atomic<uint32_t> mode_{RT_STREAM_SYNC_WAIT_ADAPTIVE};
+    std::atomic<uint64_t> taskTimeNs_{0ULL};
+    std::atomic<uint64_t> lastSample_{0ULL}; // finished task id << 48 | time in us, 0: no sample
+    std::atomic<uint64_t> lastWaitUs_{0ULL};
+    std::atomic<uint32_t> parkedNum_{0U};
+    std::mutex parkMutex_;
+    std::condition_variable parkCond_;
+    uint64_t notifySeq_{0ULL};    // protected by parkMutex_
+    uint64_t notifyTimeUs_{0ULL}; // protected by parkMutex_
+
+    std::atomic<uint64_t> spinNum_{0ULL};
+    std::atomic<uint64_t> parkNum_{0ULL};
+    std::atomic<uint64_t> notifiedNum_{0ULL};
+    std::atomic<uint64_t> pollNum_{0ULL};
+    std::atomic<uint64_t> wakeupLatencySumUs_{0ULL};
+    std::atomic<uint64_t> wakeupLatencyMaxUs_{0ULL};
+};
+
+// Kernel SQEs held back by AllocTaskAndSendStars to be sent with one driver call, protected by the stream lock.
+struct StreamSubmitBatch {
+    uint32_t maxTaskNum = 0U; // 0 or 1: every task is sent at once
+    uint32_t taskNum = 0U;
+    uint32_t sqeNum = 0U;
+    uint64_t beginTime = 0ULL; // us
+    rtError_t error = RT_ERROR_NONE; // last failed send, reported by the next flush
+    std::vector<rtStarsSqe_t> sqes;
+};
+
 struct RtStarsRecordQueue {
     uint32_t* queue = nullptr;
     uint32_t size = 0U;
@@ -269,6 +337,14 @@ public:
     // Query state of event
     rtError_t Query(void) const;
 
+    // Send the kernels held back by batched submission, also report a batched send that failed since the last call.
+    rtError_t FlushBatchedTask();
+    rtError_t SetSubmitBatchSize(const uint32_t batchSize);
+    uint32_t GetSubmitBatchSize() const { return submitBatch_.maxTaskNum; }
+    StreamSubmitBatch& GetSubmitBatch() { return submitBatch_; }
+    StreamWaitPolicy& GetWaitPolicy() { return waitPolicy_; }
+    const StreamWaitPolicy& GetWaitPolicy() const { return waitPolicy_; }
+
     // end fuison kernels
     rtError_t KernelFusionEnd();
 
@@ -567,7 +643,11 @@ public:
 
     uint16_t GetRecycleEndTaskId() const { return recycleEndTaskId_.Value(); }
 
-    void SetExecuteEndTaskId(uint16_t taskId) { executeEndTaskid_.Set(taskId); }
+    void SetExecuteEndTaskId(uint16_t taskId)
+    {
+        executeEndTaskid_.Set(taskId);
+        waitPolicy_.Notify();
+    }
 
     uint16_t GetExecuteEndTaskId() const { return executeEndTaskid_.Value(); }
 
@@ -1121,6 +1201,8 @@ private:
         RT_STREAM_CAPTURE_STATUS_NONE};            // only for single-operator stream, not capture stream
     mutable uint32_t cacheOpInfoOriginSwitch_{0U}; // only record this stream switch status for rec: 0: false, 1:true
     mutable uint32_t cacheOpInfoSwitch_{0U};       // aclgraph stream status: 0: false, 1:true,
+    StreamSubmitBatch submitBatch_;
+    StreamWaitPolicy waitPolicy_;
     std::mutex captureLock_;                       // used to mutually exclusive alloc task between begin/end capture
     bool isOrigCaptureStream_{false};
     bool isLastLevelCaptureStream_{true};
@@ -432,6 +432,15 @@ rtError_t AllocTaskAndSendStars(TaskInfo* submitTask, Stream* stm, uint32_t* con
     COND_RETURN_ERROR_MSG_INNER(
         error != RT_ERROR_NONE, error, "Try recycle task failed, retCode=%#x.", static_cast<uint32_t>(error));
 
+    if (stm->GetLimitFlag() && (stm->GetSubmitBatchSize() > 1U)) {
+        // the device can not release the positions taken by held back SQEs until they are sent
+        stm->StreamLock();
+        error = engine->SendBatchedSqe(stm);
+        stm->StreamUnLock();
+        COND_RETURN_ERROR_MSG_INNER(
+            error != RT_ERROR_NONE, error, "Failed to flush batched task, stream_id=%d.", stm->Id_());
+    }
+
     while (stm->GetLimitFlag() && (!stm->GetRecycleFlag())) {
         TIMESTAMP_BEGIN(TaskSendLimitedV1);
         engine->SendingWaitProc(stm); // Send limited, need release complete task.
@@ -483,7 +492,10 @@ rtError_t AllocTaskAndSendStars(TaskInfo* submitTask, Stream* stm, uint32_t* con
                 "The number of pending tasks in the stream exceeds the limit");
             return RT_ERROR_STREAM_FULL;
         }
+        // held back kernels keep their task info until they are sent and finished
+        error = engine->SendBatchedSqe(stm);
         stm->StreamUnLock();
+        COND_RETURN_ERROR(error != RT_ERROR_NONE, error, "Failed to send batched task, stream_id=%d.", stm->Id_());
         stm->StarsStmDfxCheck(beginCnt, endCnt, checkCount);
         taskFactory->TryTaskReclaim(stm);
 
@@ -577,6 +589,27 @@ rtError_t AllocTaskAndSendStars(TaskInfo* submitTask, Stream* stm, uint32_t* con
         return error;
     }
 
+    if (engine->IsBatchableTask(stm, taskInfo)) {
+        error = engine->AppendBatchedSqe(stm, starsSqe, sendSqeNum);
+        if (error != RT_ERROR_NONE) {
+            stm->pendingNum_.Sub(1U);
+        }
+        stm->StreamUnLock();
+        RT_LOG(
+            RT_LOG_DEBUG, "device_id=%u, sq_id=%u, stream_id=%d, task_id=%hu, task_type=%u(%s) batched, retCode=%#x.",
+            devId, sqId, stm->Id_(), taskInfo->id, static_cast<uint32_t>(taskInfo->type), taskInfo->typeName,
+            static_cast<uint32_t>(error));
+        return error;
+    }
+    // keep the sq order, held back kernels go before this task
+    error = engine->SendBatchedSqe(stm);
+    if (error != RT_ERROR_NONE) {
+        stm->pendingNum_.Sub(1U);
+        stm->StreamUnLock();
+        RT_LOG(RT_LOG_ERROR, "Failed to send batched task, device_id=%u, stream_id=%d.", devId, stm->Id_());
+        return error;
+    }
+
     // 调用driver接口发送sqe
     TIMESTAMP_BEGIN(SqTaskSendNormalV1);
     if (!stm->IsSoftwareSqEnable()) {
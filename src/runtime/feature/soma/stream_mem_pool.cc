@@ -78,7 +78,8 @@ void Segment::MergeLeft()
 }
 
 SegmentManager::SegmentManager(Segment* seg, uint32_t deviceId, bool canDelete)
-    : tail_(seg),
+    : allocedSlotNum_(0U),
+      tail_(seg),
       base_(0U),
       size_(0U),
       busySize_(0U),
@@ -99,6 +100,7 @@ SegmentManager::SegmentManager(Segment* seg, uint32_t deviceId, bool canDelete)
         size_ = seg->size;
         seg->state = SegmentState::FREE;
         (void)freeSegs_.insert(seg);
+        InitAllocedSlots();
     }
 }
 
@@ -168,7 +170,7 @@ rtError_t SegmentManager::SegmentAlloc(Segment*& ret, uint64_t size, int streamI
 
         ret->state = SegmentState::BUSY;
         ret->streamId = streamId;
-        (void)allocedMap_.insert(std::make_pair(ret->basePtr, ret));
+        TrackAllocedSegment(ret);
         reserveSize_ += size;
         maxReservedSize_ = std::max(maxReservedSize_, reserveSize_);
     } else {
@@ -185,7 +187,7 @@ rtError_t SegmentManager::SegmentAlloc(Segment*& ret, uint64_t size, int streamI
             "Unable to alloc segments(size=%#" PRIx64 ") from segment(size=%#" PRIx64 ").", size, reuseSegment->size);
 
         ret->state = SegmentState::BUSY;
-        (void)allocedMap_.insert(std::make_pair(ret->basePtr, ret));
+        TrackAllocedSegment(ret);
         if (reuseSegment->basePtr != ret->basePtr) {
             (void)cachedSegs_.insert(reuseSegment);
         }
@@ -197,14 +199,17 @@ rtError_t SegmentManager::SegmentAlloc(Segment*& ret, uint64_t size, int streamI
 
 rtError_t SegmentManager::SegmentFree(uint64_t ptr, bool forceFree)
 {
+    Segment* seg = UntrackAllocedSegment(ptr);
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = allocedMap_.find(ptr);
-    COND_RETURN_ERROR(
-        it == allocedMap_.end(), RT_ERROR_POOL_PTR_NOTFOUND, "Unable to free ptr=%#" PRIx64 " from memPoolId=%#" PRIx64,
-        ptr, MemPoolId());
-    Segment* seg = it->second;
+    if (seg == nullptr) {
+        auto it = allocedMap_.find(ptr);
+        COND_RETURN_ERROR(
+            it == allocedMap_.end(), RT_ERROR_POOL_PTR_NOTFOUND,
+            "Unable to free ptr=%#" PRIx64 " from memPoolId=%#" PRIx64, ptr, MemPoolId());
+        seg = it->second;
+        (void)allocedMap_.erase(it);
+    }
     RT_LOG(RT_LOG_DEBUG, "Free segment ptr=%#" PRIx64 " size=%#" PRIx64 ".", seg->basePtr, seg->size);
-    (void)allocedMap_.erase(it);
     busySize_ -= seg->size;
     if (forceFree) {
         seg->state = SegmentState::FREE;
@@ -217,8 +222,64 @@ rtError_t SegmentManager::SegmentFree(uint64_t ptr, bool forceFree)
     return RT_ERROR_NONE;
 }
 
+void SegmentManager::InitAllocedSlots()
+{
+    allocedSlots_.reset();
+    allocedSlotNum_ = 0U;
+    // segments are only aligned to DEVICE_POOL_MIN_BLOCK_SIZE when the pool itself is
+    if ((size_ == 0U) || ((base_ % DEVICE_POOL_MIN_BLOCK_SIZE) != 0U) || ((size_ % DEVICE_POOL_MIN_BLOCK_SIZE) != 0U)) {
+        return;
+    }
+    const uint64_t slotNum = size_ / DEVICE_POOL_MIN_BLOCK_SIZE;
+    COND_RETURN_VOID_WARN(
+        slotNum > SOMA_ALLOCED_SLOT_MAX_NUM, "Pool is too large for alloced slots, memPoolID=%#" PRIx64 ".",
+        MemPoolId());
+    allocedSlots_.reset(new (std::nothrow) std::atomic<Segment*>[slotNum]);
+    COND_RETURN_VOID_WARN(
+        allocedSlots_ == nullptr, "Alloced slots disabled, memPoolID=%#" PRIx64 ": host out of memory.", MemPoolId());
+    for (uint64_t i = 0U; i < slotNum; i++) {
+        allocedSlots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    allocedSlotNum_ = slotNum;
+}
+
+bool SegmentManager::GetAllocedSlot(uint64_t ptr, uint64_t& slot) const
+{
+    if ((allocedSlotNum_ == 0U) || (ptr < base_) || (((ptr - base_) % DEVICE_POOL_MIN_BLOCK_SIZE) != 0U)) {
+        return false;
+    }
+    slot = (ptr - base_) / DEVICE_POOL_MIN_BLOCK_SIZE;
+    return slot < allocedSlotNum_;
+}
+
+void SegmentManager::TrackAllocedSegment(Segment* seg)
+{
+    uint64_t slot = 0U;
+    if (GetAllocedSlot(seg->basePtr, slot)) {
+        allocedSlots_[slot].store(seg, std::memory_order_release);
+        return;
+    }
+    (void)allocedMap_.insert(std::make_pair(seg->basePtr, seg));
+}
+
+Segment* SegmentManager::UntrackAllocedSegment(uint64_t ptr)
+{
+    uint64_t slot = 0U;
+    if (!GetAllocedSlot(ptr, slot)) {
+        return nullptr;
+    }
+    return allocedSlots_[slot].exchange(nullptr, std::memory_order_acq_rel);
+}
+
 uint64_t SegmentManager::GetAllocSize(uint64_t ptr)
 {
+    uint64_t slot = 0U;
+    if (GetAllocedSlot(ptr, slot)) {
+        const Segment* seg = allocedSlots_[slot].load(std::memory_order_acquire);
+        if (seg != nullptr) {
+            return seg->size;
+        }
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = allocedMap_.find(ptr);
     return (it != allocedMap_.end()) ? it->second->size : 0;
@@ -415,6 +476,7 @@ void SegmentManager::SetInitialSegment(Segment* seg)
     size_ = seg->size;
     seg->state = SegmentState::FREE;
     (void)freeSegs_.insert(seg);
+    InitAllocedSlots();
 }
 
 rtError_t SegmentManager::TrimTo(const uint64_t minBytesToKeep)
@@ -42,6 +42,7 @@ constexpr size_t HASH_GOLDEN_RATIO = 0x9E3779B9UL;
 constexpr size_t BYTES_PER_MB = 1024U * 1024U;
 constexpr int32_t INVALID_STREAM_ID = -1;
 constexpr int32_t INVALID_SEQ_ID = -1;
+constexpr uint64_t SOMA_ALLOCED_SLOT_MAX_NUM = (1UL << 20); // pools larger than 2 TB track segments in allocedMap_
 enum class SegmentState : uint8_t {
     FREE = 0,
     CACHED = 1,
@@ -145,6 +146,10 @@ public:
     void SetInitialSegment(Segment* seg);
 
 private:
+    void InitAllocedSlots();
+    bool GetAllocedSlot(uint64_t ptr, uint64_t& slot) const;
+    void TrackAllocedSegment(Segment* seg);
+    Segment* UntrackAllocedSegment(uint64_t ptr);
     void MergeIntoCachedSegs(Segment*& seg);
     bool CheckMergeRules(const Segment* segLeft, const Segment* segRight) const;
     Segment* AllocFromFreeSegs(uint64_t size);
@@ -155,6 +160,10 @@ private:
     std::unordered_map<uint64_t, Segment*> allocedMap_;
     std::set<Segment*, SegmentComparator> cachedSegs_;
     std::set<Segment*, SegmentComparator> freeSegs_;
+    // indexed by (basePtr - base_) / DEVICE_POOL_MIN_BLOCK_SIZE, free and GetAllocSize find aligned segments here
+    // without the lock, unaligned ones are kept in allocedMap_
+    std::unique_ptr<std::atomic<Segment*>[]> allocedSlots_;
+    uint64_t allocedSlotNum_;
 
     PoolDependencyFea state_;
     Segment* tail_;
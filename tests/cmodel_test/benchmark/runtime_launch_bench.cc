@@ -0,0 +1,636 @@
+/**
+ * Copyright (c) 2026 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Launch path microbenchmark on the cmodel runtime.
+// Every case is run with 1, 2, 4 ... --threads threads. Each op is timed on its own, the stream is synchronized
+// every --sync_interval ops outside of the timed region, and the results are written as json so that the hot path
+// can be tracked per commit:
+//   runtime_launch_bench --threads=8 --iterations=20000 --out=bench.json --tag=<commit>
+// The simulated device of the cmodel driver (CMODEL_DRV_SIM_DEVICE) is enabled unless it is set by the caller.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "runtime/rt.h"
+#include "runtime.hpp"
+#include "device.hpp"
+#include "memory_pool_manager.hpp"
+#include "buffer_allocator.hpp"
+
+namespace {
+using BenchClock = std::chrono::steady_clock;
+using cce::runtime::BufferAllocator;
+using cce::runtime::Device;
+using cce::runtime::MemoryPoolManager;
+using cce::runtime::Runtime;
+
+constexpr int32_t BENCH_DEVICE_ID = 0;
+constexpr uint16_t BENCH_MODULE_ID = 255U;
+constexpr uint64_t BENCH_COPY_SIZE = 64ULL;
+constexpr size_t BENCH_POOL_ALLOC_SIZE = 256U;
+constexpr uint32_t BENCH_BUFFER_ITEM_SIZE = 64U;
+
+struct BenchOptions {
+    uint32_t maxThreads = 4U;
+    uint32_t iterations = 10000U;
+    uint32_t warmup = 100U;
+    uint32_t syncInterval = 512U;
+    uint32_t submitBatch = 8U;
+    std::string outPath;
+    std::string tag;
+    std::string filter;
+    std::string kernelBin;
+    std::string kernelName;
+};
+
+struct ThreadSample {
+    std::vector<uint64_t> costNs;
+    uint32_t errorCnt = 0U;
+};
+
+// One benchmark case. Prepare / Cleanup and Sync run outside of the timed region.
+class BenchCase {
+public:
+    virtual ~BenchCase() = default;
+    virtual const char *Name() const = 0;
+    // return false with a reason to skip the case
+    virtual bool Prepare(const uint32_t threadNum, std::string &skipReason) = 0;
+    virtual rtError_t RunOnce(const uint32_t tid) = 0;
+    virtual void Sync(const uint32_t tid)
+    {
+        (void)tid;
+    }
+    virtual void Cleanup() = 0;
+};
+
+class StreamCase : public BenchCase {
+public:
+    bool Prepare(const uint32_t threadNum, std::string &skipReason) override
+    {
+        streams_.assign(threadNum, nullptr);
+        for (rtStream_t &stm : streams_) {
+            if (rtStreamCreate(&stm, 0) != RT_ERROR_NONE) {
+                skipReason = "rtStreamCreate failed";
+                return false;
+            }
+        }
+        return true;
+    }
+    void Sync(const uint32_t tid) override
+    {
+        (void)rtStreamSynchronize(streams_[tid]);
+    }
+    void Cleanup() override
+    {
+        for (rtStream_t stm : streams_) {
+            if (stm != nullptr) {
+                (void)rtStreamSynchronize(stm);
+                (void)rtStreamDestroy(stm);
+            }
+        }
+        streams_.clear();
+    }
+
+protected:
+    std::vector<rtStream_t> streams_;
+};
+
+// submitBatch > 1 turns on RT_STREAM_ATTR_SUBMIT_BATCH for every stream of the case
+class KernelLaunchCase : public StreamCase {
+public:
+    KernelLaunchCase(const BenchOptions &opt, const uint32_t submitBatch)
+        : binPath_(opt.kernelBin), kernelName_(opt.kernelName), submitBatch_(submitBatch)
+    {
+    }
+    const char *Name() const override
+    {
+        return (submitBatch_ > 1U) ? "kernel_launch_submit_batch" : "kernel_launch";
+    }
+    bool Prepare(const uint32_t threadNum, std::string &skipReason) override
+    {
+        if (binPath_.empty() || kernelName_.empty()) {
+            skipReason = "no --kernel_bin / --kernel_name given";
+            return false;
+        }
+        if (binHandle_ == nullptr) {
+            std::ifstream file(binPath_, std::ios::binary);
+            binData_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            if (binData_.empty()) {
+                skipReason = "failed to read " + binPath_;
+                return false;
+            }
+            rtDevBinary_t bin = {RT_DEV_BINARY_MAGIC_ELF, 2U, binData_.data(), binData_.size()};
+            if (rtDevBinaryRegister(&bin, &binHandle_) != RT_ERROR_NONE) {
+                skipReason = "rtDevBinaryRegister failed";
+                return false;
+            }
+            if (rtFunctionRegister(binHandle_, &stubFunc_, kernelName_.c_str(), kernelName_.c_str(), 0U) !=
+                RT_ERROR_NONE) {
+                skipReason = "rtFunctionRegister failed";
+                return false;
+            }
+        }
+        if (!StreamCase::Prepare(threadNum, skipReason)) {
+            return false;
+        }
+        if (submitBatch_ <= 1U) {
+            return true;
+        }
+        rtStreamAttrValue_t value = {};
+        value.submitBatchSize = submitBatch_;
+        for (rtStream_t stm : streams_) {
+            if (rtsStreamSetAttribute(stm, RT_STREAM_ATTR_SUBMIT_BATCH, &value) != RT_ERROR_NONE) {
+                skipReason = "RT_STREAM_ATTR_SUBMIT_BATCH is not supported";
+                return false;
+            }
+        }
+        return true;
+    }
+    rtError_t RunOnce(const uint32_t tid) override
+    {
+        uint64_t args[2U] = {0ULL, 0ULL};
+        return rtKernelLaunch(&stubFunc_, 1U, args, static_cast<uint32_t>(sizeof(args)), nullptr, streams_[tid]);
+    }
+    ~KernelLaunchCase() override
+    {
+        if (binHandle_ != nullptr) {
+            (void)rtDevBinaryUnRegister(binHandle_);
+        }
+    }
+
+private:
+    std::string binPath_;
+    std::string kernelName_;
+    uint32_t submitBatch_;
+    std::vector<char> binData_;
+    void *binHandle_ = nullptr;
+    char stubFunc_ = 0;
+};
+
+class MemcpyAsyncCase : public StreamCase {
+public:
+    const char *Name() const override
+    {
+        return "memcpy_async_h2d";
+    }
+    bool Prepare(const uint32_t threadNum, std::string &skipReason) override
+    {
+        devPtr_.assign(threadNum, nullptr);
+        hostPtr_.assign(threadNum, nullptr);
+        for (uint32_t i = 0U; i < threadNum; i++) {
+            if ((rtMalloc(&devPtr_[i], BENCH_COPY_SIZE, RT_MEMORY_HBM, BENCH_MODULE_ID) != RT_ERROR_NONE) ||
+                (rtMallocHost(&hostPtr_[i], BENCH_COPY_SIZE, BENCH_MODULE_ID) != RT_ERROR_NONE)) {
+                skipReason = "rtMalloc / rtMallocHost failed";
+                return false;
+            }
+        }
+        return StreamCase::Prepare(threadNum, skipReason);
+    }
+    rtError_t RunOnce(const uint32_t tid) override
+    {
+        return rtMemcpyAsync(devPtr_[tid], BENCH_COPY_SIZE, hostPtr_[tid], BENCH_COPY_SIZE,
+            RT_MEMCPY_HOST_TO_DEVICE, streams_[tid]);
+    }
+    void Cleanup() override
+    {
+        StreamCase::Cleanup();
+        for (void *ptr : devPtr_) {
+            if (ptr != nullptr) {
+                (void)rtFree(ptr);
+            }
+        }
+        for (void *ptr : hostPtr_) {
+            if (ptr != nullptr) {
+                (void)rtFreeHost(ptr);
+            }
+        }
+        devPtr_.clear();
+        hostPtr_.clear();
+    }
+
+private:
+    std::vector<void *> devPtr_;
+    std::vector<void *> hostPtr_;
+};
+
+// record on the first stream of the thread, wait on the second one
+class EventRecordWaitCase : public BenchCase {
+public:
+    const char *Name() const override
+    {
+        return "event_record_wait";
+    }
+    bool Prepare(const uint32_t threadNum, std::string &skipReason) override
+    {
+        recordStreams_.assign(threadNum, nullptr);
+        waitStreams_.assign(threadNum, nullptr);
+        events_.assign(threadNum, nullptr);
+        for (uint32_t i = 0U; i < threadNum; i++) {
+            if ((rtStreamCreate(&recordStreams_[i], 0) != RT_ERROR_NONE) ||
+                (rtStreamCreate(&waitStreams_[i], 0) != RT_ERROR_NONE) ||
+                (rtEventCreate(&events_[i]) != RT_ERROR_NONE)) {
+                skipReason = "rtStreamCreate / rtEventCreate failed";
+                return false;
+            }
+        }
+        return true;
+    }
+    rtError_t RunOnce(const uint32_t tid) override
+    {
+        const rtError_t ret = rtEventRecord(events_[tid], recordStreams_[tid]);
+        if (ret != RT_ERROR_NONE) {
+            return ret;
+        }
+        return rtStreamWaitEvent(waitStreams_[tid], events_[tid]);
+    }
+    void Sync(const uint32_t tid) override
+    {
+        (void)rtStreamSynchronize(recordStreams_[tid]);
+        (void)rtStreamSynchronize(waitStreams_[tid]);
+    }
+    void Cleanup() override
+    {
+        for (size_t i = 0U; i < events_.size(); i++) {
+            if (recordStreams_[i] != nullptr) {
+                (void)rtStreamSynchronize(recordStreams_[i]);
+            }
+            if (waitStreams_[i] != nullptr) {
+                (void)rtStreamSynchronize(waitStreams_[i]);
+            }
+            if (events_[i] != nullptr) {
+                (void)rtEventDestroy(events_[i]);
+            }
+            if (recordStreams_[i] != nullptr) {
+                (void)rtStreamDestroy(recordStreams_[i]);
+            }
+            if (waitStreams_[i] != nullptr) {
+                (void)rtStreamDestroy(waitStreams_[i]);
+            }
+        }
+        recordStreams_.clear();
+        waitStreams_.clear();
+        events_.clear();
+    }
+
+private:
+    std::vector<rtStream_t> recordStreams_;
+    std::vector<rtStream_t> waitStreams_;
+    std::vector<rtEvent_t> events_;
+};
+
+class StreamCreateDestroyCase : public BenchCase {
+public:
+    const char *Name() const override
+    {
+        return "stream_create_destroy";
+    }
+    bool Prepare(const uint32_t threadNum, std::string &skipReason) override
+    {
+        (void)threadNum;
+        (void)skipReason;
+        return true;
+    }
+    rtError_t RunOnce(const uint32_t tid) override
+    {
+        (void)tid;
+        rtStream_t stm = nullptr;
+        const rtError_t ret = rtStreamCreate(&stm, 0);
+        if (ret != RT_ERROR_NONE) {
+            return ret;
+        }
+        return rtStreamDestroy(stm);
+    }
+    void Cleanup() override {}
+};
+
+class MemoryPoolCase : public BenchCase {
+public:
+    const char *Name() const override
+    {
+        return "memory_pool_alloc_free";
+    }
+    bool Prepare(const uint32_t threadNum, std::string &skipReason) override
+    {
+        (void)threadNum;
+        dev_ = Runtime::Instance()->DeviceRetain(static_cast<uint32_t>(BENCH_DEVICE_ID), 0U);
+        pool_ = (dev_ != nullptr) ? dev_->GetKernelMemoryPool() : nullptr;
+        if (pool_ == nullptr) {
+            skipReason = "device has no kernel memory pool";
+            return false;
+        }
+        return true;
+    }
+    rtError_t RunOnce(const uint32_t tid) override
+    {
+        (void)tid;
+        void *const ptr = pool_->Allocate(BENCH_POOL_ALLOC_SIZE, false);
+        if (ptr == nullptr) {
+            return RT_ERROR_MEMORY_ALLOCATION;
+        }
+        pool_->Release(ptr, BENCH_POOL_ALLOC_SIZE);
+        return RT_ERROR_NONE;
+    }
+    void Cleanup() override
+    {
+        if (dev_ != nullptr) {
+            Runtime::Instance()->DeviceRelease(dev_);
+        }
+        dev_ = nullptr;
+        pool_ = nullptr;
+    }
+
+private:
+    Device *dev_ = nullptr;
+    MemoryPoolManager *pool_ = nullptr;
+};
+
+// all threads share one allocator, as the stream / task allocators of the runtime do
+class BufferAllocatorCase : public BenchCase {
+public:
+    const char *Name() const override
+    {
+        return "buffer_allocator_alloc_id";
+    }
+    bool Prepare(const uint32_t threadNum, std::string &skipReason) override
+    {
+        (void)threadNum;
+        allocator_.reset(new (std::nothrow) BufferAllocator(BENCH_BUFFER_ITEM_SIZE));
+        if (allocator_ == nullptr) {
+            skipReason = "failed to create BufferAllocator";
+            return false;
+        }
+        return true;
+    }
+    rtError_t RunOnce(const uint32_t tid) override
+    {
+        (void)tid;
+        const int32_t id = allocator_->AllocId(false);
+        if (id < 0) {
+            return RT_ERROR_MEMORY_ALLOCATION;
+        }
+        allocator_->FreeById(id);
+        return RT_ERROR_NONE;
+    }
+    void Cleanup() override
+    {
+        allocator_.reset();
+    }
+
+private:
+    std::unique_ptr<BufferAllocator> allocator_;
+};
+
+uint64_t Percentile(const std::vector<uint64_t> &sorted, const uint32_t percent)
+{
+    if (sorted.empty()) {
+        return 0ULL;
+    }
+    const size_t idx = (sorted.size() - 1U) * percent / 100U;
+    return sorted[idx];
+}
+
+nlohmann::json RunCase(BenchCase &benchCase, const BenchOptions &opt, const uint32_t threadNum)
+{
+    nlohmann::json result;
+    result["case"] = benchCase.Name();
+    result["threads"] = threadNum;
+    std::string skipReason;
+    if (!benchCase.Prepare(threadNum, skipReason)) {
+        benchCase.Cleanup();
+        result["skipped"] = true;
+        result["reason"] = skipReason;
+        return result;
+    }
+
+    std::vector<ThreadSample> samples(threadNum);
+    std::atomic<uint32_t> readyCnt{0U};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    const auto worker = [&benchCase, &opt, &samples, &readyCnt, &start](const uint32_t tid) {
+        ThreadSample &sample = samples[tid];
+        for (uint32_t i = 0U; i < opt.warmup; i++) {
+            (void)benchCase.RunOnce(tid);
+        }
+        benchCase.Sync(tid);
+        sample.costNs.reserve(opt.iterations);
+        (void)readyCnt.fetch_add(1U);
+        while (!start.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        for (uint32_t i = 0U; i < opt.iterations; i++) {
+            const auto begin = BenchClock::now();
+            const rtError_t ret = benchCase.RunOnce(tid);
+            const auto end = BenchClock::now();
+            sample.costNs.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+            if (ret != RT_ERROR_NONE) {
+                sample.errorCnt++;
+            }
+            if ((opt.syncInterval != 0U) && (((i + 1U) % opt.syncInterval) == 0U)) {
+                benchCase.Sync(tid);
+            }
+        }
+        benchCase.Sync(tid);
+    };
+    for (uint32_t tid = 0U; tid < threadNum; tid++) {
+        threads.emplace_back(worker, tid);
+    }
+    while (readyCnt.load() != threadNum) {
+        std::this_thread::yield();
+    }
+    const auto wallBegin = BenchClock::now();
+    start.store(true, std::memory_order_release);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    const auto wallEnd = BenchClock::now();
+    benchCase.Cleanup();
+
+    std::vector<uint64_t> all;
+    all.reserve(static_cast<size_t>(opt.iterations) * threadNum);
+    uint64_t errorCnt = 0ULL;
+    uint64_t busyNs = 0ULL;
+    for (const ThreadSample &sample : samples) {
+        all.insert(all.end(), sample.costNs.begin(), sample.costNs.end());
+        errorCnt += sample.errorCnt;
+    }
+    for (const uint64_t cost : all) {
+        busyNs += cost;
+    }
+    std::sort(all.begin(), all.end());
+    const double wallSec = std::chrono::duration<double>(wallEnd - wallBegin).count();
+    result["skipped"] = false;
+    result["ops"] = all.size();
+    result["errors"] = errorCnt;
+    result["wall_s"] = wallSec;
+    // wall time includes the periodic stream syncs, so ops_per_s is the throughput sustained by the device
+    result["ops_per_s"] = (wallSec > 0.0) ? (static_cast<double>(all.size()) / wallSec) : 0.0;
+    result["avg_ns"] = all.empty() ? 0ULL : (busyNs / all.size());
+    result["p50_ns"] = Percentile(all, 50U);
+    result["p99_ns"] = Percentile(all, 99U);
+    result["max_ns"] = all.empty() ? 0ULL : all.back();
+    return result;
+}
+
+bool ParseUint(const char *const value, uint32_t &out)
+{
+    char *end = nullptr;
+    const unsigned long val = strtoul(value, &end, 10);
+    if ((end == value) || (*end != '\0') || (val > UINT32_MAX)) {
+        return false;
+    }
+    out = static_cast<uint32_t>(val);
+    return true;
+}
+
+void Usage(const char *const prog)
+{
+    printf("Usage: %s [--threads=N] [--iterations=N] [--warmup=N] [--sync_interval=N] [--filter=case]\n"
+           "          [--kernel_bin=file --kernel_name=name] [--submit_batch=N] [--tag=str] [--out=file.json]\n",
+        prog);
+}
+
+bool ParseArgs(const int argc, char *argv[], BenchOptions &opt)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        const size_t pos = arg.find('=');
+        if ((arg.compare(0U, 2U, "--") != 0) || (pos == std::string::npos)) {
+            return false;
+        }
+        const std::string key = arg.substr(2U, pos - 2U);
+        const std::string value = arg.substr(pos + 1U);
+        bool ok = true;
+        if (key == "threads") {
+            ok = ParseUint(value.c_str(), opt.maxThreads) && (opt.maxThreads != 0U);
+        } else if (key == "iterations") {
+            ok = ParseUint(value.c_str(), opt.iterations);
+        } else if (key == "warmup") {
+            ok = ParseUint(value.c_str(), opt.warmup);
+        } else if (key == "sync_interval") {
+            ok = ParseUint(value.c_str(), opt.syncInterval);
+        } else if (key == "submit_batch") {
+            ok = ParseUint(value.c_str(), opt.submitBatch);
+        } else if (key == "filter") {
+            opt.filter = value;
+        } else if (key == "kernel_bin") {
+            opt.kernelBin = value;
+        } else if (key == "kernel_name") {
+            opt.kernelName = value;
+        } else if (key == "tag") {
+            opt.tag = value;
+        } else if (key == "out") {
+            opt.outPath = value;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint32_t> ThreadSteps(const uint32_t maxThreads)
+{
+    std::vector<uint32_t> steps;
+    for (uint32_t num = 1U; num < maxThreads; num *= 2U) {
+        steps.push_back(num);
+    }
+    steps.push_back(maxThreads);
+    return steps;
+}
+
+const char *GetEnvOrEmpty(const char *const name)
+{
+    const char *const value = getenv(name);
+    return (value == nullptr) ? "" : value;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchOptions opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage(argv[0]);
+        return 1;
+    }
+    (void)setenv("CMODEL_DRV_SIM_DEVICE", "1", 0);
+
+    if (rtSetDevice(BENCH_DEVICE_ID) != RT_ERROR_NONE) {
+        fprintf(stderr, "rtSetDevice(%d) failed\n", BENCH_DEVICE_ID);
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<BenchCase>> cases;
+    cases.emplace_back(new KernelLaunchCase(opt, 0U));
+    cases.emplace_back(new KernelLaunchCase(opt, opt.submitBatch));
+    cases.emplace_back(new MemcpyAsyncCase());
+    cases.emplace_back(new EventRecordWaitCase());
+    cases.emplace_back(new StreamCreateDestroyCase());
+    cases.emplace_back(new MemoryPoolCase());
+    cases.emplace_back(new BufferAllocatorCase());
+
+    nlohmann::json report;
+    report["tag"] = opt.tag;
+    report["iterations"] = opt.iterations;
+    report["warmup"] = opt.warmup;
+    report["sync_interval"] = opt.syncInterval;
+    report["submit_batch"] = opt.submitBatch;
+    report["env"]["CMODEL_DRV_SIM_DEVICE"] = GetEnvOrEmpty("CMODEL_DRV_SIM_DEVICE");
+    report["env"]["CMODEL_DRV_SIM_LATENCY_US"] = GetEnvOrEmpty("CMODEL_DRV_SIM_LATENCY_US");
+    report["env"]["CMODEL_DRV_SIM_LATENCY_DIST"] = GetEnvOrEmpty("CMODEL_DRV_SIM_LATENCY_DIST");
+    report["results"] = nlohmann::json::array();
+    for (const std::unique_ptr<BenchCase> &benchCase : cases) {
+        if (!opt.filter.empty() && (opt.filter != benchCase->Name())) {
+            continue;
+        }
+        for (const uint32_t threadNum : ThreadSteps(opt.maxThreads)) {
+            nlohmann::json result = RunCase(*benchCase, opt, threadNum);
+            if (result["skipped"].get<bool>()) {
+                printf("%-28s threads=%-3u skipped: %s\n", benchCase->Name(), threadNum,
+                    result["reason"].get<std::string>().c_str());
+                report["results"].push_back(result);
+                break;
+            }
+            printf("%-28s threads=%-3u ops/s=%-12.0f avg=%-8" PRIu64 "ns p50=%-8" PRIu64 "ns p99=%-8" PRIu64
+                "ns errors=%" PRIu64 "\n", benchCase->Name(), threadNum, result["ops_per_s"].get<double>(),
+                result["avg_ns"].get<uint64_t>(), result["p50_ns"].get<uint64_t>(),
+                result["p99_ns"].get<uint64_t>(), result["errors"].get<uint64_t>());
+            report["results"].push_back(result);
+        }
+    }
+    cases.clear();
+    (void)rtDeviceReset(BENCH_DEVICE_ID);
+
+    const std::string dump = report.dump(4);
+    if (opt.outPath.empty()) {
+        printf("%s\n", dump.c_str());
+        return 0;
+    }
+    std::ofstream out(opt.outPath);
+    out << dump << std::endl;
+    if (!out.good()) {
+        fprintf(stderr, "failed to write %s\n", opt.outPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2026 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Host memset microbenchmark.
+// Compares the single threaded fill (MemsetD32Serial, the path before streaming stores and worker threads) with
+// MemsetD32Optimized / MemsetD16Optimized / MemsetD8Optimized and libc memset, from cache resident sizes up to
+// --max_mb. Every size is filled --iterations times after one untimed warmup fill, the results are written as json:
+//   runtime_memset_bench --max_mb=1024 --iterations=10 --out=memset.json --tag=<commit>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "memset_common.h"
+
+namespace {
+using BenchClock = std::chrono::steady_clock;
+using cce::runtime::MemsetD16Optimized;
+using cce::runtime::MemsetD32Optimized;
+using cce::runtime::MemsetD32Serial;
+using cce::runtime::MemsetD8Optimized;
+
+constexpr size_t BENCH_MIN_SIZE = 64ULL * 1024ULL;
+constexpr size_t BENCH_SIZE_UNIT = 1024ULL * 1024ULL;
+constexpr size_t BENCH_BUF_ALIGN = 4096ULL;
+constexpr uint32_t BENCH_FILL_VALUE = 0x5AA5C33CU;
+
+struct BenchOptions {
+    uint32_t maxMb = 512U;
+    uint32_t iterations = 10U;
+    std::string outPath;
+    std::string tag;
+    std::string filter;
+};
+
+struct MemsetCase {
+    const char *name;
+    std::function<void(uint8_t *, size_t)> fill;
+};
+
+std::vector<MemsetCase> BuildCases()
+{
+    return {
+        {"d32_serial",
+            [](uint8_t *buf, size_t size) {
+                MemsetD32Serial(reinterpret_cast<uint32_t *>(buf), BENCH_FILL_VALUE, size / sizeof(uint32_t));
+            }},
+        {"d32_optimized",
+            [](uint8_t *buf, size_t size) {
+                MemsetD32Optimized(reinterpret_cast<uint32_t *>(buf), BENCH_FILL_VALUE, size / sizeof(uint32_t));
+            }},
+        {"d16_optimized",
+            [](uint8_t *buf, size_t size) {
+                MemsetD16Optimized(reinterpret_cast<uint16_t *>(buf), static_cast<uint16_t>(BENCH_FILL_VALUE),
+                    size / sizeof(uint16_t));
+            }},
+        {"d8_optimized",
+            [](uint8_t *buf, size_t size) {
+                MemsetD8Optimized(buf, static_cast<uint8_t>(BENCH_FILL_VALUE), size);
+            }},
+        {"libc_memset",
+            [](uint8_t *buf, size_t size) {
+                (void)memset(buf, static_cast<int32_t>(BENCH_FILL_VALUE & 0xFFU), size);
+            }},
+    };
+}
+
+std::vector<size_t> SizeSteps(const size_t maxSize)
+{
+    std::vector<size_t> steps;
+    for (size_t size = BENCH_MIN_SIZE; size < maxSize; size *= 4ULL) {
+        steps.push_back(size);
+    }
+    steps.push_back(maxSize);
+    return steps;
+}
+
+nlohmann::json RunCase(const MemsetCase &memsetCase, uint8_t *const buf, const size_t size,
+    const uint32_t iterations)
+{
+    std::vector<uint64_t> costNs;
+    costNs.reserve(iterations);
+    // the first fill faults the pages in, it is left out of the samples
+    memsetCase.fill(buf, size);
+    for (uint32_t i = 0U; i < iterations; i++) {
+        const auto begin = BenchClock::now();
+        memsetCase.fill(buf, size);
+        const auto end = BenchClock::now();
+        costNs.push_back(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+    }
+    std::sort(costNs.begin(), costNs.end());
+    const uint64_t bestNs = costNs.empty() ? 0ULL : costNs.front();
+    const uint64_t medianNs = costNs.empty() ? 0ULL : costNs[costNs.size() / 2U];
+    nlohmann::json result;
+    result["case"] = memsetCase.name;
+    result["size"] = size;
+    result["iterations"] = iterations;
+    result["best_ns"] = bestNs;
+    result["p50_ns"] = medianNs;
+    result["gb_per_s"] = (medianNs > 0ULL) ? (static_cast<double>(size) / static_cast<double>(medianNs)) : 0.0;
+    return result;
+}
+
+bool ParseUint(const char *const value, uint32_t &out)
+{
+    char *end = nullptr;
+    const unsigned long val = strtoul(value, &end, 10);
+    if ((end == value) || (*end != '\0') || (val > UINT32_MAX)) {
+        return false;
+    }
+    out = static_cast<uint32_t>(val);
+    return true;
+}
+
+void Usage(const char *const prog)
+{
+    printf("Usage: %s [--max_mb=N] [--iterations=N] [--filter=case] [--tag=str] [--out=file.json]\n", prog);
+}
+
+bool ParseArgs(const int argc, char *argv[], BenchOptions &opt)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        const size_t pos = arg.find('=');
+        if ((arg.compare(0U, 2U, "--") != 0) || (pos == std::string::npos)) {
+            return false;
+        }
+        const std::string key = arg.substr(2U, pos - 2U);
+        const std::string value = arg.substr(pos + 1U);
+        bool ok = true;
+        if (key == "max_mb") {
+            ok = ParseUint(value.c_str(), opt.maxMb) && (opt.maxMb != 0U);
+        } else if (key == "iterations") {
+            ok = ParseUint(value.c_str(), opt.iterations) && (opt.iterations != 0U);
+        } else if (key == "filter") {
+            opt.filter = value;
+        } else if (key == "tag") {
+            opt.tag = value;
+        } else if (key == "out") {
+            opt.outPath = value;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchOptions opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage(argv[0]);
+        return 1;
+    }
+    const size_t maxSize = static_cast<size_t>(opt.maxMb) * BENCH_SIZE_UNIT;
+    uint8_t *const buf = static_cast<uint8_t *>(aligned_alloc(BENCH_BUF_ALIGN, maxSize));
+    if (buf == nullptr) {
+        fprintf(stderr, "alloc %zu bytes failed\n", maxSize);
+        return 1;
+    }
+
+    nlohmann::json report;
+    report["tag"] = opt.tag;
+    report["iterations"] = opt.iterations;
+    report["results"] = nlohmann::json::array();
+    for (const MemsetCase &memsetCase : BuildCases()) {
+        if (!opt.filter.empty() && (opt.filter != memsetCase.name)) {
+            continue;
+        }
+        for (const size_t size : SizeSteps(maxSize)) {
+            nlohmann::json result = RunCase(memsetCase, buf, size, opt.iterations);
+            printf("%-16s size=%-12zu p50=%-12" PRIu64 "ns GB/s=%.2f\n", memsetCase.name, size,
+                result["p50_ns"].get<uint64_t>(), result["gb_per_s"].get<double>());
+            report["results"].push_back(result);
+        }
+    }
+    free(buf);
+
+    const std::string dump = report.dump(4);
+    if (opt.outPath.empty()) {
+        printf("%s\n", dump.c_str());
+        return 0;
+    }
+    std::ofstream out(opt.outPath);
+    out << dump << std::endl;
+    if (!out.good()) {
+        fprintf(stderr, "failed to write %s\n", opt.outPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -19,13 +19,15 @@ THREAD_NUM=$(grep -c ^processor /proc/cpuinfo)
 ASCEND_3RD_LIB_PATH="${ROOT_DIR}/output/third_party"
 ASCEND_INSTALL_PATH="${ASCEND_INSTALL_PATH:-/usr/local/Ascend/cann}"
 PRODUCT_TYPE=""
+BUILD_BENCH="off"
 
 usage() {
   echo "Usage:"
-  echo "  bash tests/cmodel_test/build_runtime_cmodel_product.sh --product_type=<PRODUCT_TYPE>"
+  echo "  bash tests/cmodel_test/build_runtime_cmodel_product.sh --product_type=<PRODUCT_TYPE> [--bench]"
+  echo "    --bench    also build the microbenchmarks runtime_launch_bench and runtime_memset_bench"
 }
 
-parsed_args=$(getopt -a -o h -l help,product_type: -- "$@") || {
+parsed_args=$(getopt -a -o h -l help,product_type:,bench -- "$@") || {
   usage
   exit 1
 }
@@ -41,6 +43,10 @@ while true; do
       PRODUCT_TYPE="$2"
       shift 2
       ;;
+    --bench)
+      BUILD_BENCH="on"
+      shift
+      ;;
     --)
       shift
       break
@@ -77,5 +83,8 @@ CMAKE_ARGS="-DENABLE_OPEN_SRC=True \
 echo "CMAKE_ARGS=${CMAKE_ARGS}"
 cmake -S "${SCRIPT_DIR}" -B . ${CMAKE_ARGS}
 cmake --build . -j"${THREAD_NUM}" --target runtime_cmodel_${PRODUCT_TYPE} runtime_camodel_${PRODUCT_TYPE}
+if [ "${BUILD_BENCH}" = "on" ]; then
+  cmake --build . -j"${THREAD_NUM}" --target runtime_launch_bench_${PRODUCT_TYPE} runtime_memset_bench_${PRODUCT_TYPE}
+fi
 
 echo "build success!"
@@ -50,7 +50,8 @@ extern aclError TensorDatasetSerializesV2(const acltdtDataset* dataset, std::vec
 extern aclError TensorDatasetDeserializesV2(const std::vector<aclTdtDataItemInfo>& itemVec, acltdtDataset* dataset);
 extern aclError UnpackageRecvDataInfo(uint8_t* outputHostAddr, size_t size, std::vector<aclTdtDataItemInfo>& itemVec);
 extern aclError TensorDataitemSerialize(
-    std::vector<aclTdtDataItemInfo>& itemVec, std::vector<rtMemQueueBuffInfo>& qBufVec);
+    std::vector<aclTdtDataItemInfo>& itemVec, const datasetMemType memType, std::vector<rtMemQueueBuffInfo>& qBufVec,
+    std::vector<std::shared_ptr<uint8_t>>& ctrlSharedPtrVec);
 extern aclError GetOrMallocHostMem(
     const acltdtChannelHandle* handle, acltdtDataset* dataset, size_t bufLen, void*& hostPtr);
 } // namespace acl
@@ -448,6 +449,55 @@ TEST_F(UTEST_tensor_data_transfer, TestGetTensorShape)
     std::string dimStr2 = "[tensor]";
     ret = GetTensorShape(dimStr2, dims);
     EXPECT_EQ(ret, false);
+
+    dims.clear();
+    EXPECT_EQ(GetTensorShape("[ 32, -1 ,224 ]", dims), true);
+    EXPECT_EQ(dims, std::vector<int64_t>({32, -1, 224}));
+
+    dims.clear();
+    EXPECT_EQ(GetTensorShape("[]", dims), true);
+    EXPECT_EQ(dims.empty(), true);
+
+    EXPECT_EQ(GetTensorShape("[9223372036854775807]", dims), true);
+    EXPECT_EQ(GetTensorShape("[9223372036854775808]", dims), false);
+    EXPECT_EQ(GetTensorShape("[1,,2]", dims), false);
+    EXPECT_EQ(GetTensorShape("[1 2]", dims), false);
+    EXPECT_EQ(GetTensorShape("[-]", dims), false);
+}
+
+TEST_F(UTEST_tensor_data_transfer, TensorDataitemSerializeContiguousCtrl)
+{
+    std::vector<aclTdtDataItemInfo> itemVec(3);
+    int32_t data = 0;
+    for (size_t i = 0; i < itemVec.size(); ++i) {
+        itemVec[i].ctrlInfo = {};
+        itemVec[i].dims = std::vector<int64_t>(i + 1, static_cast<int64_t>(i + 1));
+        itemVec[i].ctrlInfo.dimNum = static_cast<uint32_t>(i + 1);
+        itemVec[i].ctrlInfo.dataLen = (i == 1) ? 0U : sizeof(int32_t);
+        itemVec[i].dataPtr = std::shared_ptr<void>(&data, [](void*) {});
+    }
+    std::vector<rtMemQueueBuffInfo> qBufVec;
+    std::vector<std::shared_ptr<uint8_t>> ctrlSharedPtrVec;
+    EXPECT_EQ(TensorDataitemSerialize(itemVec, MEM_HOST, qBufVec, ctrlSharedPtrVec), ACL_SUCCESS);
+    ASSERT_EQ(ctrlSharedPtrVec.size(), 1U);
+    ASSERT_EQ(qBufVec.size(), 5U);
+
+    // ctrl slices are adjacent in the one buffer, each data buf keeps the total size 64 aligned
+    uint8_t* const base = ctrlSharedPtrVec[0].get();
+    EXPECT_EQ(qBufVec[0].addr, base);
+    EXPECT_EQ(qBufVec[2].addr, base + qBufVec[0].len);
+    EXPECT_EQ(qBufVec[3].addr, base + qBufVec[0].len + qBufVec[2].len);
+    EXPECT_EQ((qBufVec[0].len + qBufVec[1].len + qBufVec[2].len) % 64U, 0U);
+
+    ItemInfo head = {};
+    (void)memcpy(&head, qBufVec[3].addr, sizeof(ItemInfo));
+    EXPECT_EQ(head.curCnt, 2U);
+    EXPECT_EQ(head.cnt, 3U);
+    EXPECT_EQ(head.dynamicBitSize, qBufVec[3].len - sizeof(ItemInfo));
+    int64_t dims[3] = {};
+    (void)memcpy(dims, static_cast<uint8_t*>(qBufVec[3].addr) + sizeof(ItemInfo), sizeof(dims));
+    EXPECT_EQ(dims[0], 3);
+    EXPECT_EQ(dims[2], 3);
 }
 
 TEST_F(UTEST_tensor_data_transfer, acltdtCreateChannel)
@@ -1128,6 +1178,62 @@ TEST_F(UTEST_tensor_data_transfer, GetOrMallocHostMem)
     EXPECT_NE(p, nullptr);
 }
 
+TEST_F(UTEST_tensor_data_transfer, GetOrMallocHostMemFromPool)
+{
+    acltdtChannelHandle handle;
+    handle.hostMemPool_ = std::make_shared<TdtHostMemPool>(2U * 1024U * 1024U);
+    EXPECT_CALL(MockFunctionTest::aclStubInstance(), rtCtxGetCurrent(_))
+        .WillRepeatedly(Return((ACL_ERROR_RT_CONTEXT_NULL)));
+    void* p = nullptr;
+    {
+        acltdtDataset dataset;
+        EXPECT_EQ(GetOrMallocHostMem(&handle, &dataset, 1000U, p), ACL_SUCCESS);
+        EXPECT_EQ(dataset.sharedMemSize_, TDT_HOST_MEM_POOL_MIN_CLASS);
+        EXPECT_EQ(p, dataset.sharedMem_.get());
+        EXPECT_EQ(GetOrMallocHostMem(&handle, &dataset, 100U * 1024U, p), ACL_SUCCESS);
+        EXPECT_EQ(dataset.sharedMemSize_, 128U * 1024U);
+    }
+    // the buffers of the destroyed dataset are reused by the next one
+    acltdtDataset dataset;
+    EXPECT_EQ(GetOrMallocHostMem(&handle, &dataset, 120U * 1024U, p), ACL_SUCCESS);
+    EXPECT_EQ(dataset.sharedMemSize_, 128U * 1024U);
+    TdtHostMemPoolStat stat = {};
+    handle.hostMemPool_->GetStat(stat);
+    EXPECT_EQ(stat.hitCount, 1U);
+    EXPECT_EQ(stat.missCount, 2U);
+    EXPECT_EQ(stat.cachedSize, TDT_HOST_MEM_POOL_MIN_CLASS);
+    EXPECT_EQ(stat.inUseSize, 128U * 1024U);
+}
+
+TEST_F(UTEST_tensor_data_transfer, TdtHostMemPoolTrim)
+{
+    EXPECT_EQ(TdtHostMemPool::GetSizeClass(1U), TDT_HOST_MEM_POOL_MIN_CLASS);
+    EXPECT_EQ(TdtHostMemPool::GetSizeClass(4097U), 8192U);
+    EXPECT_EQ(TdtHostMemPool::GetSizeClass(1024U * 1024U + 1U), 1280U * 1024U);
+
+    auto pool = std::make_shared<TdtHostMemPool>(64U * 1024U);
+    std::shared_ptr<void> buf1;
+    std::shared_ptr<void> buf2;
+    size_t size = 0U;
+    EXPECT_EQ(pool->Acquire(32U * 1024U, buf1, size), ACL_SUCCESS);
+    EXPECT_EQ(pool->Acquire(64U * 1024U, buf2, size), ACL_SUCCESS);
+    buf1.reset();
+    buf2.reset();
+    // the least recently released 32K buffer is trimmed to stay under the limit
+    TdtHostMemPoolStat stat = {};
+    pool->GetStat(stat);
+    EXPECT_EQ(stat.trimCount, 1U);
+    EXPECT_EQ(stat.cachedSize, 64U * 1024U);
+
+    EXPECT_EQ(pool->Acquire(48U * 1024U, buf1, size), ACL_SUCCESS);
+    EXPECT_EQ(size, 64U * 1024U);
+    EXPECT_CALL(MockFunctionTest::aclStubInstance(), rtMallocHost(_, _, _))
+        .WillRepeatedly(Return(ACL_ERROR_RT_MEMORY_ALLOCATION));
+    EXPECT_NE(pool->Acquire(128U * 1024U, buf2, size), ACL_SUCCESS);
+    pool.reset();
+    buf1.reset();
+}
+
 TEST_F(UTEST_tensor_data_transfer, acltdtCleanChannel_succ_with_tdt)
 {
     uint32_t deviceId = 1;
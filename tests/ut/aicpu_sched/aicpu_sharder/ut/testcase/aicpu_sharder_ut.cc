@@ -17,6 +17,7 @@
 #include <queue>
 #include <exception>
 #include <string>
+#include <vector>
 #define private public
 #include "aicpu_sharder.h"
 #undef private
@@ -183,6 +184,66 @@ TEST_F(AiCPUSharderUt, ParallelForGetTaskThousands)
     }
 }
 
+TEST_F(AiCPUSharderUt, ParallelForStealAllBlocks)
+{
+    const uint32_t coreNum = 8U;
+    int64_t helperNum = -1;
+    const SplitKernelScheduler splitKernelSchedulerCount = [&helperNum](const uint32_t parallelId,
+                                                                        const int64_t shardNum,
+                                                                        const std::queue<Closure>& queue) {
+        helperNum = shardNum;
+        taskQueue_ = queue;
+        return 0U;
+    };
+    SharderNonBlock::GetInstance().Register(
+        coreNum, randomKernelScheduler, splitKernelSchedulerCount, splitKernelGetProcesser);
+    const int64_t total = 1000;
+    std::vector<uint32_t> hit(total, 0U);
+    const auto worker = [&hit](int64_t start, int64_t end) {
+        for (int64_t i = start; i < end; ++i) {
+            hit[i]++;
+        }
+    };
+    ParallelFor(total, 3, worker);
+    // one helper per core except the caller, helpers arriving late find all blocks done
+    EXPECT_EQ(helperNum, coreNum - 1U);
+    EXPECT_TRUE(taskQueue_.empty());
+    for (int64_t i = 0; i < total; ++i) {
+        EXPECT_EQ(hit[i], 1U);
+    }
+}
+
+TEST_F(AiCPUSharderUt, ParallelForSplitSchedulerPartialSubmitFail)
+{
+    const uint32_t coreNum = 8U;
+    // only the first helpers are submitted before the scheduler fails, they run after ParallelFor returns
+    const SplitKernelScheduler splitKernelSchedulerPartial = [](const uint32_t parallelId, const int64_t shardNum,
+                                                                const std::queue<Closure>& queue) {
+        taskQueue_ = queue;
+        while (static_cast<int64_t>(taskQueue_.size()) > (shardNum / 2)) {
+            taskQueue_.pop();
+        }
+        return 1U;
+    };
+    SharderNonBlock::GetInstance().Register(
+        coreNum, randomKernelScheduler, splitKernelSchedulerPartial, splitKernelGetProcesser);
+    const int64_t total = 1000;
+    std::vector<uint32_t> hit(total, 0U);
+    const auto worker = [&hit](int64_t start, int64_t end) {
+        for (int64_t i = start; i < end; ++i) {
+            hit[i]++;
+        }
+    };
+    ParallelFor(total, 3, worker);
+    EXPECT_FALSE(taskQueue_.empty());
+    while (!taskQueue_.empty()) {
+        splitKernelGetProcesser();
+    }
+    for (int64_t i = 0; i < total; ++i) {
+        EXPECT_EQ(hit[i], 1U);
+    }
+}
+
 TEST_F(AiCPUSharderUt, ScheduleSuccess)
 {
     SharderNonBlock::GetInstance().Register(
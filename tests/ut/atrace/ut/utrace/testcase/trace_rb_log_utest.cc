@@ -98,18 +98,7 @@ int ReadMsgFunc(int threadId, struct RbLog *rb)
             std::string str = txt;
             std::string tmp = str.erase(0, str.length() - 3);
             if (tmp.compare("msg") != 0) {
-                uint32_t readIdx = 0;
-                for (; readIdx != rb->head.bufSize; readIdx++) {
-                    RbLogMsg *msg = (RbLogMsg *)(rb->msg + rb->head.msgSize * readIdx);
-                    ADIAG_RUN_INF("[rb] readIdx : %d busy :%d, txtSize : %d, txt:%s",
-                        readIdx, (int)msg->head.busy, msg->head.txtSize, msg->txt);
-                }
-                readIdx = 0;
-                for (;readIdx != newRb->head.bufSize; readIdx++) {
-                    RbLogMsg *msg = (RbLogMsg *)(newRb->msg + newRb->head.msgSize * readIdx);
-                    ADIAG_RUN_INF("[new rb] readIdx : %d busy :%d, txtSize : %d, txt:%s",
-                        readIdx, (int)msg->head.busy, msg->head.txtSize, msg->txt);
-                }
+                ADIAG_RUN_INF("[new rb] ring num : %u, read count : %d, txt:%s", newRb->head.ringNum, num, txt);
             }
             EXPECT_STREQ(tmp.c_str(), "msg");
             num++;
@@ -329,7 +318,6 @@ TEST_F(RraceRbLogUtest, TestTraceRbLogCreateValidName)
     std::string name = "1234567890123456789012345678901";
     auto rb = TraceRbLogCreate(name.c_str(), &attr);
     EXPECT_TRUE(rb != NULL);
-    rb->head.writeIdx = 0xFFFFFFFF;
     EXPECT_EQ(rb->head.msgSize, 128);
     EXPECT_EQ(rb->head.msgTxtSize, 112);
     EXPECT_EQ(rb->head.bufSize, attr.msgNum);
@@ -373,12 +361,24 @@ struct RbLog *GetDefaultRb()
     return rb;
 }
 
+RbLogRing *GetRing(struct RbLog *rb, uint32_t ringIdx)
+{
+    return (RbLogRing *)(rb->msg + sizeof(RbLogRing) * ringIdx);
+}
+
 void FillBuffer(struct RbLog *rb)
 {
     std::string buffer(rb->head.msgTxtSize, '*');
     auto ret = TraceRbLogWriteRbMsg(rb, 0, buffer.c_str(), buffer.length());
     EXPECT_EQ(ret, TRACE_SUCCESS);
-    rb->head.writeIdx--;
+    // drop the msg but keep its bytes, the next msg is written over them
+    for (uint32_t i = 0; i < rb->head.ringNum; i++) {
+        RbLogRing *ring = GetRing(rb, i);
+        ring->headPos = 0;
+        ring->tailPos = 0;
+        ring->readPos = 0;
+        ring->msgCount = 0;
+    }
 }
 
 TEST_F(RraceRbLogUtest, TestTraceRbLogWriteInvalidBufSize)
@@ -618,7 +618,7 @@ TEST_F(RraceRbLogUtest, TestTraceRbLogCopyEntryFailed)
     auto ret = TraceRbLogGetCopyOfRingBuffer(&newRb, rb);
     EXPECT_NE(ret, TRACE_SUCCESS);
 
-    size_t totalSize = sizeof(RbLog) + rb->head.bufSize * rb->head.msgSize;
+    size_t totalSize = sizeof(RbLog) + rb->head.dataSize;
     void *buffer = malloc(totalSize);
     MOCKER(AdiagMalloc).stubs().will(returnValue(buffer)).then(returnValue((void *)NULL));
     ret = TraceRbLogGetCopyOfRingBuffer(&newRb, rb);
@@ -636,7 +636,7 @@ TEST_F(RraceRbLogUtest, TestTraceRbLogCopyEntryListFailed)
     auto rb = GetDefaultRbAttr(&en);
     struct RbLog *newRb = NULL;
 
-    size_t totalSize = sizeof(RbLog) + rb->head.bufSize * rb->head.msgSize;
+    size_t totalSize = sizeof(RbLog) + rb->head.dataSize;
     void *buffer1 = malloc(totalSize);
     void *buffer2 = malloc(sizeof(struct AdiagList));
     MOCKER(AdiagMalloc).stubs().will(returnValue(buffer1)).then(returnValue(buffer2)).then(returnValue((void *)NULL));
@@ -655,7 +655,7 @@ TEST_F(RraceRbLogUtest, TestTraceRbLogCopyEntryListMallocFailed)
     auto rb = GetDefaultRbAttr(&en);
     struct RbLog *newRb = NULL;
 
-    size_t totalSize = sizeof(RbLog) + rb->head.bufSize * rb->head.msgSize;
+    size_t totalSize = sizeof(RbLog) + rb->head.dataSize;
     void *buffer1 = malloc(totalSize);
     void *buffer2 = malloc(sizeof(struct AdiagList));
     void *buffer3 = malloc(sizeof(TraceStructField));
@@ -703,4 +703,119 @@ TEST_F(RraceRbLogUtest, TestTraceRbLogCreateStrcpyFailed)
 
     auto rb = TraceRbLogCreate(name.c_str(), &attr);
     EXPECT_EQ((struct RbLog *)NULL, rb);
-}
\ No newline at end of file
+}
+TEST_F(RraceRbLogUtest, TestTraceRbLogShortMsgRetention)
+{
+    std::string name = "HCCL";
+    TraceAttr attr = { 0 };
+    attr.msgNum = 64;
+    attr.msgSize = 112;
+    auto rb = TraceRbLogCreate(name.c_str(), &attr);
+    ASSERT_TRUE(rb != NULL);
+    EXPECT_EQ(rb->head.ringNum, 1);
+
+    int msgNum = 200;
+    for (int i = 0; i < msgNum; i++) {
+        std::string buffer = "msg_" + std::to_string(i);
+        EXPECT_EQ(TraceRbLogWriteRbMsg(rb, 0, buffer.c_str(), buffer.length()), TRACE_SUCCESS);
+    }
+    struct RbLog *newRb = NULL;
+    EXPECT_EQ(TraceRbLogGetCopyOfRingBuffer(&newRb, rb), TRACE_SUCCESS);
+    uint32_t count = TracerRbLogGetMsgNum(newRb);
+    // short msgs take less space than msgSize, more msgs than msgNum are kept
+    EXPECT_GT(count, attr.msgNum);
+    char *txt = NULL;
+    char timestamp[TIMESTAMP_MAX_LENGTH] = {0};
+    for (int i = msgNum - (int)count; i < msgNum; i++) {
+        EXPECT_EQ(TraceRbLogReadRbMsg(newRb, (char *)&timestamp, sizeof(timestamp), &txt), TRACE_SUCCESS);
+        EXPECT_STREQ(txt, ("msg_" + std::to_string(i)).c_str());
+    }
+    EXPECT_EQ(TraceRbLogReadRbMsg(newRb, (char *)&timestamp, sizeof(timestamp), &txt), TRACE_RING_BUFFER_EMPTY);
+    TraceRbLogDestroy(newRb);
+    TraceRbLogDestroy(rb);
+}
+
+static uint32_t g_fakeCpuId = 0;
+static int32_t FakeCpuId(void)
+{
+    return (int32_t)(g_fakeCpuId++);
+}
+
+TEST_F(RraceRbLogUtest, TestTraceRbLogMergeRings)
+{
+    MOCKER(TraceGetCpuNum).stubs().will(returnValue(4U));
+    MOCKER(TraceGetCpuId).stubs().will(invoke(FakeCpuId));
+    auto rb = GetDefaultRb();
+    EXPECT_EQ(rb->head.ringNum, 4);
+
+    // msgs of different lengths go to the rings in turn, they are read back in write order
+    int msgNum = 400;
+    for (int i = 0; i < msgNum; i++) {
+        std::string buffer = std::string(i % 50, '*') + "msg_" + std::to_string(i);
+        EXPECT_EQ(TraceRbLogWriteRbMsg(rb, 0, buffer.c_str(), buffer.length()), TRACE_SUCCESS);
+    }
+    for (uint32_t i = 0; i < rb->head.ringNum; i++) {
+        EXPECT_EQ(GetRing(rb, i)->msgCount, msgNum / 4);
+    }
+    struct RbLog *newRb = NULL;
+    EXPECT_EQ(TraceRbLogGetCopyOfRingBuffer(&newRb, rb), TRACE_SUCCESS);
+    EXPECT_EQ(TracerRbLogGetMsgNum(newRb), msgNum);
+    char *txt = NULL;
+    uint32_t len = 0;
+    uint64_t lastCycle = 0;
+    for (int i = 0; i < msgNum; i++) {
+        EXPECT_EQ(TraceRbLogReadOriRbMsg(newRb, &txt, &len), TRACE_SUCCESS);
+        // msgs are expanded to msgSize bytes for the binary file
+        EXPECT_EQ(len, newRb->head.msgSize);
+        RbLogMsg *msg = (RbLogMsg *)txt;
+        std::string expect = std::string(i % 50, '*') + "msg_" + std::to_string(i);
+        EXPECT_EQ(msg->head.txtSize, expect.length());
+        EXPECT_EQ(std::string(msg->txt, msg->head.txtSize), expect);
+        EXPECT_EQ(msg->txt[msg->head.txtSize], '\0');
+        EXPECT_GE(msg->head.cycle, lastCycle);
+        lastCycle = msg->head.cycle;
+    }
+    EXPECT_EQ(TraceRbLogReadOriRbMsg(newRb, &txt, &len), TRACE_RING_BUFFER_EMPTY);
+    TraceRbLogDestroy(newRb);
+
+    // the live buffer is read the same way after prepare
+    TraceRbLogPrepareForRead(rb);
+    uint64_t cycle = 0;
+    for (int i = 0; i < msgNum; i++) {
+        EXPECT_EQ(TraceRbLogReadOriRbMsgSafe(rb, &txt, &len, &cycle), TRACE_SUCCESS);
+        EXPECT_EQ(cycle, ((RbLogMsg *)txt)->head.cycle);
+    }
+    EXPECT_EQ(TraceRbLogReadOriRbMsgSafe(rb, &txt, &len, &cycle), TRACE_RING_BUFFER_EMPTY);
+    TraceRbLogDestroy(rb);
+}
+
+TEST_F(RraceRbLogUtest, TestTraceRbLogNoLockSingleRing)
+{
+    MOCKER(TraceGetCpuNum).stubs().will(returnValue(4U));
+    std::string name = "HCCL";
+    TraceAttr attr = { 0 };
+    attr.msgNum = 1024;
+    attr.msgSize = 112;
+    attr.noLock = TRACE_LOCK_FREE;
+    auto rb = TraceRbLogCreate(name.c_str(), &attr);
+    ASSERT_TRUE(rb != NULL);
+    EXPECT_EQ(rb->head.ringNum, 1);
+
+    // wrap around the ring several times
+    int msgNum = 5000;
+    for (int i = 0; i < msgNum; i++) {
+        std::string buffer = std::string(i % 100, '#') + std::to_string(i);
+        EXPECT_EQ(TraceRbLogWriteRbMsgNoLock(rb, 0, buffer.c_str(), buffer.length()), TRACE_SUCCESS);
+    }
+    uint32_t count = TracerRbLogGetMsgNum(rb);
+    EXPECT_GT(count, 0);
+    TraceRbLogPrepareForRead(rb);
+    char *txt = NULL;
+    char timestamp[TIMESTAMP_MAX_LENGTH] = {0};
+    for (int i = msgNum - (int)count; i < msgNum; i++) {
+        EXPECT_EQ(TraceRbLogReadRbMsgSafe(rb, (char *)&timestamp, sizeof(timestamp), &txt), TRACE_SUCCESS);
+        EXPECT_STREQ(txt, (std::string(i % 100, '#') + std::to_string(i)).c_str());
+    }
+    EXPECT_EQ(TraceRbLogReadRbMsgSafe(rb, (char *)&timestamp, sizeof(timestamp), &txt), TRACE_RING_BUFFER_EMPTY);
+    TraceRbLogDestroy(rb);
+}
@@ -10,6 +10,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <chrono>
+#include <thread>
+#include <vector>
 #include "gtest/gtest.h"
 #include "mockcpp/mockcpp.hpp"
 #include "osal/osal.h"
@@ -18,12 +21,18 @@
 #include "errno/error_code.h"
 #include "report/hash_dic.h"
 #include "report/report_manager.h"
+#include "report/report_buffer_mgr.h"
+#include "thread/thread_pool.h"
 #include "logger/logger.h"
 #include "osal/osal_thread.h"
 #include "transport/transport.h"
 #include "transport/uploader.h"
 #include "utils/utils.h"
 
+extern "C" {
+extern SizeCount g_sizeCount[REPORT_TYPE_MAX];
+}
+
 class TypeInfoUtest: public testing::Test {
 protected:
     virtual void SetUp()
@@ -47,4 +56,64 @@ TEST_F(TypeInfoUtest, RegisterTypeInfo)
     EXPECT_EQ(PROFILING_FAILED, MsprofRegTypeInfo(level, typeId, nullptr));
     // report not inited
     EXPECT_EQ(PROFILING_FAILED, MsprofRegTypeInfo(level, typeId, hashData));
-}
\ No newline at end of file
+}
+
+class ReportBufferUtest: public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        EXPECT_EQ(PROFILING_SUCCESS, ProfThreadPoolInit(10, 0, 10));
+        EXPECT_EQ(PROFILING_SUCCESS, ReportInitialize(1U << 17));
+        EXPECT_EQ(PROFILING_SUCCESS, ReportStart());
+    }
+    virtual void TearDown()
+    {
+        ReportUninitialize();
+        ProfThreadPoolFinalize();
+        GlobalMockObject::verify();
+    }
+};
+
+TEST_F(ReportBufferUtest, FlushPartialBatchByTimer)
+{
+    struct MsprofApi api = {};
+    api.level = 5000;
+    EXPECT_EQ(MSPROF_ERROR_NONE, ReportApiPush(0, &api));
+    for (uint32_t i = 0; i < 100 && g_sizeCount[REPORT_API_INDEX].totalPopCount == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(REPORT_BUFFER_FLUSH_INTERVAL_MS));
+    }
+    EXPECT_EQ(1U, g_sizeCount[REPORT_API_INDEX].totalPopCount);
+}
+
+TEST_F(ReportBufferUtest, PushFromThreadsWithoutLoss)
+{
+    const uint32_t threadNum = 4;
+    const uint32_t pushNum = 20000;
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> pushed(threadNum, 0U);
+    std::vector<uint32_t> dropped(threadNum, 0U);
+    for (uint32_t t = 0; t < threadNum; t++) {
+        threads.emplace_back([t, pushNum, &pushed, &dropped]() {
+            struct MsprofApi api = {};
+            api.level = 5000;
+            for (uint32_t i = 0; i < pushNum; i++) {
+                if (ReportApiPush(0, &api) == MSPROF_ERROR_NONE) {
+                    pushed[t]++;
+                } else {
+                    dropped[t]++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ReportStop();
+    uint64_t pushedNum = 0;
+    for (uint32_t t = 0; t < threadNum; t++) {
+        EXPECT_EQ(pushNum, pushed[t]);
+        EXPECT_EQ(0U, dropped[t]);
+        pushedNum += pushed[t];
+    }
+    EXPECT_EQ(pushedNum, g_sizeCount[REPORT_API_INDEX].totalPopCount);
+}
@@ -212,6 +212,31 @@ TEST_F(BindRelationUTest, BindRelation_MULTI_BIND)
     EXPECT_EQ(relation_.srcToDstRelation_.size(), 3);
 }
 
+TEST_F(BindRelationUTest, Order_BuildRouteTable)
+{
+    OptionalArg args = {};
+    args.eType = dgw::EntityType::ENTITY_TAG;
+    relation_.srcToDstRelation_[EntityInfo(1U, 0U)] = {EntityInfo(3U, 0U), EntityInfo(4U, 0U)};
+    relation_.srcToDstRelation_[EntityInfo(5U, 0U, &args)] = {EntityInfo(6U, 0U)};
+    relation_.dstToSrcRelation_[EntityInfo(3U, 0U)] = {EntityInfo(1U, 0U)};
+    relation_.dstToSrcRelation_[EntityInfo(4U, 0U)] = {EntityInfo(1U, 0U)};
+    relation_.dstToSrcRelation_[EntityInfo(6U, 0U)] = {EntityInfo(5U, 0U, &args)};
+
+    relation_.Order();
+    const auto& routeTable = relation_.GetRouteTable(0U);
+    ASSERT_EQ(routeTable.srcs.size(), 2U);
+    ASSERT_EQ(routeTable.dstOffsets.size(), 3U);
+    EXPECT_EQ(routeTable.dsts.size(), 3U);
+    ASSERT_EQ(routeTable.queueRoutes.count(1U), 1U);
+    ASSERT_EQ(routeTable.queueRoutes.at(1U).size(), 1U);
+    const uint32_t queueRoute = routeTable.queueRoutes.at(1U)[0U];
+    EXPECT_EQ(routeTable.srcs[queueRoute].GetId(), 1U);
+    EXPECT_EQ(routeTable.dstOffsets[queueRoute + 1U] - routeTable.dstOffsets[queueRoute], 2U);
+    // tag src is not woken by enqueue event
+    ASSERT_EQ(routeTable.eventlessRoutes.size(), 1U);
+    EXPECT_EQ(routeTable.srcs[routeTable.eventlessRoutes[0U]].GetId(), 5U);
+}
+
 TEST_F(BindRelationUTest, UpdateSubscribe_Success01)
 {
     std::vector<EntityInfoPtr> entities;
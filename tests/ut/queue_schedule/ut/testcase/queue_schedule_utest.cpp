@@ -25,6 +25,8 @@
 #include "try_push_state.h"
 #include "strategy/broadcast_strategy.h"
 #include "strategy/hash_strategy.h"
+#include "strategy/consistent_hash_strategy.h"
+#include "strategy/least_depth_strategy.h"
 #include "hccl/comm_channel_manager.h"
 #include "dynamic_sched_mgr.hpp"
 #include "schedule_config.h"
@@ -526,6 +528,36 @@ TEST_F(QueueScheduleUTest, ScheduleDataBuffAll_Q2T_success)
     bindRelation.Order();
 }
 
+TEST_F(QueueScheduleUTest, ScheduleDataBuffAll_OnlyReadyRoutes)
+{
+    auto& bindRelation = BindRelation::GetInstance();
+    auto src1 = EntityInfo(2U, 0U);
+    auto dst1 = EntityInfo(3U, 0U);
+    auto src2 = EntityInfo(4U, 0U);
+    auto dst2 = EntityInfo(5U, 0U);
+    EXPECT_EQ(BQS_STATUS_OK, bindRelation.Bind(src1, dst1));
+    EXPECT_EQ(BQS_STATUS_OK, bindRelation.Bind(src2, dst2));
+    bindRelation.Order();
+
+    const auto& routeTable = bindRelation.GetRouteTable(0U);
+    auto& readySet = queueSchedule.GetReadyQueueSet(0U);
+    readySet.overflow.store(false);
+    queueSchedule.MarkQueueReady(4U, 0U);
+    EXPECT_TRUE(queueSchedule.CollectReadyRoutes(routeTable, readySet));
+    ASSERT_EQ(readySet.routes.size(), 1U);
+    EXPECT_EQ(routeTable.srcs[readySet.routes[0U]].GetId(), 4U);
+    // ready queue is consumed by collect
+    EXPECT_TRUE(queueSchedule.CollectReadyRoutes(routeTable, readySet));
+    EXPECT_TRUE(readySet.routes.empty());
+
+    // queue id out of range can not be tracked, all routes are visited
+    queueSchedule.MarkQueueReady(MAX_QUEUE_ID_NUM, 0U);
+    EXPECT_FALSE(queueSchedule.CollectReadyRoutes(routeTable, readySet));
+    MOCKER(halQueueDeQueue).stubs().will(returnValue((int)DRV_ERROR_QUEUE_EMPTY));
+    queueSchedule.ScheduleDataBuffAll(true, 0U, false);
+    EXPECT_FALSE(readySet.overflow.load());
+}
+
 TEST_F(QueueScheduleUTest, ChangeErrorState_success)
 {
     auto& bindRelation = BindRelation::GetInstance();
@@ -3408,6 +3440,71 @@ TEST_F(QueueScheduleUTest, HashStrategy_SearchFail)
     EXPECT_EQ(dgw::FsmStatus::FSM_FAILED, hashStrategy.Search(0, 0, selEntityVec, 0));
 }
 
+TEST_F(QueueScheduleUTest, ConsistentHashStrategy_KeepAffinityWhenGroupChanged)
+{
+    dgw::EntityMaterial material = {};
+    material.eType = dgw::EntityType::ENTITY_QUEUE;
+    std::vector<dgw::EntityPtr> entities;
+    for (uint32_t i = 0U; i < 4U; ++i) {
+        material.id = 100U + i;
+        entities.emplace_back(std::make_shared<dgw::SimpleEntity>(material, 0U));
+    }
+    const uint32_t groupId = 1000U;
+    auto groupEntities = entities;
+    EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, dgw::EntityManager::Instance(0U).CreateGroup(groupId, groupEntities));
+
+    dgw::ConsistentHashStrategy strategy;
+    std::vector<dgw::EntityPtr> selEntityVec;
+    EXPECT_EQ(dgw::FsmStatus::FSM_FAILED, strategy.Search(groupId, 0UL, selEntityVec, 0U));
+    std::vector<dgw::Entity*> selected;
+    for (uint64_t transId = 1UL; transId <= 200UL; ++transId) {
+        selEntityVec.clear();
+        EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, strategy.Search(groupId, transId, selEntityVec, 0U));
+        ASSERT_EQ(selEntityVec.size(), 1U);
+        selected.emplace_back(selEntityVec[0U].get());
+    }
+
+    // remove the last entity, only its flows are remapped
+    EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, dgw::EntityManager::Instance(0U).DeleteGroup(groupId));
+    groupEntities.assign(entities.begin(), entities.begin() + 3);
+    EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, dgw::EntityManager::Instance(0U).CreateGroup(groupId, groupEntities));
+    for (uint64_t transId = 1UL; transId <= 200UL; ++transId) {
+        selEntityVec.clear();
+        EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, strategy.Search(groupId, transId, selEntityVec, 0U));
+        ASSERT_EQ(selEntityVec.size(), 1U);
+        if (selected[transId - 1UL] != entities[3U].get()) {
+            EXPECT_EQ(selEntityVec[0U].get(), selected[transId - 1UL]);
+        }
+    }
+    EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, dgw::EntityManager::Instance(0U).DeleteGroup(groupId));
+}
+
+TEST_F(QueueScheduleUTest, LeastDepthStrategy_SkipFullEntity)
+{
+    dgw::EntityMaterial material = {};
+    material.eType = dgw::EntityType::ENTITY_QUEUE;
+    material.id = 200U;
+    dgw::EntityPtr fullEntity = std::make_shared<dgw::SimpleEntity>(material, 0U);
+    material.id = 201U;
+    dgw::EntityPtr idleEntity = std::make_shared<dgw::SimpleEntity>(material, 0U);
+    fullEntity->curState_ = dgw::FsmState::FSM_FULL_STATE;
+    idleEntity->curState_ = dgw::FsmState::FSM_IDLE_STATE;
+    const uint32_t groupId = 1001U;
+    std::vector<dgw::EntityPtr> groupEntities = {fullEntity, idleEntity};
+    EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, dgw::EntityManager::Instance(0U).CreateGroup(groupId, groupEntities));
+
+    dgw::LeastDepthStrategy strategy;
+    std::vector<dgw::EntityPtr> selEntityVec;
+    EXPECT_EQ(dgw::FsmStatus::FSM_FAILED, strategy.Search(0U, 1UL, selEntityVec, 0U));
+    for (uint64_t transId = 1UL; transId <= 16UL; ++transId) {
+        selEntityVec.clear();
+        EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, strategy.Search(groupId, transId, selEntityVec, 0U));
+        ASSERT_EQ(selEntityVec.size(), 1U);
+        EXPECT_EQ(selEntityVec[0U], idleEntity);
+    }
+    EXPECT_EQ(dgw::FsmStatus::FSM_SUCCESS, dgw::EntityManager::Instance(0U).DeleteGroup(groupId));
+}
+
 TEST_F(QueueScheduleUTest, ScheduleDataBuffAll_PROCESS_MEMQ_ERROR)
 {
     GlobalMockObject::verify();
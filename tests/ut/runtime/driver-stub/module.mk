@@ -28,6 +28,7 @@ LOCAL_SRC_FILES := ../../../../src/cmodel_driver/driver_api.c \
                    ../../../../src/cmodel_driver/driver_impl.c \
                    ../../../../src/cmodel_driver/driver_mem.c \
                    ../../../../src/cmodel_driver/driver_queue.c \
+                   ../../../../src/cmodel_driver/driver_sim.c \
                    test/main.cc \
 				   test/drv_utest_device.cc\
 				   test/drv_utest_event.cc\
@@ -35,6 +36,7 @@ LOCAL_SRC_FILES := ../../../../src/cmodel_driver/driver_api.c \
 				   test/drv_utest_model.cc\
 				   test/drv_utest_mem.cc\
 				   test/drv_utest_dispatch.cc\
+				   test/drv_utest_sim.cc\
                    stub/drv_utest_stub.cc
 				   
 LOCAL_C_INCLUDES := $(TOPDIR)inc ${TOP_DIR}/inc/external $(TOPDIR) $(TOPDIR)src/cmodel_driver abl/libc_sec/include 
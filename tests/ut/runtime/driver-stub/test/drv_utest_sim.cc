@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2025 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gtest/gtest.h>
+#include "mockcpp/mockcpp.hpp"
+#include "driver/ascend_hal.h"
+#include "driver_sim.h"
+
+using namespace testing;
+
+class DrvSimTest : public testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        (void)setenv("CMODEL_DRV_SIM_DEVICE", "1", 1);
+        (void)setenv("CMODEL_DRV_SIM_LATENCY_US", "0", 1);
+        (void)setenv("CMODEL_DRV_SIM_CQ_BATCH", "1", 1);
+    }
+
+    virtual void TearDown()
+    {
+        drvSimExit();
+        (void)unsetenv("CMODEL_DRV_SIM_DEVICE");
+        (void)unsetenv("CMODEL_DRV_SIM_LATENCY_US");
+        (void)unsetenv("CMODEL_DRV_SIM_CQ_BATCH");
+        GlobalMockObject::verify();
+    }
+};
+
+TEST_F(DrvSimTest, sim_init_and_exit)
+{
+    (void)unsetenv("CMODEL_DRV_SIM_DEVICE");
+    EXPECT_EQ(drvSimInit(), DRV_ERROR_NONE);
+    EXPECT_EQ(drvSimIsEnabled(), DRV_FALSE);
+
+    (void)setenv("CMODEL_DRV_SIM_DEVICE", "1", 1);
+    EXPECT_EQ(drvSimInit(), DRV_ERROR_NONE);
+    EXPECT_EQ(drvSimIsEnabled(), DRV_TRUE);
+    drvSimExit();
+    EXPECT_EQ(drvSimIsEnabled(), DRV_FALSE);
+
+    // exit twice is harmless
+    drvSimExit();
+    EXPECT_EQ(drvSimIsEnabled(), DRV_FALSE);
+}
+
+static uint32_t g_simThreadCreateCount = 0U;
+static uint32_t g_simThreadJoinCount = 0U;
+
+// the thread of the last device fails to start, the devices before it pretend to run
+static int StubSimThreadCreate(pthread_t* thread, const pthread_attr_t* attr, void* (*routine)(void*), void* arg)
+{
+    (void)attr;
+    (void)routine;
+    (void)arg;
+    g_simThreadCreateCount++;
+    if (g_simThreadCreateCount == static_cast<uint32_t>(MAX_DEV_NUM)) {
+        return EAGAIN;
+    }
+    *thread = 0;
+    return 0;
+}
+
+static int StubSimThreadJoin(pthread_t thread, void** ret)
+{
+    (void)thread;
+    (void)ret;
+    g_simThreadJoinCount++;
+    return 0;
+}
+
+TEST_F(DrvSimTest, sim_init_fail_unwind_started_device)
+{
+    g_simThreadCreateCount = 0U;
+    g_simThreadJoinCount = 0U;
+    MOCKER(pthread_create).stubs().will(invoke(StubSimThreadCreate));
+    MOCKER(pthread_join).stubs().will(invoke(StubSimThreadJoin));
+    EXPECT_EQ(drvSimInit(), DRV_ERROR_INNER_ERR);
+    EXPECT_EQ(drvSimIsEnabled(), DRV_FALSE);
+    // every device started before the failed one is stopped
+    EXPECT_EQ(g_simThreadJoinCount, static_cast<uint32_t>(MAX_DEV_NUM) - 1U);
+    GlobalMockObject::verify();
+
+    // nothing is left behind, a later init succeeds
+    EXPECT_EQ(drvSimInit(), DRV_ERROR_NONE);
+    EXPECT_EQ(drvSimIsEnabled(), DRV_TRUE);
+}
+
+TEST_F(DrvSimTest, sim_sq_to_cq_report)
+{
+    const uint32_t devId = 0U;
+    const uint32_t sqId = 1U;
+    const uint16_t streamId = 5U;
+    const uint16_t taskIds[] = {7U, 8U};
+    const uint32_t cmdCount = sizeof(taskIds) / sizeof(taskIds[0]);
+    ASSERT_EQ(drvSimInit(), DRV_ERROR_NONE);
+
+    struct halSqMemGetInput in;
+    struct halSqMemGetOutput out;
+    (void)memset(&in, 0, sizeof(in));
+    (void)memset(&out, 0, sizeof(out));
+    in.sqId = sqId;
+    in.cmdCount = cmdCount;
+    ASSERT_EQ(drvSimSqMemGet(devId, &in, &out), DRV_ERROR_NONE);
+    ASSERT_EQ(out.cmdCount, cmdCount);
+    drvCommandStruct_t* cmd = (drvCommandStruct_t*)out.cmdPtr;
+    for (uint32_t i = 0U; i < cmdCount; i++) {
+        (void)memset(cmd[i].dummy, 0, sizeof(cmd[i].dummy));
+        (void)memcpy(&cmd[i].dummy[0], &streamId, sizeof(streamId));
+        (void)memcpy(&cmd[i].dummy[2], &taskIds[i], sizeof(taskIds[i]));
+    }
+
+    struct halSqMsgInfo info;
+    (void)memset(&info, 0, sizeof(info));
+    info.sqId = sqId;
+    info.cmdCount = cmdCount;
+    ASSERT_EQ(drvSimSqMsgSend(devId, &info), DRV_ERROR_NONE);
+
+    // reports come back in order of the sqes
+    uint32_t received = 0U;
+    while (received < cmdCount) {
+        ASSERT_EQ(drvSimCqReportWait(devId, 1000), DRV_ERROR_NONE);
+        struct halReportGetOutput report;
+        (void)memset(&report, 0, sizeof(report));
+        ASSERT_EQ(drvSimCqReportGet(devId, &report), DRV_ERROR_NONE);
+        ASSERT_GT(report.count, 0U);
+        const drvSimReport_t* reports = (const drvSimReport_t*)report.reportPtr;
+        for (uint32_t i = 0U; (i < report.count) && (received < cmdCount); i++, received++) {
+            EXPECT_EQ(static_cast<uint16_t>(reports[i].streamId), streamId);
+            EXPECT_EQ(reports[i].taskId, taskIds[received]);
+            EXPECT_EQ(static_cast<uint32_t>(reports[i].sqId), sqId);
+        }
+        EXPECT_EQ(drvSimReportRelease(devId, report.count), DRV_ERROR_NONE);
+    }
+
+    // no more reports
+    EXPECT_EQ(drvSimCqReportWait(devId, 0), DRV_ERROR_WAIT_TIMEOUT);
+    drvSimSqFree(devId, sqId);
+}
@@ -9,6 +9,7 @@
  */
 #include "../../rt_utest_api.hpp"
 #include "profiling_task.h"
+#include "stars_engine.hpp"
 #include "../../data/elf.h"
 
 class CloudV2ApiTest910b : public testing::Test {
@@ -2267,6 +2268,66 @@ TEST_F(CloudV2ApiTest910b, kernel_launch_cloud)
     EXPECT_EQ(error, RT_ERROR_NONE);
 }
 
+drvError_t StubHalSqTaskSendNormalType(uint32_t devId, struct halTaskSendInfo* info);
+
+static uint32_t g_sqTaskSendNum = 0U;
+
+static drvError_t halSqTaskSendCountStub(uint32_t devId, struct halTaskSendInfo* info)
+{
+    g_sqTaskSendNum++;
+    return StubHalSqTaskSendNormalType(devId, info);
+}
+
+TEST_F(CloudV2ApiTest910b, kernel_launch_submit_batch)
+{
+    rtError_t error;
+    void* args[] = {&error, NULL};
+    constexpr uint32_t batchSize = 4U;
+    constexpr uint32_t launchNum = 10U;
+
+    rtStream_t stream;
+    error = rtStreamCreate(&stream, 0);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    Stream* stm = rt_ut::UnwrapOrNull<Stream>(stream);
+    rtStreamAttrValue_t value = {0};
+    value.submitBatchSize = batchSize;
+    error = rtsStreamSetAttribute(stream, RT_STREAM_ATTR_SUBMIT_BATCH, &value);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    ASSERT_EQ(stm->GetSubmitBatchSize(), batchSize);
+
+    // the deadline never passes, only a full batch or a flush sends the held back kernels
+    MOCKER_CPP(&StarsEngine::GetBatchRemainTime).stubs().will(returnValue(static_cast<uint64_t>(50U)));
+    MOCKER(halSqTaskSend).stubs().will(invoke(halSqTaskSendCountStub));
+    g_sqTaskSendNum = 0U;
+    for (uint32_t i = 0U; i < launchNum; i++) {
+        error = rtKernelLaunch(&function_, 1, (void*)args, sizeof(args), NULL, stream);
+        EXPECT_EQ(error, RT_ERROR_NONE);
+    }
+    EXPECT_EQ(g_sqTaskSendNum, launchNum / batchSize);
+    EXPECT_EQ(stm->GetSubmitBatch().taskNum, launchNum % batchSize);
+
+    error = rtStreamSynchronize(stream);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    EXPECT_EQ(stm->GetSubmitBatch().taskNum, 0U);
+    EXPECT_EQ(g_sqTaskSendNum, launchNum / batchSize + 1U);
+    GlobalMockObject::verify();
+
+    // a failed batched send is reported by the next synchronize
+    MOCKER_CPP(&StarsEngine::GetBatchRemainTime).stubs().will(returnValue(static_cast<uint64_t>(50U)));
+    error = rtKernelLaunch(&function_, 1, (void*)args, sizeof(args), NULL, stream);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    MOCKER_CPP_VIRTUAL(stm, &Stream::PrintStmDfxAndCheckDevice).stubs().will(returnValue(RT_ERROR_DRV_ERR));
+    MOCKER(halSqTaskSend).stubs().will(returnValue(DRV_ERROR_IOCRL_FAIL));
+    error = rtStreamSynchronize(stream);
+    EXPECT_NE(error, RT_ERROR_NONE);
+    EXPECT_EQ(stm->GetSubmitBatch().taskNum, 0U);
+    EXPECT_EQ(stm->GetSubmitBatch().error, RT_ERROR_NONE);
+    GlobalMockObject::verify();
+
+    error = rtStreamDestroy(stream);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+}
+
 TEST_F(CloudV2ApiTest910b, kernel_launch_fusion_not_mini)
 {
     rtError_t error;
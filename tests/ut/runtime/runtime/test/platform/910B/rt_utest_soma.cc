@@ -519,3 +519,47 @@ TEST_F(SomaTest, SomaApiEventStateCallbackRegTest)
         EventStateCallbackType::RT_EVENT_STATE_CALLBACK_TYPE_MAX);
     EXPECT_EQ(ret, RT_ERROR_INVALID_VALUE);
 }
+
+TEST_F(SomaTest, MemPoolTest_AllocedSlots)
+{
+    constexpr uint64_t blockSize = DEVICE_POOL_MIN_BLOCK_SIZE;
+    Segment* initSeg = SegmentManager::CreateSegment((64ULL << 30), 8U * blockSize, nullptr, nullptr);
+    SegmentManager* memPool = PoolRegistry::CreateManager(initSeg, 0U, true);
+    PoolRegistry::Instance().RegisterMemPool(memPool);
+    ReuseFlag flag = ReuseFlag::REUSE_FLAG_NONE;
+
+    Segment* ptr = nullptr;
+    rtError_t error = memPool->SegmentAlloc(ptr, blockSize, 1, flag);
+    ASSERT_EQ(error, RT_ERROR_NONE);
+    const uint64_t va = ptr->basePtr;
+    EXPECT_EQ(memPool->GetAllocSize(va), blockSize);
+    EXPECT_EQ(memPool->GetAllocSize(va + 1U), 0U);
+    error = memPool->SegmentFree(va);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    EXPECT_EQ(memPool->GetAllocSize(va), 0U);
+    error = memPool->SegmentFree(va);
+    EXPECT_EQ(error, RT_ERROR_POOL_PTR_NOTFOUND);
+    uint64_t usedSize = 1U;
+    memPool->GetAttribute(rtMemPoolAttrUsedMemCurrent, &usedSize);
+    EXPECT_EQ(usedSize, 0U);
+    EXPECT_EQ(memPool->cachedSegs_.size(), 1U);
+
+    // the freed segment stays cached, the next allocation on the same stream comes from the free segments
+    error = memPool->SegmentAlloc(ptr, blockSize, 1, flag);
+    ASSERT_EQ(error, RT_ERROR_NONE);
+    EXPECT_NE(ptr->basePtr, va);
+    EXPECT_EQ(flag, ReuseFlag::REUSE_FLAG_NONE);
+    EXPECT_EQ(memPool->GetAllocSize(ptr->basePtr), blockSize);
+    error = memPool->SegmentFree(ptr->basePtr);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+
+    error = memPool->TrimTo(0U);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    uint64_t reservedSize = 1U;
+    memPool->GetAttribute(rtMemPoolAttrReservedMemCurrent, &reservedSize);
+    EXPECT_EQ(reservedSize, 0U);
+
+    std::shared_ptr<SegmentManager> owned;
+    error = PoolRegistry::Instance().RemoveMemPool(memPool, owned);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+}
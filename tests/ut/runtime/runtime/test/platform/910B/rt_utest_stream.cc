@@ -9,6 +9,7 @@
  */
 #include <cstdio>
 #include <stdlib.h>
+#include <thread>
 
 #include "driver/ascend_hal.h"
 #include "runtime/rt.h"
@@ -198,6 +199,146 @@ TEST_F(CloudV2StreamTest, stream_get_attribute2)
     ((Runtime*)Runtime::Instance())->DeviceRelease(device);
 }
 
+TEST_F(CloudV2StreamTest, stream_submit_batch_attribute)
+{
+    rtError_t error;
+    rtStreamAttrValue_t setvalue = {0};
+    rtStreamAttrValue_t getvalue = {0};
+    rtStream_t stm;
+    error = rtStreamCreate(&stm, 0);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    Stream* stream = rt_ut::UnwrapOrNull<Stream>(stm);
+    const uint32_t expectSize = std::min(16U, stream->GetSqDepth() / 4U);
+
+    setvalue.submitBatchSize = 16U;
+    error = rtsStreamSetAttribute(stm, RT_STREAM_ATTR_SUBMIT_BATCH, &setvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    error = rtsStreamGetAttribute(stm, RT_STREAM_ATTR_SUBMIT_BATCH, &getvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    EXPECT_EQ(getvalue.submitBatchSize, (expectSize > 1U) ? expectSize : 0U);
+    EXPECT_EQ(stream->GetSubmitBatch().taskNum, 0U);
+
+    // nothing is held back, flush is a no-op
+    error = rtStreamSynchronize(stm);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+
+    setvalue.submitBatchSize = RT_STREAM_SUBMIT_BATCH_SIZE_MAX + 1U;
+    error = rtsStreamSetAttribute(stm, RT_STREAM_ATTR_SUBMIT_BATCH, &setvalue);
+    EXPECT_EQ(error, ACL_ERROR_RT_PARAM_INVALID);
+
+    setvalue.submitBatchSize = 0U;
+    error = rtsStreamSetAttribute(stm, RT_STREAM_ATTR_SUBMIT_BATCH, &setvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    getvalue = {0};
+    error = rtsStreamGetAttribute(stm, RT_STREAM_ATTR_SUBMIT_BATCH, &getvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    EXPECT_EQ(getvalue.submitBatchSize, 0U);
+
+    error = rtStreamDestroy(stm);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+}
+
+TEST_F(CloudV2StreamTest, stream_sync_wait_mode_attribute)
+{
+    rtError_t error;
+    rtStreamAttrValue_t setvalue = {0};
+    rtStreamAttrValue_t getvalue = {0};
+    rtStream_t stm;
+    error = rtStreamCreate(&stm, 0);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+
+    error = rtsStreamGetAttribute(stm, RT_STREAM_ATTR_SYNC_WAIT_MODE, &getvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    EXPECT_EQ(getvalue.syncWaitMode, RT_STREAM_SYNC_WAIT_ADAPTIVE);
+
+    setvalue.syncWaitMode = RT_STREAM_SYNC_WAIT_LOW_CPU;
+    error = rtsStreamSetAttribute(stm, RT_STREAM_ATTR_SYNC_WAIT_MODE, &setvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    error = rtsStreamGetAttribute(stm, RT_STREAM_ATTR_SYNC_WAIT_MODE, &getvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    EXPECT_EQ(getvalue.syncWaitMode, RT_STREAM_SYNC_WAIT_LOW_CPU);
+
+    setvalue.syncWaitMode = RT_STREAM_SYNC_WAIT_MAX;
+    error = rtsStreamSetAttribute(stm, RT_STREAM_ATTR_SYNC_WAIT_MODE, &setvalue);
+    EXPECT_EQ(error, ACL_ERROR_RT_PARAM_INVALID);
+
+    getvalue.syncWaitStat.spinNum = UINT32_MAX;
+    error = rtsStreamGetAttribute(stm, RT_STREAM_ATTR_SYNC_WAIT_STAT, &getvalue);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+    EXPECT_EQ(getvalue.syncWaitStat.spinNum, 0U);
+    EXPECT_EQ(getvalue.syncWaitStat.parkNum, 0U);
+    error = rtsStreamSetAttribute(stm, RT_STREAM_ATTR_SYNC_WAIT_STAT, &setvalue);
+    EXPECT_EQ(error, ACL_ERROR_RT_PARAM_INVALID);
+
+    error = rtStreamDestroy(stm);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+}
+
+static uint64_t g_waitPolicyClockUs = 0ULL;
+static uint64_t WaitPolicyFakeClockUs()
+{
+    return g_waitPolicyClockUs;
+}
+
+TEST_F(CloudV2StreamTest, stream_wait_policy_untrained)
+{
+    StreamWaitPolicy policy(&WaitPolicyFakeClockUs);
+    StreamWaitStat stat = {};
+    g_waitPolicyClockUs = 1000ULL;
+
+    // nothing learned: less than 10 pending tasks spin, 10 or more sleep
+    EXPECT_EQ(policy.Wait(0U, 9U, nullptr), false);
+    policy.GetStat(stat);
+    EXPECT_EQ(stat.spinNum, 1U);
+    EXPECT_EQ(stat.parkNum, 0U);
+    EXPECT_EQ(policy.Wait(0U, 10U, []() { return true; }), true);
+    EXPECT_EQ(policy.Wait(0U, 200U, []() { return true; }), true);
+    policy.GetStat(stat);
+    EXPECT_EQ(stat.spinNum, 1U);
+    EXPECT_EQ(stat.parkNum, 2U);
+    EXPECT_EQ(stat.pollNum, 2U);
+    EXPECT_EQ(stat.taskTimeNs, 0U);
+}
+
+TEST_F(CloudV2StreamTest, stream_wait_policy_learn_and_park)
+{
+    StreamWaitPolicy policy(&WaitPolicyFakeClockUs);
+    StreamWaitStat stat = {};
+    g_waitPolicyClockUs = 1000ULL;
+
+    // one task finished 1500us after the previous wait
+    EXPECT_EQ(policy.Wait(0U, 5U, nullptr), false);
+    g_waitPolicyClockUs += 1500ULL;
+    EXPECT_EQ(policy.Wait(1U, 1U, nullptr), false);
+    policy.GetStat(stat);
+    EXPECT_EQ(stat.spinNum, 1U);
+    EXPECT_EQ(stat.parkNum, 0U);
+    EXPECT_EQ(stat.taskTimeNs, 1500U * 1000U);
+
+    // progress seen after a long gap without waiters is not learned
+    g_waitPolicyClockUs += 100000ULL;
+    EXPECT_EQ(policy.Wait(3U, 3U, nullptr), false);
+    policy.GetStat(stat);
+    EXPECT_EQ(stat.taskTimeNs, 1500U * 1000U);
+
+    // far from the learned completion time, sleep until the recycle path notifies
+    std::atomic<bool> done{false};
+    std::thread notifier([&policy, &done]() {
+        done.store(true);
+        policy.Notify();
+    });
+    EXPECT_EQ(policy.Wait(3U, 12U, [&done]() { return done.load(); }), true);
+    notifier.join();
+    policy.GetStat(stat);
+    EXPECT_EQ(stat.parkNum, 1U);
+
+    policy.SetMode(RT_STREAM_SYNC_WAIT_LOW_LATENCY);
+    EXPECT_EQ(policy.Wait(3U, 12U, nullptr), false);
+    policy.GetStat(stat);
+    EXPECT_EQ(stat.parkNum, 1U);
+    EXPECT_EQ(stat.spinNum, 2U);
+}
+
 TEST_F(CloudV2StreamTest, rtsLaunchHostFunc01)
 {
     rtError_t error;
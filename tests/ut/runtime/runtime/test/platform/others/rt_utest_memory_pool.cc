@@ -75,6 +75,17 @@ rtError_t DevMemAllocStubxx(
     return RT_ERROR_NONE;
 }
 
+// 每次返回不同的 2M 假地址，模拟各内存池地址互不重叠
+rtError_t DevMemAllocFakeAddrStub(
+    NpuDriver* drv, void** dptr, uint64_t size, rtMemType_t type, uint32_t deviceId, uint16_t moduleId, bool isLogError,
+    bool readOnlyFlag, bool starsTillingFlag, bool isNewApi, bool cpOnlyFlag)
+{
+    static uintptr_t fakeAddr = 0x100000000ULL;
+    *dptr = reinterpret_cast<void*>(fakeAddr);
+    fakeAddr += POOL_SIZE_2M;
+    return RT_ERROR_NONE;
+}
+
 TEST_F(MemoryPoolManagerTest, kernel_memory_pool_test)
 {
     int32_t devId = -1;
@@ -83,12 +94,8 @@ TEST_F(MemoryPoolManagerTest, kernel_memory_pool_test)
 
     NpuDriver* rawDrv = new NpuDriver();
 
-    void* memBase = (void*)100;
     MOCKER(memcpy_s).stubs().will(returnValue(NULL));
-    MOCKER_CPP_VIRTUAL(rawDrv, &NpuDriver::DevMemAlloc)
-        .stubs()
-        .with(outBoundP(&memBase, sizeof(memBase)), mockcpp::any(), mockcpp::any(), mockcpp::any())
-        .will(returnValue(RT_ERROR_NONE));
+    MOCKER_CPP_VIRTUAL(rawDrv, &NpuDriver::DevMemAlloc).stubs().will(invoke(DevMemAllocFakeAddrStub));
 
     int64_t aiCpuCnt = 1;
     MOCKER_CPP_VIRTUAL(rawDrv, &NpuDriver::GetDevInfo)
@@ -205,6 +212,123 @@ TEST_F(MemoryPoolManagerTest, kernel_memory_list_test)
     ((Runtime*)Runtime::Instance())->DeviceRelease(device);
 }
 
+TEST_F(MemoryPoolManagerTest, kernel_memory_pool_coalesce_and_stat)
+{
+    int32_t devId = -1;
+    rtError_t error;
+    Device* device;
+
+    NpuDriver* rawDrv = new NpuDriver();
+
+    MOCKER(memcpy_s).stubs().will(returnValue(NULL));
+    MOCKER_CPP_VIRTUAL(rawDrv, &NpuDriver::DevMemAlloc).stubs().will(invoke(DevMemAllocFakeAddrStub));
+
+    int64_t aiCpuCnt = 1;
+    MOCKER_CPP_VIRTUAL(rawDrv, &NpuDriver::GetDevInfo)
+        .stubs()
+        .with(mockcpp::any(), mockcpp::any(), mockcpp::any(), outBoundP(&aiCpuCnt, sizeof(aiCpuCnt)))
+        .will(returnValue(RT_ERROR_NONE));
+    error = rtGetDevice(&devId);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+
+    device = ((Runtime*)Runtime::Instance())->DeviceRetain(devId, 0);
+
+    MemoryPoolManager* kernelMemPoolMng = new (std::nothrow) MemoryPoolManager(device);
+    error = kernelMemPoolMng->Init();
+    EXPECT_EQ(error, RT_ERROR_NONE);
+
+    // 申请 0.5M, 1M, 0.5M 占满一个内存池
+    const size_t halfSize = 512 * 1024;
+    const size_t oneSize = 1024 * 1024;
+    uint8_t* deviceMem1 = static_cast<uint8_t*>(kernelMemPoolMng->Allocate(halfSize, true));
+    uint8_t* deviceMem2 = static_cast<uint8_t*>(kernelMemPoolMng->Allocate(oneSize, true));
+    uint8_t* deviceMem3 = static_cast<uint8_t*>(kernelMemPoolMng->Allocate(halfSize, true));
+    EXPECT_EQ(deviceMem2, deviceMem1 + halfSize);
+    EXPECT_EQ(deviceMem3, deviceMem2 + oneSize);
+
+    MemoryPoolStat stat;
+    kernelMemPoolMng->GetStat(stat);
+    EXPECT_EQ(stat.poolNum, 1U);
+    EXPECT_EQ(stat.usedSize, POOL_SIZE_2M);
+    EXPECT_EQ(stat.largestFreeBlock, 0U);
+
+    // 释放相邻的 0.5M 和 1M 后立即合并，1.5M 的申请不需要新建内存池
+    kernelMemPoolMng->Release(deviceMem1, halfSize);
+    kernelMemPoolMng->Release(deviceMem2, oneSize);
+    kernelMemPoolMng->GetStat(stat);
+    EXPECT_EQ(stat.freeBlockNum, 1U);
+    EXPECT_EQ(stat.largestFreeBlock, halfSize + oneSize);
+    EXPECT_DOUBLE_EQ(stat.fragmentation, 0.0);
+
+    void* deviceMem4 = kernelMemPoolMng->Allocate(halfSize + oneSize, true);
+    EXPECT_EQ(deviceMem4, deviceMem1);
+    EXPECT_EQ(kernelMemPoolMng->numPools_, 1);
+
+    // 非块首地址和重复释放不会破坏空闲块
+    EXPECT_TRUE(kernelMemPoolMng->TryRelease(deviceMem1 + 1, halfSize));
+    kernelMemPoolMng->Release(deviceMem3, halfSize);
+    EXPECT_FALSE(kernelMemPoolMng->TryRelease(deviceMem3, halfSize));
+    kernelMemPoolMng->GetStat(stat);
+    EXPECT_EQ(stat.usedSize, halfSize + oneSize);
+    EXPECT_EQ(stat.highWaterMark, POOL_SIZE_2M);
+
+    kernelMemPoolMng->Release(deviceMem4, halfSize + oneSize);
+    kernelMemPoolMng->GetStat(stat);
+    EXPECT_EQ(stat.usedSize, 0U);
+    EXPECT_EQ(stat.largestFreeBlock, POOL_SIZE_2M);
+
+    delete kernelMemPoolMng;
+    delete rawDrv;
+    ((Runtime*)Runtime::Instance())->DeviceRelease(device);
+}
+
+TEST_F(MemoryPoolManagerTest, kernel_memory_pool_index_lookup)
+{
+    int32_t devId = -1;
+    rtError_t error;
+    Device* device;
+
+    NpuDriver* rawDrv = new NpuDriver();
+
+    MOCKER(memcpy_s).stubs().will(returnValue(NULL));
+    MOCKER_CPP_VIRTUAL(rawDrv, &NpuDriver::DevMemAlloc).stubs().will(invoke(DevMemAllocFakeAddrStub));
+
+    int64_t aiCpuCnt = 1;
+    MOCKER_CPP_VIRTUAL(rawDrv, &NpuDriver::GetDevInfo)
+        .stubs()
+        .with(mockcpp::any(), mockcpp::any(), mockcpp::any(), outBoundP(&aiCpuCnt, sizeof(aiCpuCnt)))
+        .will(returnValue(RT_ERROR_NONE));
+    error = rtGetDevice(&devId);
+    EXPECT_EQ(error, RT_ERROR_NONE);
+
+    device = ((Runtime*)Runtime::Instance())->DeviceRetain(devId, 0);
+
+    MemoryPoolManager* kernelMemPoolMng = new (std::nothrow) MemoryPoolManager(device);
+    error = kernelMemPoolMng->Init();
+    EXPECT_EQ(error, RT_ERROR_NONE);
+
+    // 每个池占满，按地址索引定位所属池
+    uint8_t* deviceMem1 = static_cast<uint8_t*>(kernelMemPoolMng->Allocate(POOL_SIZE_2M, true));
+    uint8_t* deviceMem2 = static_cast<uint8_t*>(kernelMemPoolMng->Allocate(POOL_SIZE_2M, true));
+    EXPECT_EQ(kernelMemPoolMng->numPools_, 2);
+    EXPECT_EQ(kernelMemPoolMng->GetMemoryPoolBaseAddr(deviceMem2 + 4096), deviceMem2);
+    EXPECT_EQ(kernelMemPoolMng->GetMemoryPoolBaseAddr(deviceMem1 + POOL_SIZE_2M - 1), deviceMem1);
+    PoolMemInfo info = kernelMemPoolMng->GetPoolMemInfo(deviceMem2);
+    EXPECT_TRUE(info.found);
+    EXPECT_EQ(info.baseAddr, deviceMem2);
+
+    EXPECT_TRUE(kernelMemPoolMng->TryRelease(deviceMem2, POOL_SIZE_2M));
+    EXPECT_FALSE(kernelMemPoolMng->Contains(deviceMem2));
+    EXPECT_TRUE(kernelMemPoolMng->Contains(deviceMem1));
+    kernelMemPoolMng->Release(deviceMem1, POOL_SIZE_2M);
+    EXPECT_FALSE(kernelMemPoolMng->Contains(deviceMem1));
+    EXPECT_EQ(kernelMemPoolMng->GetMemoryPoolBaseAddr(deviceMem1), nullptr);
+
+    delete kernelMemPoolMng;
+    delete rawDrv;
+    ((Runtime*)Runtime::Instance())->DeviceRelease(device);
+}
+
 TEST_F(MemoryPoolManagerTest, kernel_memory_pool_allocate_fail)
 {
     int32_t devId = -1;
@@ -1147,6 +1147,38 @@ TEST_F(NpuDriverTest, buffer_allocator_test1)
     EXPECT_EQ(id, -1);
 }
 
+TEST_F(NpuDriverTest, bitmap_summary_alloc_free_test)
+{
+    const uint32_t maxCnt = 64U * 64U * 2U + 3U;
+    Bitmap bitmap(maxCnt);
+    for (uint32_t i = 0U; i < maxCnt; i++) {
+        EXPECT_EQ(bitmap.AllocId(), static_cast<int32_t>(i));
+    }
+    EXPECT_EQ(bitmap.GetAllocedCount(), maxCnt);
+    EXPECT_EQ(bitmap.summaryL1_[0], 0ULL);
+    EXPECT_EQ(bitmap.summaryL2_[0], 0ULL);
+    EXPECT_EQ(bitmap.AllocId(), -1);
+
+    // a freed id deep in the map is found through the summary levels
+    bitmap.FreeId(5000);
+    EXPECT_NE(bitmap.summaryL2_[0], 0ULL);
+    EXPECT_EQ(bitmap.AllocId(), 5000);
+    EXPECT_EQ(bitmap.AllocId(), -1);
+
+    // limited allocation never returns an id beyond the limit
+    bitmap.FreeId(maxCnt - 1U);
+    EXPECT_EQ(bitmap.AllocId(100U), -1);
+    EXPECT_EQ(bitmap.AllocId(), static_cast<int32_t>(maxCnt - 1U));
+
+    bitmap.OccupyId(10);
+    bitmap.FreeId(10);
+    bitmap.FreeId(11);
+    EXPECT_EQ(bitmap.GetAllocedCount(), maxCnt - 2U);
+    bitmap.OccupyId(10);
+    bitmap.OccupyId(11);
+    EXPECT_EQ(bitmap.summaryL1_[0], 0ULL);
+}
+
 // itemSzie = 0,  constructor error
 TEST_F(NpuDriverTest, buffer_allocator_error1)
 {
@@ -163,3 +163,83 @@ TEST_F(MemsetTaskTest, MemsetD32OnDevice_totalBytes_exceeds_destMax)
     rtError_t error = MemsetD32OnDevice(nullptr, 8U, 0xABABABABU, 10U, nullptr, false);
     EXPECT_EQ(error, RT_ERROR_INVALID_VALUE);
 }
+
+// 超过并行阈值的填充由 worker 线程分段完成，检查各分段边界及前后未越界
+TEST(SimdUtilsTest, OptimizedParallelUnaligned)
+{
+    const size_t count = 48 * 1024 * 1024 / sizeof(uint32_t) + 13; // 48MB，非分段整数倍
+    uint32_t* buf = (uint32_t*)aligned_alloc(64, (count + 2) * sizeof(uint32_t));
+    if (buf == nullptr) {
+        GTEST_SKIP() << "Cannot allocate 48MB for parallel test";
+    }
+    buf[0] = 0U;
+    buf[count + 1] = 0U;
+    const uint32_t value = 0x3C3C5A5A;
+    MemsetD32Optimized(buf + 1, value, count);
+    EXPECT_EQ(buf[0], 0U);
+    EXPECT_EQ(buf[count + 1], 0U);
+    size_t mismatch = 0;
+    for (size_t i = 1; i <= count; ++i) {
+        mismatch += (buf[i] != value) ? 1U : 0U;
+    }
+    EXPECT_EQ(mismatch, 0U);
+    free(buf);
+}
+
+// 串行版本与优化版本结果一致
+TEST(SimdUtilsTest, SerialVariousCounts)
+{
+    std::vector<size_t> counts = {0, 1, 7, 8, 9, 31, 33, 1023, 4097};
+    uint32_t* buf = (uint32_t*)aligned_alloc(32, (4097 + 2) * sizeof(uint32_t));
+    ASSERT_NE(buf, nullptr);
+    for (size_t n : counts) {
+        buf[n + 1] = 0U;
+        MemsetD32Serial(buf + 1, 0x11223344U, n);
+        for (size_t i = 1; i <= n; ++i) {
+            EXPECT_EQ(buf[i], 0x11223344U) << "Failed at n=" << n;
+        }
+        EXPECT_EQ(buf[n + 1], 0U) << "Overrun at n=" << n;
+    }
+    free(buf);
+}
+
+// 16位填充：起始地址 2 字节对齐但非 4 字节对齐，且元素个数为奇数
+TEST(SimdUtilsTest, MemsetD16OptimizedUnaligned)
+{
+    const size_t count = 4099;
+    uint16_t* buf = (uint16_t*)aligned_alloc(32, (count + 2) * sizeof(uint16_t));
+    ASSERT_NE(buf, nullptr);
+    buf[0] = 0U;
+    buf[count + 1] = 0U;
+    MemsetD16Optimized(buf + 1, 0xBEEF, count);
+    EXPECT_EQ(buf[0], 0U);
+    EXPECT_EQ(buf[count + 1], 0U);
+    for (size_t i = 1; i <= count; ++i) {
+        EXPECT_EQ(buf[i], 0xBEEF) << "Failed at i=" << i;
+    }
+    free(buf);
+}
+
+// 8位填充：小块走 memset，大块走流式写入，均检查首尾不越界
+TEST(SimdUtilsTest, MemsetD8OptimizedSmallAndLarge)
+{
+    std::vector<size_t> counts = {0, 1, 3, 4097, 40 * 1024 * 1024 + 3};
+    const size_t maxCount = counts.back();
+    uint8_t* buf = (uint8_t*)aligned_alloc(64, maxCount + 64);
+    if (buf == nullptr) {
+        GTEST_SKIP() << "Cannot allocate 40MB for D8 test";
+    }
+    for (size_t n : counts) {
+        buf[0] = 0U;
+        buf[n + 1] = 0U;
+        MemsetD8Optimized(buf + 1, 0xA7, n);
+        EXPECT_EQ(buf[0], 0U) << "Underrun at n=" << n;
+        EXPECT_EQ(buf[n + 1], 0U) << "Overrun at n=" << n;
+        size_t mismatch = 0;
+        for (size_t i = 1; i <= n; ++i) {
+            mismatch += (buf[i] != 0xA7) ? 1U : 0U;
+        }
+        EXPECT_EQ(mismatch, 0U) << "Failed at n=" << n;
+    }
+    free(buf);
+}
@@ -1020,6 +1020,76 @@ TEST_F(ArgLoaderTest, uma_arg_loader_copy_err8)
     delete device;
 }
 
+TEST_F(ArgLoaderTest, h2d_copy_mgr_size_bucket)
+{
+    EXPECT_EQ(H2DCopyMgr::GetSizeBucket(0U), 0U);
+    EXPECT_EQ(H2DCopyMgr::GetSizeBucket(64U), 0U);
+    EXPECT_EQ(H2DCopyMgr::GetSizeBucket(65U), 1U);
+    EXPECT_EQ(H2DCopyMgr::GetSizeBucket(128U), 1U);
+    EXPECT_EQ(H2DCopyMgr::GetSizeBucket(129U), 2U);
+    EXPECT_EQ(H2DCopyMgr::GetSizeBucket(64U * 1024U * 1024U), H2D_COPY_STAT_SIZE_BUCKET_NUM - 1U);
+}
+
+TEST_F(ArgLoaderTest, h2d_copy_mgr_auto_policy)
+{
+    NpuDriver drv;
+    RawDevice* device = new RawDevice(0);
+    device->driver_ = &drv;
+    MOCKER_CPP_VIRTUAL(&drv, &NpuDriver::MemCopySync).stubs().will(returnValue(RT_ERROR_NONE));
+
+    H2DCopyMgr* argAllocator =
+        new (std::nothrow) H2DCopyMgr(device, 2, 5U, 5U, BufferAllocator::LINEAR, COPY_POLICY_MAX);
+    argAllocator->policy_ = COPY_POLICY_PCIE_BAR;
+    int dst = 0;
+    int src = 1;
+    // without AUTO or the stat switch nothing is recorded and no stat table is created
+    EXPECT_EQ(argAllocator->isStatEnable_, false);
+    EXPECT_EQ(argAllocator->H2DMemCopy(&dst, &src, sizeof(int)), RT_ERROR_NONE);
+    EXPECT_EQ(argAllocator->copyStat_.load(), nullptr);
+    H2DCopyStat emptyStat = {};
+    EXPECT_EQ(argAllocator->GetCopyStat(COPY_POLICY_PCIE_BAR, 0U, emptyStat), RT_ERROR_NONE);
+    EXPECT_EQ(emptyStat.count, 0U);
+
+    argAllocator->isAutoPolicy_ = true;
+    argAllocator->isStatEnable_ = true;
+    // warmup, both policies are tried in turn
+    for (uint32_t i = 0U; i < 16U; i++) {
+        EXPECT_EQ(argAllocator->H2DMemCopy(&dst, &src, sizeof(int)), RT_ERROR_NONE);
+    }
+    H2DCopyStat barStat = {};
+    H2DCopyStat syncStat = {};
+    EXPECT_EQ(argAllocator->GetCopyStat(COPY_POLICY_PCIE_BAR, 0U, barStat), RT_ERROR_NONE);
+    EXPECT_EQ(argAllocator->GetCopyStat(COPY_POLICY_SYNC, 0U, syncStat), RT_ERROR_NONE);
+    EXPECT_EQ(barStat.count, 8U);
+    EXPECT_EQ(syncStat.count, 8U);
+    EXPECT_EQ(barStat.bytes, 8U * sizeof(int));
+    uint64_t histCount = 0U;
+    for (uint32_t i = 0U; i < H2D_COPY_STAT_LATENCY_BIN_NUM; i++) {
+        histCount += barStat.latencyHist[i];
+    }
+    EXPECT_EQ(histCount, 8U);
+
+    // the cheaper policy is used afterwards
+    ASSERT_NE(argAllocator->copyStat_.load(), nullptr);
+    argAllocator->copyStat_.load()->avgCostNs[COPY_POLICY_PCIE_BAR][0U] = 1000U;
+    argAllocator->copyStat_.load()->avgCostNs[COPY_POLICY_SYNC][0U] = 10U;
+    EXPECT_EQ(argAllocator->GetAutoSelectedPolicy(0U), COPY_POLICY_SYNC);
+    EXPECT_EQ(argAllocator->H2DMemCopy(&dst, &src, sizeof(int)), RT_ERROR_NONE);
+    EXPECT_EQ(argAllocator->GetCopyStat(COPY_POLICY_SYNC, 0U, syncStat), RT_ERROR_NONE);
+    EXPECT_EQ(syncStat.count, 9U);
+
+    EXPECT_EQ(argAllocator->GetCopyStat(COPY_POLICY_MAX, 0U, syncStat), RT_ERROR_INVALID_VALUE);
+    EXPECT_EQ(argAllocator->GetCopyStat(COPY_POLICY_SYNC, H2D_COPY_STAT_SIZE_BUCKET_NUM, syncStat),
+        RT_ERROR_INVALID_VALUE);
+    argAllocator->ResetCopyStat();
+    EXPECT_EQ(argAllocator->GetCopyStat(COPY_POLICY_SYNC, 0U, syncStat), RT_ERROR_NONE);
+    EXPECT_EQ(syncStat.count, 0U);
+    EXPECT_EQ(argAllocator->GetAutoSelectedPolicy(0U), COPY_POLICY_SYNC);
+
+    delete argAllocator;
+    delete device;
+}
+
 TEST_F(ArgLoaderTest, uma_arg_loader_copy_long_string_cut)
 {
     int32_t devId = -1;
@@ -17,6 +17,7 @@
 #include "runtime/rt_inner_dfx.h"
 #include "parse_kernel_dfx_info.hpp"
 #include "thread_local_container.hpp"
+#include "latency_stat.hpp"
 #undef private
 #undef protected
 
@@ -216,3 +217,122 @@ TEST_F(ParseDfxInfoApiTest, ParseKernelDfxInfo_WhenConcurrentAccess_ExpectNoCras
 
     SUCCEED();
 }
+
+// LatencyStat links itself into a global list and has to outlive the exporter, so the instances are static
+class LatencyStatTest : public testing::Test {
+protected:
+    virtual void SetUp() {}
+
+    virtual void TearDown()
+    {
+        LatencyStatManager::Instance().SetEnable(false);
+        GlobalMockObject::verify();
+    }
+};
+
+TEST_F(LatencyStatTest, GetBucketIndex_WhenValueInRange_ExpectWithinBucketBound)
+{
+    EXPECT_EQ(LatencyStat::GetBucketIndex(0ULL), 0U);
+    EXPECT_EQ(LatencyStat::GetBucketIndex(3ULL), 3U);
+    EXPECT_EQ(LatencyStat::GetBucketIndex(4ULL), 4U);
+    EXPECT_EQ(LatencyStat::GetBucketIndex(8ULL), 8U);
+    EXPECT_EQ(LatencyStat::GetBucketIndex(UINT64_MAX), LATENCY_STAT_BUCKET_NUM - 1U);
+    const uint64_t values[] = {5ULL, 7ULL, 100ULL, 1000ULL, 123456ULL, 1ULL << 39U};
+    for (const uint64_t value : values) {
+        const uint32_t idx = LatencyStat::GetBucketIndex(value);
+        EXPECT_LE(LatencyStat::GetBucketLowerBound(idx), value);
+        EXPECT_GT(LatencyStat::GetBucketLowerBound(idx + 1U), value);
+    }
+}
+
+TEST_F(LatencyStatTest, GetSummary_WhenRecordCycle_ExpectPercentile)
+{
+    static LatencyStat stat("LatencyStatTest");
+    stat.Reset();
+    LatencyStatSummary summary;
+    EXPECT_FALSE(stat.GetSummary(summary));
+
+    for (uint64_t i = 1ULL; i <= 1000ULL; i++) {
+        stat.RecordCycle(i);
+    }
+    EXPECT_TRUE(stat.GetSummary(summary));
+    EXPECT_EQ(summary.count, 1000ULL);
+    EXPECT_EQ(summary.sumCycle, 500500ULL);
+    EXPECT_EQ(summary.maxCycle, 1000ULL);
+    // relative error of a bucket is below 1/8
+    EXPECT_NEAR(static_cast<double>(summary.p50Cycle), 500.0, 500.0 / 8);
+    EXPECT_NEAR(static_cast<double>(summary.p99Cycle), 990.0, 990.0 / 8);
+    EXPECT_LE(summary.p999Cycle, summary.maxCycle);
+
+    stat.Reset();
+    EXPECT_FALSE(stat.GetSummary(summary));
+}
+
+TEST_F(LatencyStatTest, RecordCycle_WhenMultiThread_ExpectNoLost)
+{
+    static LatencyStat stat("LatencyStatMultiThread");
+    stat.Reset();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0U; i < 4U; i++) {
+        threads.emplace_back([&stat]() {
+            for (uint64_t j = 0ULL; j < 1000ULL; j++) {
+                stat.RecordCycle(j);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LatencyStatSummary summary;
+    EXPECT_TRUE(stat.GetSummary(summary));
+    EXPECT_EQ(summary.count, 4000ULL);
+    EXPECT_EQ(summary.maxCycle, 999ULL);
+}
+
+TEST_F(LatencyStatTest, rtsSetLatencyStat_WhenSwitch_ExpectRecordOnlyWhenEnabled)
+{
+    static LatencyStat stat("LatencyStatSwitch");
+    stat.Reset();
+    uint64_t begin = 0ULL;
+    EXPECT_EQ(rtsSetLatencyStat(0U), RT_ERROR_NONE);
+    EXPECT_FALSE(LatencyStat::IsEnabled());
+
+    EXPECT_EQ(rtsSetLatencyStat(1U), RT_ERROR_NONE);
+    EXPECT_TRUE(LatencyStat::IsEnabled());
+    begin = LatencyStat::Now();
+    stat.Record(begin);
+    stat.Record(0ULL);
+    LatencyStatSummary summary;
+    EXPECT_TRUE(stat.GetSummary(summary));
+    EXPECT_EQ(summary.count, 1ULL);
+    stat.Dump();
+
+    EXPECT_EQ(rtsSetLatencyStat(0U), RT_ERROR_NONE);
+    EXPECT_FALSE(LatencyStat::IsEnabled());
+    // a new window is started when turned on again
+    EXPECT_EQ(rtsSetLatencyStat(1U), RT_ERROR_NONE);
+    EXPECT_FALSE(stat.GetSummary(summary));
+}
+
+TIMESTAMP_DEFINE(LatencyStatMacro)
+
+static void RunTimestampedSection()
+{
+    TIMESTAMP_BEGIN(LatencyStatMacro);
+    TIMESTAMP_END(LatencyStatMacro);
+}
+
+TEST_F(LatencyStatTest, TimestampMacro_WhenSwitch_ExpectRecordOnlyWhenEnabled)
+{
+    LatencyStatMacroStat.Reset();
+    LatencyStatSummary summary;
+    EXPECT_EQ(rtsSetLatencyStat(0U), RT_ERROR_NONE);
+    RunTimestampedSection();
+    EXPECT_FALSE(LatencyStatMacroStat.GetSummary(summary));
+
+    EXPECT_EQ(rtsSetLatencyStat(1U), RT_ERROR_NONE);
+    RunTimestampedSection();
+    RunTimestampedSection();
+    EXPECT_TRUE(LatencyStatMacroStat.GetSummary(summary));
+    EXPECT_EQ(summary.count, 2ULL);
+}
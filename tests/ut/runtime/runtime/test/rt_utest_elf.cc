@@ -29,6 +29,9 @@
 
 #include "elf.hpp"
 #include "data/elf.h"
+#include "kernel_bin_cache.hpp"
+#include <filesystem>
+#include <vector>
 
 using namespace testing;
 using namespace cce::runtime;
@@ -1278,3 +1281,93 @@ TEST_F(ELFTest, GetBinaryMetaInfo_Error)
     rtError_t ret = GetBinaryMetaInfo(&elfData, 99, 1, &data, &dataSize);
     EXPECT_NE(ret, RT_ERROR_NONE);
 }
+
+static void FreeElfKernels(rtElfData* elfData, RtKernel* kernels)
+{
+    for (uint32_t i = 0; (kernels != nullptr) && (i < elfData->kernel_num); ++i) {
+        DELETE_A(kernels[i].name);
+    }
+    delete[] kernels;
+    delete[] elfData->section_headers;
+    delete elfData;
+}
+
+class KernelBinCacheTest : public ELFTest {
+protected:
+    void SetUp() override
+    {
+        ELFTest::SetUp();
+        char_t dir[] = "/tmp/rt_utest_kernel_bin_cache_XXXXXX";
+        ASSERT_NE(mkdtemp(dir), nullptr);
+        cacheDir_ = dir;
+    }
+
+    void TearDown() override
+    {
+        if (!cacheDir_.empty()) {
+            std::filesystem::remove_all(cacheDir_);
+        }
+        ELFTest::TearDown();
+    }
+
+    std::string cacheDir_;
+};
+
+TEST_F(KernelBinCacheTest, StoreAndLoad)
+{
+    KernelBinCache binCache(cacheDir_);
+    ASSERT_TRUE(binCache.IsEnabled());
+
+    std::vector<char_t> binary(elf_o, elf_o + sizeof(elf_o));
+    const uint64_t binHash = binCache.HashBinary(binary.data(), binary.size());
+    rtElfData* elfData = new rtElfData();
+    elfData->obj_size = binary.size();
+    EXPECT_EQ(binCache.LoadElf(binary.data(), binary.size(), binHash, elfData), nullptr);
+    const std::string source(binary.data(), binary.size());
+    RtKernel* kernels = ProcessObject(binary.data(), elfData);
+    ASSERT_NE(kernels, nullptr);
+    binCache.StoreElf(binHash, source, elfData, kernels);
+
+    std::vector<char_t> reload(elf_o, elf_o + sizeof(elf_o));
+    EXPECT_EQ(binCache.HashBinary(reload.data(), reload.size()), binHash);
+    rtElfData* cachedData = new rtElfData();
+    cachedData->obj_size = reload.size();
+    RtKernel* cachedKernels = binCache.LoadElf(reload.data(), reload.size(), binHash, cachedData);
+    ASSERT_NE(cachedKernels, nullptr);
+    EXPECT_EQ(cachedData->kernel_num, elfData->kernel_num);
+    EXPECT_EQ(cachedData->func_num, elfData->func_num);
+    EXPECT_EQ(cachedData->elf_header.e_machine, elfData->elf_header.e_machine);
+    EXPECT_EQ(cachedData->text_offset, elfData->text_offset);
+    EXPECT_EQ(cachedData->text_size, elfData->text_size);
+    EXPECT_EQ(cachedData->stackSize, elfData->stackSize);
+    // pointers into the binary are rebased on the reloaded buffer
+    const auto offsetOf = [](const void* ptr, const char_t* base) -> ptrdiff_t {
+        return (ptr == nullptr) ? -1 : (static_cast<const char_t*>(ptr) - base);
+    };
+    EXPECT_EQ(offsetOf(cachedData->so_name, reload.data()), offsetOf(elfData->so_name, binary.data()));
+    EXPECT_EQ(cachedData->globalSymbolMap, elfData->globalSymbolMap);
+    for (uint32_t i = 0; i < elfData->kernel_num; ++i) {
+        EXPECT_STREQ(cachedKernels[i].name, kernels[i].name);
+        EXPECT_EQ(cachedKernels[i].offset, kernels[i].offset);
+        EXPECT_EQ(cachedKernels[i].length, kernels[i].length);
+        EXPECT_EQ(cachedKernels[i].metaInfo.funcType, kernels[i].metaInfo.funcType);
+        EXPECT_EQ(cachedKernels[i].metaInfo.taskRation, kernels[i].metaInfo.taskRation);
+        EXPECT_EQ(offsetOf(cachedKernels[i].metaInfo.dfxAddr, reload.data()),
+            offsetOf(kernels[i].metaInfo.dfxAddr, binary.data()));
+        EXPECT_EQ(cachedKernels[i].metaInfo.minStackSize, kernels[i].metaInfo.minStackSize);
+        EXPECT_EQ(cachedKernels[i].metaInfo.paramCount, kernels[i].metaInfo.paramCount);
+    }
+
+    // entry of another content is never returned
+    rtElfData* otherData = new rtElfData();
+    otherData->obj_size = binary.size();
+    EXPECT_EQ(binCache.LoadElf(binary.data(), binary.size(), binHash + 1ULL, otherData), nullptr);
+    // same key with different content, as on a hash collision, is a miss
+    std::vector<char_t> collide(elf_o, elf_o + sizeof(elf_o));
+    collide[collide.size() - 1U] ^= 0x5A;
+    EXPECT_EQ(binCache.LoadElf(collide.data(), collide.size(), binHash, otherData), nullptr);
+    delete otherData;
+
+    FreeElfKernels(cachedData, cachedKernels);
+    FreeElfKernels(elfData, kernels);
+}
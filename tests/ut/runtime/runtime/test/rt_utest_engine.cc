@@ -180,6 +180,49 @@ TEST_F(EngineTest, EngineSendingWait)
     delete kernel;
 }
 
+TEST_F(EngineTest, FifoSchedulerMultiProducerOrder)
+{
+    constexpr uint32_t producerNum = 4U;
+    constexpr uint32_t taskNum = FIFO_SCHEDULER_QUEUE_DEPTH;
+    std::vector<TaskInfo> tasks(producerNum * taskNum);
+    FifoScheduler* scheduler = new FifoScheduler();
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0U; p < producerNum; p++) {
+        producers.emplace_back([scheduler, &tasks, p]() {
+            for (uint32_t i = 0U; i < taskNum; i++) {
+                tasks[p * taskNum + i].id = static_cast<uint16_t>(p);
+                tasks[p * taskNum + i].taskSn = i;
+                EXPECT_EQ(scheduler->PushTask(&tasks[p * taskNum + i]), RT_ERROR_NONE);
+            }
+        });
+    }
+
+    // 每个生产者的任务保持提交顺序; 失败时也要回收生产者线程, 这里不能用 ASSERT
+    std::vector<uint32_t> nextSn(producerNum, 0U);
+    for (uint32_t i = 0U; i < producerNum * taskNum; i++) {
+        TaskInfo* task = scheduler->PopTask();
+        EXPECT_NE(task, nullptr);
+        if (task == nullptr) {
+            break;
+        }
+        EXPECT_EQ(task->taskSn, nextSn[task->id]);
+        nextSn[task->id]++;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    // 空任务只唤醒消费者
+    std::thread waker([scheduler]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        (void)scheduler->PushTask(nullptr);
+    });
+    EXPECT_EQ(scheduler->PopTask(), nullptr);
+    waker.join();
+    delete scheduler;
+}
+
 TEST_F(EngineTest, AddTaskToStream)
 {
     rtError_t err = RT_ERROR_NONE;
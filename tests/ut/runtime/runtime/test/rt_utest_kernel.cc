@@ -148,6 +148,38 @@ TEST_F(KernelTest, kernel_remove)
     EXPECT_EQ(kernel, (const Kernel*)NULL);
 }
 
+TEST_F(KernelTest, kernel_lookup_lock_free_snapshot)
+{
+    KernelTable table;
+    PlainProgram stubProg(RT_KERNEL_ATTR_TYPE_AICPU);
+    Program* program = &stubProg;
+    int32_t fun1, fun2;
+
+    MOCKER_CPP(&Runtime::GetProgram).stubs().will(returnValue(true));
+
+    Kernel* k1 = new Kernel("snap_f1", 0ULL, program, RT_KERNEL_ATTR_TYPE_AICPU, 10);
+    Kernel* k2 = new Kernel("snap_f2", 0ULL, program, RT_KERNEL_ATTR_TYPE_AICPU, 10);
+    k1->SetStub_(&fun1);
+    k2->SetStub_(&fun2);
+
+    EXPECT_EQ(table.Add(k1), RT_ERROR_NONE);
+    EXPECT_TRUE(table.lookupIndex_.IsStale());
+    // first lookup after registration publishes the snapshot
+    EXPECT_EQ(table.Lookup(&fun1), k1);
+    EXPECT_FALSE(table.lookupIndex_.IsStale());
+    EXPECT_EQ(table.Lookup(&fun1), k1);
+    EXPECT_EQ(table.Lookup(&fun2), nullptr);
+
+    EXPECT_EQ(table.Add(k2), RT_ERROR_NONE);
+    EXPECT_EQ(table.Lookup(&fun2), k2);
+    EXPECT_EQ(table.Lookup(&fun1), k1);
+
+    EXPECT_EQ(table.RemoveAll(program), RT_ERROR_NONE);
+    EXPECT_FALSE(table.lookupIndex_.IsStale());
+    EXPECT_EQ(table.Lookup(&fun1), nullptr);
+    EXPECT_EQ(table.Lookup(&fun2), nullptr);
+}
+
 TEST_F(KernelTest, kernel_table_destroy_releases_remaining_kernels)
 {
     PlainProgram stubProg(RT_KERNEL_ATTR_TYPE_AICPU);
@@ -36,6 +36,7 @@
 #include "inner_thread_local.hpp"
 #include "profiling_agent.hpp"
 #include "onlineprof.hpp"
+#include "profile_record_ring.hpp"
 #include "data/elf.h"
 #undef protected
 #undef private
@@ -4378,3 +4379,40 @@ TEST_F(ProfilerTest, RuntimeProfilerStop_UnInitFailed)
     profiler->RuntimeProfilerStop();
     GlobalMockObject::verify();
 }
+
+TEST_F(ProfilerTest, ProfileRecordRing_DrainAtWatermarkAndFlush)
+{
+    MOCKER(MsprofReportCompactInfo).stubs().will(returnValue(0));
+    ProfileRecordRing::FlushAll();
+    ProfileRecordRing::ResetOpStat();
+
+    rtProfileRecordSyncRt_t record = {};
+    record.type = PROFILE_RECORD_TYPE_RT_CALL_RT;
+    record.rtOpType = 1U;
+    record.startStamp = 100ULL;
+    record.endStamp = 300ULL;
+    for (uint32_t i = 0U; i < PROFILE_RECORD_RING_DRAIN_WATERMARK; i++) {
+        ProfileRecordRing::Push(record);
+    }
+    ProfileRecordOpStat stat = {};
+    EXPECT_TRUE(ProfileRecordRing::GetOpStat(1U, stat));
+    EXPECT_EQ(stat.count, PROFILE_RECORD_RING_DRAIN_WATERMARK);
+    EXPECT_EQ(stat.totalNs, PROFILE_RECORD_RING_DRAIN_WATERMARK * 200ULL);
+    EXPECT_EQ(stat.maxNs, 200ULL);
+
+    rtProfileRecordSyncDrv_t drvRecord = {};
+    drvRecord.type = PROFILE_RECORD_TYPE_RT_CALL_DRV;
+    drvRecord.drvOpType = 2U;
+    drvRecord.startStamp = 100ULL;
+    drvRecord.endStamp = 600ULL;
+    ProfileRecordRing::Push(drvRecord);
+    EXPECT_FALSE(ProfileRecordRing::GetOpStat(2U, stat));
+    ProfileRecordRing::DumpOpStat();
+    EXPECT_TRUE(ProfileRecordRing::GetOpStat(2U, stat));
+    EXPECT_EQ(stat.count, 1ULL);
+    EXPECT_EQ(stat.maxNs, 500ULL);
+
+    ProfileRecordRing::ResetOpStat();
+    EXPECT_FALSE(ProfileRecordRing::GetOpStat(1U, stat));
+    EXPECT_FALSE(ProfileRecordRing::GetOpStat(PROFILE_RECORD_OP_TYPE_NUM, stat));
+}
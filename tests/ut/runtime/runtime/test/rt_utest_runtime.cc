@@ -934,6 +934,33 @@ TEST_F(RuntimeTest, GetKernelBinByFileName_test)
     EXPECT_EQ(ret, RT_ERROR_NONE);
 }
 
+TEST_F(RuntimeTest, GetKernelBinByFileName_read_large_file)
+{
+    Runtime* rtInstance = (Runtime*)Runtime::Instance();
+    const char_t* binFileName = "/tmp/rt_utest_large_kernel.bin";
+    const std::string content(512U * 1024U, 'k');
+    std::ofstream ofs(binFileName, std::ios::binary);
+    ofs << content;
+    ofs.close();
+
+    char_t* buffer = nullptr;
+    uint64_t length = 0U;
+    rtError_t ret = rtInstance->GetKernelBinByFileName(binFileName, &buffer, &length);
+    EXPECT_EQ(ret, RT_ERROR_NONE);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(length, content.size());
+    EXPECT_EQ(buffer[0], 'k');
+    EXPECT_EQ(buffer[length - 1U], 'k');
+    // the buffer is a snapshot, rewriting the file afterwards must not change it
+    std::ofstream rewrite(binFileName, std::ios::binary | std::ios::in | std::ios::out);
+    rewrite << 'x';
+    rewrite.close();
+    EXPECT_EQ(buffer[0], 'k');
+    ret = rtInstance->FreeKernelBin(buffer);
+    EXPECT_EQ(ret, RT_ERROR_NONE);
+    unlink(binFileName);
+}
+
 TEST_F(RuntimeTest, feature_version_1)
 {
     FeatureToTsVersionInit();
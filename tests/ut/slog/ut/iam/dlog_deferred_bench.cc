@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2026 Huawei Technologies Co., Ltd.
+ * This program is free software, you can redistribute it and/or modify it under the terms and conditions of
+ * CANN Open Software License Agreement Version 2.0 (the "License").
+ * Please refer to the License for details. You may not use this file except in compliance with the License.
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT, MERCHANTABILITY, OR FITNESS FOR A PARTICULAR PURPOSE.
+ * See LICENSE in the root of the software repository for the full text of the License.
+ */
+
+// Deferred log format microbenchmark.
+// Compares the caller thread cost of an eager log (time string, head and vsnprintf, as DlogWriteInner does) with a
+// deferred log (raw time, format id and arguments), the send task cost of formatting the deferred log, and the bytes
+// each log takes in the thread buffer:
+//   dlog_deferred_bench --iterations=1000000
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "dlog_core.h"
+#include "dlog_deferred.h"
+#include "dlog_time.h"
+
+extern "C" {
+// STATIC is empty in _LOG_UT_ builds, the eager path is measured through the same function DlogWriteInner uses
+int32_t ConstructLogMsg(LogMsg *logMsg, const LogMsgArg *msgArg, const char *fmt, va_list v);
+}
+
+namespace {
+using BenchClock = std::chrono::steady_clock;
+
+constexpr uint32_t BENCH_RECORD_HEAD_SIZE = 24U; // DlogThreadRecord in dlog_async_process.c
+constexpr uint32_t BENCH_RECORD_ALIGN = 8U;
+constexpr char BENCH_FMT[] = "launch kernel, stream_id=%d, task_id=%u, name=%s, block_dim=%u, args_size=%zu.";
+
+struct BenchResult {
+    double nsPerLog = 0.0;
+    uint32_t recordSize = 0U;
+};
+
+uint32_t RecordSize(uint32_t msgLen)
+{
+    return (BENCH_RECORD_HEAD_SIZE + msgLen + BENCH_RECORD_ALIGN - 1U) & ~(BENCH_RECORD_ALIGN - 1U);
+}
+
+LogMsgArg MakeArg()
+{
+    LogMsgArg arg = {};
+    arg.moduleId = SLOG;
+    arg.typeMask = DEBUG_LOG_MASK;
+    arg.level = DLOG_INFO;
+    arg.selfPid = 1;
+    return arg;
+}
+
+double NsPerLog(BenchClock::time_point start, uint64_t iterations)
+{
+    const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+    return static_cast<double>(cost) / static_cast<double>(iterations);
+}
+
+int32_t EagerLog(LogMsg *logMsg, LogMsgArg *arg, const char *fmt, ...)
+{
+    DlogGetTime(arg->timestamp, TIMESTAMP_LEN);
+    va_list values;
+    va_start(values, fmt);
+    int32_t ret = ConstructLogMsg(logMsg, arg, fmt, values);
+    va_end(values);
+    return ret;
+}
+
+int32_t DeferredLog(LogMsg *logMsg, const char *fmt, ...)
+{
+    va_list values;
+    va_start(values, fmt);
+    int32_t ret = DlogDeferredEncodeLog(logMsg->msg, MSG_LENGTH, fmt, values, &logMsg->msgLength);
+    va_end(values);
+    return ret;
+}
+
+BenchResult RunEager(uint64_t iterations)
+{
+    LogMsg logMsg = {};
+    LogMsgArg arg = MakeArg();
+    const auto start = BenchClock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        (void)EagerLog(&logMsg, &arg, BENCH_FMT, static_cast<int32_t>(i & 0xFFU), static_cast<uint32_t>(i),
+            "matmul_kernel_0", 48U, static_cast<size_t>(256));
+    }
+    return {NsPerLog(start, iterations), RecordSize(logMsg.msgLength)};
+}
+
+BenchResult RunDeferred(uint64_t iterations, LogMsg *logMsg)
+{
+    const auto start = BenchClock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        (void)DeferredLog(logMsg, BENCH_FMT, static_cast<int32_t>(i & 0xFFU), static_cast<uint32_t>(i),
+            "matmul_kernel_0", 48U, static_cast<size_t>(256));
+    }
+    return {NsPerLog(start, iterations), RecordSize(logMsg->msgLength)};
+}
+
+BenchResult RunDecode(uint64_t iterations, const LogMsg *encoded)
+{
+    char text[MSG_LENGTH];
+    uint32_t textLen = 0U;
+    const auto start = BenchClock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        LogMsgArg arg = MakeArg();
+        textLen = DlogDeferredDecodeLog(encoded->msg, encoded->msgLength, &arg, text, sizeof(text));
+    }
+    return {NsPerLog(start, iterations), RecordSize(textLen)};
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    uint64_t iterations = 1000000ULL;
+    for (int32_t i = 1; i < argc; i++) {
+        const std::string option(argv[i]);
+        if (option.rfind("--iterations=", 0) == 0) {
+            iterations = std::strtoull(option.c_str() + strlen("--iterations="), nullptr, 10);
+        }
+    }
+    if (iterations == 0ULL) {
+        (void)fprintf(stderr, "usage: %s [--iterations=N]\n", argv[0]);
+        return 1;
+    }
+
+    LogMsg encoded = {};
+    const BenchResult eager = RunEager(iterations);
+    const BenchResult deferred = RunDeferred(iterations, &encoded);
+    const BenchResult decode = RunDecode(iterations, &encoded);
+    (void)printf("%-24s %12s %14s\n", "case", "ns/log", "record bytes");
+    (void)printf("%-24s %12.1f %14u\n", "eager_caller", eager.nsPerLog, eager.recordSize);
+    (void)printf("%-24s %12.1f %14u\n", "deferred_caller", deferred.nsPerLog, deferred.recordSize);
+    (void)printf("%-24s %12.1f %14s\n", "deferred_send_task", decode.nsPerLog, "-");
+    return 0;
+}
@@ -14,12 +14,15 @@
 #include <cstdlib>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <string>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
 #include "dlog_async_process.h"
 #include "dlog_attr.h"
 #include "dlog_core.h"
+#include "dlog_deferred.h"
 #include "dlog_iam.h"
 #include "dlog_level_mgr.h"
 #include "log_iam_pub.h"
@@ -34,6 +37,9 @@ void LogCtrlIncLogic(void);
 int32_t DlogWriteBufToHiMem(RingBufferStat* ringBuffer);
 void SafeWritesByIam(RingBufferStat* ringBuffer);
 void DlogPrintLogLoss(void);
+void DlogThreadBufRelease(void *arg);
+extern __thread void *g_dlogThreadBuf;
+extern uint64_t g_deferredUnloadNum;
 
 void IamSlogStubReset(void);
 void IamSlogStubSetServicePreparation(bool ready);
@@ -175,6 +181,205 @@ int RunAsyncCoverageScenario()
     DlogSetInited(false);
     return result;
 }
+
+// Every thread writes into its own buffer, the periodic timer merges them into one ring buffer for slogd.
+int RunThreadBufferMergeScenario()
+{
+    int result = 0;
+    auto check = [&result](bool condition) {
+        if (!condition) {
+            result = 1;
+        }
+    };
+    DlogSetInited(false);
+    DlogInit();
+    check(DlogIsInited());
+    IamSlogStubNotifyResource(IAM_RESOURCE_READY);
+    check(DlogIamServiceIsValid());
+
+    constexpr int32_t threadNum = 4;
+    constexpr int32_t logNum = 100;
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < threadNum; t++) {
+        threads.emplace_back([t]() {
+            LogMsg message = {};
+            message.type = DEBUG_LOG;
+            message.level = DLOG_ERROR;
+            message.moduleId = SLOG;
+            for (int32_t i = 0; i < logNum; i++) {
+                int32_t len = sprintf_s(message.msg, sizeof(message.msg), "thread %d log %03d", t, i);
+                message.msgLength = static_cast<uint32_t>(len);
+                DlogWriteToBuf(&message);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    IamSlogStubFirePeriodicTimer();
+
+    std::vector<char> sent(DEF_SIZE / 4U);
+    int32_t fd = open(LOGOUT_IAM_SERVICE_PATH, O_RDONLY);
+    check(fd >= 0);
+    check(read(fd, sent.data(), sent.size()) == static_cast<ssize_t>(sent.size()));
+    (void)close(fd);
+
+    const RingBufferCtrl *ctrl = reinterpret_cast<const RingBufferCtrl *>(sent.data());
+    ReadContext context = {};
+    LogBufReStart(ctrl, &context);
+    std::vector<int32_t> nextIdx(threadNum, 0);
+    char text[MSG_LENGTH] = {0};
+    LogHead head = {};
+    int32_t count = 0;
+    while (LogBufRead(&context, ctrl, text, sizeof(text), &head) > 0) {
+        int32_t t = -1;
+        int32_t i = -1;
+        check(sscanf(text, "thread %d log %d", &t, &i) == 2);
+        check((t >= 0) && (t < threadNum) && (nextIdx[t] == i));
+        if ((t >= 0) && (t < threadNum)) {
+            nextIdx[t] = i + 1;
+        }
+        count++;
+    }
+    check(count == threadNum * logNum);
+
+    IamSlogStubNotifyResource(IAM_RESOURCE_WAITING);
+    DlogAsyncExit();
+    DlogSetInited(false);
+    return result;
+}
+
+int RunThreadBufReleaseScenario()
+{
+    int result = 0;
+    auto check = [&result](bool condition) {
+        if (!condition) {
+            result = 1;
+        }
+    };
+    DlogSetInited(false);
+    DlogInit();
+    check(DlogIsInited());
+    IamSlogStubNotifyResource(IAM_RESOURCE_READY);
+
+    LogMsg message = {};
+    message.type = DEBUG_LOG;
+    message.level = DLOG_ERROR;
+    message.moduleId = SLOG;
+    int32_t len = sprintf_s(message.msg, sizeof(message.msg), "thread buffer release");
+    message.msgLength = static_cast<uint32_t>(len);
+
+    void *released = nullptr;
+    std::thread first([&]() {
+        DlogWriteToBuf(&message);
+        released = g_dlogThreadBuf;
+        check(released != nullptr);
+        // key destructor runs on the exiting thread, the thread must not keep the released buffer
+        DlogThreadBufRelease(released);
+        check(g_dlogThreadBuf == nullptr);
+        DlogWriteToBuf(&message);
+        check(g_dlogThreadBuf != nullptr);
+    });
+    first.join();
+
+    void *reused = nullptr;
+    std::thread second([&]() {
+        DlogWriteToBuf(&message);
+        reused = g_dlogThreadBuf;
+    });
+    second.join();
+    check(reused == released);
+
+    IamSlogStubNotifyResource(IAM_RESOURCE_WAITING);
+    DlogAsyncExit();
+    DlogSetInited(false);
+    return result;
+}
+
+uint32_t DeferredRoundTrip(char* text, uint32_t textLen, const char* fmt, ...)
+{
+    char encoded[MSG_LENGTH] = {0};
+    uint32_t encodeLen = 0U;
+    va_list values;
+    va_start(values, fmt);
+    int32_t ret = DlogDeferredEncode(encoded, sizeof(encoded), fmt, values, &encodeLen);
+    va_end(values);
+    if (ret != LOG_SUCCESS) {
+        return 0U;
+    }
+    return DlogDeferredDecode(encoded, encodeLen, text, textLen);
+}
+
+int32_t DeferredEncode(char* buf, uint32_t* encodeLen, const char* fmt, ...)
+{
+    va_list values;
+    va_start(values, fmt);
+    int32_t ret = DlogDeferredEncode(buf, MSG_LENGTH, fmt, values, encodeLen);
+    va_end(values);
+    return ret;
+}
+
+int32_t DeferredEncodeLog(char* buf, uint32_t* encodeLen, const char* fmt, ...)
+{
+    va_list values;
+    va_start(values, fmt);
+    int32_t ret = DlogDeferredEncodeLog(buf, MSG_LENGTH, fmt, values, encodeLen);
+    va_end(values);
+    return ret;
+}
+
+// Logs written in deferred mode reach slogd as the same text eager formatting would produce.
+int RunDeferredFormatScenario()
+{
+    int result = 0;
+    auto check = [&result](bool condition) {
+        if (!condition) {
+            result = 1;
+        }
+    };
+    (void)setenv("ASCEND_LOG_DEFERRED_FORMAT", "1", 1);
+    check(DlogDeferredEnabled());
+    DlogSetInited(false);
+    DlogInit();
+    IamSlogStubNotifyResource(IAM_RESOURCE_READY);
+    check(DlogIamServiceIsValid());
+
+    LogMsgArg debug = MakeMsgArg(SLOG, DEBUG_LOG_MASK, DLOG_ERROR);
+    check(CallWrite(&debug, "deferred %d %s %5.2f", 7, "seven", 7.0) == LOG_SUCCESS);
+    check(CallWrite(&debug, "fallback %ls", L"wide") == LOG_SUCCESS);
+    IamSlogStubFirePeriodicTimer();
+
+    std::vector<char> sent(DEF_SIZE / 4U);
+    int32_t fd = open(LOGOUT_IAM_SERVICE_PATH, O_RDONLY);
+    check(fd >= 0);
+    check(read(fd, sent.data(), sent.size()) == static_cast<ssize_t>(sent.size()));
+    (void)close(fd);
+
+    const RingBufferCtrl *ctrl = reinterpret_cast<const RingBufferCtrl *>(sent.data());
+    ReadContext context = {};
+    LogBufReStart(ctrl, &context);
+    char text[MSG_LENGTH] = {0};
+    LogHead head = {};
+    std::vector<std::string> logs;
+    while (LogBufRead(&context, ctrl, text, sizeof(text), &head) > 0) {
+        logs.emplace_back(text, head.msgLength);
+        (void)memset_s(text, sizeof(text), 0, sizeof(text));
+    }
+    check(logs.size() == 2U);
+    check((logs.size() > 0U) && (logs[0].find("deferred 7 seven  7.00") != std::string::npos));
+    check((logs.size() > 1U) && (logs[1].find("fallback wide") != std::string::npos));
+    // head built by send task is the same as the eager one up to the timestamp
+    if (logs.size() == 2U) {
+        const size_t headEnd = logs[1].find("):");
+        check((headEnd != std::string::npos) && (logs[0].compare(0, headEnd + 2U, logs[1], 0, headEnd + 2U) == 0));
+        check(logs[0].find("[ERROR] SLOG(") == 0U);
+    }
+
+    IamSlogStubNotifyResource(IAM_RESOURCE_WAITING);
+    DlogAsyncExit();
+    DlogSetInited(false);
+    return result;
+}
 }
 
 class IamSlogCoverageUtest : public testing::Test {
@@ -235,6 +440,18 @@ TEST_F(IamSlogCoverageUtest, InitializesWritesFlushesAndExits)
     EXPECT_EXIT(std::exit(RunAsyncCoverageScenario()), testing::ExitedWithCode(0), "");
 }
 
+TEST_F(IamSlogCoverageUtest, MergesThreadBuffersInOrder)
+{
+    CreateIamService();
+    EXPECT_EXIT(std::exit(RunThreadBufferMergeScenario()), testing::ExitedWithCode(0), "");
+}
+
+TEST_F(IamSlogCoverageUtest, ReleasesThreadBufferOnThreadExit)
+{
+    CreateIamService();
+    EXPECT_EXIT(std::exit(RunThreadBufReleaseScenario()), testing::ExitedWithCode(0), "");
+}
+
 TEST_F(IamSlogCoverageUtest, HandlesIamRegistrationAndResourceLifecycle)
 {
     IamSlogStubSetServicePreparation(false);
@@ -288,3 +505,84 @@ TEST_F(IamSlogCoverageUtest, InitializesSystemLevelsFromIam)
     IamSlogStubSetIoctlResult(SYS_ERROR, EBUSY);
     DlogLevelInitCallBack();
 }
+
+TEST_F(IamSlogCoverageUtest, DeferredFormatMatchesEagerFormat)
+{
+    char text[MSG_LENGTH] = {0};
+    char expect[MSG_LENGTH] = {0};
+    const char *nullStr = nullptr;
+    uint32_t len = DeferredRoundTrip(text, sizeof(text), "%d %5.2f %-4s|%.3s|%*d %x %p %c %llu %hhd %%",
+        -12, 3.14159, "ab", "abcdef", 6, 42, 0xbeefU, reinterpret_cast<void *>(0x1234), 'z', 18446744073709551615ULL,
+        300);
+    int32_t expectLen = snprintf(expect, sizeof(expect), "%d %5.2f %-4s|%.3s|%*d %x %p %c %llu %hhd %%",
+        -12, 3.14159, "ab", "abcdef", 6, 42, 0xbeefU, reinterpret_cast<void *>(0x1234), 'z', 18446744073709551615ULL,
+        300);
+    EXPECT_EQ(static_cast<uint32_t>(expectLen), len);
+    EXPECT_STREQ(expect, text);
+
+    len = DeferredRoundTrip(text, sizeof(text), "%-*.*s|%+08.3e|%#o|%s|%zu|%ld", -6, 2, "xyz", 1.5e-7, 8U, nullStr,
+        static_cast<size_t>(99), -5L);
+    (void)snprintf(expect, sizeof(expect), "%-*.*s|%+08.3e|%#o|%s|%zu|%ld", -6, 2, "xyz", 1.5e-7, 8U, "(null)",
+        static_cast<size_t>(99), -5L);
+    EXPECT_EQ(strlen(expect), len);
+    EXPECT_STREQ(expect, text);
+
+    EXPECT_EQ(0U, DeferredRoundTrip(text, sizeof(text), "%ls", L"wide"));
+    EXPECT_EQ(0U, DeferredRoundTrip(text, sizeof(text), "%Lf", 1.0L));
+}
+
+TEST_F(IamSlogCoverageUtest, DeferredFormatIsStoredById)
+{
+    char first[MSG_LENGTH] = {0};
+    char second[MSG_LENGTH] = {0};
+    uint32_t firstLen = 0U;
+    uint32_t secondLen = 0U;
+    const char *fmt = "stored by id %d %s";
+    EXPECT_EQ(LOG_SUCCESS, DeferredEncode(first, &firstLen, fmt, 1, "one"));
+    EXPECT_EQ(LOG_SUCCESS, DeferredEncode(second, &secondLen, fmt, 2, "two"));
+    // uint16 id, one 8 bytes integer, uint16 length and bytes of string, the format itself is not copied
+    EXPECT_EQ(2U + 8U + 2U + 3U, firstLen);
+    EXPECT_EQ(firstLen, secondLen);
+    EXPECT_EQ(0, memcmp(first, second, 2U));
+
+    char text[MSG_LENGTH] = {0};
+    EXPECT_EQ(strlen("stored by id 2 two"), DlogDeferredDecode(second, secondLen, text, sizeof(text)));
+    EXPECT_STREQ("stored by id 2 two", text);
+
+    // id is taken from the thread cache until a library is unloaded, then the address is checked again
+    // and another format loaded at an address already registered is written eagerly
+    char reused[] = "reused %d";
+    EXPECT_EQ(LOG_SUCCESS, DeferredEncode(first, &firstLen, reused, 1));
+    reused[0] = 'R';
+    EXPECT_EQ(LOG_SUCCESS, DeferredEncode(second, &secondLen, reused, 1));
+    EXPECT_EQ(0, memcmp(first, second, 2U));
+    g_deferredUnloadNum = UINT64_MAX;
+    DlogDeferredCheckUnload();
+    EXPECT_NE(UINT64_MAX, g_deferredUnloadNum);
+    EXPECT_EQ(LOG_FAILURE, DeferredEncode(first, &firstLen, reused, 1));
+}
+
+TEST_F(IamSlogCoverageUtest, DeferredLogBuildsHeadOnDecode)
+{
+    char encoded[MSG_LENGTH] = {0};
+    uint32_t encodeLen = 0U;
+    EXPECT_EQ(LOG_SUCCESS, DeferredEncodeLog(encoded, &encodeLen, "decode head %u", 5U));
+
+    LogMsgArg arg = MakeMsgArg(SLOG, DEBUG_LOG_MASK, DLOG_WARN);
+    arg.selfPid = 1234;
+    char text[MSG_LENGTH] = {0};
+    uint32_t len = DlogDeferredDecodeLog(encoded, encodeLen, &arg, text, sizeof(text));
+    EXPECT_EQ(strlen(text), len);
+    std::string log(text);
+    EXPECT_EQ(0U, log.find("[WARNING] SLOG(1234,"));
+    EXPECT_EQ(log.size() - strlen("decode head 5"), log.rfind(" decode head 5") + 1U);
+    EXPECT_NE('\0', arg.timestamp[0]);
+
+    EXPECT_EQ(0U, DlogDeferredDecodeLog(encoded, 4U, &arg, text, sizeof(text)));
+}
+
+TEST_F(IamSlogCoverageUtest, WritesDeferredFormatLogs)
+{
+    CreateIamService();
+    EXPECT_EXIT(std::exit(RunDeferredFormatScenario()), testing::ExitedWithCode(0), "");
+}
@@ -10,8 +10,11 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <cstring>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 #include <unistd.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
@@ -92,6 +95,20 @@ extern "C" int32_t CovWriteFailCb(const char *content, uint32_t len, int32_t typ
     (void)type;
     return -1;
 }
+static std::atomic<uint32_t> g_covWriteNum{0};
+static std::atomic<uint32_t> g_covWriteAfterRelease{0};
+static std::atomic<bool> g_covWriteReleased{false};
+extern "C" int32_t CovWriteCountCb(const char *content, uint32_t len, int32_t type)
+{
+    (void)content;
+    (void)len;
+    (void)type;
+    if (g_covWriteReleased.load()) {
+        g_covWriteAfterRelease++;
+    }
+    g_covWriteNum++;
+    return 0;
+}
 extern "C" void CovFlushCb(void) {}
 extern "C" void CovForkCb(void) {}
 extern "C" void CovAtForkCb(int32_t stage)
@@ -571,6 +588,35 @@ TEST_F(DlogCoreUtest, RegisterCallbacksAndPlogPath)
     EXPECT_EQ(LOG_FAILURE, CallWrite(&argDiscard, "discard %d", 10));
 }
 
+TEST_F(DlogCoreUtest, PlogWritersStopUsingCallbackOnceUnregistered)
+{
+    /* writers call the plog callback without the slog lock, unregister must wait for them */
+    g_covWriteNum = 0;
+    g_covWriteAfterRelease = 0;
+    g_covWriteReleased = false;
+    EXPECT_EQ(SUCCESS, RegisterCallback(reinterpret_cast<ArgPtr>(CovWriteCountCb), LOG_WRITE));
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (uint32_t i = 0; i < 4U; i++) {
+        writers.emplace_back([&stop]() {
+            while (!stop.load()) {
+                LogMsgArg arg = MakeMsgArg(SLOG, DEBUG_LOG_MASK, DLOG_ERROR);
+                (void)CallWrite(&arg, "concurrent %d", 12);
+            }
+        });
+    }
+    while (g_covWriteNum.load() < 1000U) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(SUCCESS, RegisterCallback(nullptr, LOG_WRITE));
+    g_covWriteReleased = true;
+    stop = true;
+    for (auto &writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(0U, g_covWriteAfterRelease.load());
+}
+
 TEST_F(DlogCoreUtest, RegisterFlushForkAtForkAndDefault)
 {
     EXPECT_EQ(SUCCESS, RegisterCallback(reinterpret_cast<ArgPtr>(CovFlushCb), LOG_FLUSH));